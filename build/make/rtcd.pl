@@ -37,6 +37,7 @@ GetOptions(
   'arch=s',
   'sym=s',
   'config=s',
+  'bench',
 );
 
 foreach my $opt (qw/arch config/) {
@@ -146,7 +147,7 @@ sub determine_indirection {
       next if $link && $link eq "false";
       $n .= "x";
     }
-    if ($n eq "x") {
+    if ($n eq "x" && !profile()) {
       eval "\$${fn}_indirect = 'false'";
     } else {
       eval "\$${fn}_indirect = 'true'";
@@ -154,6 +155,71 @@ sub determine_indirection {
   }
 }
 
+#
+# Profiling wrappers, see vpx_ports/vpx_rtcd_profile.h
+#
+sub profile {
+  return vpx_config("CONFIG_RTCD_PROFILE") eq "yes";
+}
+
+# Renames the parameters of a prototype to a0, a1, ..., as some prototypes
+# leave them unnamed. Returns the new parameter list and the argument list,
+# e.g. "const uint8_t *src, int" becomes "const uint8_t *a0, int a1" and
+# "a0, a1".
+sub wrapper_args($) {
+  my (@decls, @names);
+  foreach my $arg (split /,/, $_[0]) {
+    $arg =~ s/^\s+|\s+$//g;
+    next if $arg eq "void";
+    $arg =~ s/\s*((?:\[[^\]]*\])*)$//;
+    my $dims = $1;
+    if ($arg =~ /^(.*?[\w*])\s*\b(\w+)$/) {
+      my ($type, $name) = ($1, $2);
+      my $words = $type;
+      $words =~ s/[*]/ /g;
+      $arg = $type
+        if $name !~ /^(?:const|volatile)$/ &&
+           $words !~ /^\s*(?:(?:const|volatile|signed|unsigned|struct)\s+)*$/;
+    }
+    my $name = "a" . scalar(@names);
+    push @decls, ($arg =~ /\*$/ ? "$arg" : "$arg ") . "$name$dims";
+    push @names, $name;
+  }
+  return (@decls ? join(", ", @decls) : "void", join(", ", @names));
+}
+
+sub declare_profile_wrappers {
+  my $table = "$opts{sym}_profile";
+  my $i = 0;
+  print "#ifdef RTCD_C\n";
+  print "#include \"vpx_ports/vpx_rtcd_profile.h\"\n\n";
+  print "static vpx_rtcd_profile_entry ${table}[] = {\n";
+  foreach my $fn (sort keys %ALL_FUNCS) {
+    print "  { \"$fn\", 0, 0 },\n";
+  }
+  print "};\n\n";
+  foreach my $fn (sort keys %ALL_FUNCS) {
+    my @val = @{$ALL_FUNCS{$fn}};
+    my $args = pop @val;
+    my $rtyp = "@val";
+    my ($decls, $names) = wrapper_args($args);
+    print "static $rtyp (*${fn}_profiled_impl)($args);\n";
+    print "static $rtyp ${fn}_profiled($decls) {\n";
+    print "  const uint64_t start = vpx_rtcd_profile_now();\n";
+    if ($rtyp eq "void") {
+      print "  ${fn}_profiled_impl($names);\n";
+      print "  vpx_rtcd_profile_add(&${table}\[$i\], start);\n";
+    } else {
+      print "  $rtyp ret = ${fn}_profiled_impl($names);\n";
+      print "  vpx_rtcd_profile_add(&${table}\[$i\], start);\n";
+      print "  return ret;\n";
+    }
+    print "}\n\n";
+    $i++;
+  }
+  print "#endif\n\n";
+}
+
 sub declare_function_pointers {
   foreach my $fn (sort keys %ALL_FUNCS) {
     my @val = @{$ALL_FUNCS{$fn}};
@@ -195,6 +261,15 @@ sub set_function_pointers {
       }
     }
   }
+  if (profile()) {
+    foreach my $fn (sort keys %ALL_FUNCS) {
+      print "    ${fn}_profiled_impl = $fn;\n";
+      print "    $fn = ${fn}_profiled;\n";
+    }
+    print "    vpx_rtcd_profile_register($opts{sym}_profile,\n";
+    print "                              (int)(sizeof($opts{sym}_profile) /\n";
+    print "                                    sizeof($opts{sym}_profile[0])));\n";
+  }
 }
 
 sub filter {
@@ -230,6 +305,7 @@ extern "C" {
 
 EOF
 declare_function_pointers("c", @ALL_ARCHS);
+declare_profile_wrappers() if profile();
 
 print <<EOF;
 void $opts{sym}(void);
@@ -438,6 +514,67 @@ EOF
   common_bottom;
 }
 
+#
+# Benchmark table generation
+#
+
+# Reduces a prototype to its types, e.g. "const uint8_t *src, int stride"
+# becomes "const uint8_t *, int".
+sub normalize_args($) {
+  my @types;
+  foreach my $arg (split /,/, $_[0]) {
+    $arg =~ s/^\s+|\s+$//g;
+    $arg =~ s/\s*((?:\[[^\]]*\])*)$//;
+    my $dims = $1;
+    $arg =~ s/\w+$// unless $arg eq "void";
+    $arg =~ s/\s+$//;
+    $arg =~ s/\s*\*\s*/ */g;
+    $arg =~ s/\s+/ /g;
+    push @types, "$arg$dims";
+  }
+  return join(", ", @types);
+}
+
+sub bench_table {
+  print <<EOF;
+// This file is generated. Do not edit.
+//
+// Lists every function in $opts{sym} with the specializations built for this
+// target. Define RTCD_BENCH_FUNCTION(fn, signature),
+// RTCD_BENCH_IMPL(ext, impl, cpu_flag) and RTCD_BENCH_END(fn) before
+// including it. A cpu_flag of 0 marks a specialization that is always
+// available.
+
+EOF
+  foreach my $fn (sort keys %ALL_FUNCS) {
+    my @val = @{$ALL_FUNCS{$fn}};
+    my $args = pop @val;
+    my $rtyp = "@val";
+    my $sig = "$rtyp(" . normalize_args($args) . ")";
+    print "RTCD_BENCH_FUNCTION($fn, \"$sig\")\n";
+    foreach my $opt ("c", @ALL_ARCHS) {
+      my $ofn = eval "\$${fn}_${opt}";
+      next if !$ofn;
+      my $flag = "0";
+      if ($opt ne "c" && $opt ne "dspr2" && $opt !~ /^mips/) {
+        $flag = $opt eq "neon_asm" ? "HAS_NEON" : "HAS_" . uc $opt;
+      }
+      print "RTCD_BENCH_IMPL($opt, $ofn, $flag)\n";
+    }
+    print "RTCD_BENCH_END($fn)\n";
+  }
+}
+
+sub generate($) {
+  my $generator = shift;
+  if ($opts{bench}) {
+    bench_table();
+    exit;
+  } else {
+    &$generator();
+  }
+}
+
 #
 # Main Driver
 #
@@ -446,12 +583,12 @@ EOF
 &require(keys %required);
 if ($opts{arch} eq 'x86') {
   @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2 avx512/);
-  x86;
+  generate \&x86;
 } elsif ($opts{arch} eq 'x86_64') {
   @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2 avx512/);
   @REQUIRES = filter(qw/mmx sse sse2/);
   &require(@REQUIRES);
-  x86;
+  generate \&x86;
 } elsif ($opts{arch} eq 'mips32' || $opts{arch} eq 'mips64') {
   my $have_dspr2 = 0;
   my $have_msa = 0;
@@ -480,24 +617,24 @@ if ($opts{arch} eq 'x86') {
   } elsif ($have_mmi == 1) {
     @ALL_ARCHS = filter("$opts{arch}", qw/mmi/);
   } else {
-    unoptimized;
+    generate \&unoptimized;
   }
-  mips;
+  generate \&mips;
 } elsif ($opts{arch} =~ /armv7\w?/) {
   @ALL_ARCHS = filter(qw/neon_asm neon/);
-  arm;
+  generate \&arm;
 } elsif ($opts{arch} eq 'armv8' || $opts{arch} eq 'arm64' ) {
   @ALL_ARCHS = filter(qw/neon/);
   &require("neon");
-  arm;
+  generate \&arm;
 } elsif ($opts{arch} =~ /^ppc/ ) {
   @ALL_ARCHS = filter(qw/vsx/);
-  ppc;
+  generate \&ppc;
 } elsif ($opts{arch} =~ /loongarch/ ) {
   @ALL_ARCHS = filter(qw/lsx lasx/);
-  loongarch;
+  generate \&loongarch;
 } else {
-  unoptimized;
+  generate \&unoptimized;
 }
 
 __END__
@@ -525,3 +662,4 @@ Options:
   --require-EXT     Require support for EXT extensions
   --sym=SYMBOL      Unique symbol to use for RTCD initialization function
   --config=FILE     File with CONFIG_FOO=yes lines to parse
+  --bench           Generate the function table used by vpx_dsp_bench
@@ -110,3 +110,29 @@ int ivf_read_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read,
 
   return 1;
 }
+
+int ivf_read_frame_mmap(struct MmapInputContext *input, const uint8_t **frame,
+                        size_t *bytes_read) {
+  const uint8_t *const raw_header = mmap_input_read(input, IVF_FRAME_HDR_SZ);
+  size_t frame_size;
+
+  if (raw_header == NULL) {
+    if (!mmap_input_eof(input)) warn("Failed to read frame size");
+    return 1;
+  }
+
+  frame_size = mem_get_le32(raw_header);
+  if (frame_size > 256 * 1024 * 1024) {
+    warn("Read invalid frame size (%u)", (unsigned int)frame_size);
+    frame_size = 0;
+  }
+
+  *frame = mmap_input_read(input, frame_size);
+  if (*frame == NULL) {
+    warn("Failed to read full frame");
+    return 1;
+  }
+
+  *bytes_read = frame_size;
+  return 0;
+}
@@ -10,6 +10,7 @@
 #ifndef VPX_IVFDEC_H_
 #define VPX_IVFDEC_H_
 
+#include "./mmapinput.h"
 #include "./tools_common.h"
 
 #ifdef __cplusplus
@@ -21,6 +22,11 @@ int file_is_ivf(struct VpxInputContext *input);
 int ivf_read_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read,
                    size_t *buffer_size);
 
+// Like ivf_read_frame(), but returns a pointer into the mapped file in
+// |frame| instead of copying the frame data.
+int ivf_read_frame_mmap(struct MmapInputContext *input, const uint8_t **frame,
+                        size_t *bytes_read);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
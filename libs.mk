@@ -29,6 +29,14 @@ $$(BUILD_PFX)$(1).h: $$(SRC_PATH_BARE)/$(2)
           $$(RTCD_OPTIONS) $$^ > $$@
 CLEAN-OBJS += $$(BUILD_PFX)$(1).h
 RTCD += $$(BUILD_PFX)$(1).h
+$$(BUILD_PFX)$(1)_bench.h: $$(SRC_PATH_BARE)/$(2)
+	@echo "    [CREATE] $$@"
+	$$(qexec)$$(SRC_PATH_BARE)/build/make/rtcd.pl --arch=$$(TGT_ISA) \
+          --sym=$(1) --bench \
+          --config=$$(CONFIG_DIR)$$(target)-$$(TOOLCHAIN).mk \
+          $$(RTCD_OPTIONS) $$^ > $$@
+CLEAN-OBJS += $$(BUILD_PFX)$(1)_bench.h
+RTCD_BENCH += $$(BUILD_PFX)$(1)_bench.h
 endef
 
 CODEC_SRCS-yes += CHANGELOG
@@ -505,6 +513,11 @@ TEST_INTRA_PRED_SPEED_SRCS=$(call addprefix_clean,test/,\
                            $(call enabled,TEST_INTRA_PRED_SPEED_SRCS))
 TEST_INTRA_PRED_SPEED_OBJS := $(sort $(call objs,$(TEST_INTRA_PRED_SPEED_SRCS)))
 
+VPX_DSP_BENCH_BIN=./vpx_dsp_bench$(EXE_SFX)
+VPX_DSP_BENCH_SRCS=$(call addprefix_clean,test/,\
+                   $(call enabled,VPX_DSP_BENCH_SRCS))
+VPX_DSP_BENCH_OBJS := $(sort $(call objs,$(VPX_DSP_BENCH_SRCS)))
+
 ifeq ($(CONFIG_ENCODERS),yes)
 RC_INTERFACE_TEST_BIN=./test_rc_interface$(EXE_SFX)
 RC_INTERFACE_TEST_SRCS=$(call addprefix_clean,test/,\
@@ -673,6 +686,21 @@ $(eval $(call linkerxx_template,$(TEST_INTRA_PRED_SPEED_BIN), \
               -L. -lvpx -lgtest $(extralibs) -lm))
 endif  # TEST_INTRA_PRED_SPEED
 
+ifneq ($(strip $(VPX_DSP_BENCH_OBJS)),)
+ifeq ($(CONFIG_DEPENDENCY_TRACKING),yes)
+$(VPX_DSP_BENCH_OBJS:.o=.d): $(RTCD_BENCH)
+else
+$(VPX_DSP_BENCH_OBJS): $(RTCD_BENCH)
+endif
+OBJS-yes += $(VPX_DSP_BENCH_OBJS)
+BINS-yes += $(VPX_DSP_BENCH_BIN)
+
+$(VPX_DSP_BENCH_BIN): lib$(CODEC_LIB)$(CODEC_LIB_SUF)
+$(eval $(call linkerxx_template,$(VPX_DSP_BENCH_BIN), \
+              $(VPX_DSP_BENCH_OBJS) \
+              -L. -lvpx $(extralibs) -lm))
+endif  # VPX_DSP_BENCH
+
 ifeq ($(CONFIG_ENCODERS),yes)
 ifneq ($(strip $(RC_INTERFACE_TEST_OBJS)),)
 $(RC_INTERFACE_TEST_OBJS) $(RC_INTERFACE_TEST_OBJS:.o=.d): \
@@ -706,6 +734,7 @@ INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(patsubst $(SRC_PATH_BARE)/%,%,\
     $(shell find $(SRC_PATH_BARE)/third_party/googletest -type f))
 INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(LIBVPX_TEST_SRCS)
 INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(TEST_INTRA_PRED_SPEED_SRCS)
+INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(VPX_DSP_BENCH_SRCS)
 INSTALL-SRCS-$(CONFIG_CODEC_SRCS) += $(RC_INTERFACE_TEST_SRCS)
 
 define test_shard_template
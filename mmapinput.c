@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./mmapinput.h"
+#include "./tools_common.h"
+
+#if CONFIG_OS_SUPPORT && HAVE_UNISTD_H && !defined(_WIN32)
+#include <sys/mman.h> /* NOLINT */
+#include <sys/stat.h> /* NOLINT */
+#define HAVE_MMAP_INPUT 1
+#else
+#define HAVE_MMAP_INPUT 0
+#endif
+
+int mmap_input_open(struct MmapInputContext *ctx, FILE *file) {
+#if HAVE_MMAP_INPUT
+  struct stat st;
+  const int fd = fileno(file);
+  const FileOffset position = ftello(file);
+  void *data;
+
+  memset(ctx, 0, sizeof(*ctx));
+  if (position < 0 || fstat(fd, &st) || !S_ISREG(st.st_mode) ||
+      st.st_size <= 0 || (uint64_t)st.st_size > (size_t)-1 ||
+      position > st.st_size)
+    return -1;
+
+  data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+              fd, 0);
+  if (data == MAP_FAILED) return -1;
+#ifdef MADV_SEQUENTIAL
+  madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+
+  ctx->data = (uint8_t *)data;
+  ctx->size = (size_t)st.st_size;
+  ctx->position = (size_t)position;
+  return 0;
+#else
+  (void)file;
+  memset(ctx, 0, sizeof(*ctx));
+  return -1;
+#endif
+}
+
+void mmap_input_close(struct MmapInputContext *ctx) {
+#if HAVE_MMAP_INPUT
+  if (ctx->data) munmap(ctx->data, ctx->size);
+#endif
+  memset(ctx, 0, sizeof(*ctx));
+}
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef VPX_MMAPINPUT_H_
+#define VPX_MMAPINPUT_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A private mapping of an input file. Readers take pointers into the mapping
+// instead of copying each frame into a heap buffer. Pages are copy-on-write,
+// so callers may modify the returned data without touching the file.
+struct MmapInputContext {
+  uint8_t *data;  // NULL when the file is not mapped.
+  size_t size;
+  size_t position;  // Offset of the next byte to be read.
+};
+
+// Maps |file| and starts reading at its current stream position. Returns 0 on
+// success. Fails for pipes, empty files and platforms without mmap, in which
+// case |ctx| is left unmapped and the caller should keep using |file|.
+int mmap_input_open(struct MmapInputContext *ctx, FILE *file);
+
+void mmap_input_close(struct MmapInputContext *ctx);
+
+// Returns a pointer to the next |size| bytes and advances past them, or NULL
+// if fewer than |size| bytes remain.
+static INLINE uint8_t *mmap_input_read(struct MmapInputContext *ctx,
+                                       size_t size) {
+  uint8_t *data;
+  if (size > ctx->size - ctx->position) return NULL;
+  data = ctx->data + ctx->position;
+  ctx->position += size;
+  return data;
+}
+
+static INLINE int mmap_input_eof(const struct MmapInputContext *ctx) {
+  return ctx->position >= ctx->size;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_MMAPINPUT_H_
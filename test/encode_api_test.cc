@@ -10,14 +10,19 @@
 
 #include <climits>
 #include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <utility>
+#include <vector>
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
+#include "test/synthetic_video_source.h"
 #include "test/video_source.h"
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
+#include "vpx_ports/vpx_timer.h"
 
 namespace {
 
@@ -360,4 +365,413 @@ TEST(EncodeAPI, ConfigChangeThreadCount) {
   }
 }
 
+#if CONFIG_VP9_ENCODER
+// Settings of EncodeSynthetic().
+struct EncodeSettings {
+  unsigned long deadline = VPX_DL_GOOD_QUALITY;
+  int cpu_used = 2;
+  int threads = 1;
+  unsigned int width = 320;
+  unsigned int height = 180;
+  unsigned int lag_in_frames = 0;
+  vpx_rc_mode end_usage = VPX_VBR;
+  int num_frames = 8;
+  // Int controls set after VP8E_SET_CPUUSED, in order.
+  std::vector<std::pair<int, int>> controls;
+};
+
+// Encodes |settings.num_frames| frames of synthetic content with VP9, then
+// flushes the encoder. Calls |frame_hook|, if set, after each source frame is
+// encoded. Returns the frame packets.
+std::vector<uint8_t> EncodeSynthetic(
+    const EncodeSettings &settings,
+    const std::function<void(vpx_codec_ctx_t *)> &frame_hook = nullptr) {
+  std::vector<uint8_t> stream;
+  vpx_codec_enc_cfg_t cfg;
+  struct Encoder {
+    ~Encoder() { EXPECT_EQ(vpx_codec_destroy(&ctx), VPX_CODEC_OK); }
+    vpx_codec_ctx_t ctx = {};
+  } enc;
+  EXPECT_EQ(vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0),
+            VPX_CODEC_OK);
+  cfg.g_w = settings.width;
+  cfg.g_h = settings.height;
+  cfg.g_threads = settings.threads;
+  cfg.g_lag_in_frames = settings.lag_in_frames;
+  cfg.rc_end_usage = settings.end_usage;
+  EXPECT_EQ(vpx_codec_enc_init(&enc.ctx, vpx_codec_vp9_cx(), &cfg, 0),
+            VPX_CODEC_OK);
+  EXPECT_EQ(vpx_codec_control(&enc.ctx, VP8E_SET_CPUUSED, settings.cpu_used),
+            VPX_CODEC_OK);
+  for (const auto &control : settings.controls) {
+    EXPECT_EQ(vpx_codec_control_(&enc.ctx, control.first, control.second),
+              VPX_CODEC_OK)
+        << "control " << control.first;
+  }
+
+  libvpx_test::SyntheticContent content = { 3, 2, 2, 0 };
+  libvpx_test::SyntheticVideoSource video(content);
+  video.SetSize(settings.width, settings.height);
+  video.Begin();
+  for (int frame = 0; frame <= settings.num_frames; ++frame) {
+    // Flush the encoder after the last frame.
+    const vpx_image_t *const img =
+        frame < settings.num_frames ? video.img() : nullptr;
+    EXPECT_EQ(vpx_codec_encode(&enc.ctx, img, video.pts(), video.duration(), 0,
+                               settings.deadline),
+              VPX_CODEC_OK);
+    if (img != nullptr && frame_hook) frame_hook(&enc.ctx);
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc.ctx, &iter)) != nullptr) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      stream.insert(stream.end(), buf, buf + pkt->data.frame.sz);
+    }
+    video.Next();
+  }
+  return stream;
+}
+
+// Encodes synthetic content with the int control |ctrl_id| set to |value|.
+std::vector<uint8_t> EncodeWithControl(int ctrl_id, int value,
+                                       unsigned long deadline, int cpu_used,
+                                       int threads,
+                                       vpx_rc_mode end_usage = VPX_VBR) {
+  EncodeSettings settings;
+  settings.deadline = deadline;
+  settings.cpu_used = cpu_used;
+  settings.threads = threads;
+  settings.lag_in_frames = deadline == VPX_DL_REALTIME ? 0 : 5;
+  settings.end_usage = end_usage;
+  settings.controls = { { VP9E_SET_ROW_MT, threads > 1 }, { ctrl_id, value } };
+  return EncodeSynthetic(settings);
+}
+
+TEST(EncodeAPI, ComponentTiming) {
+  constexpr int kWidth = 352;
+  constexpr int kHeight = 288;
+  vpx_codec_enc_cfg_t cfg;
+  struct Encoder {
+    ~Encoder() { EXPECT_EQ(vpx_codec_destroy(&ctx), VPX_CODEC_OK); }
+    vpx_codec_ctx_t ctx = {};
+  } enc;
+  ASSERT_NO_FATAL_FAILURE(
+      InitCodec(*vpx_codec_vp9_cx(), kWidth, kHeight, &enc.ctx, &cfg));
+
+  vpx_component_timing_t timing;
+  EXPECT_EQ(vpx_codec_control(&enc.ctx, VP9E_GET_COMPONENT_TIMING, nullptr),
+            VPX_CODEC_INVALID_PARAM);
+
+  libvpx_test::DummyVideoSource video;
+  video.SetSize(kWidth, kHeight);
+  video.Begin();
+  const auto encode_frame = [&]() {
+    ASSERT_EQ(vpx_codec_encode(&enc.ctx, video.img(), video.pts(),
+                               video.duration(), 0, VPX_DL_GOOD_QUALITY),
+              VPX_CODEC_OK);
+    video.Next();
+  };
+
+  // Nothing is recorded while the timing is disabled.
+  ASSERT_NO_FATAL_FAILURE(encode_frame());
+  ASSERT_EQ(vpx_codec_control(&enc.ctx, VP9E_GET_COMPONENT_TIMING, &timing),
+            VPX_CODEC_OK);
+  for (int i = 0; i < VP9E_TIMING_COMPONENTS; ++i) {
+    EXPECT_EQ(timing.total_wall_us[i], 0) << "component " << i;
+    EXPECT_EQ(timing.total_cpu_us[i], 0) << "component " << i;
+  }
+
+  ASSERT_EQ(vpx_codec_control(&enc.ctx, VP9E_SET_COMPONENT_TIMING, 1),
+            VPX_CODEC_OK);
+  int64_t mode_search_wall = 0;
+  for (int frame = 0; frame < 3; ++frame) {
+    ASSERT_NO_FATAL_FAILURE(encode_frame());
+    ASSERT_EQ(vpx_codec_control(&enc.ctx, VP9E_GET_COMPONENT_TIMING, &timing),
+              VPX_CODEC_OK);
+    for (int i = 0; i < VP9E_TIMING_COMPONENTS; ++i) {
+      EXPECT_GE(timing.frame_wall_us[i], 0) << "component " << i;
+      EXPECT_GE(timing.frame_cpu_us[i], 0) << "component " << i;
+      EXPECT_GE(timing.total_wall_us[i], timing.frame_wall_us[i]);
+      EXPECT_GE(timing.total_cpu_us[i], timing.frame_cpu_us[i]);
+    }
+    EXPECT_GE(timing.total_wall_us[VP9E_TIMING_MODE_SEARCH], mode_search_wall);
+    mode_search_wall = timing.total_wall_us[VP9E_TIMING_MODE_SEARCH];
+  }
+  EXPECT_GT(mode_search_wall, 0);
+
+  // Disabling keeps the accumulated values.
+  const vpx_component_timing_t enabled_timing = timing;
+  ASSERT_EQ(vpx_codec_control(&enc.ctx, VP9E_SET_COMPONENT_TIMING, 0),
+            VPX_CODEC_OK);
+  ASSERT_NO_FATAL_FAILURE(encode_frame());
+  ASSERT_EQ(vpx_codec_control(&enc.ctx, VP9E_GET_COMPONENT_TIMING, &timing),
+            VPX_CODEC_OK);
+  EXPECT_EQ(memcmp(&enabled_timing, &timing, sizeof(timing)), 0);
+}
+
+#if CONFIG_MULTITHREAD && VPX_HAVE_THREAD_CPU_CLOCK && !defined(_WIN32)
+// With row based multithreading most of the mode search runs on the worker
+// threads, so the CPU time of the stages must include theirs. The Windows
+// thread clocks tick too coarsely to compare the sums.
+TEST(EncodeAPI, ComponentTimingThreads) {
+  EncodeSettings settings;
+  settings.threads = 4;
+  settings.width = 640;
+  settings.height = 360;
+  settings.controls = { { VP9E_SET_ROW_MT, 1 },
+                        { VP9E_SET_COMPONENT_TIMING, 1 } };
+  vpx_component_timing_t timing = {};
+  const int64_t cpu_start = vpx_process_cpu_usec();
+  EncodeSynthetic(settings, [&](vpx_codec_ctx_t *ctx) {
+    EXPECT_EQ(vpx_codec_control(ctx, VP9E_GET_COMPONENT_TIMING, &timing),
+              VPX_CODEC_OK);
+  });
+  const int64_t process_cpu = vpx_process_cpu_usec() - cpu_start;
+
+  int64_t component_cpu = 0;
+  for (int i = 0; i < VP9E_TIMING_COMPONENTS; ++i) {
+    component_cpu += timing.total_cpu_us[i];
+  }
+  EXPECT_GT(component_cpu, process_cpu / 2);
+  EXPECT_LE(component_cpu, process_cpu + 1000);
+}
+#endif  // CONFIG_MULTITHREAD && VPX_HAVE_THREAD_CPU_CLOCK && !defined(_WIN32)
+
+// Encodes |num_frames| frames of synthetic content and returns the search
+// statistics of each frame.
+std::vector<vpx_search_stats_t> EncodeForSearchStats(int threads,
+                                                     unsigned long deadline,
+                                                     int num_frames) {
+  std::vector<vpx_search_stats_t> stats;
+  EncodeSettings settings;
+  settings.deadline = deadline;
+  settings.cpu_used = deadline == VPX_DL_REALTIME ? 8 : 2;
+  settings.threads = threads;
+  settings.width = 640;
+  settings.height = 360;
+  settings.num_frames = num_frames;
+  settings.controls = { { VP9E_SET_TILE_COLUMNS, 1 },
+                        { VP9E_SET_SEARCH_STATS, 1 } };
+  EncodeSynthetic(settings, [&](vpx_codec_ctx_t *enc) {
+    vpx_search_stats_t frame_stats;
+    EXPECT_EQ(vpx_codec_control(enc, VP9E_GET_SEARCH_STATS, &frame_stats),
+              VPX_CODEC_OK);
+    stats.push_back(frame_stats);
+  });
+  return stats;
+}
+
+int64_t BlocksSearched(const vpx_search_stats_t &stats) {
+  int64_t blocks = 0;
+  for (int i = 0; i < VPX_SEARCH_STATS_BLOCK_SIZES; ++i) {
+    blocks += stats.blocks_searched[i];
+  }
+  return blocks;
+}
+
+TEST(EncodeAPI, SearchStats) {
+  for (const unsigned long deadline :
+       { VPX_DL_GOOD_QUALITY, VPX_DL_REALTIME }) {
+    SCOPED_TRACE(deadline);
+    const std::vector<vpx_search_stats_t> stats =
+        EncodeForSearchStats(1, deadline, 3);
+    ASSERT_EQ(stats.size(), 3u);
+
+    // The key frame only searches intra modes.
+    EXPECT_GT(BlocksSearched(stats[0]), 0);
+    EXPECT_GT(stats[0].intra_modes_tested, 0);
+    EXPECT_EQ(stats[0].inter_modes_tested, 0);
+    EXPECT_EQ(stats[0].full_pel_searches, 0);
+    EXPECT_EQ(stats[0].sub_pel_searches, 0);
+
+    for (size_t i = 1; i < stats.size(); ++i) {
+      EXPECT_GT(BlocksSearched(stats[i]), 0) << "frame " << i;
+      EXPECT_GT(stats[i].inter_modes_tested, 0) << "frame " << i;
+      EXPECT_GT(stats[i].full_pel_searches, 0) << "frame " << i;
+      EXPECT_GE(stats[i].full_pel_sads, stats[i].full_pel_searches);
+      EXPECT_GE(stats[i].sub_pel_evals, stats[i].sub_pel_searches);
+      EXPECT_GE(stats[i].ml_prune_checks, stats[i].ml_prunes);
+      EXPECT_GE(stats[i].ml_breakout_checks, stats[i].ml_breakouts);
+    }
+  }
+
+  // Nothing is counted while the statistics are disabled, nor by an encode
+  // call that codes no frame.
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  vpx_search_stats_t stats;
+  ASSERT_NO_FATAL_FAILURE(
+      InitCodec(*vpx_codec_vp9_cx(), 352, 288, &enc, &cfg));
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_GET_SEARCH_STATS, nullptr),
+            VPX_CODEC_INVALID_PARAM);
+  libvpx_test::DummyVideoSource video;
+  video.SetSize(352, 288);
+  video.Begin();
+  ASSERT_EQ(vpx_codec_encode(&enc, video.img(), video.pts(), video.duration(),
+                             0, VPX_DL_GOOD_QUALITY),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_GET_SEARCH_STATS, &stats),
+            VPX_CODEC_OK);
+  EXPECT_EQ(BlocksSearched(stats), 0);
+  EXPECT_EQ(stats.intra_modes_tested, 0);
+
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_SET_SEARCH_STATS, 1), VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_encode(&enc, nullptr, 0, 0, 0, VPX_DL_GOOD_QUALITY),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_control(&enc, VP9E_GET_SEARCH_STATS, &stats),
+            VPX_CODEC_OK);
+  EXPECT_EQ(BlocksSearched(stats), 0);
+  EXPECT_EQ(stats.full_pel_sads, 0);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+// Tile based multi-threading codes the same blocks as a single thread, so the
+// counters summed over the workers must match.
+TEST(EncodeAPI, SearchStatsMultiThreaded) {
+  const std::vector<vpx_search_stats_t> single =
+      EncodeForSearchStats(1, VPX_DL_GOOD_QUALITY, 3);
+  const std::vector<vpx_search_stats_t> multi =
+      EncodeForSearchStats(2, VPX_DL_GOOD_QUALITY, 3);
+  ASSERT_EQ(single.size(), multi.size());
+  for (size_t i = 0; i < single.size(); ++i) {
+    EXPECT_EQ(memcmp(&single[i], &multi[i], sizeof(single[i])), 0)
+        << "frame " << i;
+  }
+}
+
+// Returns the speed level of each frame of a cpu-used 5 encode.
+std::vector<int> EncodeForAutoSpeed(unsigned int target_frame_time,
+                                    unsigned long deadline, int num_frames) {
+  std::vector<int> speeds;
+  EncodeSettings settings;
+  settings.deadline = deadline;
+  settings.cpu_used = 5;
+  settings.end_usage = VPX_CBR;
+  settings.num_frames = num_frames;
+  settings.controls = { { VP9E_SET_RTC_TARGET_FRAME_TIME,
+                          static_cast<int>(target_frame_time) } };
+  EncodeSynthetic(settings, [&](vpx_codec_ctx_t *enc) {
+    int speed = -1;
+    EXPECT_EQ(vpx_codec_control(enc, VP9E_GET_LAST_SPEED, &speed),
+              VPX_CODEC_OK);
+    speeds.push_back(speed);
+  });
+  return speeds;
+}
+
+TEST(EncodeAPI, RtcAutoSpeed) {
+  constexpr int kNumFrames = 6;
+
+  // A target no frame can meet drives the speed up to the fastest level. The
+  // key frame is always encoded at cpu-used.
+  std::vector<int> speeds = EncodeForAutoSpeed(1, VPX_DL_REALTIME, kNumFrames);
+  ASSERT_EQ(speeds.size(), static_cast<size_t>(kNumFrames));
+  EXPECT_EQ(speeds[0], 5);
+  for (int i = 1; i < kNumFrames; ++i) {
+    EXPECT_GE(speeds[i], speeds[i - 1]) << "frame " << i;
+  }
+  EXPECT_EQ(speeds.back(), 9);
+
+  // A target every frame meets never goes below cpu-used, and disabling the
+  // control or encoding in good quality mode always uses cpu-used.
+  const struct {
+    unsigned int target_frame_time;
+    unsigned long deadline;
+  } kFixedSpeed[] = { { 100000000, VPX_DL_REALTIME },
+                      { 0, VPX_DL_REALTIME },
+                      { 1, VPX_DL_GOOD_QUALITY } };
+  for (const auto &params : kFixedSpeed) {
+    SCOPED_TRACE(params.target_frame_time);
+    speeds = EncodeForAutoSpeed(params.target_frame_time, params.deadline,
+                                kNumFrames);
+    for (int i = 0; i < kNumFrames; ++i) {
+      EXPECT_EQ(speeds[i], 5) << "frame " << i;
+    }
+  }
+}
+
+// The interpolated planes are bit-exact with the sub-pixel variance
+// functions, so the cache must not change the encoding.
+TEST(EncodeAPI, SubpelCacheBitExact) {
+  const struct {
+    unsigned long deadline;
+    int cpu_used;
+  } kModes[] = { { VPX_DL_GOOD_QUALITY, 2 },
+                 { VPX_DL_GOOD_QUALITY, 4 },
+                 { VPX_DL_REALTIME, 7 } };
+  for (const auto &mode : kModes) {
+    for (int threads : { 1, 2 }) {
+      SCOPED_TRACE(testing::Message() << "cpu-used " << mode.cpu_used
+                                      << " threads " << threads);
+      const std::vector<uint8_t> reference =
+          EncodeWithControl(VP9E_SET_SUBPEL_CACHE, 0, mode.deadline,
+                            mode.cpu_used, threads);
+      ASSERT_FALSE(reference.empty());
+      for (int level = 1; level <= 2; ++level) {
+        EXPECT_EQ(EncodeWithControl(VP9E_SET_SUBPEL_CACHE, level,
+                                    mode.deadline, mode.cpu_used, threads),
+                  reference)
+            << "level " << level;
+      }
+    }
+  }
+}
+
+// The source statistics and skin map of the real-time superblock walk are
+// computed on the encoder threads before the walk, so the encoding must not
+// depend on how the rows are split between the threads. Row based
+// multi-threading is only enabled with several threads.
+TEST(EncodeAPI, RealtimeContentAnalysisThreads) {
+  for (vpx_rc_mode end_usage : { VPX_VBR, VPX_CBR }) {
+    const std::vector<uint8_t> reference = EncodeWithControl(
+        VP9E_SET_AQ_MODE, 3, VPX_DL_REALTIME, 7, 2, end_usage);
+    ASSERT_FALSE(reference.empty());
+    for (int threads : { 3, 4 }) {
+      SCOPED_TRACE(testing::Message() << "end usage " << end_usage
+                                      << " threads " << threads);
+      EXPECT_EQ(EncodeWithControl(VP9E_SET_AQ_MODE, 3, VPX_DL_REALTIME, 7,
+                                  threads, end_usage),
+                reference);
+    }
+  }
+}
+
+TEST(EncodeAPI, TrellisOptRange) {
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  ASSERT_EQ(vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0),
+            VPX_CODEC_OK);
+  ASSERT_EQ(vpx_codec_enc_init(&enc, vpx_codec_vp9_cx(), &cfg, 0),
+            VPX_CODEC_OK);
+  for (int level = -1; level <= 2; ++level) {
+    EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_TRELLIS_OPT, level),
+              VPX_CODEC_OK);
+  }
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_TRELLIS_OPT, -2),
+            VPX_CODEC_INVALID_PARAM);
+  EXPECT_EQ(vpx_codec_control(&enc, VP9E_SET_TRELLIS_OPT, 3),
+            VPX_CODEC_INVALID_PARAM);
+  EXPECT_EQ(vpx_codec_destroy(&enc), VPX_CODEC_OK);
+}
+
+// The good quality speeds that optimize the coefficients default to the full
+// trellis, which the fast approximation does not reproduce.
+TEST(EncodeAPI, TrellisOptLevels) {
+  for (int threads : { 1, 2 }) {
+    SCOPED_TRACE(testing::Message() << "threads " << threads);
+    const std::vector<uint8_t> reference = EncodeWithControl(
+        VP9E_SET_TRELLIS_OPT, -1, VPX_DL_GOOD_QUALITY, 2, threads);
+    ASSERT_FALSE(reference.empty());
+    EXPECT_EQ(EncodeWithControl(VP9E_SET_TRELLIS_OPT, 1, VPX_DL_GOOD_QUALITY,
+                                2, threads),
+              reference);
+    const std::vector<uint8_t> fast = EncodeWithControl(
+        VP9E_SET_TRELLIS_OPT, 2, VPX_DL_GOOD_QUALITY, 2, threads);
+    EXPECT_FALSE(fast.empty());
+    EXPECT_NE(fast, reference);
+  }
+}
+#endif  // CONFIG_VP9_ENCODER
+
 }  // namespace
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Time spent packing the bitstream, which includes the search for the
+// coefficient probability updates, against the whole encode time, at low
+// resolutions and a high frame rate where this per-frame cost is the most
+// visible. The packing time is the encoder's own VP9E_TIMING_PACK_BITSTREAM
+// measurement, so it excludes the rest of the encode. Both times are CPU
+// time of the test thread, which runs the encoder on its own.
+
+#include <algorithm>
+#include <cstdio>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/synthetic_video_source.h"
+#include "test/util.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+const int kFrames = 60;
+const int kFrameRate = 60;
+const libvpx_test::SyntheticContent kContent = { 2, 3, 2, 30 };
+
+struct ResolutionParam {
+  const char *name;
+  unsigned int width;
+  unsigned int height;
+  unsigned int kbps;
+};
+
+const ResolutionParam kResolutions[] = {
+  { "180p", 320, 180, 400 },
+  { "360p", 640, 360, 1000 },
+};
+
+struct CodingParam {
+  const char *name;
+  libvpx_test::TestMode mode;
+  int speed;
+};
+
+const CodingParam kCodings[] = {
+  { "good2", ::libvpx_test::kOnePassGood, 2 },
+  { "rt7", ::libvpx_test::kRealTime, 7 },
+  { "rt9", ::libvpx_test::kRealTime, 9 },
+};
+
+class PackBitstreamPerfTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<int, int> {
+ protected:
+  PackBitstreamPerfTest()
+      : EncoderTest(GET_PARAM(0)), resolution_(kResolutions[GET_PARAM(1)]),
+        coding_(kCodings[GET_PARAM(2)]), encode_usecs_(0), start_usecs_(0),
+        pack_usecs_(0), frames_(0) {}
+  virtual ~PackBitstreamPerfTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(coding_.mode);
+    cfg_.g_timebase.num = 1;
+    cfg_.g_timebase.den = kFrameRate;
+    cfg_.g_threads = 1;
+    cfg_.g_lag_in_frames = coding_.mode == ::libvpx_test::kRealTime ? 0 : 25;
+    cfg_.rc_end_usage =
+        coding_.mode == ::libvpx_test::kRealTime ? VPX_CBR : VPX_VBR;
+    cfg_.rc_target_bitrate = resolution_.kbps;
+  }
+
+  virtual bool DoDecode() const { return false; }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, coding_.speed);
+      encoder->Control(VP9E_SET_COMPONENT_TIMING, 1);
+    }
+    start_usecs_ = vpx_thread_cpu_usec();
+  }
+
+  virtual void PostEncodeFrameHook(::libvpx_test::Encoder *encoder) {
+    vpx_component_timing_t timing;
+    encode_usecs_ += vpx_thread_cpu_usec() - start_usecs_;
+    encoder->Control(VP9E_GET_COMPONENT_TIMING, &timing);
+    pack_usecs_ = timing.total_cpu_us[VP9E_TIMING_PACK_BITSTREAM];
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t * /*pkt*/) { ++frames_; }
+
+  const ResolutionParam &resolution_;
+  const CodingParam &coding_;
+  int64_t encode_usecs_;
+  int64_t start_usecs_;
+  int64_t pack_usecs_;
+  int frames_;
+};
+
+TEST_P(PackBitstreamPerfTest, PackTime) {
+  libvpx_test::SyntheticVideoSource video(kContent);
+  video.SetSize(resolution_.width, resolution_.height);
+  video.set_limit(kFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_GT(frames_, 0);
+  printf("%s %s: pack %.3f ms/frame, encode %.3f ms/frame, pack share "
+         "%.1f%%\n",
+         resolution_.name, coding_.name, pack_usecs_ / 1000.0 / frames_,
+         encode_usecs_ / 1000.0 / frames_,
+         pack_usecs_ * 100.0 / std::max<int64_t>(encode_usecs_, 1));
+}
+
+VP9_INSTANTIATE_TEST_SUITE(
+    PackBitstreamPerfTest,
+    ::testing::Range(0, static_cast<int>(sizeof(kResolutions) /
+                                         sizeof(kResolutions[0]))),
+    ::testing::Range(0, static_cast<int>(sizeof(kCodings) /
+                                         sizeof(kCodings[0]))));
+}  // namespace
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Encode and decode throughput on procedurally generated content, so that it
+// can run without LIBVPX_TEST_DATA_PATH. The following environment variables
+// control the run:
+//   LIBVPX_PERF_FRAMES     number of frames to encode, overriding the default
+//                          that scales with the resolution.
+//   LIBVPX_PERF_RESULTS    file that "<name> <encode fps> <decode fps>" lines
+//                          are appended to.
+//   LIBVPX_PERF_BASELINE   file of lines in the same format. A configuration
+//                          fails if its throughput falls more than
+//                          LIBVPX_PERF_TOLERANCE percent (default 10) below
+//                          the baseline.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./vpx_config.h"
+#include "./vpx_version.h"
+#include "test/synthetic_video_source.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+const double kUsecsInSec = 1000000.0;
+const int kFrameRate = 30;
+
+struct ContentParam {
+  const char *name;
+  libvpx_test::SyntheticContent content;
+};
+
+const ContentParam kContents[] = {
+  { "mixed", { 2, 3, 2, 30 } },   { "static", { 0, 1, 1, 0 } },
+  { "pan", { 8, 2, 2, 0 } },      { "noisy", { 1, 12, 1, 0 } },
+  { "texture", { 2, 2, 4, 0 } },  { "scenecut", { 2, 3, 2, 8 } },
+};
+
+struct ResolutionParam {
+  const char *name;
+  unsigned int width;
+  unsigned int height;
+};
+
+const ResolutionParam kResolutions[] = {
+  { "360p", 640, 360 },
+  { "720p", 1280, 720 },
+  { "1080p", 1920, 1080 },
+  { "2160p", 3840, 2160 },
+};
+
+struct CodingParam {
+  const char *name;
+  unsigned long deadline;
+  int speed;
+  int threads;
+  int log2_tile_cols;
+  int row_mt;
+};
+
+const CodingParam kCodings[] = {
+  { "rt_s8_t1", VPX_DL_REALTIME, 8, 1, 0, 0 },
+  { "rt_s7_t2", VPX_DL_REALTIME, 7, 2, 1, 1 },
+  { "rt_s6_t4", VPX_DL_REALTIME, 6, 4, 2, 1 },
+  { "rt_s5_t8", VPX_DL_REALTIME, 5, 8, 3, 1 },
+  { "good_s2_t4", VPX_DL_GOOD_QUALITY, 2, 4, 2, 1 },
+};
+
+#define NELEMENTS(x) static_cast<int>(sizeof(x) / sizeof((x)[0]))
+
+// Indices into kContents, kResolutions and kCodings, and the bit depth.
+typedef std::tuple<int, int, int, int> SyntheticPerfParam;
+
+struct PerfResult {
+  double encode_fps;
+  double decode_fps;
+};
+
+// Reads "<name> <encode fps> <decode fps>" lines.
+std::map<std::string, PerfResult> ReadBaseline(const char *path) {
+  std::map<std::string, PerfResult> baseline;
+  FILE *const f = fopen(path, "r");
+  char name[256];
+  PerfResult result;
+  if (f == nullptr) return baseline;
+  while (fscanf(f, "%255s %lf %lf", name, &result.encode_fps,
+                &result.decode_fps) == 3) {
+    baseline[name] = result;
+  }
+  fclose(f);
+  return baseline;
+}
+
+// Sum of squared differences over all planes of two images of the same size
+// and format.
+uint64_t ImageSse(const vpx_image_t *a, const vpx_image_t *b) {
+  const bool highbd = (a->fmt & VPX_IMG_FMT_HIGHBITDEPTH) != 0;
+  uint64_t sse = 0;
+  for (int plane = 0; plane < 3; ++plane) {
+    const int ss_x = plane ? a->x_chroma_shift : 0;
+    const int ss_y = plane ? a->y_chroma_shift : 0;
+    const int w = (a->d_w + ss_x) >> ss_x;
+    const int h = (a->d_h + ss_y) >> ss_y;
+    for (int y = 0; y < h; ++y) {
+      const uint8_t *const row_a = a->planes[plane] + y * a->stride[plane];
+      const uint8_t *const row_b = b->planes[plane] + y * b->stride[plane];
+      for (int x = 0; x < w; ++x) {
+        const int diff =
+            highbd ? reinterpret_cast<const uint16_t *>(row_a)[x] -
+                         reinterpret_cast<const uint16_t *>(row_b)[x]
+                   : row_a[x] - row_b[x];
+        sse += diff * diff;
+      }
+    }
+  }
+  return sse;
+}
+
+class SyntheticPerfTest : public ::testing::TestWithParam<SyntheticPerfParam> {
+ protected:
+  SyntheticPerfTest()
+      : content_(kContents[std::get<0>(GetParam())]),
+        resolution_(kResolutions[std::get<1>(GetParam())]),
+        coding_(kCodings[std::get<2>(GetParam())]),
+        bit_depth_(std::get<3>(GetParam())) {}
+
+  std::string Name() const {
+    char name[256];
+    snprintf(name, sizeof(name), "%s_%s_%s_%dbit", content_.name,
+             resolution_.name, coding_.name, bit_depth_);
+    return name;
+  }
+
+  // About 60 frames at 360p and no fewer than 10 at the larger sizes.
+  int NumFrames() const {
+    const char *const frames = getenv("LIBVPX_PERF_FRAMES");
+    if (frames != nullptr && atoi(frames) > 0) return atoi(frames);
+    const unsigned int area = resolution_.width * resolution_.height;
+    return std::max(10, static_cast<int>(60 * 640 * 360 / area));
+  }
+
+  const ContentParam &content_;
+  const ResolutionParam &resolution_;
+  const CodingParam &coding_;
+  const int bit_depth_;
+};
+
+TEST_P(SyntheticPerfTest, EncodeDecode) {
+  const int frames = NumFrames();
+  const bool highbd = bit_depth_ > 8;
+  libvpx_test::SyntheticVideoSource video(content_.content, bit_depth_);
+  video.SetSize(resolution_.width, resolution_.height);
+  video.set_limit(frames);
+
+  vpx_codec_enc_cfg_t cfg;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+  cfg.g_w = resolution_.width;
+  cfg.g_h = resolution_.height;
+  cfg.g_timebase.num = 1;
+  cfg.g_timebase.den = kFrameRate;
+  cfg.g_threads = coding_.threads;
+  // About 0.05 bits per pixel.
+  cfg.rc_target_bitrate =
+      resolution_.width * resolution_.height * kFrameRate / 20000;
+  if (coding_.deadline == VPX_DL_REALTIME) {
+    cfg.g_lag_in_frames = 0;
+    cfg.rc_end_usage = VPX_CBR;
+  }
+  if (highbd) {
+    cfg.g_profile = 2;
+    cfg.g_bit_depth = static_cast<vpx_bit_depth_t>(bit_depth_);
+    cfg.g_input_bit_depth = bit_depth_;
+  }
+
+  vpx_codec_ctx_t encoder;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&encoder, vpx_codec_vp9_cx(), &cfg,
+                               highbd ? VPX_CODEC_USE_HIGHBITDEPTH : 0));
+  vpx_codec_control(&encoder, VP8E_SET_CPUUSED, coding_.speed);
+  vpx_codec_control(&encoder, VP9E_SET_TILE_COLUMNS, coding_.log2_tile_cols);
+  vpx_codec_control(&encoder, VP9E_SET_ROW_MT, coding_.row_mt);
+
+  // Encode, keeping the compressed frames for the decoder.
+  std::vector<std::vector<uint8_t> > packets;
+  size_t total_bytes = 0;
+  int64_t encode_usecs = 0;
+  int64_t encode_cpu_usecs = 0;
+  bool flushing = false;
+  video.Begin();
+  for (;;) {
+    vpx_image_t *const img = flushing ? nullptr : video.img();
+    const int64_t cpu_start = vpx_process_cpu_usec();
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    ASSERT_EQ(VPX_CODEC_OK, vpx_codec_encode(&encoder, img, video.pts(), 1, 0,
+                                             coding_.deadline))
+        << vpx_codec_error_detail(&encoder);
+    vpx_usec_timer_mark(&timer);
+    encode_usecs += vpx_usec_timer_elapsed(&timer);
+    encode_cpu_usecs += vpx_process_cpu_usec() - cpu_start;
+
+    bool got_data = false;
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&encoder, &iter)) != nullptr) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      const uint8_t *const buf = static_cast<uint8_t *>(pkt->data.frame.buf);
+      packets.push_back(std::vector<uint8_t>(buf, buf + pkt->data.frame.sz));
+      total_bytes += pkt->data.frame.sz;
+      got_data = true;
+    }
+    if (flushing && !got_data) break;
+    if (!flushing) {
+      video.Next();
+      flushing = video.img() == nullptr;
+    }
+  }
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&encoder));
+
+  // Decode, comparing each output frame against the source outside of the
+  // timed region.
+  vpx_codec_dec_cfg_t dec_cfg = vpx_codec_dec_cfg_t();
+  dec_cfg.threads = coding_.threads;
+  vpx_codec_ctx_t decoder;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&decoder, vpx_codec_vp9_dx(), &dec_cfg, 0));
+  vpx_codec_control(&decoder, VP9D_SET_ROW_MT, coding_.row_mt);
+
+  vpx_image_t *const source =
+      vpx_img_alloc(nullptr, highbd ? VPX_IMG_FMT_I42016 : VPX_IMG_FMT_I420,
+                    resolution_.width, resolution_.height, 32);
+  ASSERT_NE(source, nullptr);
+  int64_t decode_usecs = 0;
+  int64_t decode_cpu_usecs = 0;
+  uint64_t sse = 0;
+  int decoded_frames = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    int64_t cpu_start = vpx_process_cpu_usec();
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(&decoder, &packets[i][0],
+                               static_cast<unsigned int>(packets[i].size()),
+                               nullptr, 0))
+        << vpx_codec_error_detail(&decoder);
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *img;
+    while ((img = vpx_codec_get_frame(&decoder, &iter)) != nullptr) {
+      vpx_usec_timer_mark(&timer);
+      decode_usecs += vpx_usec_timer_elapsed(&timer);
+      decode_cpu_usecs += vpx_process_cpu_usec() - cpu_start;
+
+      video.Render(decoded_frames++, source);
+      sse += ImageSse(source, img);
+
+      cpu_start = vpx_process_cpu_usec();
+      vpx_usec_timer_start(&timer);
+    }
+    vpx_usec_timer_mark(&timer);
+    decode_usecs += vpx_usec_timer_elapsed(&timer);
+    decode_cpu_usecs += vpx_process_cpu_usec() - cpu_start;
+  }
+  vpx_img_free(source);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&decoder));
+  ASSERT_EQ(frames, decoded_frames);
+
+  const double samples =
+      1.5 * resolution_.width * resolution_.height * decoded_frames;
+  const double peak = (1 << bit_depth_) - 1;
+  const double psnr =
+      sse == 0 ? 100.0 : 10.0 * log10(peak * peak * samples / sse);
+  PerfResult result;
+  result.encode_fps = frames * kUsecsInSec / std::max<int64_t>(encode_usecs, 1);
+  result.decode_fps = frames * kUsecsInSec / std::max<int64_t>(decode_usecs, 1);
+  const double kbps = total_bytes * 8.0 * kFrameRate / frames / 1000;
+  const std::string name = Name();
+
+  printf("{\n");
+  printf("\t\"type\" : \"synthetic_perf_test\",\n");
+  printf("\t\"version\" : \"%s\",\n", VERSION_STRING_NOSP);
+  printf("\t\"name\" : \"%s\",\n", name.c_str());
+  printf("\t\"content\" : \"%s\",\n", content_.name);
+  printf("\t\"width\" : %u,\n", resolution_.width);
+  printf("\t\"height\" : %u,\n", resolution_.height);
+  printf("\t\"bitDepth\" : %d,\n", bit_depth_);
+  printf("\t\"speed\" : %d,\n", coding_.speed);
+  printf("\t\"threads\" : %d,\n", coding_.threads);
+  printf("\t\"tileColumns\" : %d,\n", 1 << coding_.log2_tile_cols);
+  printf("\t\"rowMt\" : %d,\n", coding_.row_mt);
+  printf("\t\"totalFrames\" : %d,\n", frames);
+  printf("\t\"encodeFramesPerSecond\" : %f,\n", result.encode_fps);
+  printf("\t\"encodeCpuMsPerFrame\" : %f,\n",
+         encode_cpu_usecs / 1000.0 / frames);
+  printf("\t\"decodeFramesPerSecond\" : %f,\n", result.decode_fps);
+  printf("\t\"decodeCpuMsPerFrame\" : %f,\n",
+         decode_cpu_usecs / 1000.0 / frames);
+  printf("\t\"bitrateKbps\" : %f,\n", kbps);
+  printf("\t\"psnr\" : %f\n", psnr);
+  printf("}\n");
+
+  const char *const results_path = getenv("LIBVPX_PERF_RESULTS");
+  if (results_path != nullptr) {
+    FILE *const f = fopen(results_path, "a");
+    ASSERT_NE(f, nullptr) << results_path;
+    fprintf(f, "%s %f %f\n", name.c_str(), result.encode_fps,
+            result.decode_fps);
+    fclose(f);
+  }
+
+  const char *const baseline_path = getenv("LIBVPX_PERF_BASELINE");
+  if (baseline_path != nullptr) {
+    const std::map<std::string, PerfResult> baseline =
+        ReadBaseline(baseline_path);
+    const std::map<std::string, PerfResult>::const_iterator it =
+        baseline.find(name);
+    if (it != baseline.end()) {
+      const char *const tolerance_env = getenv("LIBVPX_PERF_TOLERANCE");
+      const double tolerance =
+          tolerance_env != nullptr ? atof(tolerance_env) : 10.0;
+      const double scale = 1.0 - tolerance / 100.0;
+      EXPECT_GE(result.encode_fps, it->second.encode_fps * scale)
+          << name << ": encoder throughput regressed";
+      EXPECT_GE(result.decode_fps, it->second.decode_fps * scale)
+          << name << ": decoder throughput regressed";
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    VP9, SyntheticPerfTest,
+    ::testing::Combine(::testing::Range(0, NELEMENTS(kContents)),
+                       ::testing::Range(0, NELEMENTS(kResolutions)),
+                       ::testing::Range(0, NELEMENTS(kCodings)),
+#if CONFIG_VP9_HIGHBITDEPTH
+                       ::testing::Values(8, 10)));
+#else
+                       ::testing::Values(8)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+}  // namespace
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef VPX_TEST_SYNTHETIC_VIDEO_SOURCE_H_
+#define VPX_TEST_SYNTHETIC_VIDEO_SOURCE_H_
+
+#include "test/acm_random.h"
+#include "test/video_source.h"
+#include "vpx/vpx_image.h"
+
+namespace libvpx_test {
+
+// Parameters of the content produced by SyntheticVideoSource.
+struct SyntheticContent {
+  // Number of pixels the background pans per frame. A foreground block moves
+  // against it at twice the speed.
+  int motion;
+  // Peak amplitude of the noise added to every sample, in 8-bit units.
+  int noise;
+  // Texture detail, from 0 (large flat objects) to 4 (fine texture).
+  int detail;
+  // Number of frames between scene cuts, 0 for a single scene.
+  int scene_length;
+};
+
+// Procedurally generated video, for tests that must not depend on
+// LIBVPX_TEST_DATA_PATH. A frame only depends on its index, so any frame can
+// be rendered again with Render() to compare against the decoder output.
+class SyntheticVideoSource : public DummyVideoSource {
+ public:
+  explicit SyntheticVideoSource(const SyntheticContent &content,
+                                int bit_depth = 8,
+                                int seed = ACMRandom::DeterministicSeed())
+      : content_(content), bit_depth_(bit_depth), seed_(seed) {
+    if (bit_depth_ > 8) SetImageFormat(VPX_IMG_FMT_I42016);
+  }
+
+  void Render(unsigned int frame, vpx_image_t *img) const {
+    const unsigned int scene =
+        content_.scene_length > 0 ? frame / content_.scene_length : 0;
+    const unsigned int pan_x = content_.motion * frame;
+    const unsigned int pan_y = content_.motion * frame / 2;
+    const unsigned int cell = 128 >> content_.detail;
+    const int block_size = img->d_h / 4;
+    const int block_x =
+        static_cast<int>((img->d_w - block_size) -
+                         (2 * content_.motion * frame) %
+                             (img->d_w - block_size));
+    const int block_y = static_cast<int>(img->d_h - block_size) / 2;
+    ACMRandom rnd(seed_ + frame);
+
+    for (int plane = 0; plane < 3; ++plane) {
+      const int ss_x = plane ? img->x_chroma_shift : 0;
+      const int ss_y = plane ? img->y_chroma_shift : 0;
+      const int w = (img->d_w + ss_x) >> ss_x;
+      const int h = (img->d_h + ss_y) >> ss_y;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          const unsigned int sx = (x << ss_x) + pan_x;
+          const unsigned int sy = (y << ss_y) + pan_y;
+          const bool in_block = (x << ss_x) >= block_x &&
+                                (x << ss_x) < block_x + block_size &&
+                                (y << ss_y) >= block_y &&
+                                (y << ss_y) < block_y + block_size;
+          int value;
+          if (plane == 0) {
+            if (in_block) {
+              value = 200 - static_cast<int>(((x << ss_x) + (y << ss_y)) & 31);
+            } else {
+              value = 48 + (Hash(sx / cell, sy / cell, scene) & 127) +
+                      (sx % cell) * 32 / cell +
+                      static_cast<int>((sx * 3 + sy * 5) & 15) *
+                          content_.detail / 4;
+            }
+          } else {
+            value = in_block ? 128 + 40 * (plane == 1 ? 1 : -1)
+                             : 96 + (Hash(sx / (cell * 4), sy / (cell * 4),
+                                          scene * 2 + plane) &
+                                     63);
+          }
+          if (content_.noise > 0) {
+            value += rnd(2 * content_.noise + 1) - content_.noise;
+          }
+          value = value < 0 ? 0 : value > 255 ? 255 : value;
+          if (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) {
+            uint16_t *const row = reinterpret_cast<uint16_t *>(
+                img->planes[plane] + y * img->stride[plane]);
+            row[x] = static_cast<uint16_t>(value << (bit_depth_ - 8));
+          } else {
+            img->planes[plane][y * img->stride[plane] + x] =
+                static_cast<uint8_t>(value);
+          }
+        }
+      }
+    }
+  }
+
+  int bit_depth() const { return bit_depth_; }
+
+ protected:
+  virtual void FillFrame() {
+    if (img_) {
+      img_->bit_depth = bit_depth_;
+      Render(frame_, img_);
+    }
+  }
+
+ private:
+  static unsigned int Hash(unsigned int x, unsigned int y, unsigned int z) {
+    unsigned int h = x * 73856093u ^ y * 19349663u ^ z * 83492791u;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h;
+  }
+
+  const SyntheticContent content_;
+  const int bit_depth_;
+  const int seed_;
+};
+
+}  // namespace libvpx_test
+
+#endif  // VPX_TEST_SYNTHETIC_VIDEO_SOURCE_H_
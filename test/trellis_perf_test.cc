@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Encode time and BD-rate of the fast approximate trellis optimization
+// against the full one, on two pass encodes of procedurally generated
+// content. The BD-rate is the average bitrate difference at equal PSNR over
+// kNumRates target bitrates, positive when the fast mode spends more bits.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/synthetic_video_source.h"
+#include "test/util.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+const int kWidth = 640;
+const int kHeight = 360;
+const int kFrames = 20;
+const int kNumRates = 4;
+const unsigned int kRates[kNumRates] = { 250, 500, 1000, 2000 };
+
+struct ContentParam {
+  const char *name;
+  libvpx_test::SyntheticContent content;
+};
+
+const ContentParam kContents[] = {
+  { "mixed", { 2, 3, 2, 30 } },
+  { "texture", { 2, 2, 4, 0 } },
+  { "noisy", { 1, 12, 1, 0 } },
+};
+
+struct RatePoint {
+  double kbps;
+  double psnr;
+};
+
+// Solves the 4x4 system |a| x = |b| in place, leaving x in |b|.
+void Solve4(double a[4][4], double b[4]) {
+  for (int col = 0; col < 4; ++col) {
+    int pivot = col;
+    for (int row = col + 1; row < 4; ++row) {
+      if (fabs(a[row][col]) > fabs(a[pivot][col])) pivot = row;
+    }
+    for (int k = 0; k < 4; ++k) std::swap(a[col][k], a[pivot][k]);
+    std::swap(b[col], b[pivot]);
+    for (int row = 0; row < 4; ++row) {
+      if (row == col) continue;
+      const double f = a[row][col] / a[col][col];
+      for (int k = col; k < 4; ++k) a[row][k] -= f * a[col][k];
+      b[row] -= f * b[col];
+    }
+  }
+  for (int row = 0; row < 4; ++row) b[row] /= a[row][row];
+}
+
+// Integral over [lo, hi] of the cubic through the (psnr, log(kbps)) points.
+double IntegrateLogRate(const RatePoint *points, double lo, double hi) {
+  double a[4][4];
+  double c[4];
+  for (int i = 0; i < kNumRates; ++i) {
+    for (int k = 0; k < 4; ++k) a[i][k] = pow(points[i].psnr, k);
+    c[i] = log(points[i].kbps);
+  }
+  Solve4(a, c);
+  double integral = 0;
+  for (int k = 0; k < 4; ++k)
+    integral += c[k] * (pow(hi, k + 1) - pow(lo, k + 1)) / (k + 1);
+  return integral;
+}
+
+// Lowest and highest PSNR of |points|.
+void PsnrRange(const RatePoint *points, double *min_psnr, double *max_psnr) {
+  *min_psnr = *max_psnr = points[0].psnr;
+  for (int i = 1; i < kNumRates; ++i) {
+    *min_psnr = std::min(*min_psnr, points[i].psnr);
+    *max_psnr = std::max(*max_psnr, points[i].psnr);
+  }
+}
+
+// Bjontegaard rate difference of |test| against |ref|, in percent.
+double BdRate(const RatePoint *ref, const RatePoint *test) {
+  double ref_min, ref_max, test_min, test_max;
+  PsnrRange(ref, &ref_min, &ref_max);
+  PsnrRange(test, &test_min, &test_max);
+  const double lo = std::max(ref_min, test_min);
+  const double hi = std::min(ref_max, test_max);
+  if (hi <= lo) return 0;
+  const double diff =
+      (IntegrateLogRate(test, lo, hi) - IntegrateLogRate(ref, lo, hi)) /
+      (hi - lo);
+  return (exp(diff) - 1) * 100;
+}
+
+class TrellisPerfTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<int, int> {
+ protected:
+  TrellisPerfTest()
+      : EncoderTest(GET_PARAM(0)), content_(kContents[GET_PARAM(1)]),
+        speed_(GET_PARAM(2)), trellis_opt_(1), encode_usecs_(0),
+        start_usecs_(0), bytes_(0), psnr_sum_(0), psnr_frames_(0) {}
+  virtual ~TrellisPerfTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.g_lag_in_frames = 25;
+    cfg_.rc_end_usage = VPX_VBR;
+    init_flags_ = VPX_CODEC_USE_PSNR;
+  }
+
+  virtual bool DoDecode() const { return false; }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) {
+    encode_usecs_ = 0;
+    bytes_ = 0;
+    psnr_sum_ = 0;
+    psnr_frames_ = 0;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, speed_);
+      encoder->Control(VP9E_SET_TRELLIS_OPT, trellis_opt_);
+    }
+    start_usecs_ = vpx_process_cpu_usec();
+  }
+
+  virtual void PostEncodeFrameHook(::libvpx_test::Encoder * /*encoder*/) {
+    encode_usecs_ += vpx_process_cpu_usec() - start_usecs_;
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    bytes_ += pkt->data.frame.sz;
+  }
+
+  virtual void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) {
+    psnr_sum_ += pkt->data.psnr.psnr[0];
+    ++psnr_frames_;
+  }
+
+  // Encodes at |kbps| with |trellis_opt|, returning the second pass encode
+  // time in microseconds.
+  int64_t Encode(int trellis_opt, unsigned int kbps, RatePoint *point) {
+    libvpx_test::SyntheticVideoSource video(content_.content);
+    video.SetSize(kWidth, kHeight);
+    video.set_limit(kFrames);
+    trellis_opt_ = trellis_opt;
+    cfg_.rc_target_bitrate = kbps;
+    EXPECT_NO_FATAL_FAILURE(RunLoop(&video));
+    EXPECT_EQ(kFrames, psnr_frames_);
+    point->kbps = bytes_ * 8.0 * 30 / kFrames / 1000;
+    point->psnr = psnr_sum_ / std::max(psnr_frames_, 1);
+    return encode_usecs_;
+  }
+
+  const ContentParam &content_;
+  const int speed_;
+  int trellis_opt_;
+  int64_t encode_usecs_;
+  int64_t start_usecs_;
+  size_t bytes_;
+  double psnr_sum_;
+  int psnr_frames_;
+};
+
+TEST_P(TrellisPerfTest, FastVsFull) {
+  RatePoint full[kNumRates], fast[kNumRates];
+  int64_t full_usecs = 0, fast_usecs = 0;
+  for (int i = 0; i < kNumRates; ++i) {
+    full_usecs += Encode(1, kRates[i], &full[i]);
+    fast_usecs += Encode(2, kRates[i], &fast[i]);
+    printf("%s speed %d %u kbps: full %.1f kbps %.3f dB, fast %.1f kbps "
+           "%.3f dB\n",
+           content_.name, speed_, kRates[i], full[i].kbps, full[i].psnr,
+           fast[i].kbps, fast[i].psnr);
+  }
+  printf("%s speed %d: full %.1f ms/frame, fast %.1f ms/frame (%+.1f%%), "
+         "BD-rate %+.2f%%\n",
+         content_.name, speed_, full_usecs / 1000.0 / (kNumRates * kFrames),
+         fast_usecs / 1000.0 / (kNumRates * kFrames),
+         (fast_usecs - full_usecs) * 100.0 / std::max<int64_t>(full_usecs, 1),
+         BdRate(full, fast));
+}
+
+VP9_INSTANTIATE_TEST_SUITE(TrellisPerfTest,
+                           ::testing::Range(0, static_cast<int>(
+                                                   sizeof(kContents) /
+                                                   sizeof(kContents[0]))),
+                           ::testing::Values(0, 1, 2));
+}  // namespace
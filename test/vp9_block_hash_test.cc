@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "vp9/encoder/vp9_block_hash.h"
+#include "vpx_scale/yv12config.h"
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+const int kWidth = 320;
+const int kHeight = 240;
+const int kSrcStride = 64;
+
+class BlockHashTest : public ::testing::Test {
+ protected:
+  BlockHashTest() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  virtual void SetUp() {
+    memset(&ref_, 0, sizeof(ref_));
+    memset(&table_, 0, sizeof(table_));
+    ASSERT_EQ(0, vpx_alloc_frame_buffer(&ref_, kWidth, kHeight, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                        0,
+#endif
+                                        32, 0));
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x)
+        ref_.y_buffer[y * ref_.y_stride + x] = rnd_.Rand8();
+    }
+    limits_.row_min = -kHeight;
+    limits_.row_max = kHeight;
+    limits_.col_min = -kWidth;
+    limits_.col_max = kWidth;
+  }
+
+  virtual void TearDown() {
+    vpx_free_frame_buffer(&ref_);
+    vp9_block_hash_free(&table_);
+  }
+
+  // Copies the |w|x|h| block of the reference at (|x|, |y|) to src_.
+  void CopyBlock(int x, int y, int w, int h) {
+    for (int r = 0; r < h; ++r) {
+      memcpy(src_ + r * kSrcStride, ref_.y_buffer + (y + r) * ref_.y_stride + x,
+             w);
+    }
+  }
+
+  ACMRandom rnd_;
+  YV12_BUFFER_CONFIG ref_;
+  BlockHashTable table_;
+  MvLimits limits_;
+  uint8_t src_[64 * kSrcStride];
+};
+
+TEST_F(BlockHashTest, FindsCopiedBlocks) {
+  static const int kBlocks[][4] = {
+    { 8, 8, 0, 0 },     { 16, 16, 304, 224 }, { 32, 16, 100, 37 },
+    { 16, 8, 3, 201 },  { 64, 64, 250, 170 }, { 8, 32, 77, 150 },
+    { 64, 32, 13, 99 }, { 32, 64, 200, 5 },
+  };
+  const MV zero_mv = { 0, 0 };
+  ASSERT_EQ(1, vp9_block_hash_build(&table_, &ref_));
+  for (int i = 0; i < static_cast<int>(sizeof(kBlocks) / sizeof(kBlocks[0]));
+       ++i) {
+    const int w = kBlocks[i][0];
+    const int h = kBlocks[i][1];
+    const int ref_x = kBlocks[i][2];
+    const int ref_y = kBlocks[i][3];
+    // Place the block somewhere else in its own frame.
+    const int x = (ref_x + 96) % (kWidth - w + 1);
+    const int y = (ref_y + 40) % (kHeight - h + 1);
+    MV mv;
+    CopyBlock(ref_x, ref_y, w, h);
+    ASSERT_EQ(1, vp9_block_hash_search(&table_, src_, kSrcStride, x, y, w, h,
+                                       &limits_, &zero_mv, &mv))
+        << "block " << i;
+    EXPECT_EQ(ref_y - y, mv.row) << "block " << i;
+    EXPECT_EQ(ref_x - x, mv.col) << "block " << i;
+  }
+}
+
+TEST_F(BlockHashTest, PicksTheClosestCopy) {
+  const MV ref_mv = { 60, 40 };
+  MV mv;
+  // Repeat the block at (16, 16) at (100, 80).
+  for (int r = 0; r < 16; ++r) {
+    memcpy(ref_.y_buffer + (80 + r) * ref_.y_stride + 100,
+           ref_.y_buffer + (16 + r) * ref_.y_stride + 16, 16);
+  }
+  ASSERT_EQ(1, vp9_block_hash_build(&table_, &ref_));
+  CopyBlock(16, 16, 16, 16);
+  ASSERT_EQ(1, vp9_block_hash_search(&table_, src_, kSrcStride, 32, 32, 16, 16,
+                                     &limits_, &ref_mv, &mv));
+  EXPECT_EQ(48, mv.row);
+  EXPECT_EQ(68, mv.col);
+
+  // The closest copy out of the limits is skipped.
+  limits_.row_max = 40;
+  ASSERT_EQ(1, vp9_block_hash_search(&table_, src_, kSrcStride, 32, 32, 16, 16,
+                                     &limits_, &ref_mv, &mv));
+  EXPECT_EQ(-16, mv.row);
+  EXPECT_EQ(-16, mv.col);
+}
+
+TEST_F(BlockHashTest, PicksTheClosestOfManyCopies) {
+  const MV zero_mv = { 0, 0 };
+  MV mv;
+  // Repeat the block at (300, 220) 80 times, all before it in raster order.
+  for (int y = 0; y < 80; y += 8) {
+    for (int x = 0; x < 128; x += 16) {
+      for (int r = 0; r < 8; ++r) {
+        memcpy(ref_.y_buffer + (y + r) * ref_.y_stride + x,
+               ref_.y_buffer + (220 + r) * ref_.y_stride + 300, 8);
+      }
+    }
+  }
+  ASSERT_EQ(1, vp9_block_hash_build(&table_, &ref_));
+  CopyBlock(300, 220, 8, 8);
+  ASSERT_EQ(1, vp9_block_hash_search(&table_, src_, kSrcStride, 300, 220, 8, 8,
+                                     &limits_, &zero_mv, &mv));
+  EXPECT_EQ(0, mv.row);
+  EXPECT_EQ(0, mv.col);
+}
+
+TEST_F(BlockHashTest, SkipsLargeFrames) {
+  YV12_BUFFER_CONFIG large;
+  memset(&large, 0, sizeof(large));
+  ASSERT_EQ(0, vpx_alloc_frame_buffer(&large, 2560, 1440, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                      0,
+#endif
+                                      32, 0));
+  EXPECT_EQ(0, vp9_block_hash_build(&table_, &large));
+  vpx_free_frame_buffer(&large);
+}
+
+TEST_F(BlockHashTest, RejectsFlatAndMissingBlocks) {
+  const MV zero_mv = { 0, 0 };
+  MV mv;
+  memset(ref_.y_buffer, 128, 16);
+  for (int r = 1; r < 16; ++r)
+    memcpy(ref_.y_buffer + r * ref_.y_stride, ref_.y_buffer, 16);
+  ASSERT_EQ(1, vp9_block_hash_build(&table_, &ref_));
+
+  // Flat blocks match everywhere, so they are not looked up.
+  CopyBlock(0, 0, 16, 16);
+  EXPECT_EQ(0, vp9_block_hash_search(&table_, src_, kSrcStride, 64, 64, 16, 16,
+                                     &limits_, &zero_mv, &mv));
+
+  CopyBlock(40, 40, 16, 16);
+  src_[5 * kSrcStride + 7] ^= 1;
+  EXPECT_EQ(0, vp9_block_hash_search(&table_, src_, kSrcStride, 64, 64, 16, 16,
+                                     &limits_, &zero_mv, &mv));
+}
+
+}  // namespace
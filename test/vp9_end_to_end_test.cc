@@ -239,6 +239,90 @@ class EndToEndTestLoopFilterThreading
  private:
   const bool use_loop_filter_opt_;
 };
+
+class EndToEndTestDecodeStats
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith3Params<int, bool, bool> {
+ protected:
+  EndToEndTestDecodeStats()
+      : EncoderTest(GET_PARAM(0)), row_mt_(GET_PARAM(2)),
+        use_loop_filter_opt_(GET_PARAM(3)), decoded_frames_(0),
+        decode_time_(0) {}
+
+  virtual ~EndToEndTestDecodeStats() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.rc_end_usage = VPX_CBR;
+    dec_cfg_.threads = GET_PARAM(1);
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 8);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 2);
+    }
+  }
+
+  virtual void PreDecodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Decoder *decoder) {
+    if (video->frame() == 0) {
+      decoder->Control(VP9D_SET_ROW_MT, row_mt_ ? 1 : 0);
+      decoder->Control(VP9D_SET_LOOP_FILTER_OPT, use_loop_filter_opt_ ? 1 : 0);
+    } else if (video->frame() == 1) {
+      decoder->Control(VP9D_SET_DECODE_STATS, 1);
+    }
+  }
+
+  virtual bool HandleDecodeResult(const vpx_codec_err_t res_dec,
+                                  const libvpx_test::VideoSource &video,
+                                  libvpx_test::Decoder *decoder) {
+    EXPECT_EQ(VPX_CODEC_OK, res_dec) << decoder->DecodeError();
+    if (res_dec != VPX_CODEC_OK) return false;
+
+    vpx_decode_stats_t stats;
+    decoder->Control(VP9D_GET_DECODE_STATS, &stats);
+    int64_t stage_sum = 0;
+    int64_t busy_sum = 0;
+    for (int i = 0; i < VP9D_STAGE_COUNT; ++i) {
+      EXPECT_GE(stats.stage_us[i], 0);
+      if (i != VP9D_STAGE_HEADER && i != VP9D_STAGE_POSTPROC) {
+        stage_sum += stats.stage_us[i];
+      }
+    }
+    // A single-threaded decode may still use a loop filter worker.
+    EXPECT_LE(stats.num_workers, static_cast<int>(dec_cfg_.threads) + 1);
+    for (int i = 0; i < stats.num_workers; ++i) {
+      EXPECT_GE(stats.worker_busy_us[i], 0);
+      EXPECT_GE(stats.worker_wait_us[i], 0);
+      busy_sum += stats.worker_busy_us[i];
+    }
+
+    if (video.frame() == 0) {
+      // Collection is off until the second frame.
+      EXPECT_EQ(0, stats.num_workers);
+      EXPECT_EQ(0, stage_sum);
+    } else {
+      EXPECT_GE(stats.num_workers, 1);
+      // The frame level loop filter that follows tile threading is not
+      // attributed to any worker.
+      EXPECT_LE(busy_sum, stage_sum);
+      decode_time_ += stats.stage_us[VP9D_STAGE_PARSE] +
+                      stats.stage_us[VP9D_STAGE_RECON];
+      ++decoded_frames_;
+    }
+    return true;
+  }
+
+  const bool row_mt_;
+  const bool use_loop_filter_opt_;
+  int decoded_frames_;
+  int64_t decode_time_;
+};
 #endif  // CONFIG_VP9_DECODER
 
 class EndToEndNV12 : public EndToEndTestLarge {};
@@ -332,6 +416,16 @@ TEST_P(EndToEndTestLoopFilterThreading, TileCountChange) {
 
   ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
 }
+
+TEST_P(EndToEndTestDecodeStats, StagesAndWorkers) {
+  ::libvpx_test::RandomVideoSource video;
+  video.SetSize(1280, 720);
+  video.set_limit(4);
+
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(3, decoded_frames_);
+  EXPECT_GT(decode_time_, 0);
+}
 #endif  // CONFIG_VP9_DECODER
 
 VP9_INSTANTIATE_TEST_SUITE(EndToEndTestLarge,
@@ -350,5 +444,7 @@ VP9_INSTANTIATE_TEST_SUITE(EndToEndTestAdaptiveRDThresh,
 #if CONFIG_VP9_DECODER
 VP9_INSTANTIATE_TEST_SUITE(EndToEndTestLoopFilterThreading, ::testing::Bool(),
                            ::testing::Range(2, 6));
+VP9_INSTANTIATE_TEST_SUITE(EndToEndTestDecodeStats, ::testing::Values(1, 2, 4),
+                           ::testing::Bool(), ::testing::Bool());
 #endif  // CONFIG_VP9_DECODER
 }  // namespace
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <tuple>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vp9/common/vp9_quant_common.h"
+#include "vp9/common/vp9_scan.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+const int kNumIterations = 1000;
+const int kStride = 64;
+
+typedef void (*FdctQuantizeFunc)(
+    const uint8_t *src, int src_stride, const uint8_t *pred, int pred_stride,
+    tran_low_t *coeff_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const int16_t *iscan);
+typedef std::tuple<FdctQuantizeFunc, TX_SIZE> FdctQuantizeParam;
+
+// The separate steps the fused kernels replace.
+void ReferenceFdctQuantize(TX_SIZE tx_size, const uint8_t *src, int src_stride,
+                           const uint8_t *pred, int pred_stride,
+                           tran_low_t *coeff, const int16_t *round,
+                           const int16_t *quant, tran_low_t *qcoeff,
+                           tran_low_t *dqcoeff, const int16_t *dequant,
+                           uint16_t *eob, const int16_t *scan,
+                           const int16_t *iscan) {
+  const int size = 4 << tx_size;
+  int16_t src_diff[16 * 16];
+  vpx_subtract_block_c(size, size, src_diff, size, src, src_stride, pred,
+                       pred_stride);
+  switch (tx_size) {
+    case TX_4X4: vpx_fdct4x4_c(src_diff, coeff, size); break;
+    case TX_8X8: vpx_fdct8x8_c(src_diff, coeff, size); break;
+    default: vpx_fdct16x16_c(src_diff, coeff, size); break;
+  }
+  vp9_quantize_fp_c(coeff, size * size, round, quant, qcoeff, dqcoeff, dequant,
+                    eob, scan, iscan);
+}
+
+class VP9FdctQuantizeTest
+    : public ::testing::TestWithParam<FdctQuantizeParam> {
+ public:
+  virtual void SetUp() {
+    fdct_quantize_ = GET_PARAM(0);
+    tx_size_ = GET_PARAM(1);
+    size_ = 4 << tx_size_;
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Sets the luma quantizer of |q| the way vp9_init_quantizer() does.
+  void SetQuantizer(int q, int rounding_factor) {
+    for (int i = 0; i < 8; ++i) {
+      const int16_t step = i == 0 ? vp9_dc_quant(q, 0, VPX_BITS_8)
+                                  : vp9_ac_quant(q, 0, VPX_BITS_8);
+      dequant_[i] = step;
+      quant_[i] = (1 << 16) / step;
+      round_[i] = (rounding_factor * step) >> 7;
+    }
+  }
+
+  // Runs the kernel under test and the reference on the blocks at
+  // |src_offset| and |pred_offset| and expects the same coefficients,
+  // quantized values and eob.
+  void CheckBlock(int src_offset, int pred_offset) {
+    const scan_order *const so = &vp9_default_scan_orders[tx_size_];
+    const int count = size_ * size_;
+    DECLARE_ALIGNED(32, tran_low_t, ref_coeff[16 * 16]);
+    DECLARE_ALIGNED(32, tran_low_t, ref_qcoeff[16 * 16]);
+    DECLARE_ALIGNED(32, tran_low_t, ref_dqcoeff[16 * 16]);
+    DECLARE_ALIGNED(32, tran_low_t, coeff[16 * 16]);
+    DECLARE_ALIGNED(32, tran_low_t, qcoeff[16 * 16]);
+    DECLARE_ALIGNED(32, tran_low_t, dqcoeff[16 * 16]);
+    uint16_t ref_eob = 0, eob = 0;
+
+    ReferenceFdctQuantize(tx_size_, src_ + src_offset, kStride,
+                          pred_ + pred_offset, kStride, ref_coeff, round_,
+                          quant_, ref_qcoeff, ref_dqcoeff, dequant_, &ref_eob,
+                          so->scan, so->iscan);
+    ASM_REGISTER_STATE_CHECK(fdct_quantize_(
+        src_ + src_offset, kStride, pred_ + pred_offset, kStride, coeff,
+        round_, quant_, qcoeff, dqcoeff, dequant_, &eob, so->scan, so->iscan));
+
+    ASSERT_EQ(ref_eob, eob);
+    for (int i = 0; i < count; ++i) {
+      ASSERT_EQ(ref_coeff[i], coeff[i]) << "coeff " << i;
+      ASSERT_EQ(ref_qcoeff[i], qcoeff[i]) << "qcoeff " << i;
+      ASSERT_EQ(ref_dqcoeff[i], dqcoeff[i]) << "dqcoeff " << i;
+    }
+  }
+
+  FdctQuantizeFunc fdct_quantize_;
+  TX_SIZE tx_size_;
+  int size_;
+  uint8_t src_[kStride * 24];
+  uint8_t pred_[kStride * 24];
+  DECLARE_ALIGNED(16, int16_t, round_[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant_[8]);
+};
+
+TEST_P(VP9FdctQuantizeTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int i = 0; i < kNumIterations; ++i) {
+    // Small residuals as well as full range ones, so that both sparse and
+    // dense blocks are checked.
+    const int full_range = i & 1;
+    const int base = rnd.Rand8();
+    for (int j = 0; j < kStride * 24; ++j) {
+      if (full_range) {
+        src_[j] = rnd.Rand8();
+        pred_[j] = rnd.Rand8();
+      } else {
+        src_[j] = clip_pixel(base + rnd.PseudoUniform(9) - 4);
+        pred_[j] = base;
+      }
+    }
+    SetQuantizer(rnd.Rand8(), (i & 2) ? 64 : 48);
+    ASSERT_NO_FATAL_FAILURE(
+        CheckBlock(rnd.PseudoUniform(16), rnd.PseudoUniform(16)));
+  }
+}
+
+TEST_P(VP9FdctQuantizeTest, ExtremeCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int i = 0; i < kNumIterations; ++i) {
+    // Every residual is -255 or 255, in a random pattern or all the same.
+    const int pattern = i % 3;
+    for (int j = 0; j < kStride * 24; ++j) {
+      const int high = pattern == 0 ? rnd.Rand8() & 1 : pattern == 1;
+      src_[j] = high ? 255 : 0;
+      pred_[j] = 255 - src_[j];
+    }
+    SetQuantizer(rnd.Rand8(), 64);
+    ASSERT_NO_FATAL_FAILURE(CheckBlock(rnd.PseudoUniform(16), 0));
+  }
+}
+
+using std::make_tuple;
+
+INSTANTIATE_TEST_SUITE_P(
+    C, VP9FdctQuantizeTest,
+    ::testing::Values(make_tuple(&vp9_fdct_quantize_fp_4x4_c, TX_4X4),
+                      make_tuple(&vp9_fdct_quantize_fp_8x8_c, TX_8X8),
+                      make_tuple(&vp9_fdct_quantize_fp_16x16_c, TX_16X16)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, VP9FdctQuantizeTest,
+    ::testing::Values(make_tuple(&vp9_fdct_quantize_fp_4x4_sse2, TX_4X4),
+                      make_tuple(&vp9_fdct_quantize_fp_8x8_sse2, TX_8X8),
+                      make_tuple(&vp9_fdct_quantize_fp_16x16_sse2, TX_16X16)));
+#endif  // HAVE_SSE2
+}  // namespace
@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/synthetic_video_source.h"
+#include "test/util.h"
+#include "vp9/encoder/vp9_pyramid.h"
+#include "vpx_scale/yv12config.h"
+
+namespace {
+
+const int kWidth = 640;
+const int kHeight = 512;
+
+class PyramidTest : public ::testing::Test {
+ protected:
+  PyramidTest() {}
+
+  virtual void SetUp() {
+    memset(&src_, 0, sizeof(src_));
+    memset(&ref_, 0, sizeof(ref_));
+    memset(&src_pyr_, 0, sizeof(src_pyr_));
+    memset(&ref_pyr_, 0, sizeof(ref_pyr_));
+    ASSERT_EQ(0, vpx_alloc_frame_buffer(&src_, kWidth, kHeight, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                        0,
+#endif
+                                        32, 0));
+    ASSERT_EQ(0, vpx_alloc_frame_buffer(&ref_, kWidth, kHeight, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                        0,
+#endif
+                                        32, 0));
+  }
+
+  virtual void TearDown() {
+    vpx_free_frame_buffer(&src_);
+    vpx_free_frame_buffer(&ref_);
+    vp9_pyramid_free(&src_pyr_);
+    vp9_pyramid_free(&ref_pyr_);
+  }
+
+  // Smooth texture with features at several scales, sampled at (x, y).
+  static uint8_t Texture(int x, int y) {
+    const unsigned int cx = static_cast<unsigned int>(x + 1024) / 24;
+    const unsigned int cy = static_cast<unsigned int>(y + 1024) / 24;
+    unsigned int h = cx * 73856093u ^ cy * 19349663u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return static_cast<uint8_t>(32 + (h & 127) + ((x * 3 + y * 5) & 31));
+  }
+
+  // Fills the source with the reference displaced by (|row|, |col|), so the
+  // motion of every block of the source is (|row|, |col|).
+  void FillFrames(int row, int col) {
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        ref_.y_buffer[y * ref_.y_stride + x] = Texture(x, y);
+        src_.y_buffer[y * src_.y_stride + x] = Texture(x + col, y + row);
+      }
+    }
+    ASSERT_EQ(1, vp9_pyramid_build(&src_pyr_, &src_));
+    ASSERT_EQ(1, vp9_pyramid_build(&ref_pyr_, &ref_));
+  }
+
+  YV12_BUFFER_CONFIG src_;
+  YV12_BUFFER_CONFIG ref_;
+  ImagePyramid src_pyr_;
+  ImagePyramid ref_pyr_;
+};
+
+TEST(PyramidLevelsTest, DependsOnTheFrameSize) {
+  EXPECT_EQ(0, vp9_pyramid_num_levels(320, 240));
+  EXPECT_EQ(1, vp9_pyramid_num_levels(352, 288));
+  EXPECT_EQ(1, vp9_pyramid_num_levels(640, 360));
+  EXPECT_EQ(2, vp9_pyramid_num_levels(1280, 720));
+  EXPECT_EQ(3, vp9_pyramid_num_levels(1920, 1080));
+  EXPECT_EQ(4, vp9_pyramid_num_levels(3840, 2160));
+  EXPECT_EQ(4, vp9_pyramid_num_levels(7680, 4320));
+}
+
+// The search ends on the first level, so it finds motion in steps of 2
+// pixels.
+TEST_F(PyramidTest, FindsTranslation) {
+  static const int kMotion[][2] = {
+    { 0, 0 }, { 6, -10 }, { -22, 30 }, { 34, -34 }, { -4, 18 }
+  };
+  static const int kBlocks[][4] = { { 64, 64, 64, 64 },
+                                    { 256, 192, 32, 32 },
+                                    { 320, 128, 16, 32 },
+                                    { 448, 384, 8, 8 } };
+  ASSERT_EQ(2, vp9_pyramid_num_levels(kWidth, kHeight));
+  for (int m = 0; m < 5; ++m) {
+    FillFrames(kMotion[m][0], kMotion[m][1]);
+    for (int b = 0; b < 4; ++b) {
+      MV mv;
+      ASSERT_EQ(1, vp9_pyramid_motion_search(&src_pyr_, &ref_pyr_,
+                                             kBlocks[b][0], kBlocks[b][1],
+                                             kBlocks[b][2], kBlocks[b][3],
+                                             &mv));
+      EXPECT_EQ(kMotion[m][0], mv.row) << "block " << b;
+      EXPECT_EQ(kMotion[m][1], mv.col) << "block " << b;
+    }
+  }
+}
+
+TEST_F(PyramidTest, RejectsMismatchedPyramids) {
+  ImagePyramid small;
+  YV12_BUFFER_CONFIG frame;
+  MV mv;
+  memset(&small, 0, sizeof(small));
+  memset(&frame, 0, sizeof(frame));
+  ASSERT_EQ(0, vpx_alloc_frame_buffer(&frame, kWidth / 2, kHeight, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                      0,
+#endif
+                                      32, 0));
+  memset(frame.buffer_alloc, 128, frame.frame_size);
+  FillFrames(0, 0);
+  ASSERT_EQ(1, vp9_pyramid_build(&small, &frame));
+  EXPECT_EQ(0, vp9_pyramid_motion_search(&src_pyr_, &small, 0, 0, 64, 64, &mv));
+  vp9_pyramid_free(&small);
+  vpx_free_frame_buffer(&frame);
+}
+
+TEST(PyramidCacheTest, ReusesPyramids) {
+  PyramidCache cache;
+  YV12_BUFFER_CONFIG frames[2];
+  memset(&cache, 0, sizeof(cache));
+  for (int i = 0; i < 2; ++i) {
+    memset(&frames[i], 0, sizeof(frames[i]));
+    ASSERT_EQ(0, vpx_alloc_frame_buffer(&frames[i], kWidth, kHeight, 1, 1,
+#if CONFIG_VP9_HIGHBITDEPTH
+                                        0,
+#endif
+                                        32, 0));
+    memset(frames[i].buffer_alloc, 64 * (i + 1), frames[i].frame_size);
+  }
+
+  const ImagePyramid *const first = vp9_pyramid_cache_get(&cache, &frames[0]);
+  ASSERT_TRUE(first != NULL);
+  EXPECT_EQ(64, first->level[0][0]);
+  const ImagePyramid *const second = vp9_pyramid_cache_get(&cache, &frames[1]);
+  ASSERT_TRUE(second != NULL);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(128, second->level[1][0]);
+  EXPECT_EQ(first, vp9_pyramid_cache_get(&cache, &frames[0]));
+  EXPECT_EQ(2, cache.num_entries);
+
+  // After a clear the pyramids are built again from the current content.
+  vp9_pyramid_cache_clear(&cache);
+  memset(frames[0].buffer_alloc, 192, frames[0].frame_size);
+  const ImagePyramid *const rebuilt = vp9_pyramid_cache_get(&cache, &frames[0]);
+  ASSERT_TRUE(rebuilt != NULL);
+  EXPECT_EQ(192, rebuilt->level[0][0]);
+
+  vp9_pyramid_cache_free(&cache);
+  for (int i = 0; i < 2; ++i) vpx_free_frame_buffer(&frames[i]);
+}
+
+// The pyramid search is on for good quality at speed <= 2 and 720p or
+// larger. Encodes such a clip with fast motion and an alt-ref, so the rd
+// motion search, the temporal filter and the tpl model all search around the
+// pyramid motion, and checks the decoded frames.
+class PyramidEncodeTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+ protected:
+  PyramidEncodeTest()
+      : EncoderTest(GET_PARAM(0)), encoding_mode_(GET_PARAM(1)),
+        cpu_used_(GET_PARAM(2)), psnr_(0.0), nframes_(0) {}
+  virtual ~PyramidEncodeTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.g_lag_in_frames = 25;
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 2000;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used_);
+      encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+      encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
+      encoder->Control(VP8E_SET_ARNR_STRENGTH, 5);
+    }
+  }
+
+  virtual void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) {
+    psnr_ += pkt->data.psnr.psnr[0];
+    ++nframes_;
+  }
+
+  double GetAveragePsnr() const { return nframes_ ? psnr_ / nframes_ : 0.0; }
+
+  const libvpx_test::TestMode encoding_mode_;
+  const int cpu_used_;
+  double psnr_;
+  unsigned int nframes_;
+};
+
+TEST_P(PyramidEncodeTest, Encodes720p) {
+  const libvpx_test::SyntheticContent content = { 12, 2, 2, 0 };
+  libvpx_test::SyntheticVideoSource video(content);
+  video.SetSize(1280, 720);
+  video.set_limit(10);
+  init_flags_ = VPX_CODEC_USE_PSNR;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(10u, nframes_);
+  EXPECT_GT(GetAveragePsnr(), 30.0);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(PyramidEncodeTest,
+                           ::testing::Values(::libvpx_test::kTwoPassGood),
+                           ::testing::Values(1, 2));
+
+}  // namespace
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/synthetic_video_source.h"
+#include "test/util.h"
+
+namespace {
+
+const int kFrames = 20;
+
+// Seeding the temporal filter and tpl model motion searches only changes
+// where they search, so the seeded encode must still decode to the encoder's
+// reconstruction and keep about the same quality.
+class TemporalMvSeedsTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  TemporalMvSeedsTest()
+      : EncoderTest(GET_PARAM(0)), cpu_used_(GET_PARAM(1)), seeds_(0),
+        psnr_(0.0), nframes_(0) {}
+  virtual ~TemporalMvSeedsTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.g_lag_in_frames = 16;
+    cfg_.rc_end_usage = VPX_VBR;
+    cfg_.rc_target_bitrate = 400;
+    init_flags_ = VPX_CODEC_USE_PSNR;
+  }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) {
+    md5_.clear();
+    psnr_ = 0.0;
+    nframes_ = 0;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used_);
+      encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+      encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
+      encoder->Control(VP8E_SET_ARNR_STRENGTH, 5);
+      encoder->Control(VP9E_SET_TEMPORAL_MV_SEEDS, seeds_);
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    ::libvpx_test::MD5 md5_res;
+    md5_res.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                pkt->data.frame.sz);
+    md5_.push_back(md5_res.Get());
+  }
+
+  virtual void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) {
+    psnr_ += pkt->data.psnr.psnr[0];
+    ++nframes_;
+  }
+
+  double GetAveragePsnr() const { return nframes_ ? psnr_ / nframes_ : 0.0; }
+
+  int cpu_used_;
+  int seeds_;
+  double psnr_;
+  int nframes_;
+  std::vector<std::string> md5_;
+};
+
+TEST_P(TemporalMvSeedsTest, EncodesWithSeeds) {
+  const libvpx_test::SyntheticContent content = { 3, 2, 2, 0 };
+  libvpx_test::SyntheticVideoSource video(content);
+  video.SetSize(320, 180);
+  video.set_limit(kFrames);
+
+  seeds_ = 0;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const std::vector<std::string> full_range_md5 = md5_;
+  const double full_range_psnr = GetAveragePsnr();
+
+  seeds_ = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_FALSE(md5_.empty());
+  EXPECT_NE(full_range_md5, md5_);
+  EXPECT_GT(GetAveragePsnr(), full_range_psnr - 0.5);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(TemporalMvSeedsTest, ::testing::Values(1, 2));
+}  // namespace
@@ -0,0 +1,1020 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+//  Times every specialization of the functions declared in the rtcd
+//  definition files and reports which one is dispatched on this CPU.
+//
+//  Usage: vpx_dsp_bench [--format=csv|json] [--filter=substring] [--list]
+//                       [--sample-us=N]
+//
+//  Functions are matched to a timing loop by their prototype. Those with a
+//  prototype the tool does not know how to drive are still listed, with no
+//  timings, so functions that fall back to C remain visible.
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "./vpx_scale_rtcd.h"
+#if CONFIG_VP8
+#include "./vp8_rtcd.h"
+#endif
+#if CONFIG_VP9
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_filter.h"
+#endif
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/vpx_filter.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/vpx_timer.h"
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+#include "vpx_ports/x86.h"
+#elif VPX_ARCH_ARM
+#include "vpx_ports/arm.h"
+#elif VPX_ARCH_MIPS
+#include "vpx_ports/mips.h"
+#elif VPX_ARCH_PPC
+#include "vpx_ports/ppc.h"
+#elif VPX_ARCH_LOONGARCH
+#include "vpx_ports/loongarch.h"
+#endif
+
+extern "C" {
+#if CONFIG_VP8
+extern void vp8_rtcd();
+#endif  // CONFIG_VP8
+#if CONFIG_VP9
+extern void vp9_rtcd();
+#endif  // CONFIG_VP9
+extern void vpx_dsp_rtcd();
+extern void vpx_scale_rtcd();
+}
+
+namespace {
+
+// Number of samples the median time is taken from.
+const int kSamples = 15;
+
+// All pixel buffers share one layout: the block under test starts kOrigin
+// rows and columns into a kStride x kRows plane, which leaves room for the
+// filter taps and edge pixels that kernels read around the block.
+const int kStride = 256;
+const int kRows = 192;
+const int kOrigin = 48;
+const int kMaxBlock = 64;
+const int kCoeffs = 64 * 64;
+
+typedef void (*RtcdFn)(void);
+
+struct Impl {
+  Impl(const char *ext, RtcdFn fn, int cpu_flag)
+      : ext(ext), fn(fn), cpu_flag(cpu_flag), ns(-1.0) {}
+  const char *ext;
+  RtcdFn fn;
+  int cpu_flag;
+  double ns;
+};
+
+struct Function {
+  const char *name;
+  const char *signature;
+  RtcdFn selected;
+  std::vector<Impl> impls;
+};
+
+// Everything a timing loop needs. The 8-bit pointers of high bitdepth
+// functions hold CONVERT_TO_BYTEPTR() addresses of the 16-bit planes.
+struct Context {
+  RtcdFn fn;
+  int w;
+  int h;
+  int bd;
+  int tx_type;
+  uint8_t *src;
+  uint8_t *ref;
+  uint8_t *dst;
+  uint8_t *pred;
+  uint16_t *src16;
+  uint16_t *ref16;
+  uint16_t *dst16;
+  uint16_t *pred16;
+  int16_t *diff;
+  tran_low_t *coeff;
+  tran_low_t *qcoeff;
+  tran_low_t *dqcoeff;
+};
+
+struct Planes {
+  uint8_t *pixels[4];
+  uint16_t *pixels16[4];
+  int bd16;
+  int16_t *diff;
+  tran_low_t *coeff;
+  tran_low_t *qcoeff;
+  tran_low_t *dqcoeff;
+  int16_t *scan;
+  uint16_t eob;
+};
+
+Planes planes;
+volatile uint64_t sink;
+
+DECLARE_ALIGNED(16, const uint8_t, kBlimit[16]) = {
+  60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60
+};
+DECLARE_ALIGNED(16, const uint8_t, kLimit[16]) = {
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10
+};
+DECLARE_ALIGNED(16, const uint8_t, kThresh[16]) = { 4, 4, 4, 4, 4, 4, 4, 4,
+                                                    4, 4, 4, 4, 4, 4, 4, 4 };
+
+// DC followed by AC values, as the quantizers expect.
+DECLARE_ALIGNED(16, const int16_t, kZbin[8]) = { 28, 34, 34, 34,
+                                                 34, 34, 34, 34 };
+DECLARE_ALIGNED(16, const int16_t, kRound[8]) = { 19, 23, 23, 23,
+                                                  23, 23, 23, 23 };
+DECLARE_ALIGNED(16, const int16_t, kQuant[8]) = { 1638, 1365, 1365, 1365,
+                                                  1365, 1365, 1365, 1365 };
+DECLARE_ALIGNED(16, const int16_t, kQuantShift[8]) = {
+  16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384
+};
+DECLARE_ALIGNED(16, const int16_t, kDequant[8]) = { 40, 48, 48, 48,
+                                                    48, 48, 48, 48 };
+
+unsigned int random_state = 0x12345678;
+
+int Rand(int range) {
+  random_state = random_state * 1103515245 + 12345;
+  return (int)((random_state >> 16) % range);
+}
+
+// A smooth gradient with some texture, like natural video. The planes are
+// shifted copies of each other so that differences look like residuals.
+void FillPixels(uint8_t *plane, int shift) {
+  int r, c;
+  for (r = 0; r < kRows; ++r) {
+    for (c = 0; c < kStride; ++c) {
+      const int v = 64 + ((r + shift) * 3 + (c + 2 * shift) * 2) % 128 +
+                    Rand(16) - 8;
+      plane[r * kStride + c] = (uint8_t)clamp(v, 0, 255);
+    }
+  }
+}
+
+void SetHighbdDepth(int bd) {
+  int i, j;
+  if (planes.bd16 == bd) return;
+  for (i = 0; i < 4; ++i) {
+    for (j = 0; j < kStride * kRows; ++j) {
+      planes.pixels16[i][j] = (uint16_t)(planes.pixels[i][j] << (bd - 8));
+    }
+  }
+  planes.bd16 = bd;
+}
+
+void AllocPlanes() {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    planes.pixels[i] = (uint8_t *)vpx_memalign(32, kStride * kRows);
+    planes.pixels16[i] = (uint16_t *)vpx_memalign(
+        32, kStride * kRows * sizeof(*planes.pixels16[i]));
+    if (!planes.pixels[i] || !planes.pixels16[i]) {
+      fprintf(stderr, "Failed to allocate buffers\n");
+      exit(EXIT_FAILURE);
+    }
+    FillPixels(planes.pixels[i], i);
+  }
+  planes.bd16 = 0;
+  planes.diff =
+      (int16_t *)vpx_memalign(32, kMaxBlock * kMaxBlock * sizeof(int16_t));
+  planes.coeff = (tran_low_t *)vpx_memalign(32, kCoeffs * sizeof(tran_low_t));
+  planes.qcoeff = (tran_low_t *)vpx_memalign(32, kCoeffs * sizeof(tran_low_t));
+  planes.dqcoeff =
+      (tran_low_t *)vpx_memalign(32, kCoeffs * sizeof(tran_low_t));
+  planes.scan = (int16_t *)vpx_memalign(32, kCoeffs * sizeof(int16_t));
+  if (!planes.diff || !planes.coeff || !planes.qcoeff || !planes.dqcoeff ||
+      !planes.scan) {
+    fprintf(stderr, "Failed to allocate buffers\n");
+    exit(EXIT_FAILURE);
+  }
+  for (i = 0; i < kMaxBlock * kMaxBlock; ++i) {
+    planes.diff[i] = (int16_t)(planes.pixels[0][i] - planes.pixels[1][i]);
+  }
+  // Coefficients that decay with frequency, like transformed residuals.
+  for (i = 0; i < kCoeffs; ++i) {
+    const int amplitude = VPXMAX(1, 256 >> (i / 64));
+    planes.coeff[i] = Rand(2 * amplitude + 1) - amplitude;
+    planes.qcoeff[i] = planes.coeff[i] / 8;
+    planes.dqcoeff[i] = planes.qcoeff[i] * 8;
+    planes.scan[i] = (int16_t)i;
+  }
+}
+
+void FreePlanes() {
+  int i;
+  for (i = 0; i < 4; ++i) {
+    vpx_free(planes.pixels[i]);
+    vpx_free(planes.pixels16[i]);
+  }
+  vpx_free(planes.diff);
+  vpx_free(planes.coeff);
+  vpx_free(planes.qcoeff);
+  vpx_free(planes.dqcoeff);
+  vpx_free(planes.scan);
+}
+
+// Finds the first WxH in the name, e.g. 16x8 in vpx_highbd_10_variance16x8.
+// Functions without one are timed on 16x16 blocks.
+void ParseBlockSize(const char *name, int *w, int *h) {
+  const char *p;
+  *w = *h = 16;
+  for (p = name; *p; ++p) {
+    int bw, bh;
+    if (isdigit(*p) && (p == name || !isdigit(p[-1])) &&
+        sscanf(p, "%dx%d", &bw, &bh) == 2 && bw > 0 && bh > 0 &&
+        bw <= kMaxBlock && bh <= kMaxBlock) {
+      *w = bw;
+      *h = bh;
+      return;
+    }
+  }
+}
+
+// Derives the block size, bit depth and transform type from the name.
+void SetupContext(const Function &f, Context *ctx) {
+  const std::string name = f.name;
+  const int highbd = name.find("highbd") != std::string::npos;
+
+  ParseBlockSize(f.name, &ctx->w, &ctx->h);
+
+  ctx->bd = 8;
+  if (highbd) {
+    ctx->bd = 10;
+    if (name.find("_8_") != std::string::npos) ctx->bd = 8;
+    if (name.find("_12_") != std::string::npos) ctx->bd = 12;
+    SetHighbdDepth(ctx->bd);
+  }
+  ctx->tx_type = 3;  // ADST_ADST
+
+  ctx->fn = NULL;
+  ctx->src16 = planes.pixels16[0] + kOrigin * kStride + kOrigin;
+  ctx->ref16 = planes.pixels16[1] + kOrigin * kStride + kOrigin;
+  ctx->dst16 = planes.pixels16[2] + kOrigin * kStride + kOrigin;
+  ctx->pred16 = planes.pixels16[3];
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (highbd) {
+    ctx->src = CONVERT_TO_BYTEPTR(ctx->src16);
+    ctx->ref = CONVERT_TO_BYTEPTR(ctx->ref16);
+    ctx->dst = CONVERT_TO_BYTEPTR(ctx->dst16);
+    ctx->pred = CONVERT_TO_BYTEPTR(ctx->pred16);
+  } else
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  {
+    ctx->src = planes.pixels[0] + kOrigin * kStride + kOrigin;
+    ctx->ref = planes.pixels[1] + kOrigin * kStride + kOrigin;
+    ctx->dst = planes.pixels[2] + kOrigin * kStride + kOrigin;
+    ctx->pred = planes.pixels[3];
+  }
+  ctx->diff = planes.diff;
+  ctx->coeff = planes.coeff;
+  ctx->qcoeff = planes.qcoeff;
+  ctx->dqcoeff = planes.dqcoeff;
+}
+
+//
+// Timing loops, one per prototype. Each runs the function |n| times.
+//
+
+typedef unsigned int (*SadFn)(const uint8_t *, int, const uint8_t *, int);
+void RunSad(const Context &c, int n) {
+  const SadFn fn = reinterpret_cast<SadFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.src, kStride, c.ref, kStride);
+}
+
+typedef unsigned int (*SadAvgFn)(const uint8_t *, int, const uint8_t *, int,
+                                 const uint8_t *);
+void RunSadAvg(const Context &c, int n) {
+  const SadAvgFn fn = reinterpret_cast<SadAvgFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.src, kStride, c.ref, kStride, c.pred);
+}
+
+typedef void (*Sad4DFn)(const uint8_t *, int, const uint8_t *const[4], int,
+                        uint32_t[4]);
+void RunSad4D(const Context &c, int n) {
+  const Sad4DFn fn = reinterpret_cast<Sad4DFn>(c.fn);
+  const uint8_t *const refs[4] = { c.ref, c.ref + 1, c.ref + kStride,
+                                   c.ref + kStride + 1 };
+  uint32_t sads[4];
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.src, kStride, refs, kStride, sads);
+    sink += sads[0];
+  }
+}
+
+typedef unsigned int (*VarianceFn)(const uint8_t *, int, const uint8_t *, int,
+                                   unsigned int *);
+void RunVariance(const Context &c, int n) {
+  const VarianceFn fn = reinterpret_cast<VarianceFn>(c.fn);
+  unsigned int sse;
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.src, kStride, c.ref, kStride, &sse);
+}
+
+typedef void (*GetVarFn)(const uint8_t *, int, const uint8_t *, int,
+                         unsigned int *, int *);
+void RunGetVar(const Context &c, int n) {
+  const GetVarFn fn = reinterpret_cast<GetVarFn>(c.fn);
+  unsigned int sse;
+  int sum, i;
+  for (i = 0; i < n; ++i) {
+    fn(c.src, kStride, c.ref, kStride, &sse, &sum);
+    sink += sse;
+  }
+}
+
+typedef uint32_t (*SubpelVarianceFn)(const uint8_t *, int, int, int,
+                                     const uint8_t *, int, uint32_t *);
+void RunSubpelVariance(const Context &c, int n) {
+  const SubpelVarianceFn fn = reinterpret_cast<SubpelVarianceFn>(c.fn);
+  uint32_t sse;
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.ref, kStride, 3, 5, c.src, kStride, &sse);
+}
+
+typedef uint32_t (*SubpelAvgVarianceFn)(const uint8_t *, int, int, int,
+                                        const uint8_t *, int, uint32_t *,
+                                        const uint8_t *);
+void RunSubpelAvgVariance(const Context &c, int n) {
+  const SubpelAvgVarianceFn fn = reinterpret_cast<SubpelAvgVarianceFn>(c.fn);
+  uint32_t sse;
+  int i;
+  for (i = 0; i < n; ++i) {
+    sink += fn(c.ref, kStride, 3, 5, c.src, kStride, &sse, c.pred);
+  }
+}
+
+typedef unsigned int (*AvgFn)(const uint8_t *, int);
+void RunAvg(const Context &c, int n) {
+  const AvgFn fn = reinterpret_cast<AvgFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.src, kStride);
+}
+
+typedef void (*MinMaxFn)(const uint8_t *, int, const uint8_t *, int, int *,
+                         int *);
+void RunMinMax(const Context &c, int n) {
+  const MinMaxFn fn = reinterpret_cast<MinMaxFn>(c.fn);
+  int min, max, i;
+  for (i = 0; i < n; ++i) {
+    fn(c.src, kStride, c.ref, kStride, &min, &max);
+    sink += max;
+  }
+}
+
+typedef void (*IntraPredFn)(uint8_t *, ptrdiff_t, const uint8_t *,
+                            const uint8_t *);
+void RunIntraPred(const Context &c, int n) {
+  const IntraPredFn fn = reinterpret_cast<IntraPredFn>(c.fn);
+  const uint8_t *const above = c.ref - kStride;
+  const uint8_t *const left = c.pred;
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dst, kStride, above, left);
+}
+
+typedef void (*HighbdIntraPredFn)(uint16_t *, ptrdiff_t, const uint16_t *,
+                                  const uint16_t *, int);
+void RunHighbdIntraPred(const Context &c, int n) {
+  const HighbdIntraPredFn fn = reinterpret_cast<HighbdIntraPredFn>(c.fn);
+  const uint16_t *const above = c.ref16 - kStride;
+  const uint16_t *const left = c.pred16;
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dst16, kStride, above, left, c.bd);
+}
+
+typedef void (*FdctFn)(const int16_t *, tran_low_t *, int);
+void RunFdct(const Context &c, int n) {
+  const FdctFn fn = reinterpret_cast<FdctFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.diff, c.qcoeff, c.w);
+}
+
+typedef void (*FhtFn)(const int16_t *, tran_low_t *, int, int);
+void RunFht(const Context &c, int n) {
+  const FhtFn fn = reinterpret_cast<FhtFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.diff, c.qcoeff, c.w, c.tx_type);
+}
+
+typedef void (*HadamardFn)(const int16_t *, ptrdiff_t, tran_low_t *);
+void RunHadamard(const Context &c, int n) {
+  const HadamardFn fn = reinterpret_cast<HadamardFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.diff, c.w, c.qcoeff);
+}
+
+typedef void (*IdctFn)(const tran_low_t *, uint8_t *, int);
+void RunIdct(const Context &c, int n) {
+  const IdctFn fn = reinterpret_cast<IdctFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dqcoeff, c.dst, kStride);
+}
+
+typedef void (*IhtFn)(const tran_low_t *, uint8_t *, int, int);
+void RunIht(const Context &c, int n) {
+  const IhtFn fn = reinterpret_cast<IhtFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dqcoeff, c.dst, kStride, c.tx_type);
+}
+
+typedef void (*HighbdIdctFn)(const tran_low_t *, uint16_t *, int, int);
+void RunHighbdIdct(const Context &c, int n) {
+  const HighbdIdctFn fn = reinterpret_cast<HighbdIdctFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dqcoeff, c.dst16, kStride, c.bd);
+}
+
+typedef void (*HighbdIhtFn)(const tran_low_t *, uint16_t *, int, int, int);
+void RunHighbdIht(const Context &c, int n) {
+  const HighbdIhtFn fn = reinterpret_cast<HighbdIhtFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dqcoeff, c.dst16, kStride, c.tx_type, c.bd);
+}
+
+typedef void (*QuantizeFn)(const tran_low_t *, intptr_t, const int16_t *,
+                           const int16_t *, const int16_t *, const int16_t *,
+                           tran_low_t *, tran_low_t *, const int16_t *,
+                           uint16_t *, const int16_t *, const int16_t *);
+void RunQuantize(const Context &c, int n) {
+  const QuantizeFn fn = reinterpret_cast<QuantizeFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.coeff, c.w * c.h, kZbin, kRound, kQuant, kQuantShift, c.qcoeff,
+       c.dqcoeff, kDequant, &planes.eob, planes.scan, planes.scan);
+  }
+}
+
+typedef void (*QuantizeFpFn)(const tran_low_t *, intptr_t, const int16_t *,
+                             const int16_t *, tran_low_t *, tran_low_t *,
+                             const int16_t *, uint16_t *, const int16_t *,
+                             const int16_t *);
+void RunQuantizeFp(const Context &c, int n) {
+  const QuantizeFpFn fn = reinterpret_cast<QuantizeFpFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.coeff, c.w * c.h, kRound, kQuant, c.qcoeff, c.dqcoeff, kDequant,
+       &planes.eob, planes.scan, planes.scan);
+  }
+}
+
+typedef int64_t (*BlockErrorFn)(const tran_low_t *, const tran_low_t *,
+                                intptr_t, int64_t *);
+void RunBlockError(const Context &c, int n) {
+  const BlockErrorFn fn = reinterpret_cast<BlockErrorFn>(c.fn);
+  int64_t ssz;
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.coeff, c.dqcoeff, c.w * c.h, &ssz);
+}
+
+typedef int64_t (*HighbdBlockErrorFn)(const tran_low_t *, const tran_low_t *,
+                                      intptr_t, int64_t *, int);
+void RunHighbdBlockError(const Context &c, int n) {
+  const HighbdBlockErrorFn fn = reinterpret_cast<HighbdBlockErrorFn>(c.fn);
+  int64_t ssz;
+  int i;
+  for (i = 0; i < n; ++i) {
+    sink += fn(c.coeff, c.dqcoeff, c.w * c.h, &ssz, c.bd);
+  }
+}
+
+typedef int64_t (*BlockErrorFpFn)(const tran_low_t *, const tran_low_t *,
+                                  int);
+void RunBlockErrorFp(const Context &c, int n) {
+  const BlockErrorFpFn fn = reinterpret_cast<BlockErrorFpFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.coeff, c.dqcoeff, c.w * c.h);
+}
+
+typedef int (*SatdFn)(const tran_low_t *, int);
+void RunSatd(const Context &c, int n) {
+  const SatdFn fn = reinterpret_cast<SatdFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.coeff, c.w * c.h);
+}
+
+typedef void (*SubtractFn)(int, int, int16_t *, ptrdiff_t, const uint8_t *,
+                           ptrdiff_t, const uint8_t *, ptrdiff_t);
+void RunSubtract(const Context &c, int n) {
+  const SubtractFn fn = reinterpret_cast<SubtractFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.h, c.w, c.diff, c.w, c.src, kStride, c.ref, kStride);
+  }
+}
+
+typedef void (*HighbdSubtractFn)(int, int, int16_t *, ptrdiff_t,
+                                 const uint8_t *, ptrdiff_t, const uint8_t *,
+                                 ptrdiff_t, int);
+void RunHighbdSubtract(const Context &c, int n) {
+  const HighbdSubtractFn fn = reinterpret_cast<HighbdSubtractFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.h, c.w, c.diff, c.w, c.src, kStride, c.ref, kStride, c.bd);
+  }
+}
+
+typedef void (*CompAvgPredFn)(uint8_t *, const uint8_t *, int, int,
+                              const uint8_t *, int);
+void RunCompAvgPred(const Context &c, int n) {
+  const CompAvgPredFn fn = reinterpret_cast<CompAvgPredFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.pred, c.src, c.w, c.h, c.ref, kStride);
+}
+
+typedef void (*HighbdCompAvgPredFn)(uint16_t *, const uint16_t *, int, int,
+                                    const uint16_t *, int);
+void RunHighbdCompAvgPred(const Context &c, int n) {
+  const HighbdCompAvgPredFn fn = reinterpret_cast<HighbdCompAvgPredFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.pred16, c.src16, c.w, c.h, c.ref16, kStride);
+}
+
+typedef unsigned int (*GetMbSsFn)(const int16_t *);
+void RunGetMbSs(const Context &c, int n) {
+  const GetMbSsFn fn = reinterpret_cast<GetMbSsFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.diff);
+}
+
+typedef uint64_t (*SumSquaresFn)(const int16_t *, int, int);
+void RunSumSquares(const Context &c, int n) {
+  const SumSquaresFn fn = reinterpret_cast<SumSquaresFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.diff, c.w, c.w);
+}
+
+typedef void (*IntProRowFn)(int16_t[16], const uint8_t *, const int,
+                            const int);
+void RunIntProRow(const Context &c, int n) {
+  const IntProRowFn fn = reinterpret_cast<IntProRowFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.diff, c.src, kStride, c.h);
+}
+
+typedef int16_t (*IntProColFn)(const uint8_t *, const int);
+void RunIntProCol(const Context &c, int n) {
+  const IntProColFn fn = reinterpret_cast<IntProColFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) sink += fn(c.src, c.w);
+}
+
+typedef int (*VectorVarFn)(const int16_t *, const int16_t *, const int);
+void RunVectorVar(const Context &c, int n) {
+  const VectorVarFn fn = reinterpret_cast<VectorVarFn>(c.fn);
+  int i;
+  // bwl 4 compares 64 entries.
+  for (i = 0; i < n; ++i) sink += fn(c.diff, c.diff + c.w, 4);
+}
+
+typedef void (*LoopFilterFn)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                             const uint8_t *);
+void RunLoopFilter(const Context &c, int n) {
+  const LoopFilterFn fn = reinterpret_cast<LoopFilterFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dst, kStride, kBlimit, kLimit, kThresh);
+}
+
+typedef void (*LoopFilterDualFn)(uint8_t *, int, const uint8_t *,
+                                 const uint8_t *, const uint8_t *,
+                                 const uint8_t *, const uint8_t *,
+                                 const uint8_t *);
+void RunLoopFilterDual(const Context &c, int n) {
+  const LoopFilterDualFn fn = reinterpret_cast<LoopFilterDualFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.dst, kStride, kBlimit, kLimit, kThresh, kBlimit, kLimit, kThresh);
+  }
+}
+
+typedef void (*HighbdLoopFilterFn)(uint16_t *, int, const uint8_t *,
+                                   const uint8_t *, const uint8_t *, int);
+void RunHighbdLoopFilter(const Context &c, int n) {
+  const HighbdLoopFilterFn fn = reinterpret_cast<HighbdLoopFilterFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.dst16, kStride, kBlimit, kLimit, kThresh, c.bd);
+}
+
+typedef void (*HighbdLoopFilterDualFn)(uint16_t *, int, const uint8_t *,
+                                       const uint8_t *, const uint8_t *,
+                                       const uint8_t *, const uint8_t *,
+                                       const uint8_t *, int);
+void RunHighbdLoopFilterDual(const Context &c, int n) {
+  const HighbdLoopFilterDualFn fn =
+      reinterpret_cast<HighbdLoopFilterDualFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.dst16, kStride, kBlimit, kLimit, kThresh, kBlimit, kLimit, kThresh,
+       c.bd);
+  }
+}
+
+#if CONFIG_VP9
+typedef void (*ConvolveFn)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                           const InterpKernel *, int, int, int, int, int, int);
+void RunConvolve(const Context &c, int n) {
+  const ConvolveFn fn = reinterpret_cast<ConvolveFn>(c.fn);
+  const InterpKernel *const kernel = vp9_filter_kernels[EIGHTTAP];
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.src, kStride, c.dst, kStride, kernel, 5, 16, 11, 16, c.w, c.h);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+typedef void (*HighbdConvolveFn)(const uint16_t *, ptrdiff_t, uint16_t *,
+                                 ptrdiff_t, const InterpKernel *, int, int,
+                                 int, int, int, int, int);
+void RunHighbdConvolve(const Context &c, int n) {
+  const HighbdConvolveFn fn = reinterpret_cast<HighbdConvolveFn>(c.fn);
+  const InterpKernel *const kernel = vp9_filter_kernels[EIGHTTAP];
+  int i;
+  for (i = 0; i < n; ++i) {
+    fn(c.src16, kStride, c.dst16, kStride, kernel, 5, 16, 11, 16, c.w, c.h,
+       c.bd);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+#endif  // CONFIG_VP9
+
+typedef void (*Vp8PredictFn)(unsigned char *, int, int, int, unsigned char *,
+                             int);
+void RunVp8Predict(const Context &c, int n) {
+  const Vp8PredictFn fn = reinterpret_cast<Vp8PredictFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.ref, kStride, 2, 5, c.dst, kStride);
+}
+
+typedef void (*Vp8CopyFn)(unsigned char *, int, unsigned char *, int);
+void RunVp8Copy(const Context &c, int n) {
+  const Vp8CopyFn fn = reinterpret_cast<Vp8CopyFn>(c.fn);
+  int i;
+  for (i = 0; i < n; ++i) fn(c.src, kStride, c.dst, kStride);
+}
+
+typedef void (*RunFn)(const Context &c, int n);
+
+struct Runner {
+  const char *signature;
+  RunFn run;
+};
+
+const Runner kRunners[] = {
+  { "unsigned int(const uint8_t *, int, const uint8_t *, int)", RunSad },
+  { "unsigned int(const unsigned char *, int, const unsigned char *, int)",
+    RunSad },
+  { "unsigned int(const uint8_t *, int, const uint8_t *, int, "
+    "const uint8_t *)",
+    RunSadAvg },
+  { "void(const uint8_t *, int, const uint8_t *const[4], int, uint32_t[4])",
+    RunSad4D },
+  { "unsigned int(const uint8_t *, int, const uint8_t *, int, "
+    "unsigned int *)",
+    RunVariance },
+  { "void(const uint8_t *, int, const uint8_t *, int, unsigned int *, int *)",
+    RunGetVar },
+  { "uint32_t(const uint8_t *, int, int, int, const uint8_t *, int, "
+    "uint32_t *)",
+    RunSubpelVariance },
+  { "uint32_t(const uint8_t *, int, int, int, const uint8_t *, int, "
+    "uint32_t *, const uint8_t *)",
+    RunSubpelAvgVariance },
+  { "unsigned int(const uint8_t *, int)", RunAvg },
+  { "void(const uint8_t *, int, const uint8_t *, int, int *, int *)",
+    RunMinMax },
+  { "void(uint8_t *, ptrdiff_t, const uint8_t *, const uint8_t *)",
+    RunIntraPred },
+  { "void(uint16_t *, ptrdiff_t, const uint16_t *, const uint16_t *, int)",
+    RunHighbdIntraPred },
+  { "void(const int16_t *, tran_low_t *, int)", RunFdct },
+  { "void(const int16_t *, tran_low_t *, int, int)", RunFht },
+  { "void(const int16_t *, ptrdiff_t, tran_low_t *)", RunHadamard },
+  { "void(const tran_low_t *, uint8_t *, int)", RunIdct },
+  { "void(const tran_low_t *, uint8_t *, int, int)", RunIht },
+  { "void(const tran_low_t *, uint16_t *, int, int)", RunHighbdIdct },
+  { "void(const tran_low_t *, uint16_t *, int, int, int)", RunHighbdIht },
+  { "void(const tran_low_t *, intptr_t, const int16_t *, const int16_t *, "
+    "const int16_t *, const int16_t *, tran_low_t *, tran_low_t *, "
+    "const int16_t *, uint16_t *, const int16_t *, const int16_t *)",
+    RunQuantize },
+  { "void(const tran_low_t *, intptr_t, const int16_t *, const int16_t *, "
+    "tran_low_t *, tran_low_t *, const int16_t *, uint16_t *, "
+    "const int16_t *, const int16_t *)",
+    RunQuantizeFp },
+  { "int64_t(const tran_low_t *, const tran_low_t *, intptr_t, int64_t *)",
+    RunBlockError },
+  { "int64_t(const tran_low_t *, const tran_low_t *, intptr_t, int64_t *, "
+    "int)",
+    RunHighbdBlockError },
+  { "int64_t(const tran_low_t *, const tran_low_t *, int)", RunBlockErrorFp },
+  { "int(const tran_low_t *, int)", RunSatd },
+  { "void(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t, "
+    "const uint8_t *, ptrdiff_t)",
+    RunSubtract },
+  { "void(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t, "
+    "const uint8_t *, ptrdiff_t, int)",
+    RunHighbdSubtract },
+  { "void(uint8_t *, const uint8_t *, int, int, const uint8_t *, int)",
+    RunCompAvgPred },
+  { "void(uint16_t *, const uint16_t *, int, int, const uint16_t *, int)",
+    RunHighbdCompAvgPred },
+  { "unsigned int(const int16_t *)", RunGetMbSs },
+  { "uint64_t(const int16_t *, int, int)", RunSumSquares },
+  { "void(int16_t[16], const uint8_t *, const int, const int)",
+    RunIntProRow },
+  { "int16_t(const uint8_t *, const int)", RunIntProCol },
+  { "int(const int16_t *, const int16_t *, const int)", RunVectorVar },
+  { "void(uint8_t *, int, const uint8_t *, const uint8_t *, "
+    "const uint8_t *)",
+    RunLoopFilter },
+  { "void(uint8_t *, int, const uint8_t *, const uint8_t *, const uint8_t *, "
+    "const uint8_t *, const uint8_t *, const uint8_t *)",
+    RunLoopFilterDual },
+  { "void(uint16_t *, int, const uint8_t *, const uint8_t *, "
+    "const uint8_t *, int)",
+    RunHighbdLoopFilter },
+  { "void(uint16_t *, int, const uint8_t *, const uint8_t *, "
+    "const uint8_t *, const uint8_t *, const uint8_t *, const uint8_t *, "
+    "int)",
+    RunHighbdLoopFilterDual },
+#if CONFIG_VP9
+  { "void(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t, "
+    "const InterpKernel *, int, int, int, int, int, int)",
+    RunConvolve },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(const uint16_t *, ptrdiff_t, uint16_t *, ptrdiff_t, "
+    "const InterpKernel *, int, int, int, int, int, int, int)",
+    RunHighbdConvolve },
+#endif
+#endif
+  { "void(unsigned char *, int, int, int, unsigned char *, int)",
+    RunVp8Predict },
+  { "void(unsigned char *, int, unsigned char *, int)", RunVp8Copy },
+};
+
+RunFn FindRunner(const Function &f) {
+  size_t i;
+  for (i = 0; i < sizeof(kRunners) / sizeof(kRunners[0]); ++i) {
+    if (!strcmp(kRunners[i].signature, f.signature)) return kRunners[i].run;
+  }
+  return NULL;
+}
+
+// Returns the median time of one call in nanoseconds. The number of calls
+// per sample grows until a sample takes at least |sample_us|.
+double TimeImpl(RunFn run, const Context &ctx, int sample_us) {
+  struct vpx_usec_timer timer;
+  int64_t times[kSamples];
+  int calls = 1;
+  int i;
+
+  for (;;) {
+    vpx_usec_timer_start(&timer);
+    run(ctx, calls);
+    vpx_usec_timer_mark(&timer);
+    if (vpx_usec_timer_elapsed(&timer) >= sample_us || calls >= (1 << 24)) {
+      break;
+    }
+    calls *= 2;
+  }
+
+  for (i = 0; i < kSamples; ++i) {
+    vpx_usec_timer_start(&timer);
+    run(ctx, calls);
+    vpx_usec_timer_mark(&timer);
+    times[i] = vpx_usec_timer_elapsed(&timer);
+  }
+  std::sort(times, times + kSamples);
+  return times[kSamples / 2] * 1000.0 / calls;
+}
+
+void AddFunctions(std::vector<Function> *functions) {
+#define RTCD_BENCH_FUNCTION(fn, sig) \
+  {                                  \
+    Function f;                      \
+    f.name = #fn;                    \
+    f.signature = sig;               \
+    f.selected = reinterpret_cast<RtcdFn>(fn);
+#define RTCD_BENCH_IMPL(ext, impl, cpu_flag) \
+  f.impls.push_back(Impl(#ext, reinterpret_cast<RtcdFn>(impl), cpu_flag));
+#define RTCD_BENCH_END(fn)  \
+  functions->push_back(f); \
+  }
+#include "./vpx_dsp_rtcd_bench.h"
+#include "./vpx_scale_rtcd_bench.h"
+#if CONFIG_VP8
+#include "./vp8_rtcd_bench.h"
+#endif
+#if CONFIG_VP9
+#include "./vp9_rtcd_bench.h"
+#endif
+#undef RTCD_BENCH_FUNCTION
+#undef RTCD_BENCH_IMPL
+#undef RTCD_BENCH_END
+}
+
+int GetCpuFlags() {
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+  return x86_simd_caps();
+#elif VPX_ARCH_ARM
+  return arm_cpu_caps();
+#elif VPX_ARCH_MIPS
+  return mips_cpu_caps();
+#elif VPX_ARCH_PPC
+  return ppc_simd_caps();
+#elif VPX_ARCH_LOONGARCH
+  return loongarch_cpu_caps();
+#else
+  return 0;
+#endif
+}
+
+const char *SelectedExt(const Function &f) {
+  size_t i;
+  for (i = 0; i < f.impls.size(); ++i) {
+    if (f.impls[i].fn == f.selected) return f.impls[i].ext;
+  }
+  return "unknown";
+}
+
+double CTime(const Function &f) {
+  size_t i;
+  for (i = 0; i < f.impls.size(); ++i) {
+    if (!strcmp(f.impls[i].ext, "c")) return f.impls[i].ns;
+  }
+  return -1.0;
+}
+
+void PrintCsv(const std::vector<Function> &functions, int cpu_flags) {
+  size_t i, j;
+  printf("function,impl,available,selected,block,ns_per_call,speedup\n");
+  for (i = 0; i < functions.size(); ++i) {
+    const Function &f = functions[i];
+    const double c_ns = CTime(f);
+    for (j = 0; j < f.impls.size(); ++j) {
+      const Impl &impl = f.impls[j];
+      const int available = !impl.cpu_flag || (cpu_flags & impl.cpu_flag);
+      printf("%s,%s,%d,%d,", f.name, impl.ext, available,
+             impl.fn == f.selected);
+      if (impl.ns >= 0) {
+        int w, h;
+        ParseBlockSize(f.name, &w, &h);
+        printf("%dx%d,%.2f,", w, h, impl.ns);
+        if (c_ns > 0 && impl.ns > 0) printf("%.2f", c_ns / impl.ns);
+      } else {
+        printf(",,");
+      }
+      printf("\n");
+    }
+  }
+}
+
+void PrintJson(const std::vector<Function> &functions, int cpu_flags) {
+  size_t i, j;
+  printf("[\n");
+  for (i = 0; i < functions.size(); ++i) {
+    const Function &f = functions[i];
+    const double c_ns = CTime(f);
+    printf("  {\"function\": \"%s\", \"signature\": \"%s\", "
+           "\"selected\": \"%s\", \"impls\": [",
+           f.name, f.signature, SelectedExt(f));
+    for (j = 0; j < f.impls.size(); ++j) {
+      const Impl &impl = f.impls[j];
+      const int available = !impl.cpu_flag || (cpu_flags & impl.cpu_flag);
+      printf("%s{\"impl\": \"%s\", \"available\": %s", j ? ", " : "",
+             impl.ext, available ? "true" : "false");
+      if (impl.ns >= 0) {
+        printf(", \"ns_per_call\": %.2f", impl.ns);
+        if (c_ns > 0 && impl.ns > 0) {
+          printf(", \"speedup\": %.2f", c_ns / impl.ns);
+        }
+      }
+      printf("}");
+    }
+    printf("]}%s\n", i + 1 < functions.size() ? "," : "");
+  }
+  printf("]\n");
+}
+
+void Usage(const char *exec_name) {
+  fprintf(stderr,
+          "Usage: %s [--format=csv|json] [--filter=substring] [--list] "
+          "[--sample-us=N]\n"
+          "  --format     Output format (default csv)\n"
+          "  --filter     Only include functions whose name contains this\n"
+          "  --list       Report dispatch only, without timing\n"
+          "  --sample-us  Minimum duration of each timed sample (default "
+          "500)\n"
+          "Functions without a block size in their name are timed on 16x16 "
+          "blocks.\n",
+          exec_name);
+  exit(EXIT_FAILURE);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::vector<Function> all_functions, functions;
+  const char *filter = NULL;
+  int json = 0;
+  int list_only = 0;
+  int sample_us = 500;
+  int cpu_flags;
+  int c_only = 0, untimed = 0;
+  size_t i, j;
+
+  for (i = 1; i < (size_t)argc; ++i) {
+    const char *const arg = argv[i];
+    if (!strcmp(arg, "--format=csv")) {
+      json = 0;
+    } else if (!strcmp(arg, "--format=json")) {
+      json = 1;
+    } else if (!strncmp(arg, "--filter=", 9)) {
+      filter = arg + 9;
+    } else if (!strcmp(arg, "--list")) {
+      list_only = 1;
+    } else if (!strncmp(arg, "--sample-us=", 12)) {
+      sample_us = atoi(arg + 12);
+      if (sample_us <= 0) Usage(argv[0]);
+    } else {
+      Usage(argv[0]);
+    }
+  }
+
+#if CONFIG_VP8
+  vp8_rtcd();
+#endif  // CONFIG_VP8
+#if CONFIG_VP9
+  vp9_rtcd();
+#endif  // CONFIG_VP9
+  vpx_dsp_rtcd();
+  vpx_scale_rtcd();
+
+  cpu_flags = GetCpuFlags();
+  AddFunctions(&all_functions);
+  for (i = 0; i < all_functions.size(); ++i) {
+    if (!filter || strstr(all_functions[i].name, filter)) {
+      functions.push_back(all_functions[i]);
+    }
+  }
+
+  AllocPlanes();
+  for (i = 0; i < functions.size(); ++i) {
+    Function &f = functions[i];
+    const RunFn run = FindRunner(f);
+
+    if (f.selected == f.impls[0].fn && f.impls.size() > 1) ++c_only;
+    if (!run) {
+      ++untimed;
+      continue;
+    }
+    if (list_only) continue;
+
+    for (j = 0; j < f.impls.size(); ++j) {
+      Impl &impl = f.impls[j];
+      Context ctx;
+      if (impl.cpu_flag && !(cpu_flags & impl.cpu_flag)) continue;
+      SetupContext(f, &ctx);
+      ctx.fn = impl.fn;
+      impl.ns = TimeImpl(run, ctx, sample_us);
+    }
+  }
+  FreePlanes();
+
+  if (json) {
+    PrintJson(functions, cpu_flags);
+  } else {
+    PrintCsv(functions, cpu_flags);
+  }
+  fprintf(stderr,
+          "%d functions, %d with SIMD versions that dispatch to C, "
+          "%d without a timing loop.\n",
+          (int)functions.size(), c_only, untimed);
+  return EXIT_SUCCESS;
+}
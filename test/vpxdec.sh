@@ -108,6 +108,27 @@ vpxdec_vp9_webm_less_than_50_frames() {
   fi
 }
 
+# Writing and hashing frames on the output thread must not change them.
+vpxdec_vp9_webm_output_thread() {
+  if [ "$(vpxdec_can_decode_vp9)" = "yes" ] && \
+     [ "$(webm_io_available)" = "yes" ] && \
+     [ "$(vpx_config_option_enabled CONFIG_MULTITHREAD)" = "yes" ]; then
+    local decoder="$(vpx_tool_path vpxdec)"
+    for hash in md5 xxh64; do
+      local expected=$(${VPX_TEST_PREFIX} "${decoder}" "${VP9_WEBM_FILE}" \
+        --hash=${hash})
+      for fb in "" "--frame-buffers=4"; do
+        local actual=$(${VPX_TEST_PREFIX} "${decoder}" "${VP9_WEBM_FILE}" \
+          --hash=${hash} --output-thread ${fb})
+        if [ -z "${expected}" ] || [ "${actual}" != "${expected}" ]; then
+          elog "Output thread hash (${actual}) != expected (${expected})"
+          return 1
+        fi
+      done
+    done
+  fi
+}
+
 # Ensures VP9_RAW_FILE correctly produces 1 frame instead of causing a hang.
 vpxdec_vp9_raw_file() {
   # Ensure a raw file properly reports eof and doesn't cause a hang.
@@ -130,6 +151,7 @@ vpxdec_tests="vpxdec_vp8_ivf
               vpxdec_vp9_webm
               vpxdec_vp9_webm_frame_parallel
               vpxdec_vp9_webm_less_than_50_frames
+              vpxdec_vp9_webm_output_thread
               vpxdec_vp9_raw_file"
 
 run_tests vpxdec_verify_environment "${vpxdec_tests}"
@@ -428,6 +428,71 @@ vpxenc_vp9_webm_non_square_par() {
   fi
 }
 
+# Reading and writing on separate threads must not change the output.
+vpxenc_vp9_ivf_pipeline() {
+  if [ "$(vpxenc_can_encode_vp9)" = "yes" ] && \
+     [ "$(vpx_config_option_enabled CONFIG_MULTITHREAD)" = "yes" ]; then
+    local output="${VPX_TEST_OUTPUT_DIR}/vp9_pipeline.ivf"
+    local reference="${VPX_TEST_OUTPUT_DIR}/vp9_serial.ivf"
+    local passes=$(vpxenc_passes_param)
+
+    for pipeline in "" "--pipeline"; do
+      vpxenc $(yuv_input_hantro_collage) \
+        --codec=vp9 \
+        --limit="${TEST_FRAMES}" \
+        --skip=2 \
+        "${passes}" \
+        ${pipeline} \
+        --ivf \
+        --output="${output}" || return 1
+      if [ -z "${pipeline}" ]; then
+        mv "${output}" "${reference}" || return 1
+      fi
+    done
+
+    if ! cmp -s "${output}" "${reference}"; then
+      elog "--pipeline changed the output."
+      return 1
+    fi
+  fi
+}
+
+# Encoding the streams of a ladder concurrently must not change them.
+vpxenc_vp9_ivf_parallel_streams() {
+  if [ "$(vpxenc_can_encode_vp9)" = "yes" ] && \
+     [ "$(vpx_config_option_enabled CONFIG_MULTITHREAD)" = "yes" ]; then
+    local prefix="${VPX_TEST_OUTPUT_DIR}/vp9_streams"
+    local passes=$(vpxenc_passes_param)
+
+    for mode in serial parallel; do
+      local parallel=""
+      if [ "${mode}" = "parallel" ]; then
+        parallel="--parallel-streams"
+      fi
+      vpxenc $(yuv_input_hantro_collage) \
+        --codec=vp9 \
+        --limit="${TEST_FRAMES}" \
+        "${passes}" \
+        ${parallel} \
+        --ivf \
+        --threads=1 \
+        --target-bitrate=400 \
+        --output="${prefix}_${mode}_0.ivf" \
+        -- \
+        --target-bitrate=200 \
+        --output="${prefix}_${mode}_1.ivf" || return 1
+    done
+
+    for i in 0 1; do
+      if ! cmp -s "${prefix}_serial_${i}.ivf" "${prefix}_parallel_${i}.ivf"
+      then
+        elog "--parallel-streams changed stream ${i}."
+        return 1
+      fi
+    done
+  fi
+}
+
 vpxenc_vp9_webm_sharpness() {
   if [ "$(vpxenc_can_encode_vp9)" = "yes" ]; then
     local sharpnesses="0 1 2 3 4 5 6 7"
@@ -477,6 +542,8 @@ vpxenc_tests="vpxenc_vp8_ivf
               vpxenc_vp9_ivf_minq0_maxq0
               vpxenc_vp9_webm_lag10_frames20
               vpxenc_vp9_webm_non_square_par
+              vpxenc_vp9_ivf_pipeline
+              vpxenc_vp9_ivf_parallel_streams
               vpxenc_vp9_webm_sharpness"
 
 if [ "$(vpx_config_option_enabled CONFIG_REALTIME_ONLY)" != "yes" ]; then
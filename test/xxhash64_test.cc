@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "./xxhash64.h"
+
+namespace {
+
+uint64_t Hash(const void *data, size_t size, uint64_t seed) {
+  Xxh64Context ctx;
+  xxh64_init(&ctx, seed);
+  xxh64_update(&ctx, data, size);
+  return xxh64_final(&ctx);
+}
+
+uint64_t HashString(const char *str) { return Hash(str, strlen(str), 0); }
+
+TEST(Xxh64Test, KnownValues) {
+  EXPECT_EQ(0xef46db3751d8e999ULL, HashString(""));
+  EXPECT_EQ(0xd24ec4f1a98c6e5bULL, HashString("a"));
+  EXPECT_EQ(0x44bc2cf5ad770999ULL, HashString("abc"));
+  EXPECT_EQ(0xfbcea83c8a378bf1ULL,
+            HashString("Nobody inspects the spammish repetition"));
+}
+
+TEST(Xxh64Test, StreamingMatchesOneShot) {
+  uint8_t data[1000];
+  for (size_t i = 0; i < sizeof(data); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+
+  // Chunk sizes both smaller and larger than the 32 byte stripe.
+  const size_t kChunkSizes[] = { 1, 5, 13, 31, 32, 33, 100 };
+  for (size_t c = 0; c < sizeof(kChunkSizes) / sizeof(kChunkSizes[0]); ++c) {
+    for (size_t size = 0; size <= sizeof(data); size += 97) {
+      const uint64_t expected = Hash(data, size, 12345);
+      Xxh64Context ctx;
+      xxh64_init(&ctx, 12345);
+      for (size_t pos = 0; pos < size; pos += kChunkSizes[c]) {
+        const size_t remaining = size - pos;
+        xxh64_update(&ctx, data + pos,
+                     remaining < kChunkSizes[c] ? remaining : kChunkSizes[c]);
+      }
+      EXPECT_EQ(expected, xxh64_final(&ctx))
+          << "chunk " << kChunkSizes[c] << " size " << size;
+    }
+  }
+}
+
+}  // namespace
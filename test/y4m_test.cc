@@ -12,6 +12,7 @@
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
+#include "./mmapinput.h"
 #include "./vpx_config.h"
 #include "./y4menc.h"
 #include "test/md5_helper.h"
@@ -241,4 +242,73 @@ TEST(Y4MHeaderTest, LongHeader) {
   y4m_input_close(&y4m);
 }
 
+// Frames fetched from a memory-mapped file must match the ones read through
+// the FILE, both for planes used in place (420jpeg) and for planes that are
+// converted into the frame buffer (420mpeg2).
+class Y4MMmapTest : public ::testing::TestWithParam<const char *> {};
+
+TEST_P(Y4MMmapTest, MatchesFileFetch) {
+  const int kNumFrames = 3;
+  libvpx_test::TempOutFile f;
+  ASSERT_NE(f.file(), nullptr);
+  fprintf(f.file(), "YUV4MPEG2 W6 H4 F30:1 Ip A0:0 C%s\n", GetParam());
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    // 6x4 luma plus two 3x2 chroma planes.
+    fputs("FRAME\n", f.file());
+    for (int i = 0; i < 6 * 4 + 2 * 3 * 2; ++i) {
+      fputc((frame * 37 + i * 11) & 0xff, f.file());
+    }
+  }
+  fflush(f.file());
+
+  y4m_input mapped;
+  struct MmapInputContext mmap_ctx;
+  ASSERT_EQ(fseek(f.file(), 0, SEEK_SET), 0);
+  ASSERT_EQ(y4m_input_open(&mapped, f.file(), /*skip_buffer=*/nullptr,
+                           /*num_skip=*/0, /*only_420=*/0),
+            0);
+  if (mmap_input_open(&mmap_ctx, f.file())) {
+    y4m_input_close(&mapped);
+    GTEST_SKIP() << "mmap is not supported on this platform";
+  }
+  mapped.mmap = &mmap_ctx;
+
+  y4m_input plain;
+  ASSERT_EQ(fseek(f.file(), 0, SEEK_SET), 0);
+  ASSERT_EQ(y4m_input_open(&plain, f.file(), /*skip_buffer=*/nullptr,
+                           /*num_skip=*/0, /*only_420=*/0),
+            0);
+
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    vpx_image_t plain_img, mapped_img;
+    ASSERT_EQ(y4m_input_fetch_frame(&plain, f.file(), &plain_img), 1);
+    ASSERT_EQ(y4m_input_fetch_frame(&mapped, f.file(), &mapped_img), 1);
+    ASSERT_EQ(plain_img.fmt, mapped_img.fmt);
+    ASSERT_EQ(plain_img.d_w, mapped_img.d_w);
+    ASSERT_EQ(plain_img.d_h, mapped_img.d_h);
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? 3 : 6;
+      const int h = plane ? 2 : 4;
+      ASSERT_EQ(plain_img.stride[plane], mapped_img.stride[plane]);
+      for (int y = 0; y < h; ++y) {
+        const uint8_t *const plain_row =
+            plain_img.planes[plane] + y * plain_img.stride[plane];
+        const uint8_t *const mapped_row =
+            mapped_img.planes[plane] + y * mapped_img.stride[plane];
+        EXPECT_EQ(memcmp(plain_row, mapped_row, w), 0)
+            << "frame " << frame << " plane " << plane << " row " << y;
+      }
+    }
+  }
+  vpx_image_t img;
+  EXPECT_EQ(y4m_input_fetch_frame(&mapped, f.file(), &img), 0);
+
+  y4m_input_close(&plain);
+  y4m_input_close(&mapped);
+  mmap_input_close(&mmap_ctx);
+}
+
+INSTANTIATE_TEST_SUITE_P(C, Y4MMmapTest,
+                         ::testing::Values("420jpeg", "420mpeg2"));
+
 }  // namespace
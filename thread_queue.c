@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+
+#include "./thread_queue.h"
+
+#if CONFIG_MULTITHREAD
+
+int thread_queue_init(struct ThreadQueue *queue, int capacity) {
+  queue->items = (void **)calloc(capacity, sizeof(*queue->items));
+  if (!queue->items) return -1;
+  queue->capacity = capacity;
+  queue->head = 0;
+  queue->count = 0;
+  queue->closed = 0;
+  pthread_mutex_init(&queue->mutex, NULL);
+  pthread_cond_init(&queue->not_empty, NULL);
+  pthread_cond_init(&queue->not_full, NULL);
+  return 0;
+}
+
+void thread_queue_destroy(struct ThreadQueue *queue) {
+  pthread_cond_destroy(&queue->not_full);
+  pthread_cond_destroy(&queue->not_empty);
+  pthread_mutex_destroy(&queue->mutex);
+  free(queue->items);
+  queue->items = NULL;
+}
+
+int thread_queue_push(struct ThreadQueue *queue, void *item) {
+  int pushed = 0;
+  pthread_mutex_lock(&queue->mutex);
+  while (queue->count == queue->capacity && !queue->closed)
+    pthread_cond_wait(&queue->not_full, &queue->mutex);
+  if (!queue->closed) {
+    queue->items[(queue->head + queue->count) % queue->capacity] = item;
+    ++queue->count;
+    pushed = 1;
+    pthread_cond_signal(&queue->not_empty);
+  }
+  pthread_mutex_unlock(&queue->mutex);
+  return pushed;
+}
+
+int thread_queue_pop(struct ThreadQueue *queue, void **item) {
+  int popped = 0;
+  pthread_mutex_lock(&queue->mutex);
+  while (queue->count == 0 && !queue->closed)
+    pthread_cond_wait(&queue->not_empty, &queue->mutex);
+  if (queue->count > 0) {
+    *item = queue->items[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    --queue->count;
+    popped = 1;
+    pthread_cond_signal(&queue->not_full);
+  }
+  pthread_mutex_unlock(&queue->mutex);
+  return popped;
+}
+
+void thread_queue_close(struct ThreadQueue *queue) {
+  pthread_mutex_lock(&queue->mutex);
+  queue->closed = 1;
+  pthread_cond_broadcast(&queue->not_empty);
+  pthread_cond_broadcast(&queue->not_full);
+  pthread_mutex_unlock(&queue->mutex);
+}
+
+#endif  // CONFIG_MULTITHREAD
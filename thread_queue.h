@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef VPX_THREAD_QUEUE_H_
+#define VPX_THREAD_QUEUE_H_
+
+#include "./vpx_config.h"
+
+#if CONFIG_MULTITHREAD
+#include "vpx_util/vpx_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A bounded FIFO of pointers for handing work between the threads of the
+// command line tools. Producers block while the queue is full and consumers
+// block while it is empty, until the queue is closed.
+struct ThreadQueue {
+  pthread_mutex_t mutex;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  void **items;
+  int capacity;
+  int head;
+  int count;
+  int closed;
+};
+
+// Returns 0 on success.
+int thread_queue_init(struct ThreadQueue *queue, int capacity);
+
+void thread_queue_destroy(struct ThreadQueue *queue);
+
+// Appends |item|, waiting for room if necessary. Returns 0 if the queue was
+// closed, in which case |item| was not queued.
+int thread_queue_push(struct ThreadQueue *queue, void *item);
+
+// Removes the oldest item, waiting for one if necessary. Returns 0 once the
+// queue is closed and drained.
+int thread_queue_pop(struct ThreadQueue *queue, void **item);
+
+// Wakes all waiters. Later pushes fail; pops return what is left.
+void thread_queue_close(struct ThreadQueue *queue);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // CONFIG_MULTITHREAD
+#endif  // VPX_THREAD_QUEUE_H_
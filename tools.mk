@@ -10,7 +10,7 @@
 
 # List of tools to build.
 TOOLS-yes            += tiny_ssim.c
-tiny_ssim.SRCS       += vpx/vpx_integer.h y4minput.c y4minput.h \
+tiny_ssim.SRCS       += vpx/vpx_integer.h y4minput.c y4minput.h mmapinput.h \
                         vpx/vpx_codec.h vpx/src/vpx_image.c
 tiny_ssim.SRCS       += vpx_mem/vpx_mem.c vpx_mem/vpx_mem.h
 tiny_ssim.SRCS       += vpx_dsp/ssim.h vpx_scale/yv12config.h
@@ -21,6 +21,8 @@ static const char *const kIVFSignature = "DKIF";
 struct VpxVideoReaderStruct {
   VpxVideoInfo info;
   FILE *file;
+  struct MmapInputContext mmap;
+  const uint8_t *frame;
   uint8_t *buffer;
   size_t buffer_size;
   size_t frame_size;
@@ -69,11 +71,15 @@ VpxVideoReader *vpx_video_reader_open(const char *filename) {
   reader->info.time_base.numerator = mem_get_le32(header + 16);
   reader->info.time_base.denominator = mem_get_le32(header + 20);
 
+  // Fall back to reading through |file| if it cannot be mapped.
+  mmap_input_open(&reader->mmap, file);
+
   return reader;
 }
 
 void vpx_video_reader_close(VpxVideoReader *reader) {
   if (reader) {
+    mmap_input_close(&reader->mmap);
     fclose(reader->file);
     free(reader->buffer);
     free(reader);
@@ -81,15 +87,22 @@ void vpx_video_reader_close(VpxVideoReader *reader) {
 }
 
 int vpx_video_reader_read_frame(VpxVideoReader *reader) {
-  return !ivf_read_frame(reader->file, &reader->buffer, &reader->frame_size,
-                         &reader->buffer_size);
+  if (reader->mmap.data) {
+    return !ivf_read_frame_mmap(&reader->mmap, &reader->frame,
+                                &reader->frame_size);
+  }
+  if (ivf_read_frame(reader->file, &reader->buffer, &reader->frame_size,
+                     &reader->buffer_size))
+    return 0;
+  reader->frame = reader->buffer;
+  return 1;
 }
 
 const uint8_t *vpx_video_reader_get_frame(VpxVideoReader *reader,
                                           size_t *size) {
   if (size) *size = reader->frame_size;
 
-  return reader->buffer;
+  return reader->frame;
 }
 
 const VpxVideoInfo *vpx_video_reader_get_info(VpxVideoReader *reader) {
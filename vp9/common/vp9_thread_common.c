@@ -13,6 +13,7 @@
 #include "./vpx_config.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_trace.h"
 #include "vp9/common/vp9_entropymode.h"
 #include "vp9/common/vp9_thread_common.h"
 #include "vp9/common/vp9_reconinter.h"
@@ -43,8 +44,12 @@ static INLINE void sync_read(VP9LfSync *const lf_sync, int r, int c) {
     pthread_mutex_t *const mutex = &lf_sync->mutex[r - 1];
     mutex_lock(mutex);
 
-    while (c > lf_sync->cur_sb_col[r - 1] - nsync) {
-      pthread_cond_wait(&lf_sync->cond[r - 1], mutex);
+    if (c > lf_sync->cur_sb_col[r - 1] - nsync) {
+      VPX_TRACE_BEGIN_JOB("lf_sync_read", -1, r);
+      while (c > lf_sync->cur_sb_col[r - 1] - nsync) {
+        pthread_cond_wait(&lf_sync->cond[r - 1], mutex);
+      }
+      VPX_TRACE_END("lf_sync_read");
     }
     pthread_mutex_unlock(mutex);
   }
@@ -148,9 +153,11 @@ static INLINE void thread_loop_filter_rows(
 static int loop_filter_row_worker(void *arg1, void *arg2) {
   VP9LfSync *const lf_sync = (VP9LfSync *)arg1;
   LFWorkerData *const lf_data = (LFWorkerData *)arg2;
+  VPX_TRACE_BEGIN("loop_filter_row_worker");
   thread_loop_filter_rows(lf_data->frame_buffer, lf_data->cm, lf_data->planes,
                           lf_data->start, lf_data->stop, lf_data->y_only,
                           lf_sync);
+  VPX_TRACE_END("loop_filter_row_worker");
   return 1;
 }
 
@@ -413,8 +420,10 @@ static int get_next_row(VP9_COMMON *cm, VP9LfSync *lf_sync) {
 
   pthread_mutex_lock(&lf_sync->recon_done_mutex[cur_row]);
   if (lf_sync->num_tiles_done[cur_row] < tile_cols) {
+    VPX_TRACE_BEGIN_JOB("lf_recon_wait", -1, cur_row);
     pthread_cond_wait(&lf_sync->recon_done_cond[cur_row],
                       &lf_sync->recon_done_mutex[cur_row]);
+    VPX_TRACE_END("lf_recon_wait");
   }
   pthread_mutex_unlock(&lf_sync->recon_done_mutex[cur_row]);
   pthread_mutex_lock(lf_sync->lf_mutex);
@@ -21,8 +21,10 @@
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
 #include "vpx_ports/mem_ops.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/vpx_scale.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_trace.h"
 #if CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
 #include "vpx_util/vpx_debug_util.h"
 #endif  // CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
@@ -908,6 +910,13 @@ static INLINE void predict_recon_intra(MACROBLOCKD *xd, MODE_INFO *mi,
   }
 }
 
+// Marks |timer| and returns the elapsed time. Used for the decode statistics,
+// which are only gathered when the TileWorkerData / ThreadData has |stats|.
+static INLINE int64_t stats_elapsed(struct vpx_usec_timer *timer) {
+  vpx_usec_timer_mark(timer);
+  return vpx_usec_timer_elapsed(timer);
+}
+
 static void decode_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
                          int mi_col, BLOCK_SIZE bsize, int bwl, int bhl) {
   VP9_COMMON *const cm = &pbi->common;
@@ -918,6 +927,7 @@ static void decode_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
   const int y_mis = VPXMIN(bh, cm->mi_rows - mi_row);
   vpx_reader *r = &twd->bit_reader;
   MACROBLOCKD *const xd = &twd->xd;
+  struct vpx_usec_timer timer;
 
   MODE_INFO *mi = set_offsets(cm, xd, bsize, mi_row, mi_col, bw, bh, x_mis,
                               y_mis, bwl, bhl);
@@ -930,7 +940,11 @@ static void decode_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
                          "Invalid block size.");
   }
 
+  if (twd->stats != NULL) vpx_usec_timer_start(&timer);
   vp9_read_mode_info(twd, pbi, mi_row, mi_col, x_mis, y_mis);
+  if (twd->stats != NULL) {
+    twd->stats->stage_time[VP9D_STAGE_PARSE] += stats_elapsed(&timer);
+  }
 
   if (mi->skip) {
     dec_reset_skip_context(xd);
@@ -1293,6 +1307,45 @@ static void process_partition(TileWorkerData *twd, VP9Decoder *const pbi,
   }
 }
 
+// Decodes one superblock. decode_block() charges the mode info parsing to
+// VP9D_STAGE_PARSE and the rest of the superblock goes to VP9D_STAGE_RECON.
+static void decode_sb(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
+                      int mi_col) {
+  DecodeWorkerStats *const stats = twd->stats;
+  struct vpx_usec_timer timer;
+  int64_t parse_time;
+
+  if (stats == NULL) {
+    decode_partition(twd, pbi, mi_row, mi_col, BLOCK_64X64, 4);
+    return;
+  }
+
+  parse_time = stats->stage_time[VP9D_STAGE_PARSE];
+  vpx_usec_timer_start(&timer);
+  decode_partition(twd, pbi, mi_row, mi_col, BLOCK_64X64, 4);
+  stats->stage_time[VP9D_STAGE_RECON] +=
+      stats_elapsed(&timer) -
+      (stats->stage_time[VP9D_STAGE_PARSE] - parse_time);
+}
+
+// Parses or reconstructs one superblock of a row-mt frame decoded by the
+// calling thread.
+static void process_sb(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
+                       int mi_col, int parse_recon_flag,
+                       process_block_fn_t process_block) {
+  DecodeWorkerStats *const stats = twd->stats;
+  struct vpx_usec_timer timer;
+
+  if (stats != NULL) vpx_usec_timer_start(&timer);
+  process_partition(twd, pbi, mi_row, mi_col, BLOCK_64X64, 4,
+                    parse_recon_flag, process_block);
+  if (stats != NULL) {
+    stats->stage_time[parse_recon_flag == PARSE ? VP9D_STAGE_PARSE
+                                                : VP9D_STAGE_RECON] +=
+        stats_elapsed(&timer);
+  }
+}
+
 static void setup_token_decoder(const uint8_t *data, const uint8_t *data_end,
                                 size_t read_size,
                                 struct vpx_internal_error_info *error_info,
@@ -1711,20 +1764,28 @@ static void map_write(RowMTWorkerData *const row_mt_worker_data, int map_idx,
 }
 
 static void map_read(RowMTWorkerData *const row_mt_worker_data, int map_idx,
-                     int sync_idx) {
+                     int sync_idx, DecodeWorkerStats *stats) {
 #if CONFIG_MULTITHREAD
   volatile int8_t *map = row_mt_worker_data->recon_map + map_idx;
   pthread_mutex_t *const mutex =
       &row_mt_worker_data->recon_sync_mutex[sync_idx];
   pthread_mutex_lock(mutex);
-  while (!(*map)) {
-    pthread_cond_wait(&row_mt_worker_data->recon_sync_cond[sync_idx], mutex);
+  if (!(*map)) {
+    struct vpx_usec_timer timer;
+    VPX_TRACE_BEGIN("recon_map_read");
+    if (stats != NULL) vpx_usec_timer_start(&timer);
+    while (!(*map)) {
+      pthread_cond_wait(&row_mt_worker_data->recon_sync_cond[sync_idx], mutex);
+    }
+    if (stats != NULL) stats->wait_time += stats_elapsed(&timer);
+    VPX_TRACE_END("recon_map_read");
   }
   pthread_mutex_unlock(mutex);
 #else
   (void)row_mt_worker_data;
   (void)map_idx;
   (void)sync_idx;
+  (void)stats;
 #endif  // CONFIG_MULTITHREAD
 }
 
@@ -1806,7 +1867,7 @@ static void recon_tile_row(TileWorkerData *tile_data, VP9Decoder *pbi,
     // Top Dependency
     if (cur_sb_row) {
       map_read(row_mt_worker_data, ((cur_sb_row - 1) * sb_cols) + c,
-               ((cur_sb_row - 1) * tile_cols) + cur_tile_col);
+               ((cur_sb_row - 1) * tile_cols) + cur_tile_col, tile_data->stats);
     }
 
     for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
@@ -1890,6 +1951,21 @@ static void parse_tile_row(TileWorkerData *tile_data, VP9Decoder *pbi,
   }
 }
 
+// Blocking vp9_jobq_dequeue(); the time spent in it is counted as waiting.
+static int dequeue_job(RowMTWorkerData *const row_mt_worker_data, Job *job,
+                       DecodeWorkerStats *stats) {
+  struct vpx_usec_timer timer;
+  int ret;
+
+  if (stats == NULL)
+    return vp9_jobq_dequeue(&row_mt_worker_data->jobq, job, sizeof(*job), 1);
+
+  vpx_usec_timer_start(&timer);
+  ret = vp9_jobq_dequeue(&row_mt_worker_data->jobq, job, sizeof(*job), 1);
+  stats->wait_time += stats_elapsed(&timer);
+  return ret;
+}
+
 static int row_decode_worker_hook(void *arg1, void *arg2) {
   ThreadData *const thread_data = (ThreadData *)arg1;
   uint8_t **data_end = (uint8_t **)arg2;
@@ -1903,10 +1979,13 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
   Job job;
   LFWorkerData *lf_data = thread_data->lf_data;
   VP9LfSync *lf_sync = thread_data->lf_sync;
+  DecodeWorkerStats *const stats = thread_data->stats;
+  struct vpx_usec_timer timer;
   volatile int corrupted = 0;
   TileWorkerData *volatile tile_data_recon = NULL;
 
-  while (!vp9_jobq_dequeue(&row_mt_worker_data->jobq, &job, sizeof(job), 1)) {
+  VPX_TRACE_BEGIN("row_decode_worker_hook");
+  while (!dequeue_job(row_mt_worker_data, &job, stats)) {
     int mi_col;
     const int mi_row = job.row_num;
 
@@ -1916,7 +1995,13 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
 
       if (cm->lf.filter_level && !cm->skip_loop_filter &&
           mi_row < cm->mi_rows) {
+        VPX_TRACE_BEGIN_JOB("lpf_row", -1, mi_row >> MI_BLOCK_SIZE_LOG2);
+        if (stats != NULL) vpx_usec_timer_start(&timer);
         vp9_loopfilter_job(lf_data, lf_sync);
+        if (stats != NULL) {
+          stats->stage_time[VP9D_STAGE_LOOP_FILTER] += stats_elapsed(&timer);
+        }
+        VPX_TRACE_END("lpf_row");
       }
     } else if (job.job_type == RECON_JOB) {
       const int cur_sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
@@ -1932,8 +2017,10 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
       mi_col_start = tile_data_recon->xd.tile.mi_col_start;
       mi_col_end = tile_data_recon->xd.tile.mi_col_end;
 
+      VPX_TRACE_BEGIN_JOB("recon_row", job.tile_col, cur_sb_row);
       if (setjmp(tile_data_recon->error_info.jmp)) {
         const int sb_cols = aligned_cols >> MI_BLOCK_SIZE_LOG2;
+        VPX_TRACE_END("recon_row");
         tile_data_recon->error_info.setjmp = 0;
         corrupted = 1;
         for (mi_col = mi_col_start; mi_col < mi_col_end;
@@ -1950,14 +2037,26 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
 
       tile_data_recon->error_info.setjmp = 1;
       tile_data_recon->xd.error_info = &tile_data_recon->error_info;
+      tile_data_recon->stats = stats;
 
-      recon_tile_row(tile_data_recon, pbi, mi_row, is_last_row, lf_sync,
-                     job.tile_col);
+      if (stats == NULL) {
+        recon_tile_row(tile_data_recon, pbi, mi_row, is_last_row, lf_sync,
+                       job.tile_col);
+      } else {
+        // Time blocked on the row above is reported as waiting.
+        const int64_t wait_time = stats->wait_time;
+        vpx_usec_timer_start(&timer);
+        recon_tile_row(tile_data_recon, pbi, mi_row, is_last_row, lf_sync,
+                       job.tile_col);
+        stats->stage_time[VP9D_STAGE_RECON] +=
+            stats_elapsed(&timer) - (stats->wait_time - wait_time);
+      }
 
       if (corrupted)
         vpx_internal_error(&tile_data_recon->error_info,
                            VPX_CODEC_CORRUPT_FRAME,
                            "Failed to decode tile data");
+      VPX_TRACE_END("recon_row");
 
       if (is_last_row) {
         vp9_tile_done(pbi);
@@ -1965,7 +2064,10 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
     } else if (job.job_type == PARSE_JOB) {
       TileWorkerData *const tile_data = &pbi->tile_worker_data[job.tile_col];
 
+      VPX_TRACE_BEGIN_JOB("parse_row", job.tile_col,
+                          mi_row >> MI_BLOCK_SIZE_LOG2);
       if (setjmp(tile_data->error_info.jmp)) {
+        VPX_TRACE_END("parse_row");
         tile_data->error_info.setjmp = 0;
         corrupted = 1;
         vp9_tile_done(pbi);
@@ -1977,13 +2079,19 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
           cm->frame_parallel_decoding_mode ? 0 : &tile_data->counts;
 
       tile_data->error_info.setjmp = 1;
+      tile_data->stats = stats;
 
+      if (stats != NULL) vpx_usec_timer_start(&timer);
       parse_tile_row(tile_data, pbi, mi_row, job.tile_col, data_end);
+      if (stats != NULL) {
+        stats->stage_time[VP9D_STAGE_PARSE] += stats_elapsed(&timer);
+      }
 
       corrupted |= tile_data->xd.corrupted;
       if (corrupted)
         vpx_internal_error(&tile_data->error_info, VPX_CODEC_CORRUPT_FRAME,
                            "Failed to decode tile data");
+      VPX_TRACE_END("parse_row");
 
       /* Queue in the recon_job for this row */
       {
@@ -2008,9 +2116,42 @@ static int row_decode_worker_hook(void *arg1, void *arg2) {
   }
 
   vpx_free(tile_data_recon);
+  VPX_TRACE_END("row_decode_worker_hook");
   return !corrupted;
 }
 
+// vp9_loop_filter_worker() for decode_tiles(), |arg2| holds the decode
+// statistics of the thread running the loop filter.
+static int loop_filter_worker_hook(void *arg1, void *arg2) {
+  DecodeWorkerStats *const stats = (DecodeWorkerStats *)arg2;
+  struct vpx_usec_timer timer;
+  int ret;
+
+  VPX_TRACE_BEGIN("loop_filter_worker_hook");
+  if (stats != NULL) vpx_usec_timer_start(&timer);
+  ret = vp9_loop_filter_worker(arg1, NULL);
+  if (stats != NULL) {
+    stats->stage_time[VP9D_STAGE_LOOP_FILTER] += stats_elapsed(&timer);
+  }
+  VPX_TRACE_END("loop_filter_worker_hook");
+  return ret;
+}
+
+// winterface->sync() on the loop filter worker, counted as waiting for the
+// calling thread.
+static void sync_lf_worker(VP9Decoder *pbi, DecodeWorkerStats *stats) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  struct vpx_usec_timer timer;
+
+  if (stats == NULL) {
+    winterface->sync(&pbi->lf_worker);
+    return;
+  }
+  vpx_usec_timer_start(&timer);
+  winterface->sync(&pbi->lf_worker);
+  stats->wait_time += stats_elapsed(&timer);
+}
+
 static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end) {
   VP9_COMMON *const cm = &pbi->common;
@@ -2022,12 +2163,14 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   int tile_row, tile_col;
   int mi_row, mi_col;
   TileWorkerData *tile_data = NULL;
+  DecodeWorkerStats *const stats =
+      pbi->decode_stats_enabled ? &pbi->worker_stats[0] : NULL;
 
   if (cm->lf.filter_level && !cm->skip_loop_filter &&
       pbi->lf_worker.data1 == NULL) {
     CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
                     vpx_memalign(32, sizeof(LFWorkerData)));
-    pbi->lf_worker.hook = vp9_loop_filter_worker;
+    pbi->lf_worker.hook = loop_filter_worker_hook;
     if (pbi->max_threads > 1 && !winterface->reset(&pbi->lf_worker)) {
       vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
                          "Loop filter thread creation failed");
@@ -2040,6 +2183,12 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
     winterface->sync(&pbi->lf_worker);
     vp9_loop_filter_data_reset(lf_data, get_frame_new_buffer(cm), cm,
                                pbi->mb.plane);
+    // A threaded loop filter is reported as a second worker.
+    pbi->lf_worker.data2 =
+        stats != NULL ? &pbi->worker_stats[pbi->max_threads > 1] : NULL;
+    if (stats != NULL && pbi->max_threads > 1) {
+      pbi->decode_stats.num_workers = 2;
+    }
   }
 
   assert(tile_rows <= 4);
@@ -2066,6 +2215,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
       tile_data->xd.corrupted = 0;
       tile_data->xd.counts =
           cm->frame_parallel_decoding_mode ? NULL : &cm->counts;
+      tile_data->stats = stats;
       vp9_zero(tile_data->dqcoeff);
       vp9_tile_init(&tile_data->xd.tile, cm, tile_row, tile_col);
       setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
@@ -2098,8 +2248,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                   row_mt_worker_data->dqcoeff[plane];
             }
             tile_data->xd.partition = row_mt_worker_data->partition;
-            process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
-                              PARSE, parse_block);
+            process_sb(tile_data, pbi, mi_row, mi_col, PARSE, parse_block);
 
             for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
               tile_data->xd.plane[plane].eob = row_mt_worker_data->eob[plane];
@@ -2107,10 +2256,9 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                   row_mt_worker_data->dqcoeff[plane];
             }
             tile_data->xd.partition = row_mt_worker_data->partition;
-            process_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4,
-                              RECON, recon_block);
+            process_sb(tile_data, pbi, mi_row, mi_col, RECON, recon_block);
           } else {
-            decode_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4);
+            decode_sb(tile_data, pbi, mi_row, mi_col);
           }
         }
         pbi->mb.corrupted |= tile_data->xd.corrupted;
@@ -2129,7 +2277,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         // decoding has completed: finish up the loop filter in this thread.
         if (mi_row + MI_BLOCK_SIZE >= cm->mi_rows) continue;
 
-        winterface->sync(&pbi->lf_worker);
+        sync_lf_worker(pbi, stats);
         lf_data->start = lf_start;
         lf_data->stop = mi_row;
         if (pbi->max_threads > 1) {
@@ -2144,9 +2292,11 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   // Loopfilter remaining rows in the frame.
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
+    sync_lf_worker(pbi, stats);
     lf_data->start = lf_data->stop;
     lf_data->stop = cm->mi_rows;
+    // The tail of the frame is filtered by the calling thread.
+    pbi->lf_worker.data2 = stats;
     winterface->execute(&pbi->lf_worker);
   }
 
@@ -2195,6 +2345,7 @@ static int tile_worker_hook(void *arg1, void *arg2) {
   tile_data->error_info.setjmp = 1;
 
   if (setjmp(tile_data->error_info.jmp)) {
+    VPX_TRACE_END("decode_tile");
     tile_data->error_info.setjmp = 0;
     tile_data->xd.corrupted = 1;
     tile_data->data_end = NULL;
@@ -2218,6 +2369,7 @@ static int tile_worker_hook(void *arg1, void *arg2) {
      */
     assert(cm->log2_tile_rows == 0);
     mi_row = 0;
+    VPX_TRACE_BEGIN_JOB("decode_tile", buf->col, -1);
     vp9_zero(tile_data->dqcoeff);
     vp9_tile_init(tile, &pbi->common, 0, buf->col);
     setup_token_decoder(buf->data, tile_data->data_end, buf->size,
@@ -2233,7 +2385,7 @@ static int tile_worker_hook(void *arg1, void *arg2) {
       vp9_zero(tile_data->xd.left_seg_context);
       for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
            mi_col += MI_BLOCK_SIZE) {
-        decode_partition(tile_data, pbi, mi_row, mi_col, BLOCK_64X64, 4);
+        decode_sb(tile_data, pbi, mi_row, mi_col);
       }
       if (pbi->lpf_mt_opt && cm->lf.filter_level && !cm->skip_loop_filter) {
         const int aligned_rows = mi_cols_aligned_to_sb(cm->mi_rows);
@@ -2248,6 +2400,7 @@ static int tile_worker_hook(void *arg1, void *arg2) {
     if (buf->col == final_col) {
       bit_reader_end = vpx_reader_find_end(&tile_data->bit_reader);
     }
+    VPX_TRACE_END("decode_tile");
   } while (!tile_data->xd.corrupted && ++n <= tile_data->buf_end);
 
   if (pbi->lpf_mt_opt && n < tile_data->buf_end && cm->lf.filter_level &&
@@ -2262,7 +2415,13 @@ static int tile_worker_hook(void *arg1, void *arg2) {
 
   if (pbi->lpf_mt_opt && !tile_data->xd.corrupted && cm->lf.filter_level &&
       !cm->skip_loop_filter) {
+    DecodeWorkerStats *const stats = tile_data->stats;
+    struct vpx_usec_timer timer;
+    if (stats != NULL) vpx_usec_timer_start(&timer);
     vp9_loopfilter_rows(lf_data, lf_sync);
+    if (stats != NULL) {
+      stats->stage_time[VP9D_STAGE_LOOP_FILTER] += stats_elapsed(&timer);
+    }
   }
 
   tile_data->data_end = bit_reader_end;
@@ -2276,6 +2435,21 @@ static int compare_tile_buffers(const void *a, const void *b) {
   return (buf_a->size < buf_b->size) - (buf_a->size > buf_b->size);
 }
 
+// Returns the decode statistics of worker |n|, or NULL if they are disabled.
+static DecodeWorkerStats *get_worker_stats(VP9Decoder *pbi, int n) {
+  if (!pbi->decode_stats_enabled || n >= VPX_DECODE_STATS_MAX_WORKERS)
+    return NULL;
+  return &pbi->worker_stats[n];
+}
+
+// The calling thread runs the last worker and then waits for the others to
+// finish; that time is counted as its waiting time.
+static void add_join_wait(VP9Decoder *pbi, int num_workers,
+                          struct vpx_usec_timer *timer) {
+  DecodeWorkerStats *const stats = get_worker_stats(pbi, num_workers - 1);
+  if (stats != NULL) stats->wait_time += stats_elapsed(timer);
+}
+
 static INLINE void init_mt(VP9Decoder *pbi) {
   int n;
   VP9_COMMON *const cm = &pbi->common;
@@ -2333,6 +2507,7 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
   const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
   VP9LfSync *lf_row_sync = &pbi->lf_row_sync;
   YV12_BUFFER_CONFIG *const new_fb = get_frame_new_buffer(cm);
+  struct vpx_usec_timer join_timer;
 
   assert(tile_cols <= (1 << 6));
   assert(tile_rows == 1);
@@ -2357,6 +2532,7 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     }
 
     thread_data->pbi = pbi;
+    thread_data->stats = get_worker_stats(pbi, n);
 
     worker->hook = row_decode_worker_hook;
     worker->data1 = thread_data;
@@ -2406,6 +2582,10 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     }
   }
 
+  if (pbi->decode_stats_enabled) {
+    pbi->decode_stats.num_workers = num_workers;
+    vpx_usec_timer_start(&join_timer);
+  }
   for (; n > 0; --n) {
     VPxWorker *const worker = &pbi->tile_workers[n - 1];
     // TODO(jzern): The tile may have specific error data associated with
@@ -2414,6 +2594,7 @@ static const uint8_t *decode_tiles_row_wise_mt(VP9Decoder *pbi,
     // detected, there's no point in continuing to decode tiles.
     corrupted |= !winterface->sync(worker);
   }
+  add_join_wait(pbi, num_workers, &join_timer);
 
   pbi->mb.corrupted = corrupted;
 
@@ -2444,6 +2625,7 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
   const int num_workers = VPXMIN(pbi->max_threads, tile_cols);
+  struct vpx_usec_timer join_timer;
   int n;
 
   assert(tile_cols <= (1 << 6));
@@ -2469,6 +2651,7 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
     tile_data->xd = pbi->mb;
     tile_data->xd.counts =
         cm->frame_parallel_decoding_mode ? NULL : &tile_data->counts;
+    tile_data->stats = get_worker_stats(pbi, n);
     worker->hook = tile_worker_hook;
     worker->data1 = tile_data;
     worker->data2 = pbi;
@@ -2539,6 +2722,10 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
       }
     }
 
+    if (pbi->decode_stats_enabled) {
+      pbi->decode_stats.num_workers = num_workers;
+      vpx_usec_timer_start(&join_timer);
+    }
     for (; n > 0; --n) {
       VPxWorker *const worker = &pbi->tile_workers[n - 1];
       TileWorkerData *const tile_data = (TileWorkerData *)worker->data1;
@@ -2549,6 +2736,7 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi, const uint8_t *data,
       pbi->mb.corrupted |= !winterface->sync(worker);
       if (!bit_reader_end) bit_reader_end = tile_data->data_end;
     }
+    add_join_wait(pbi, num_workers, &join_timer);
   }
 
   // Accumulate thread frame counts.
@@ -2951,11 +3139,17 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   struct vpx_read_bit_buffer rb;
   int context_updated = 0;
   uint8_t clear_data[MAX_VP9_HEADER_SIZE];
-  const size_t first_partition_size = read_uncompressed_header(
+  struct vpx_usec_timer timer;
+  size_t first_partition_size;
+  int tile_rows, tile_cols;
+  YV12_BUFFER_CONFIG *new_fb;
+
+  if (pbi->decode_stats_enabled) vpx_usec_timer_start(&timer);
+  first_partition_size = read_uncompressed_header(
       pbi, init_read_bit_buffer(pbi, &rb, data, data_end, clear_data));
-  const int tile_rows = 1 << cm->log2_tile_rows;
-  const int tile_cols = 1 << cm->log2_tile_cols;
-  YV12_BUFFER_CONFIG *const new_fb = get_frame_new_buffer(cm);
+  tile_rows = 1 << cm->log2_tile_rows;
+  tile_cols = 1 << cm->log2_tile_cols;
+  new_fb = get_frame_new_buffer(cm);
 #if CONFIG_BITSTREAM_DEBUG || CONFIG_MISMATCH_DEBUG
   bitstream_queue_set_frame_read(cm->current_video_frame * 2 + cm->show_frame);
 #endif
@@ -2967,6 +3161,9 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
   if (!first_partition_size) {
     // showing a frame directly
     *p_data_end = data + (cm->profile <= PROFILE_2 ? 1 : 2);
+    if (pbi->decode_stats_enabled) {
+      pbi->decode_stats.stage_us[VP9D_STAGE_HEADER] += stats_elapsed(&timer);
+    }
     return;
   }
 
@@ -3010,6 +3207,10 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
     pbi->total_tiles = tile_rows * tile_cols;
   }
 
+  if (pbi->decode_stats_enabled) {
+    pbi->decode_stats.stage_us[VP9D_STAGE_HEADER] += stats_elapsed(&timer);
+  }
+
   if (pbi->max_threads > 1 && tile_rows == 1 &&
       (tile_cols > 1 || pbi->row_mt == 1)) {
     if (pbi->row_mt == 1) {
@@ -3023,9 +3224,14 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
           if (!cm->skip_loop_filter) {
             // If multiple threads are used to decode tiles, then we use those
             // threads to do parallel loopfiltering.
+            if (pbi->decode_stats_enabled) vpx_usec_timer_start(&timer);
             vp9_loop_filter_frame_mt(
                 new_fb, cm, pbi->mb.plane, cm->lf.filter_level, 0, 0,
                 pbi->tile_workers, pbi->num_tile_workers, &pbi->lf_row_sync);
+            if (pbi->decode_stats_enabled) {
+              pbi->decode_stats.stage_us[VP9D_STAGE_LOOP_FILTER] +=
+                  stats_elapsed(&timer);
+            }
           }
         } else {
           vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
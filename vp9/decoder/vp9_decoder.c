@@ -404,6 +404,22 @@ static void release_fb_on_decoder_exit(VP9Decoder *pbi) {
   }
 }
 
+// Folds the per-thread decode statistics into pbi->decode_stats.
+static void accumulate_decode_stats(VP9Decoder *pbi) {
+  vpx_decode_stats_t *const stats = &pbi->decode_stats;
+  int i, j;
+
+  stats->num_workers = VPXMIN(stats->num_workers, VPX_DECODE_STATS_MAX_WORKERS);
+  for (i = 0; i < stats->num_workers; ++i) {
+    const DecodeWorkerStats *const worker = &pbi->worker_stats[i];
+    for (j = 0; j < VP9D_STAGE_COUNT; ++j) {
+      stats->stage_us[j] += worker->stage_time[j];
+      stats->worker_busy_us[i] += worker->stage_time[j];
+    }
+    stats->worker_wait_us[i] = worker->wait_time;
+  }
+}
+
 int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
                                 const uint8_t **psource) {
   VP9_COMMON *volatile const cm = &pbi->common;
@@ -455,6 +471,12 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
   pbi->hold_ref_buf = 0;
   pbi->cur_buf = &frame_bufs[cm->new_fb_idx];
 
+  if (pbi->decode_stats_enabled) {
+    vp9_zero(pbi->decode_stats);
+    vp9_zero(pbi->worker_stats);
+    pbi->decode_stats.num_workers = 1;
+  }
+
   if (setjmp(cm->error.jmp)) {
     cm->error.setjmp = 0;
     pbi->ready_for_new_data = 1;
@@ -467,6 +489,7 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   cm->error.setjmp = 1;
   vp9_decode_frame(pbi, source, source + size, psource);
+  if (pbi->decode_stats_enabled) accumulate_decode_stats(pbi);
 
   swap_frame_buffers(pbi);
 
@@ -510,7 +533,14 @@ int vp9_get_raw_frame(VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
 
 #if CONFIG_VP9_POSTPROC
   if (!cm->show_existing_frame) {
+    struct vpx_usec_timer timer;
+    if (pbi->decode_stats_enabled) vpx_usec_timer_start(&timer);
     ret = vp9_post_proc_frame(cm, sd, flags, cm->width);
+    if (pbi->decode_stats_enabled) {
+      vpx_usec_timer_mark(&timer);
+      pbi->decode_stats.stage_us[VP9D_STAGE_POSTPROC] +=
+          vpx_usec_timer_elapsed(&timer);
+    }
   } else {
     *sd = *cm->frame_to_show;
     ret = 0;
@@ -13,6 +13,7 @@
 
 #include "./vpx_config.h"
 
+#include "vpx/vp8dx.h"
 #include "vpx/vpx_codec.h"
 #include "vpx_dsp/bitreader.h"
 #include "vpx_scale/yv12config.h"
@@ -33,10 +34,17 @@ extern "C" {
 
 typedef enum JobType { PARSE_JOB, RECON_JOB, LPF_JOB } JobType;
 
+// Per-thread accumulators behind VP9D_GET_DECODE_STATS, in microseconds.
+typedef struct DecodeWorkerStats {
+  int64_t stage_time[VP9D_STAGE_COUNT];
+  int64_t wait_time;
+} DecodeWorkerStats;
+
 typedef struct ThreadData {
   struct VP9Decoder *pbi;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  DecodeWorkerStats *stats;  // NULL unless decode statistics are enabled.
 } ThreadData;
 
 typedef struct TileBuffer {
@@ -52,6 +60,7 @@ typedef struct TileWorkerData {
   FRAME_COUNTS counts;
   LFWorkerData *lf_data;
   VP9LfSync *lf_sync;
+  DecodeWorkerStats *stats;  // NULL unless decode statistics are enabled.
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
   /* dqcoeff are shared by all the planes. So planes must be decoded serially */
   DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
@@ -124,6 +133,10 @@ typedef struct VP9Decoder {
   int row_mt;
   int lpf_mt_opt;
   RowMTWorkerData *row_mt_worker_data;
+
+  int decode_stats_enabled;
+  vpx_decode_stats_t decode_stats;
+  DecodeWorkerStats worker_stats[VPX_DECODE_STATS_MAX_WORKERS];
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi, size_t size,
@@ -541,6 +541,53 @@ static void build_tree_distribution(VP9_COMP *cpi, TX_SIZE tx_size,
   }
 }
 
+// Searches the update of each probability of the first nodes of the
+// coefficient trees of |tx_size|. Replaces the probabilities of
+// |new_coef_probs| by the ones to send, or by the current ones if they are not
+// updated, and returns the savings of the updates, net of the cost of flagging
+// every probability. The search only depends on the counts and on the current
+// probabilities of |tx_size|, so it is done before any of the updates are
+// written.
+static int64_t search_coef_prob_updates(const VP9_COMP *cpi, TX_SIZE tx_size,
+                                        vp9_coeff_stats *frame_branch_ct,
+                                        vp9_coeff_probs_model *new_coef_probs,
+                                        int *num_updates) {
+  vp9_coeff_probs_model *old_coef_probs = cpi->common.fc->coef_probs[tx_size];
+  const vpx_prob upd = DIFF_UPDATE_PROB;
+  const int stepsize = cpi->sf.coeff_prob_appx_step;
+  int64_t savings = 0;
+  int i, j, k, l, t;
+
+  *num_updates = 0;
+  for (i = 0; i < PLANE_TYPES; ++i) {
+    for (j = 0; j < REF_TYPES; ++j) {
+      for (k = 0; k < COEF_BANDS; ++k) {
+        for (l = 0; l < BAND_COEFF_CONTEXTS(k); ++l) {
+          for (t = 0; t < UNCONSTRAINED_NODES; ++t) {
+            vpx_prob *const newp = &new_coef_probs[i][j][k][l][t];
+            const vpx_prob oldp = old_coef_probs[i][j][k][l][t];
+            int64_t s;
+            if (t == PIVOT_NODE)
+              s = vp9_prob_diff_update_savings_search_model(
+                  frame_branch_ct[i][j][k][l][0], oldp, newp, upd, stepsize);
+            else
+              s = vp9_prob_diff_update_savings_search(
+                  frame_branch_ct[i][j][k][l][t], oldp, newp, upd);
+            if (s > 0 && *newp != oldp) {
+              savings += s - (int)(vp9_cost_zero(upd));
+              ++*num_updates;
+            } else {
+              savings -= (int)(vp9_cost_zero(upd));
+              *newp = oldp;
+            }
+          }
+        }
+      }
+    }
+  }
+  return savings;
+}
+
 static void update_coef_probs_common(vpx_writer *const bc, VP9_COMP *cpi,
                                      TX_SIZE tx_size,
                                      vp9_coeff_stats *frame_branch_ct,
@@ -549,44 +596,14 @@ static void update_coef_probs_common(vpx_writer *const bc, VP9_COMP *cpi,
   const vpx_prob upd = DIFF_UPDATE_PROB;
   const int entropy_nodes_update = UNCONSTRAINED_NODES;
   int i, j, k, l, t;
-  int stepsize = cpi->sf.coeff_prob_appx_step;
+  int num_updates;
+  const int64_t savings = search_coef_prob_updates(
+      cpi, tx_size, frame_branch_ct, new_coef_probs, &num_updates);
 
   switch (cpi->sf.use_fast_coef_updates) {
     case TWO_LOOP: {
-      /* dry run to see if there is any update at all needed */
-      int64_t savings = 0;
-      int update[2] = { 0, 0 };
-      for (i = 0; i < PLANE_TYPES; ++i) {
-        for (j = 0; j < REF_TYPES; ++j) {
-          for (k = 0; k < COEF_BANDS; ++k) {
-            for (l = 0; l < BAND_COEFF_CONTEXTS(k); ++l) {
-              for (t = 0; t < entropy_nodes_update; ++t) {
-                vpx_prob newp = new_coef_probs[i][j][k][l][t];
-                const vpx_prob oldp = old_coef_probs[i][j][k][l][t];
-                int64_t s;
-                int u = 0;
-                if (t == PIVOT_NODE)
-                  s = vp9_prob_diff_update_savings_search_model(
-                      frame_branch_ct[i][j][k][l][0], oldp, &newp, upd,
-                      stepsize);
-                else
-                  s = vp9_prob_diff_update_savings_search(
-                      frame_branch_ct[i][j][k][l][t], oldp, &newp, upd);
-                if (s > 0 && newp != oldp) u = 1;
-                if (u)
-                  savings += s - (int)(vp9_cost_zero(upd));
-                else
-                  savings -= (int)(vp9_cost_zero(upd));
-                update[u]++;
-              }
-            }
-          }
-        }
-      }
-
-      // printf("Update %d %d, savings %d\n", update[0], update[1], savings);
       /* Is coef updated at all */
-      if (update[1] == 0 || savings < 0) {
+      if (num_updates == 0 || savings < 0) {
         vpx_write_bit(bc, 0);
         return;
       }
@@ -595,21 +612,10 @@ static void update_coef_probs_common(vpx_writer *const bc, VP9_COMP *cpi,
         for (j = 0; j < REF_TYPES; ++j) {
           for (k = 0; k < COEF_BANDS; ++k) {
             for (l = 0; l < BAND_COEFF_CONTEXTS(k); ++l) {
-              // calc probs and branch cts for this frame only
               for (t = 0; t < entropy_nodes_update; ++t) {
-                vpx_prob newp = new_coef_probs[i][j][k][l][t];
+                const vpx_prob newp = new_coef_probs[i][j][k][l][t];
                 vpx_prob *oldp = old_coef_probs[i][j][k][l] + t;
-                const vpx_prob upd = DIFF_UPDATE_PROB;
-                int64_t s;
-                int u = 0;
-                if (t == PIVOT_NODE)
-                  s = vp9_prob_diff_update_savings_search_model(
-                      frame_branch_ct[i][j][k][l][0], *oldp, &newp, upd,
-                      stepsize);
-                else
-                  s = vp9_prob_diff_update_savings_search(
-                      frame_branch_ct[i][j][k][l][t], *oldp, &newp, upd);
-                if (s > 0 && newp != *oldp) u = 1;
+                const int u = newp != *oldp;
                 vpx_write(bc, u, upd);
                 if (u) {
                   /* send/use new probability */
@@ -628,27 +634,19 @@ static void update_coef_probs_common(vpx_writer *const bc, VP9_COMP *cpi,
       int updates = 0;
       int noupdates_before_first = 0;
       assert(cpi->sf.use_fast_coef_updates == ONE_LOOP_REDUCED);
+      if (num_updates == 0) {
+        vpx_write_bit(bc, 0);  // no updates
+        return;
+      }
       for (i = 0; i < PLANE_TYPES; ++i) {
         for (j = 0; j < REF_TYPES; ++j) {
           for (k = 0; k < COEF_BANDS; ++k) {
             for (l = 0; l < BAND_COEFF_CONTEXTS(k); ++l) {
-              // calc probs and branch cts for this frame only
               for (t = 0; t < entropy_nodes_update; ++t) {
-                vpx_prob newp = new_coef_probs[i][j][k][l][t];
+                const vpx_prob newp = new_coef_probs[i][j][k][l][t];
                 vpx_prob *oldp = old_coef_probs[i][j][k][l] + t;
-                int64_t s;
-                int u = 0;
-
-                if (t == PIVOT_NODE) {
-                  s = vp9_prob_diff_update_savings_search_model(
-                      frame_branch_ct[i][j][k][l][0], *oldp, &newp, upd,
-                      stepsize);
-                } else {
-                  s = vp9_prob_diff_update_savings_search(
-                      frame_branch_ct[i][j][k][l][t], *oldp, &newp, upd);
-                }
+                const int u = newp != *oldp;
 
-                if (s > 0 && newp != *oldp) u = 1;
                 updates += u;
                 if (u == 0 && updates == 0) {
                   noupdates_before_first++;
@@ -672,9 +670,6 @@ static void update_coef_probs_common(vpx_writer *const bc, VP9_COMP *cpi,
           }
         }
       }
-      if (updates == 0) {
-        vpx_write_bit(bc, 0);  // no updates
-      }
       return;
     }
   }
@@ -944,11 +939,14 @@ static int encode_tile_worker(void *arg1, void *arg2) {
   VP9BitstreamWorkerData *data = (VP9BitstreamWorkerData *)arg2;
   MACROBLOCKD *const xd = &data->xd;
   const int tile_row = 0;
+  const int timed = cpi->component_timing.enabled;
+  const int64_t cpu_start = timed ? vpx_thread_cpu_usec() : 0;
   vpx_start_encode(&data->bit_writer, data->dest);
   write_modes(cpi, xd, &cpi->tile_data[data->tile_idx].tile_info,
               &data->bit_writer, tile_row, data->tile_idx,
               &data->max_mv_magnitude, data->interp_filter_selected);
   vpx_stop_encode(&data->bit_writer);
+  if (timed) data->cpu_time = vpx_thread_cpu_usec() - cpu_start;
   return 1;
 }
 
@@ -1042,6 +1040,10 @@ static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
       for (k = 0; k < SWITCHABLE; ++k) {
         cpi->interp_filter_selected[0][k] += data->interp_filter_selected[0][k];
       }
+      // The last worker runs on the calling thread, whose clock already counts.
+      if (VP9_TIME_WORKER_THREADS && cpi->component_timing.enabled &&
+          j < num_workers - 1)
+        cpi->component_timing.worker_cpu_us += data->cpu_time;
 
       // Prefix the size of the tile on all but the last.
       if (tile_col != tile_cols || j < i - 1) {
@@ -1349,7 +1351,7 @@ static size_t write_compressed_header(VP9_COMP *cpi, uint8_t *data) {
   return header_bc.pos;
 }
 
-void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
+static void pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
   uint8_t *data = dest;
   size_t first_part_size, uncompressed_hdr_size;
   struct vpx_write_bit_buffer wb = { data, 0 };
@@ -1386,3 +1388,11 @@ void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
 
   *size = data - dest;
 }
+
+void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
+  COMPONENT_TIMER timer;
+  vp9_component_timer_start(&cpi->component_timing, &timer);
+  pack_bitstream(cpi, dest, size);
+  vp9_component_timer_stop(&cpi->component_timing, &timer,
+                           VP9E_TIMING_PACK_BITSTREAM);
+}
@@ -28,6 +28,8 @@ typedef struct VP9BitstreamWorkerData {
   // is increment the very first index (index 0) for the first dimension. Hence
   // this is sufficient.
   int interp_filter_selected[1][SWITCHABLE];
+  // CPU time spent in the tile, only set when component timing is enabled.
+  int64_t cpu_time;
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
 } VP9BitstreamWorkerData;
 
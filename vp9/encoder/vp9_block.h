@@ -11,10 +11,12 @@
 #ifndef VPX_VP9_ENCODER_VP9_BLOCK_H_
 #define VPX_VP9_ENCODER_VP9_BLOCK_H_
 
+#include "vpx/vp8cx.h"
 #include "vpx_util/vpx_thread.h"
 
 #include "vp9/common/vp9_entropymv.h"
 #include "vp9/common/vp9_entropy.h"
+#include "vp9/encoder/vp9_subpel_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -96,6 +98,15 @@ struct macroblock {
   int segment_id;
   int mb_energy;
 
+  // Points to the search_counts of the ThreadData owning this MACROBLOCK when
+  // VP9E_SET_SEARCH_STATS is on, NULL otherwise. Workers re-point it after
+  // copying the MACROBLOCK of the main thread.
+  vpx_search_stats_t *search_counts;
+
+  // Interpolated reference planes for the sub-pixel motion search, shared by
+  // all the threads. Only holds planes while the tiles are being encoded.
+  const SubpelCache *subpel_cache;
+
   // These are set to their default values at the beginning, and then adjusted
   // further in the encoding process.
   BLOCK_SIZE min_partition_size;
@@ -142,6 +153,8 @@ struct macroblock {
   vp9_coeff_cost token_costs[TX_SIZES];
 
   int optimize;
+  // Use the single pass approximation of the trellis optimization.
+  int fast_coeff_opt;
 
   // indicate if it is in the rd search loop or encoding process
   int use_lp32x32fdct;
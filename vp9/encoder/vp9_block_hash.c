@@ -0,0 +1,281 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/encoder/vp9_block_hash.h"
+
+// Bases of the hashes of the rows of a block and of the row hashes. All
+// arithmetic wraps around.
+#define ROW_BASE 0x9e3779b1u
+#define COL_BASE 0x85ebca6bu
+
+#define BLOCK_HASH_BUCKETS (1 << BLOCK_HASH_BUCKET_BITS)
+
+static uint32_t power(uint32_t base, int exp) {
+  uint32_t p = 1;
+  while (exp-- > 0) p *= base;
+  return p;
+}
+
+// Hash of a flat |size|x|size| block of value 1, the hash of a flat block of
+// value v being v times this.
+static uint32_t flat_hash(int size) {
+  uint32_t row = 0, col = 0;
+  int i;
+  for (i = 0; i < size; ++i) {
+    row = row * ROW_BASE + 1;
+    col = col * COL_BASE + 1;
+  }
+  return row * col;
+}
+
+static uint32_t block_hash(const uint8_t *src, int stride, int size) {
+  uint32_t h = 0;
+  int r, c;
+  for (r = 0; r < size; ++r) {
+    uint32_t row = 0;
+    for (c = 0; c < size; ++c) row = row * ROW_BASE + src[c];
+    h = h * COL_BASE + row;
+    src += stride;
+  }
+  return h;
+}
+
+static int alloc_buckets(BlockHashTable *table) {
+  int i;
+  for (i = 0; i < BLOCK_HASH_SIZES; ++i) {
+    if (table->bucket_start[i] != NULL) continue;
+    table->bucket_start[i] = (int32_t *)vpx_malloc(
+        (BLOCK_HASH_BUCKETS + 1) * sizeof(*table->bucket_start[i]));
+    if (table->bucket_start[i] == NULL) return 0;
+  }
+  return 1;
+}
+
+static int alloc_scratch(BlockHashTable *table, int size) {
+  if (size <= table->scratch_size) return 1;
+  vpx_free(table->scratch);
+  table->scratch = (uint32_t *)vpx_malloc(size * sizeof(*table->scratch));
+  table->scratch_size = table->scratch ? size : 0;
+  return table->scratch != NULL;
+}
+
+static int alloc_positions(BlockHashTable *table, int size_idx, int size) {
+  if (size <= table->positions_size[size_idx]) return 1;
+  vpx_free(table->positions[size_idx]);
+  vpx_free(table->hash_low[size_idx]);
+  table->positions_size[size_idx] = 0;
+  table->positions[size_idx] =
+      (int32_t *)vpx_malloc(size * sizeof(*table->positions[size_idx]));
+  table->hash_low[size_idx] =
+      (uint16_t *)vpx_malloc(size * sizeof(*table->hash_low[size_idx]));
+  if (table->positions[size_idx] == NULL || table->hash_low[size_idx] == NULL)
+    return 0;
+  table->positions_size[size_idx] = size;
+  return 1;
+}
+
+// Rolls the hashes of the blocks of size 8 << |size_idx| over the frame, in
+// raster order. Counts the blocks of each bucket in bucket_start[b + 1], or,
+// if |place| is set, stores them at the next position of their bucket in
+// bucket_start[b]. Only |size| rows of row hashes are kept: the row leaving
+// the column hashes is the one the new row replaces.
+static void scan_blocks(BlockHashTable *table, int size_idx, int place) {
+  const int size = 8 << size_idx;
+  const int width = table->width;
+  const int cols = width - size + 1;
+  const uint32_t row_pow = power(ROW_BASE, size - 1);
+  const uint32_t col_pow = power(COL_BASE, size - 1);
+  const uint32_t flat = flat_hash(size);
+  uint32_t *const col_hashes = table->scratch;
+  uint32_t *const row_hashes = table->scratch + cols;
+  int32_t *const start = table->bucket_start[size_idx];
+  int32_t *const positions = table->positions[size_idx];
+  uint16_t *const hash_low = table->hash_low[size_idx];
+  int x, y, i;
+
+  memset(col_hashes, 0, cols * sizeof(*col_hashes));
+  for (y = 0; y < table->height; ++y) {
+    const uint8_t *const row = table->y_buffer + y * table->stride;
+    uint32_t *const ring_row = row_hashes + (y % size) * cols;
+    // Top row of the blocks whose last row is |y|.
+    const int block_y = y - size + 1;
+    const uint8_t *const block_row = row - (size - 1) * table->stride;
+    uint32_t h = 0;
+    for (i = 0; i < size; ++i) h = h * ROW_BASE + row[i];
+    for (x = 0; x < cols; ++x) {
+      uint32_t hash;
+      int bucket;
+      if (x > 0) h = (h - row[x - 1] * row_pow) * ROW_BASE + row[x + size - 1];
+      hash = col_hashes[x];
+      if (y >= size) hash -= ring_row[x] * col_pow;
+      hash = hash * COL_BASE + h;
+      col_hashes[x] = hash;
+      ring_row[x] = h;
+      if (block_y < 0 || hash == block_row[x] * flat) continue;
+      bucket = (int)(hash >> (32 - BLOCK_HASH_BUCKET_BITS));
+      if (place) {
+        const int32_t k = start[bucket]++;
+        positions[k] = block_y * width + x;
+        hash_low[k] = (uint16_t)hash;
+      } else {
+        ++start[bucket + 1];
+      }
+    }
+  }
+}
+
+static int index_blocks(BlockHashTable *table, int size_idx) {
+  int32_t *const start = table->bucket_start[size_idx];
+  int b;
+
+  memset(start, 0, (BLOCK_HASH_BUCKETS + 1) * sizeof(*start));
+  scan_blocks(table, size_idx, 0);
+  for (b = 0; b < BLOCK_HASH_BUCKETS; ++b) start[b + 1] += start[b];
+  if (!alloc_positions(table, size_idx, VPXMAX(start[BLOCK_HASH_BUCKETS], 1)))
+    return 0;
+  // Placing the blocks moves each start to the start of the next bucket.
+  scan_blocks(table, size_idx, 1);
+  for (b = BLOCK_HASH_BUCKETS; b > 0; --b) start[b] = start[b - 1];
+  start[0] = 0;
+  return 1;
+}
+
+int vp9_block_hash_build(BlockHashTable *table, const YV12_BUFFER_CONFIG *src) {
+  const int width = src->y_crop_width;
+  const int height = src->y_crop_height;
+  int i;
+
+  table->y_buffer = NULL;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) return 0;
+#endif
+  if (width < 16 || height < 16) return 0;
+  if ((int64_t)width * height > BLOCK_HASH_MAX_PIXELS) return 0;
+  // Column hashes and 16 rows of row hashes.
+  if (!alloc_buckets(table) || !alloc_scratch(table, 17 * (width - 7)))
+    return 0;
+  table->y_buffer = src->y_buffer;
+  table->stride = src->y_stride;
+  table->width = width;
+  table->height = height;
+  for (i = 0; i < BLOCK_HASH_SIZES; ++i) {
+    if (!index_blocks(table, i)) {
+      table->y_buffer = NULL;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void vp9_block_hash_free(BlockHashTable *table) {
+  int i;
+  vpx_free(table->scratch);
+  for (i = 0; i < BLOCK_HASH_SIZES; ++i) {
+    vpx_free(table->positions[i]);
+    vpx_free(table->hash_low[i]);
+    vpx_free(table->bucket_start[i]);
+  }
+  memset(table, 0, sizeof(*table));
+}
+
+static int blocks_equal(const uint8_t *a, int a_stride, const uint8_t *b,
+                        int b_stride, int w, int h) {
+  int r;
+  for (r = 0; r < h; ++r) {
+    if (memcmp(a, b, w)) return 0;
+    a += a_stride;
+    b += b_stride;
+  }
+  return 1;
+}
+
+int vp9_block_hash_search(const BlockHashTable *table, const uint8_t *src,
+                          int src_stride, int x, int y, int w, int h,
+                          const MvLimits *limits, const MV *ref_mv, MV *mv) {
+  const int size_idx = w >= 16 && h >= 16;
+  const int size = 8 << size_idx;
+  const int width = table->width;
+  // Position of the block |ref_mv| points to.
+  const int target_x = x + ref_mv->col;
+  const int target_y = y + ref_mv->row;
+  const int32_t *positions;
+  const uint16_t *hash_low;
+  int best_dist = INT_MAX;
+  int candidates = 0;
+  uint32_t hash;
+  int bucket, start, end, up, down;
+
+  if (table->y_buffer == NULL || w < 8 || h < 8 || x + w > table->width ||
+      y + h > table->height)
+    return 0;
+  hash = block_hash(src, src_stride, size);
+  if (hash == src[0] * flat_hash(size)) return 0;
+
+  positions = table->positions[size_idx];
+  hash_low = table->hash_low[size_idx];
+  bucket = (int)(hash >> (32 - BLOCK_HASH_BUCKET_BITS));
+  start = table->bucket_start[size_idx][bucket];
+  end = table->bucket_start[size_idx][bucket + 1];
+
+  // The blocks of the bucket are in raster order: find the first one on the
+  // target row or below, then walk up and down from there, nearest row
+  // first, until no row left can hold a closer match.
+  {
+    const int32_t target_pos =
+        VPXMIN(VPXMAX(target_y, 0), table->height) * width;
+    int lo = start, hi = end;
+    while (lo < hi) {
+      const int mid = lo + (hi - lo) / 2;
+      if (positions[mid] < target_pos)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    down = lo;
+    up = lo - 1;
+  }
+
+  while (candidates < BLOCK_HASH_MAX_CANDIDATES) {
+    const int down_dist =
+        down < end ? abs(positions[down] / width - target_y) : INT_MAX;
+    const int up_dist =
+        up >= start ? abs(positions[up] / width - target_y) : INT_MAX;
+    const int k = down_dist <= up_dist ? down++ : up--;
+    const int row_dist = VPXMIN(down_dist, up_dist);
+    int px, py, dist;
+    MV this_mv;
+    if (row_dist >= best_dist) break;
+    if (hash_low[k] != (uint16_t)hash) continue;
+    ++candidates;
+    px = positions[k] % width;
+    py = positions[k] / width;
+    this_mv.row = (int16_t)(py - y);
+    this_mv.col = (int16_t)(px - x);
+    if (px + w > table->width || py + h > table->height) continue;
+    if (this_mv.row < limits->row_min || this_mv.row > limits->row_max ||
+        this_mv.col < limits->col_min || this_mv.col > limits->col_max)
+      continue;
+    dist = row_dist + abs(px - target_x);
+    if (dist >= best_dist ||
+        !blocks_equal(src, src_stride,
+                      table->y_buffer + py * table->stride + px,
+                      table->stride, w, h))
+      continue;
+    best_dist = dist;
+    *mv = this_mv;
+  }
+  return best_dist != INT_MAX;
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_BLOCK_HASH_H_
+#define VPX_VP9_ENCODER_VP9_BLOCK_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vp9/common/vp9_blockd.h"
+#include "vp9/common/vp9_mv.h"
+#include "vp9/encoder/vp9_block.h"
+#include "vpx_scale/yv12config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scrolled or moved regions of screen content are often exact copies of an
+// area of a reference, far beyond the reach of the regular motion search. A
+// block hash table indexes the hash of the 8x8 and 16x16 luma blocks at every
+// pixel position of a reference, so an exact match of a block is found with a
+// lookup. The hashes are polynomial rolling hashes: the hash of each block is
+// updated from the one of its neighbor.
+#define BLOCK_HASH_SIZES 2
+
+// The bucket of a hash is given by its top bits.
+#define BLOCK_HASH_BUCKET_BITS 16
+
+// Blocks of matching hash verified per lookup, closest first, which bounds the
+// cost of repetitive content.
+#define BLOCK_HASH_MAX_CANDIDATES 64
+
+// Largest frame that is hashed, in pixels. A table takes up to 12 bytes per
+// pixel.
+#define BLOCK_HASH_MAX_PIXELS (1920 * 1080)
+
+typedef struct BlockHashTable {
+  // Luma plane of the hashed frame, NULL if the table is empty.
+  const uint8_t *y_buffer;
+  int stride;
+  int width;
+  int height;
+  // Positions y * width + x of the blocks of size 8 << i, grouped by bucket
+  // and in raster order within a bucket, and the low bits of their hash. The
+  // blocks of bucket b are at [bucket_start[i][b], bucket_start[i][b + 1]).
+  // Flat blocks, which match everywhere, are not indexed.
+  int32_t *positions[BLOCK_HASH_SIZES];
+  uint16_t *hash_low[BLOCK_HASH_SIZES];
+  int32_t *bucket_start[BLOCK_HASH_SIZES];
+  int positions_size[BLOCK_HASH_SIZES];
+  // Rolling row and column hashes, used while building.
+  uint32_t *scratch;
+  int scratch_size;
+} BlockHashTable;
+
+// Builds the table of the luma plane of |src|. Returns 0 on allocation
+// failure, for high bitdepth frames, and for frames smaller than 16x16 or
+// larger than BLOCK_HASH_MAX_PIXELS, in which case the table is empty.
+int vp9_block_hash_build(BlockHashTable *table, const YV12_BUFFER_CONFIG *src);
+
+void vp9_block_hash_free(BlockHashTable *table);
+
+// Looks for an exact copy of the |w|x|h| block |src|, at (|x|, |y|) in its
+// frame, in the frame of |table|. Among the matches with a motion vector
+// within |limits|, picks the closest to the full pel |ref_mv|. The matches
+// are visited by increasing row distance to the position |ref_mv| points to,
+// so the search only misses the closest one when more than
+// BLOCK_HASH_MAX_CANDIDATES matches are nearer in rows. Returns 0 if there is
+// none, otherwise stores its full pel motion vector in |mv|.
+int vp9_block_hash_search(const BlockHashTable *table, const uint8_t *src,
+                          int src_stride, int x, int y, int w, int h,
+                          const MvLimits *limits, const MV *ref_mv, MV *mv);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_BLOCK_HASH_H_
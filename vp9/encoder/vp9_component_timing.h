@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_COMPONENT_TIMING_H_
+#define VPX_VP9_ENCODER_VP9_COMPONENT_TIMING_H_
+
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx/vp8cx.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Worker threads add their own CPU time only when they are separate threads
+// with a clock of their own. Otherwise the calling thread's clock has it.
+#define VP9_TIME_WORKER_THREADS \
+  (CONFIG_MULTITHREAD && VPX_HAVE_THREAD_CPU_CLOCK)
+
+// Per-stage timing reported through VP9E_GET_COMPONENT_TIMING. The timers
+// below only read the clocks when the timing is enabled, so a disabled
+// encoder pays a single branch per stage.
+typedef struct COMPONENT_TIMING {
+  int enabled;
+  // CPU time of the encoder worker threads, added after every join so that a
+  // stage timed on the calling thread also counts the work it handed out.
+  int64_t worker_cpu_us;
+  vpx_component_timing_t stats;
+} COMPONENT_TIMING;
+
+typedef struct COMPONENT_TIMER {
+  struct vpx_usec_timer wall;
+  int64_t cpu_start;
+} COMPONENT_TIMER;
+
+static INLINE void vp9_component_timing_add(COMPONENT_TIMING *timing,
+                                            vp9e_timing_component component,
+                                            int64_t wall_us, int64_t cpu_us) {
+  vpx_component_timing_t *const stats = &timing->stats;
+  stats->total_wall_us[component] += wall_us;
+  stats->total_cpu_us[component] += cpu_us;
+  stats->frame_wall_us[component] += wall_us;
+  stats->frame_cpu_us[component] += cpu_us;
+}
+
+// Returns the CPU time of the calling thread plus the joined worker threads.
+static INLINE int64_t vp9_component_timing_cpu_usec(
+    const COMPONENT_TIMING *timing) {
+  return vpx_thread_cpu_usec() + timing->worker_cpu_us;
+}
+
+static INLINE void vp9_component_timer_start(const COMPONENT_TIMING *timing,
+                                             COMPONENT_TIMER *timer) {
+  if (!timing->enabled) return;
+  vpx_usec_timer_start(&timer->wall);
+  timer->cpu_start = vp9_component_timing_cpu_usec(timing);
+}
+
+// Stops |timer| and charges the elapsed time to |component|. |timer| must
+// have been started while the timing was enabled.
+static INLINE void vp9_component_timer_stop(COMPONENT_TIMING *timing,
+                                            COMPONENT_TIMER *timer,
+                                            vp9e_timing_component component) {
+  if (!timing->enabled) return;
+  vpx_usec_timer_mark(&timer->wall);
+  vp9_component_timing_add(timing, component,
+                           vpx_usec_timer_elapsed(&timer->wall),
+                           vp9_component_timing_cpu_usec(timing) -
+                               timer->cpu_start);
+}
+
+// Clears the per-frame values; called at the start of every encode call.
+static INLINE void vp9_component_timing_new_frame(COMPONENT_TIMING *timing) {
+  if (!timing->enabled) return;
+  memset(timing->stats.frame_wall_us, 0, sizeof(timing->stats.frame_wall_us));
+  memset(timing->stats.frame_cpu_us, 0, sizeof(timing->stats.frame_cpu_us));
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_COMPONENT_TIMING_H_
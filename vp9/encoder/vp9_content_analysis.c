@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/common/vp9_common.h"
+#include "vp9/encoder/vp9_content_analysis.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_skin_detection.h"
+
+int vp9_content_analysis_setup(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  ContentAnalysis *const ca = &cpi->content_analysis;
+  int num_sbs;
+
+  ca->source_diff = 0;
+  ca->skin = 0;
+  ca->sb_rows = (cm->mi_rows + MI_BLOCK_SIZE - 1) >> MI_BLOCK_SIZE_LOG2;
+  ca->sb_cols = (cm->mi_cols + MI_BLOCK_SIZE - 1) >> MI_BLOCK_SIZE_LOG2;
+  if (!cpi->sf.use_nonrd_pick_mode) return 0;
+
+  ca->skin = cpi->use_skin_detection;
+  ca->source_diff = cpi->compute_source_sad_onepass && cpi->sf.use_source_sad;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (cm->use_highbitdepth) ca->source_diff = 0;
+#endif
+  num_sbs = ca->sb_rows * ca->sb_cols;
+  if (ca->source_diff && num_sbs > ca->diff_stats_size) {
+    vpx_free(ca->diff_stats);
+    ca->diff_stats_size = 0;
+    CHECK_MEM_ERROR(cm, ca->diff_stats,
+                    vpx_malloc(num_sbs * sizeof(*ca->diff_stats)));
+    ca->diff_stats_size = num_sbs;
+  }
+  return (ca->source_diff || ca->skin) ? ca->sb_rows : 0;
+}
+
+static void compute_source_diff(const VP9_COMP *cpi, int mi_row, int mi_col,
+                                SourceDiffStats *stats) {
+  const uint8_t *src_y = cpi->Source->y_buffer;
+  const uint8_t *last_src_y = cpi->Last_Source->y_buffer;
+  const int src_ystride = cpi->Source->y_stride;
+  const int last_src_ystride = cpi->Last_Source->y_stride;
+  // Both planes are addressed with the stride of the source, as in the
+  // superblock walk.
+  const int shift = src_ystride * (mi_row << 3) + (mi_col << 3);
+  src_y += shift;
+  last_src_y += shift;
+  stats->sad = cpi->fn_ptr[BLOCK_64X64].sdf(src_y, src_ystride, last_src_y,
+                                            last_src_ystride);
+  stats->variance = vpx_variance64x64(src_y, src_ystride, last_src_y,
+                                      last_src_ystride, &stats->sse);
+}
+
+void vp9_content_analysis_jobs(VP9_COMP *cpi, int first_job, int job_step) {
+  const ContentAnalysis *const ca = &cpi->content_analysis;
+  int sb_row, sb_col;
+  for (sb_row = first_job; sb_row < ca->sb_rows; sb_row += job_step) {
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    for (sb_col = 0; sb_col < ca->sb_cols; ++sb_col) {
+      const int mi_col = sb_col << MI_BLOCK_SIZE_LOG2;
+      if (ca->source_diff) {
+        compute_source_diff(cpi, mi_row, mi_col,
+                            &ca->diff_stats[sb_row * ca->sb_cols + sb_col]);
+      }
+      if (ca->skin) vp9_compute_skin_sb(cpi, BLOCK_16X16, mi_row, mi_col);
+    }
+  }
+}
+
+const SourceDiffStats *vp9_content_analysis_diff_stats(
+    const ContentAnalysis *ca, int mi_row, int mi_col) {
+  if (!ca->source_diff) return NULL;
+  return &ca->diff_stats[(mi_row >> MI_BLOCK_SIZE_LOG2) * ca->sb_cols +
+                         (mi_col >> MI_BLOCK_SIZE_LOG2)];
+}
+
+void vp9_content_analysis_free(ContentAnalysis *ca) {
+  vpx_free(ca->diff_stats);
+  memset(ca, 0, sizeof(*ca));
+}
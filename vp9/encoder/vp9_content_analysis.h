@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_CONTENT_ANALYSIS_H_
+#define VPX_VP9_ENCODER_VP9_CONTENT_ANALYSIS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct VP9_COMP;
+
+// The real-time superblock walk measures the source of each superblock
+// against the previous source, and detects skin in it, before choosing its
+// partitioning. Both only read the sources and the statistics of the previous
+// frames, so they are computed for the whole frame before the walk, one job
+// per superblock row, on the encoder threads. The results are the ones the
+// walk computed, so the analysis does not change the encoding.
+
+// Source of a 64x64 superblock against the co-located block of the previous
+// source.
+typedef struct SourceDiffStats {
+  unsigned int sad;
+  unsigned int sse;
+  unsigned int variance;
+} SourceDiffStats;
+
+typedef struct ContentAnalysis {
+  // Analyses done for the frame being coded.
+  int source_diff;
+  int skin;
+  int sb_rows;
+  int sb_cols;
+  // Per superblock, in raster order, if |source_diff| is set.
+  SourceDiffStats *diff_stats;
+  int diff_stats_size;
+} ContentAnalysis;
+
+// Decides which analyses the frame needs and allocates their results.
+// Returns the number of jobs, 0 if there is nothing to compute.
+int vp9_content_analysis_setup(struct VP9_COMP *cpi);
+
+// Runs the jobs first_job, first_job + job_step, ... set up by
+// vp9_content_analysis_setup().
+void vp9_content_analysis_jobs(struct VP9_COMP *cpi, int first_job,
+                               int job_step);
+
+// Returns the statistics of the superblock at |mi_row|, |mi_col|, or NULL if
+// they were not computed for the frame.
+const SourceDiffStats *vp9_content_analysis_diff_stats(
+    const ContentAnalysis *ca, int mi_row, int mi_col);
+
+void vp9_content_analysis_free(ContentAnalysis *ca);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_CONTENT_ANALYSIS_H_
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "./vpx_dsp_rtcd.h"
 #include "vp9/encoder/vp9_context_tree.h"
 #include "vp9/encoder/vp9_encoder.h"
 
@@ -42,6 +43,7 @@ static void alloc_mode_context(VP9_COMMON *cm, int num_4x4_blk,
       ctx->eobs_pbuf[i][k] = ctx->eobs[i][k];
     }
   }
+  ctx->inter_pred_ready = 0;
 }
 
 static void free_mode_context(PICK_MODE_CONTEXT *ctx) {
@@ -60,6 +62,11 @@ static void free_mode_context(PICK_MODE_CONTEXT *ctx) {
       ctx->eobs[i][k] = 0;
     }
   }
+  for (i = 0; i < 2; ++i) {
+    vpx_free(ctx->inter_pred_pbuf[i]);
+    ctx->inter_pred_pbuf[i] = 0;
+  }
+  ctx->inter_pred_ready = 0;
 }
 
 static void alloc_tree_contexts(VP9_COMMON *cm, PC_TREE *tree,
@@ -158,3 +165,94 @@ void vp9_free_pc_tree(ThreadData *td) {
     td->pc_tree = NULL;
   }
 }
+
+static void alloc_inter_pred_bufs(VP9_COMMON *cm, PICK_MODE_CONTEXT *ctx) {
+  const int num_pix = ctx->num_4x4_blk << 4;
+  int i;
+  if (ctx->num_4x4_blk == 0 || ctx->inter_pred_pbuf[0] != NULL) return;
+  for (i = 0; i < 2; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    CHECK_MEM_ERROR(
+        cm, ctx->inter_pred_pbuf[i],
+        vpx_memalign(32, MAX_MB_PLANE * num_pix * sizeof(uint16_t)));
+#else
+    CHECK_MEM_ERROR(cm, ctx->inter_pred_pbuf[i],
+                    vpx_memalign(32, MAX_MB_PLANE * num_pix));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+}
+
+void vp9_alloc_pc_tree_inter_pred(VP9_COMMON *cm, ThreadData *td) {
+  const int tree_nodes = 64 + 16 + 4 + 1;
+  int i;
+  for (i = 0; i < tree_nodes; ++i) {
+    PC_TREE *const tree = &td->pc_tree[i];
+    alloc_inter_pred_bufs(cm, &tree->none);
+    alloc_inter_pred_bufs(cm, &tree->horizontal[0]);
+    alloc_inter_pred_bufs(cm, &tree->horizontal[1]);
+    alloc_inter_pred_bufs(cm, &tree->vertical[0]);
+    alloc_inter_pred_bufs(cm, &tree->vertical[1]);
+  }
+}
+
+void vp9_get_inter_pred_planes(const PICK_MODE_CONTEXT *ctx, int idx,
+                               const MACROBLOCKD *xd, BLOCK_SIZE bsize,
+                               struct buf_2d pred[MAX_MB_PLANE]) {
+  const int plane_size = ctx->num_4x4_blk << 4;
+  int i;
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, &xd->plane[i]);
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH)
+      pred[i].buf = CONVERT_TO_BYTEPTR((uint16_t *)ctx->inter_pred_pbuf[idx] +
+                                       i * plane_size);
+    else
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+      pred[i].buf = ctx->inter_pred_pbuf[idx] + i * plane_size;
+    pred[i].stride = 4 * num_4x4_blocks_wide_lookup[plane_bsize];
+  }
+}
+
+void vp9_copy_pred_planes(const MACROBLOCKD *xd, BLOCK_SIZE bsize,
+                          const struct buf_2d src[MAX_MB_PLANE],
+                          const struct buf_2d dst[MAX_MB_PLANE]) {
+  int i;
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    const BLOCK_SIZE plane_bsize = get_plane_block_size(bsize, &xd->plane[i]);
+    const int bw = 4 * num_4x4_blocks_wide_lookup[plane_bsize];
+    const int bh = 4 * num_4x4_blocks_high_lookup[plane_bsize];
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+      vpx_highbd_convolve_copy(CONVERT_TO_SHORTPTR(src[i].buf), src[i].stride,
+                               CONVERT_TO_SHORTPTR(dst[i].buf), dst[i].stride,
+                               NULL, 0, 0, 0, 0, bw, bh, xd->bd);
+      continue;
+    }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+    vpx_convolve_copy(src[i].buf, src[i].stride, dst[i].buf, dst[i].stride,
+                      NULL, 0, 0, 0, 0, bw, bh);
+  }
+}
+
+void vp9_store_inter_pred(PICK_MODE_CONTEXT *ctx, const MODE_INFO *mi) {
+  uint8_t *const buf = ctx->inter_pred_pbuf[0];
+  ctx->inter_pred_pbuf[0] = ctx->inter_pred_pbuf[1];
+  ctx->inter_pred_pbuf[1] = buf;
+  ctx->inter_pred_ready = 1;
+  ctx->inter_pred_ref_frame[0] = mi->ref_frame[0];
+  ctx->inter_pred_ref_frame[1] = mi->ref_frame[1];
+  ctx->inter_pred_mv[0] = mi->mv[0];
+  ctx->inter_pred_mv[1] = mi->mv[1];
+  ctx->inter_pred_filter = mi->interp_filter;
+}
+
+int vp9_inter_pred_matches(const PICK_MODE_CONTEXT *ctx, const MODE_INFO *mi) {
+  return ctx->inter_pred_ready && is_inter_block(mi) &&
+         mi->sb_type >= BLOCK_8X8 &&
+         ctx->inter_pred_ref_frame[0] == mi->ref_frame[0] &&
+         ctx->inter_pred_ref_frame[1] == mi->ref_frame[1] &&
+         ctx->inter_pred_mv[0].as_int == mi->mv[0].as_int &&
+         (!has_second_ref(mi) ||
+          ctx->inter_pred_mv[1].as_int == mi->mv[1].as_int) &&
+         ctx->inter_pred_filter == mi->interp_filter;
+}
@@ -38,6 +38,16 @@ typedef struct {
   tran_low_t *dqcoeff_pbuf[MAX_MB_PLANE][3];
   uint16_t *eobs_pbuf[MAX_MB_PLANE][3];
 
+  // Inter predictions of the rd mode search, planes stored one after the
+  // other. 0: in use, 1: best in store. The best one is reused when the
+  // block is encoded if inter_pred_ready is set and the mode info still
+  // matches the mode it was built for.
+  uint8_t *inter_pred_pbuf[2];
+  int inter_pred_ready;
+  MV_REFERENCE_FRAME inter_pred_ref_frame[2];
+  int_mv inter_pred_mv[2];
+  INTERP_FILTER inter_pred_filter;
+
   int is_coded;
   int num_4x4_blk;
   int skip;
@@ -99,6 +109,29 @@ typedef struct PC_TREE {
 void vp9_setup_pc_tree(struct VP9Common *cm, struct ThreadData *td);
 void vp9_free_pc_tree(struct ThreadData *td);
 
+// Allocates the inter prediction buffers of the contexts of the tree of |td|
+// that do not have them yet. Called on the main thread before a frame whose
+// speed features reuse the rd inter predictions; the buffers are left NULL
+// otherwise and freed with the tree.
+void vp9_alloc_pc_tree_inter_pred(struct VP9Common *cm, struct ThreadData *td);
+
+// Sets |pred| to the planes of the inter prediction buffer |idx| of |ctx|,
+// for a block of size |bsize|.
+void vp9_get_inter_pred_planes(const PICK_MODE_CONTEXT *ctx, int idx,
+                               const MACROBLOCKD *xd, BLOCK_SIZE bsize,
+                               struct buf_2d pred[MAX_MB_PLANE]);
+
+// Copies the planes of a block of size |bsize| from |src| to |dst|.
+void vp9_copy_pred_planes(const MACROBLOCKD *xd, BLOCK_SIZE bsize,
+                          const struct buf_2d src[MAX_MB_PLANE],
+                          const struct buf_2d dst[MAX_MB_PLANE]);
+
+// Records that the best inter prediction of |ctx| is the one of |mi|.
+void vp9_store_inter_pred(PICK_MODE_CONTEXT *ctx, const MODE_INFO *mi);
+
+// Returns whether the best inter prediction of |ctx| is the one of |mi|.
+int vp9_inter_pred_matches(const PICK_MODE_CONTEXT *ctx, const MODE_INFO *mi);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -1205,27 +1205,20 @@ static void chroma_check(VP9_COMP *cpi, MACROBLOCK *x, int bsize,
   }
 }
 
-static uint64_t avg_source_sad(VP9_COMP *cpi, MACROBLOCK *x, int shift,
-                               int sb_offset) {
-  unsigned int tmp_sse;
+static uint64_t avg_source_sad(VP9_COMP *cpi, MACROBLOCK *x, int mi_row,
+                               int mi_col, int sb_offset) {
+  const SourceDiffStats *const stats =
+      vp9_content_analysis_diff_stats(&cpi->content_analysis, mi_row, mi_col);
   uint64_t tmp_sad;
+  unsigned int tmp_sse;
   unsigned int tmp_variance;
-  const BLOCK_SIZE bsize = BLOCK_64X64;
-  uint8_t *src_y = cpi->Source->y_buffer;
-  int src_ystride = cpi->Source->y_stride;
-  uint8_t *last_src_y = cpi->Last_Source->y_buffer;
-  int last_src_ystride = cpi->Last_Source->y_stride;
   uint64_t avg_source_sad_threshold = 10000;
   uint64_t avg_source_sad_threshold2 = 12000;
-#if CONFIG_VP9_HIGHBITDEPTH
-  if (cpi->common.use_highbitdepth) return 0;
-#endif
-  src_y += shift;
-  last_src_y += shift;
-  tmp_sad =
-      cpi->fn_ptr[bsize].sdf(src_y, src_ystride, last_src_y, last_src_ystride);
-  tmp_variance = vpx_variance64x64(src_y, src_ystride, last_src_y,
-                                   last_src_ystride, &tmp_sse);
+  // The statistics are not computed for high bitdepth.
+  if (stats == NULL) return 0;
+  tmp_sad = stats->sad;
+  tmp_sse = stats->sse;
+  tmp_variance = stats->variance;
   // Note: tmp_sse - tmp_variance = ((sum * sum) >> 12)
   if (tmp_sad < avg_source_sad_threshold)
     x->content_state_sb = ((tmp_sse - tmp_variance) < 25) ? kLowSadLowSumdiff
@@ -1983,6 +1976,7 @@ static void rd_pick_sb_modes(VP9_COMP *cpi, TileDataEnc *tile_data,
 
   // Use the lower precision, but faster, 32x32 fdct for mode selection.
   x->use_lp32x32fdct = 1;
+  if (x->search_counts != NULL) ++x->search_counts->blocks_searched[bsize];
 
   set_offsets(cpi, tile_info, x, mi_row, mi_col, bsize);
   mi = xd->mi[0];
@@ -1997,6 +1991,7 @@ static void rd_pick_sb_modes(VP9_COMP *cpi, TileDataEnc *tile_data,
   ctx->is_coded = 0;
   ctx->skippable = 0;
   ctx->pred_pixel_ready = 0;
+  ctx->inter_pred_ready = 0;
   x->skip_recode = 0;
 
   // Set to zero to make sure we do not use the previous encoded frame stats
@@ -4117,7 +4112,9 @@ static int rd_pick_partition(VP9_COMP *cpi, ThreadData *td,
           if (!x->e_mbd.lossless &&
               !segfeature_active(&cm->seg, mi->segment_id, SEG_LVL_SKIP) &&
               ctx->mic.mode >= INTRA_MODES && bsize >= BLOCK_16X16) {
+            if (x->search_counts != NULL) ++x->search_counts->ml_prune_checks;
             if (ml_pruning_partition(cm, xd, ctx, mi_row, mi_col, bsize)) {
+              if (x->search_counts != NULL) ++x->search_counts->ml_prunes;
               do_split = 0;
               do_rect = 0;
             }
@@ -4128,7 +4125,10 @@ static int rd_pick_partition(VP9_COMP *cpi, ThreadData *td,
           const int use_ml_based_breakout =
               cpi->sf.rd_ml_partition.search_breakout && cm->base_qindex >= 100;
           if (use_ml_based_breakout) {
+            if (x->search_counts != NULL)
+              ++x->search_counts->ml_breakout_checks;
             if (ml_predict_breakout(cpi, bsize, x, &this_rdc)) {
+              if (x->search_counts != NULL) ++x->search_counts->ml_breakouts;
               do_split = 0;
               do_rect = 0;
             }
@@ -4137,6 +4137,7 @@ static int rd_pick_partition(VP9_COMP *cpi, ThreadData *td,
               if ((best_rdc.dist < (dist_breakout_thr >> 2)) ||
                   (best_rdc.dist < dist_breakout_thr &&
                    best_rdc.rate < rate_breakout_thr)) {
+                if (x->search_counts != NULL) ++x->search_counts->rd_breakouts;
                 do_split = 0;
                 do_rect = 0;
               }
@@ -4662,6 +4663,7 @@ static void nonrd_pick_sb_modes(VP9_COMP *cpi, TileDataEnc *tile_data,
   const int num_4x4_blocks_high = num_4x4_blocks_high_lookup[bs];
   int plane;
 
+  if (x->search_counts != NULL) ++x->search_counts->blocks_searched[bsize];
   set_offsets(cpi, tile_info, x, mi_row, mi_col, bsize);
 
   set_segment_index(cpi, x, mi_row, mi_col, bsize, 0);
@@ -4960,6 +4962,7 @@ static void nonrd_pick_partition(VP9_COMP *cpi, ThreadData *td,
           rate_breakout_thr *= num_pels_log2_lookup[bsize];
           if (!x->e_mbd.lossless && this_rdc.rate < rate_breakout_thr &&
               this_rdc.dist < dist_breakout_thr) {
+            if (x->search_counts != NULL) ++x->search_counts->rd_breakouts;
             do_split = 0;
             do_rect = 0;
           }
@@ -5494,10 +5497,6 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, ThreadData *td,
     (*(cpi->row_mt_sync_read_ptr))(&tile_data->row_mt_sync, sb_row,
                                    sb_col_in_tile);
 
-    if (cpi->use_skin_detection) {
-      vp9_compute_skin_sb(cpi, BLOCK_16X16, mi_row, mi_col);
-    }
-
     x->source_variance = UINT_MAX;
     for (i = 0; i < MAX_REF_FRAMES; ++i) {
       x->pred_mv[i].row = INT16_MAX;
@@ -5519,9 +5518,8 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, ThreadData *td,
     x->lastgolden_frame_usage = 0;
 
     if (cpi->compute_source_sad_onepass && cpi->sf.use_source_sad) {
-      int shift = cpi->Source->y_stride * (mi_row << 3) + (mi_col << 3);
       int sb_offset2 = ((cm->mi_cols + 7) >> 3) * (mi_row >> 3) + (mi_col >> 3);
-      int64_t source_sad = avg_source_sad(cpi, x, shift, sb_offset2);
+      int64_t source_sad = avg_source_sad(cpi, x, mi_row, mi_col, sb_offset2);
       if (sf->adapt_partition_source_sad &&
           (cpi->oxcf.rc_mode == VPX_VBR && !cpi->rc.is_src_frame_alt_ref &&
            source_sad > sf->adapt_partition_thresh &&
@@ -6001,6 +5999,56 @@ void vp9_kmeans(double *ctr_ls, double *boundary_ls, int *count_ls, int k,
   }
 }
 
+// Interpolates the references the motion search may use, on |num_workers|
+// threads. The cache is left empty if it is disabled or cannot be allocated.
+static void build_subpel_cache(VP9_COMP *cpi, int num_workers) {
+  VP9_COMMON *const cm = &cpi->common;
+  const YV12_BUFFER_CONFIG *refs[SUBPEL_CACHE_MAX_REFS];
+  int num_refs = 0;
+  MV_REFERENCE_FRAME ref_frame;
+
+  // The planes hold the bilinear interpolation of 8-bit references only.
+  if (cpi->sf.subpel_cache_level == SUBPEL_CACHE_OFF ||
+      cpi->sf.use_accurate_subpel_search != USE_2_TAPS ||
+      frame_is_intra_only(cm))
+    return;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (cm->use_highbitdepth) return;
+#endif
+
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    const YV12_BUFFER_CONFIG *buf;
+    int i;
+    if (!(cpi->ref_frame_flags & ref_frame_to_flag(ref_frame))) continue;
+    buf = vp9_get_scaled_ref_frame(cpi, ref_frame);
+    if (buf == NULL) buf = get_ref_frame_buffer(cpi, ref_frame);
+    if (buf == NULL) continue;
+    for (i = 0; i < num_refs; ++i)
+      if (refs[i] == buf) break;
+    if (i == num_refs) refs[num_refs++] = buf;
+  }
+
+  if (num_refs == 0 ||
+      !vp9_subpel_cache_setup(&cpi->subpel_cache, cpi->sf.subpel_cache_level,
+                              refs, num_refs))
+    return;
+  if (num_workers > 1)
+    vp9_subpel_cache_build_mt(cpi, num_workers);
+  else
+    vp9_subpel_cache_build(&cpi->subpel_cache);
+}
+
+// Runs the per frame analyses of the superblock walk on |num_workers|
+// threads.
+static void analyze_content(VP9_COMP *cpi, int num_workers) {
+  const int num_jobs = vp9_content_analysis_setup(cpi);
+  if (num_jobs == 0) return;
+  if (num_workers > 1 && num_jobs > 1)
+    vp9_content_analysis_mt(cpi, num_jobs, num_workers);
+  else
+    vp9_content_analysis_jobs(cpi, 0, 1);
+}
+
 static void encode_frame_internal(VP9_COMP *cpi) {
   SPEED_FEATURES *const sf = &cpi->sf;
   ThreadData *const td = &cpi->td;
@@ -6029,7 +6077,8 @@ static void encode_frame_internal(VP9_COMP *cpi) {
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   x->inv_txfm_add = xd->lossless ? vp9_iwht4x4_add : vp9_idct4x4_add;
 #if CONFIG_CONSISTENT_RECODE
-  x->optimize = sf->optimize_coefficients == 1 && cpi->oxcf.pass != 1;
+  x->optimize =
+      sf->optimize_coefficients != NO_TRELLIS_OPT && cpi->oxcf.pass != 1;
 #endif
   if (xd->lossless) x->optimize = 0;
   x->sharpness = cpi->oxcf.sharpness;
@@ -6104,8 +6153,18 @@ static void encode_frame_internal(VP9_COMP *cpi) {
 
   {
     struct vpx_usec_timer emr_timer;
+    const int num_workers =
+        cpi->row_mt ? cpi->oxcf.max_threads
+                    : VPXMIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols);
     vpx_usec_timer_start(&emr_timer);
 
+    analyze_content(cpi, num_workers);
+    vp9_setup_pyramids(cpi, cpi->ref_frame_flags);
+    vp9_setup_hash_tables(cpi);
+    build_subpel_cache(cpi, num_workers);
+    if (sf->reuse_rd_inter_pred && !sf->use_nonrd_pick_mode)
+      vp9_alloc_pc_tree_inter_pred(cm, td);
+
     if (!cpi->row_mt) {
       cpi->row_mt_sync_read_ptr = vp9_row_mt_sync_read_dummy;
       cpi->row_mt_sync_write_ptr = vp9_row_mt_sync_write_dummy;
@@ -6121,6 +6180,8 @@ static void encode_frame_internal(VP9_COMP *cpi) {
       vp9_encode_tiles_row_mt(cpi);
     }
 
+    vp9_subpel_cache_clear(&cpi->subpel_cache);
+
     vpx_usec_timer_mark(&emr_timer);
     cpi->time_encode_sb_row += vpx_usec_timer_elapsed(&emr_timer);
   }
@@ -6210,7 +6271,7 @@ static void restore_encode_params(VP9_COMP *cpi) {
 }
 #endif  // CONFIG_CONSISTENT_RECODE || CONFIG_RATE_CTRL
 
-void vp9_encode_frame(VP9_COMP *cpi) {
+static void encode_frame(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
 
 #if CONFIG_RATE_CTRL
@@ -6369,6 +6430,91 @@ void vp9_encode_frame(VP9_COMP *cpi) {
   }
 }
 
+// Returns the ThreadData used by tile worker |i|, or NULL if the worker
+// shares cpi->td.
+static ThreadData *get_worker_td(VP9_COMP *cpi, int i) {
+  if (cpi->tile_thr_data == NULL || cpi->tile_thr_data[i].td == &cpi->td)
+    return NULL;
+  return cpi->tile_thr_data[i].td;
+}
+
+void vp9_accumulate_search_stats(vpx_search_stats_t *dst,
+                                 const vpx_search_stats_t *src) {
+  int i;
+  for (i = 0; i < VPX_SEARCH_STATS_BLOCK_SIZES; ++i)
+    dst->blocks_searched[i] += src->blocks_searched[i];
+  dst->ml_prune_checks += src->ml_prune_checks;
+  dst->ml_prunes += src->ml_prunes;
+  dst->ml_breakout_checks += src->ml_breakout_checks;
+  dst->ml_breakouts += src->ml_breakouts;
+  dst->rd_breakouts += src->rd_breakouts;
+  dst->intra_modes_tested += src->intra_modes_tested;
+  dst->inter_modes_tested += src->inter_modes_tested;
+  dst->modes_skipped += src->modes_skipped;
+  dst->mode_early_exits += src->mode_early_exits;
+  dst->full_pel_searches += src->full_pel_searches;
+  dst->full_pel_steps += src->full_pel_steps;
+  dst->full_pel_sads += src->full_pel_sads;
+  dst->sub_pel_searches += src->sub_pel_searches;
+  dst->sub_pel_evals += src->sub_pel_evals;
+}
+
+// Runs encode_frame() and adds the search statistics gathered by all threads
+// to cpi->search_stats.
+static void encode_frame_with_stats(VP9_COMP *cpi) {
+  vp9_zero(cpi->td.search_counts);
+  encode_frame(cpi);
+  vp9_accumulate_search_stats(&cpi->search_stats, &cpi->td.search_counts);
+}
+
+void vp9_encode_frame(VP9_COMP *cpi) {
+  COMPONENT_TIMING *const timing = &cpi->component_timing;
+  COMPONENT_TIMER timer;
+  int64_t wall_time, cpu_time, tokenize_wall_time, tokenize_cpu_time;
+  int tokenize_threads, i;
+
+  if (!timing->enabled) {
+    encode_frame_with_stats(cpi);
+    return;
+  }
+
+  cpi->td.tokenize_wall_time = 0;
+  cpi->td.tokenize_cpu_time = 0;
+  for (i = 0; i < cpi->num_workers; ++i) {
+    ThreadData *const td = get_worker_td(cpi, i);
+    if (td != NULL) td->tokenize_wall_time = td->tokenize_cpu_time = 0;
+  }
+
+  vp9_component_timer_start(timing, &timer);
+  encode_frame_with_stats(cpi);
+  vpx_usec_timer_mark(&timer.wall);
+  wall_time = vpx_usec_timer_elapsed(&timer.wall);
+  cpu_time = vp9_component_timing_cpu_usec(timing) - timer.cpu_start;
+
+  // Tokenization is charged separately. Its wall time is summed over the tile
+  // workers, so only the share of one worker is taken off the wall time. The
+  // CPU time is summed over all threads, as is the time of the whole stage.
+  tokenize_wall_time = cpi->td.tokenize_wall_time;
+  tokenize_cpu_time = cpi->td.tokenize_cpu_time;
+  tokenize_threads = cpi->td.tokenize_wall_time > 0;
+  for (i = 0; i < cpi->num_workers; ++i) {
+    const ThreadData *const td = get_worker_td(cpi, i);
+    if (td != NULL && td->tokenize_wall_time > 0) {
+      tokenize_wall_time += td->tokenize_wall_time;
+      tokenize_cpu_time += td->tokenize_cpu_time;
+      ++tokenize_threads;
+    }
+  }
+  if (tokenize_threads > 0) tokenize_wall_time /= tokenize_threads;
+  wall_time -= tokenize_wall_time;
+  cpu_time -= tokenize_cpu_time;
+
+  vp9_component_timing_add(timing, VP9E_TIMING_TOKENIZE, tokenize_wall_time,
+                           tokenize_cpu_time);
+  vp9_component_timing_add(timing, VP9E_TIMING_MODE_SEARCH,
+                           VPXMAX(wall_time, 0), VPXMAX(cpu_time, 0));
+}
+
 static void sum_intra_stats(FRAME_COUNTS *counts, const MODE_INFO *mi) {
   const PREDICTION_MODE y_mode = mi->mode;
   const PREDICTION_MODE uv_mode = mi->uv_mode;
@@ -6413,6 +6559,21 @@ static void update_zeromv_cnt(VP9_COMP *const cpi, const MODE_INFO *const mi,
     }
 }
 
+static void tokenize_sb(VP9_COMP *cpi, ThreadData *td, TOKENEXTRA **t,
+                        int dry_run, int seg_skip, BLOCK_SIZE bsize) {
+  if (cpi->component_timing.enabled) {
+    struct vpx_usec_timer timer;
+    const int64_t cpu_start = vpx_thread_cpu_usec();
+    vpx_usec_timer_start(&timer);
+    vp9_tokenize_sb(cpi, td, t, dry_run, seg_skip, bsize);
+    vpx_usec_timer_mark(&timer);
+    td->tokenize_wall_time += vpx_usec_timer_elapsed(&timer);
+    td->tokenize_cpu_time += vpx_thread_cpu_usec() - cpu_start;
+  } else {
+    vp9_tokenize_sb(cpi, td, t, dry_run, seg_skip, bsize);
+  }
+}
+
 static void encode_superblock(VP9_COMP *cpi, ThreadData *td, TOKENEXTRA **t,
                               int output_enabled, int mi_row, int mi_col,
                               BLOCK_SIZE bsize, PICK_MODE_CONTEXT *ctx) {
@@ -6450,8 +6611,8 @@ static void encode_superblock(VP9_COMP *cpi, ThreadData *td, TOKENEXTRA **t,
     for (plane = 0; plane < MAX_MB_PLANE; ++plane)
       vp9_encode_intra_block_plane(x, VPXMAX(bsize, BLOCK_8X8), plane, 1);
     if (output_enabled) sum_intra_stats(td->counts, mi);
-    vp9_tokenize_sb(cpi, td, t, !output_enabled, seg_skip,
-                    VPXMAX(bsize, BLOCK_8X8));
+    tokenize_sb(cpi, td, t, !output_enabled, seg_skip,
+                VPXMAX(bsize, BLOCK_8X8));
   } else {
     int ref;
     const int is_compound = has_second_ref(mi);
@@ -6462,12 +6623,22 @@ static void encode_superblock(VP9_COMP *cpi, ThreadData *td, TOKENEXTRA **t,
       vp9_setup_pre_planes(xd, ref, cfg, mi_row, mi_col,
                            &xd->block_refs[ref]->sf);
     }
-    if (!(cpi->sf.reuse_inter_pred_sby && ctx->pred_pixel_ready) || seg_skip)
-      vp9_build_inter_predictors_sby(xd, mi_row, mi_col,
-                                     VPXMAX(bsize, BLOCK_8X8));
+    if (cpi->sf.reuse_rd_inter_pred && !cpi->sf.use_nonrd_pick_mode &&
+        vp9_inter_pred_matches(ctx, mi)) {
+      struct buf_2d pred[MAX_MB_PLANE], dst[MAX_MB_PLANE];
+      int plane;
+      vp9_get_inter_pred_planes(ctx, 1, xd, bsize, pred);
+      for (plane = 0; plane < MAX_MB_PLANE; ++plane)
+        dst[plane] = xd->plane[plane].dst;
+      vp9_copy_pred_planes(xd, bsize, pred, dst);
+    } else {
+      if (!(cpi->sf.reuse_inter_pred_sby && ctx->pred_pixel_ready) || seg_skip)
+        vp9_build_inter_predictors_sby(xd, mi_row, mi_col,
+                                       VPXMAX(bsize, BLOCK_8X8));
 
-    vp9_build_inter_predictors_sbuv(xd, mi_row, mi_col,
-                                    VPXMAX(bsize, BLOCK_8X8));
+      vp9_build_inter_predictors_sbuv(xd, mi_row, mi_col,
+                                      VPXMAX(bsize, BLOCK_8X8));
+    }
 
 #if CONFIG_MISMATCH_DEBUG
     if (output_enabled) {
@@ -6490,8 +6661,8 @@ static void encode_superblock(VP9_COMP *cpi, ThreadData *td, TOKENEXTRA **t,
 #endif
 
     vp9_encode_sb(x, VPXMAX(bsize, BLOCK_8X8), mi_row, mi_col, output_enabled);
-    vp9_tokenize_sb(cpi, td, t, !output_enabled, seg_skip,
-                    VPXMAX(bsize, BLOCK_8X8));
+    tokenize_sb(cpi, td, t, !output_enabled, seg_skip,
+                VPXMAX(bsize, BLOCK_8X8));
   }
 
   if (seg_skip) {
@@ -21,6 +21,7 @@ struct macroblock;
 struct yv12_buffer_config;
 struct VP9_COMP;
 struct ThreadData;
+struct vpx_search_stats;
 
 // Constants used in SOURCE_VAR_BASED_PARTITION
 #define VAR_HIST_MAX_BG_VAR 1000
@@ -35,6 +36,10 @@ void vp9_setup_src_planes(struct macroblock *x,
 
 void vp9_encode_frame(struct VP9_COMP *cpi);
 
+// Adds the counters of |src| to |dst|.
+void vp9_accumulate_search_stats(struct vpx_search_stats *dst,
+                                 const struct vpx_search_stats *src);
+
 void vp9_init_tile_data(struct VP9_COMP *cpi);
 void vp9_encode_tile(struct VP9_COMP *cpi, struct ThreadData *td, int tile_row,
                      int tile_col);
@@ -62,6 +62,152 @@ static const int plane_rd_mult[REF_TYPES][PLANE_TYPES] = {
 #define RIGHT_SHIFT_POSSIBLY_NEGATIVE(num, shift) \
   (((num) >= 0) ? (num) >> (shift) : -((-(num)) >> (shift)))
 
+// Largest magnitude of the quantized values that optimize_b_fast() may lower.
+#define FAST_OPT_MAX_LEVEL 2
+
+// Cheaper approximation of vp9_optimize_b(). Each value of magnitude up to
+// FAST_OPT_MAX_LEVEL is lowered by one if that lowers its own rate distortion
+// cost, without looking ahead at the context of the next token, and larger
+// values are not costed at all. The end of block is then moved back over the
+// trailing zeros and values of magnitude 1, to the position of best rate
+// distortion cost.
+static int optimize_b_fast(MACROBLOCK *mb, int plane, int block,
+                           TX_SIZE tx_size, int ctx) {
+  MACROBLOCKD *const xd = &mb->e_mbd;
+  struct macroblock_plane *const p = &mb->plane[plane];
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  const int ref = is_inter_block(xd->mi[0]);
+  uint8_t token_cache[1024];
+  const tran_low_t *const coeff = BLOCK_OFFSET(p->coeff, block);
+  tran_low_t *const qcoeff = BLOCK_OFFSET(p->qcoeff, block);
+  tran_low_t *const dqcoeff = BLOCK_OFFSET(pd->dqcoeff, block);
+  const int eob = p->eobs[block];
+  const PLANE_TYPE plane_type = get_plane_type(plane);
+  const int default_eob = 16 << (tx_size << 1);
+  const int shift = (tx_size == TX_32X32);
+  const int16_t *const dequant_ptr = pd->dequant;
+  const uint8_t *const band_translate = get_band_translate(tx_size);
+  const scan_order *const so = get_scan(xd, tx_size, plane_type, block);
+  const int16_t *const scan = so->scan;
+  const int16_t *const nb = so->neighbors;
+  const MODE_INFO *mbmi = xd->mi[0];
+  const int sharpness = mb->sharpness;
+  const int64_t rdadj = (int64_t)mb->rdmult * plane_rd_mult[ref][plane_type];
+  const int64_t rdmult =
+      (sharpness == 0 ? rdadj >> 1
+                      : (rdadj * (8 - sharpness + mbmi->segment_id)) >> 4);
+  const int64_t rddiv = mb->rddiv;
+#if CONFIG_VP9_HIGHBITDEPTH
+  const int bd_shift =
+      (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) ? xd->bd - 8 : 0;
+#else
+  const int bd_shift = 0;
+#endif
+  unsigned int(*const token_costs)[2][COEFF_CONTEXTS][ENTROPY_TOKENS] =
+      mb->token_costs[tx_size][plane_type][ref];
+  int64_t tail_rate, tail_dist, best_rd_diff;
+  int i, last_eob, final_eob;
+
+  assert((!plane_type && !plane) || (plane_type && plane));
+  assert(eob <= default_eob);
+
+  for (i = 0; i < eob; i++) {
+    const int rc = scan[i];
+    token_cache[rc] = vp9_pt_energy_class[vp9_get_token(qcoeff[rc])];
+  }
+
+  // Lower the small values one at a time, in scan order so that the context
+  // of each one reflects the choices made before it.
+  last_eob = 0;
+  for (i = 0; i < eob; i++) {
+    const int rc = scan[i];
+    const int x = qcoeff[rc];
+    const int sign = -(x < 0);
+    const int x1 = x - 2 * sign - 1;
+    int ctx_cur, diff0, diff1;
+    unsigned int *costs;
+    int64_t rd_cost0, rd_cost1;
+    if (x == 0) continue;
+    if (abs(x) > FAST_OPT_MAX_LEVEL) {
+      last_eob = i + 1;
+      continue;
+    }
+    ctx_cur = (i == 0) ? ctx : get_coef_context(nb, token_cache, i);
+    costs = token_costs[band_translate[i]][i > 0 && !qcoeff[scan[i - 1]]]
+                       [ctx_cur];
+    diff0 = RIGHT_SHIFT_POSSIBLY_NEGATIVE(
+        (dqcoeff[rc] - coeff[rc]) * (1 << shift), bd_shift);
+    diff1 = x1 ? diff0 - (((dequant_ptr[rc != 0] >> bd_shift) + sign) ^ sign)
+               : RIGHT_SHIFT_POSSIBLY_NEGATIVE(-coeff[rc] * (1 << shift),
+                                               bd_shift);
+    rd_cost0 = RDCOST(rdmult, rddiv,
+                      vp9_dct_cat_lt_10_value_cost[x] +
+                          costs[vp9_dct_cat_lt_10_value_tokens[x].token],
+                      (int64_t)diff0 * diff0);
+    rd_cost1 = RDCOST(rdmult, rddiv,
+                      vp9_dct_cat_lt_10_value_cost[x1] +
+                          costs[vp9_dct_cat_lt_10_value_tokens[x1].token],
+                      (int64_t)diff1 * diff1);
+    if (rd_cost1 < rd_cost0) {
+      qcoeff[rc] = x1;
+      dqcoeff[rc] =
+          x1 ? RIGHT_SHIFT_POSSIBLY_NEGATIVE(x1 * dequant_ptr[rc != 0], shift)
+             : 0;
+      token_cache[rc] = vp9_pt_energy_class[x1 ? ONE_TOKEN : ZERO_TOKEN];
+    }
+    if (qcoeff[rc]) last_eob = i + 1;
+  }
+
+  // Move the end of block back over the trailing values of magnitude 1. The
+  // rate and distortion of the tail cut at each candidate are accumulated
+  // against the cost of the end of block token.
+  final_eob = last_eob;
+  tail_rate = 0;
+  if (last_eob > 0 && last_eob < default_eob) {
+    tail_rate = token_costs[band_translate[last_eob]][0][get_coef_context(
+        nb, token_cache, last_eob)][EOB_TOKEN];
+  }
+  tail_dist = 0;
+  best_rd_diff = 0;
+  for (i = last_eob - 1; i >= 0; i--) {
+    const int rc = scan[i];
+    const int x = qcoeff[rc];
+    const int ctx_cur = (i == 0) ? ctx : get_coef_context(nb, token_cache, i);
+    const int prev_zero = i > 0 && !qcoeff[scan[i - 1]];
+    unsigned int *const costs =
+        token_costs[band_translate[i]][prev_zero][ctx_cur];
+    int64_t rd_diff;
+    if (x == 0) {
+      tail_rate += costs[ZERO_TOKEN];
+    } else {
+      const int diff0 = RIGHT_SHIFT_POSSIBLY_NEGATIVE(
+          (dqcoeff[rc] - coeff[rc]) * (1 << shift), bd_shift);
+      const int diff_for_zero =
+          RIGHT_SHIFT_POSSIBLY_NEGATIVE(-coeff[rc] * (1 << shift), bd_shift);
+      if (abs(x) > 1) break;
+      tail_rate += vp9_dct_cat_lt_10_value_cost[x] + costs[ONE_TOKEN];
+      tail_dist += (int64_t)diff_for_zero * diff_for_zero -
+                   (int64_t)diff0 * diff0;
+    }
+    // A new end of block must follow a non-zero value.
+    if (prev_zero) continue;
+    rd_diff = RDCOST(rdmult, rddiv, costs[EOB_TOKEN], tail_dist) -
+              RDCOST(rdmult, rddiv, tail_rate, 0);
+    if (rd_diff < best_rd_diff) {
+      best_rd_diff = rd_diff;
+      final_eob = i;
+    }
+  }
+
+  for (i = final_eob; i < eob; i++) {
+    const int rc = scan[i];
+    qcoeff[rc] = 0;
+    dqcoeff[rc] = 0;
+  }
+  mb->plane[plane].eobs[block] = final_eob;
+  return final_eob;
+}
+
 int vp9_optimize_b(MACROBLOCK *mb, int plane, int block, TX_SIZE tx_size,
                    int ctx) {
   MACROBLOCKD *const xd = &mb->e_mbd;
@@ -113,6 +259,9 @@ int vp9_optimize_b(MACROBLOCK *mb, int plane, int block, TX_SIZE tx_size,
   tran_low_t before_best_eob_qc = 0;
   tran_low_t before_best_eob_dqc = 0;
 
+  if (mb->fast_coeff_opt)
+    return optimize_b_fast(mb, plane, block, tx_size, ctx);
+
   assert((!plane_type && !plane) || (plane_type && plane));
   assert(eob <= default_eob);
 
@@ -346,7 +495,7 @@ static INLINE void highbd_fdct32x32(int rd_transform, const int16_t *src,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
 void vp9_xform_quant_fp(MACROBLOCK *x, int plane, int block, int row, int col,
-                        BLOCK_SIZE plane_bsize, TX_SIZE tx_size) {
+                        TX_SIZE tx_size) {
   MACROBLOCKD *const xd = &x->e_mbd;
   const struct macroblock_plane *const p = &x->plane[plane];
   const struct macroblockd_plane *const pd = &xd->plane[plane];
@@ -355,14 +504,17 @@ void vp9_xform_quant_fp(MACROBLOCK *x, int plane, int block, int row, int col,
   tran_low_t *const qcoeff = BLOCK_OFFSET(p->qcoeff, block);
   tran_low_t *const dqcoeff = BLOCK_OFFSET(pd->dqcoeff, block);
   uint16_t *const eob = &p->eobs[block];
-  const int diff_stride = 4 * num_4x4_blocks_wide_lookup[plane_bsize];
-  const int16_t *src_diff;
-  src_diff = &p->src_diff[4 * (row * diff_stride + col)];
+  const int diff_stride = 4 << tx_size;
+  const uint8_t *const src = &p->src.buf[4 * (row * p->src.stride + col)];
+  const uint8_t *const dst = &pd->dst.buf[4 * (row * pd->dst.stride + col)];
+  DECLARE_ALIGNED(16, int16_t, src_diff[32 * 32]);
   // skip block condition should be handled before this is called.
   assert(!x->skip_block);
 
 #if CONFIG_VP9_HIGHBITDEPTH
   if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vpx_highbd_subtract_block(diff_stride, diff_stride, src_diff, diff_stride,
+                              src, p->src.stride, dst, pd->dst.stride, xd->bd);
     switch (tx_size) {
       case TX_32X32:
         highbd_fdct32x32(x->use_lp32x32fdct, src_diff, coeff, diff_stride);
@@ -396,27 +548,39 @@ void vp9_xform_quant_fp(MACROBLOCK *x, int plane, int block, int row, int col,
 
   switch (tx_size) {
     case TX_32X32:
+      vpx_subtract_block(32, 32, src_diff, diff_stride, src, p->src.stride, dst,
+                         pd->dst.stride);
       fdct32x32(x->use_lp32x32fdct, src_diff, coeff, diff_stride);
       vp9_quantize_fp_32x32(coeff, 1024, p->round_fp, p->quant_fp, qcoeff,
                             dqcoeff, pd->dequant, eob, scan_order->scan,
                             scan_order->iscan);
       break;
     case TX_16X16:
-      vpx_fdct16x16(src_diff, coeff, diff_stride);
-      vp9_quantize_fp(coeff, 256, p->round_fp, p->quant_fp, qcoeff, dqcoeff,
-                      pd->dequant, eob, scan_order->scan, scan_order->iscan);
+      vp9_fdct_quantize_fp_16x16(src, p->src.stride, dst, pd->dst.stride, coeff,
+                                 p->round_fp, p->quant_fp, qcoeff, dqcoeff,
+                                 pd->dequant, eob, scan_order->scan,
+                                 scan_order->iscan);
       break;
     case TX_8X8:
-      vpx_fdct8x8(src_diff, coeff, diff_stride);
-      vp9_quantize_fp(coeff, 64, p->round_fp, p->quant_fp, qcoeff, dqcoeff,
-                      pd->dequant, eob, scan_order->scan, scan_order->iscan);
-
+      vp9_fdct_quantize_fp_8x8(src, p->src.stride, dst, pd->dst.stride, coeff,
+                               p->round_fp, p->quant_fp, qcoeff, dqcoeff,
+                               pd->dequant, eob, scan_order->scan,
+                               scan_order->iscan);
       break;
     default:
       assert(tx_size == TX_4X4);
-      x->fwd_txfm4x4(src_diff, coeff, diff_stride);
-      vp9_quantize_fp(coeff, 16, p->round_fp, p->quant_fp, qcoeff, dqcoeff,
-                      pd->dequant, eob, scan_order->scan, scan_order->iscan);
+      if (xd->lossless) {
+        vpx_subtract_block(4, 4, src_diff, diff_stride, src, p->src.stride, dst,
+                           pd->dst.stride);
+        x->fwd_txfm4x4(src_diff, coeff, diff_stride);
+        vp9_quantize_fp(coeff, 16, p->round_fp, p->quant_fp, qcoeff, dqcoeff,
+                        pd->dequant, eob, scan_order->scan, scan_order->iscan);
+      } else {
+        vp9_fdct_quantize_fp_4x4(src, p->src.stride, dst, pd->dst.stride,
+                                 coeff, p->round_fp, p->quant_fp, qcoeff,
+                                 dqcoeff, pd->dequant, eob, scan_order->scan,
+                                 scan_order->iscan);
+      }
       break;
   }
 }
@@ -612,7 +776,7 @@ static void encode_block(int plane, int block, int row, int col,
         return;
 #endif
       } else {
-        vp9_xform_quant_fp(x, plane, block, row, col, plane_bsize, tx_size);
+        vp9_xform_quant_fp(x, plane, block, row, col, tx_size);
       }
     } else {
       if (max_txsize_lookup[plane_bsize] == tx_size) {
@@ -773,7 +937,9 @@ void vp9_encode_sb(MACROBLOCK *x, BLOCK_SIZE bsize, int mi_row, int mi_col,
   if (x->skip) return;
 
   for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
-    if (!x->skip_recode) vp9_subtract_plane(x, bsize, plane);
+    // The rtc transform computes the residual of each transform block as it
+    // goes, while it is still in cache, and skips the zero forced blocks.
+    if (!x->skip_recode && !x->quant_fp) vp9_subtract_plane(x, bsize, plane);
 
     if (x->optimize && (!x->skip_recode || !x->skip_optimize)) {
       const struct macroblockd_plane *const pd = &xd->plane[plane];
@@ -35,8 +35,10 @@ int vp9_optimize_b(MACROBLOCK *mb, int plane, int block, TX_SIZE tx_size,
 void vp9_encode_sb(MACROBLOCK *x, BLOCK_SIZE bsize, int mi_row, int mi_col,
                    int output_enabled);
 void vp9_encode_sby_pass1(MACROBLOCK *x, BLOCK_SIZE bsize);
+// Subtracts the prediction in the destination buffer from the source, then
+// transforms and quantizes the transform block, for the rtc encoding path.
 void vp9_xform_quant_fp(MACROBLOCK *x, int plane, int block, int row, int col,
-                        BLOCK_SIZE plane_bsize, TX_SIZE tx_size);
+                        TX_SIZE tx_size);
 void vp9_xform_quant_dc(MACROBLOCK *x, int plane, int block, int row, int col,
                         BLOCK_SIZE plane_bsize, TX_SIZE tx_size);
 void vp9_xform_quant(MACROBLOCK *x, int plane, int block, int row, int col,
@@ -981,6 +981,19 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
   vpx_free(cpi->skin_map);
   cpi->skin_map = NULL;
 
+  vp9_subpel_cache_free(&cpi->subpel_cache);
+  vp9_content_analysis_free(&cpi->content_analysis);
+  vp9_pyramid_cache_free(&cpi->pyramid_cache);
+  for (i = LAST_FRAME; i <= ALTREF_FRAME; ++i)
+    vp9_pyramid_motion_field_free(&cpi->pyramid_field[i]);
+  for (i = 0; i < REFS_PER_FRAME; ++i) {
+    vp9_block_hash_free(&cpi->hash_tables[i]);
+    cpi->hash_table_buf_idx[i] = INVALID_IDX;
+  }
+  vpx_free(cpi->recode_mvs);
+  cpi->recode_mvs = NULL;
+  cpi->recode_mvs_size = 0;
+
   vpx_free(cpi->prev_partition);
   cpi->prev_partition = NULL;
 
@@ -1144,6 +1157,7 @@ static void configure_static_seg_features(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   const RATE_CONTROL *const rc = &cpi->rc;
   struct segmentation *const seg = &cm->seg;
+  COMPONENT_TIMER timer;
 
   int high_q = (int)(rc->avg_q > 48.0);
   int qi_delta;
@@ -1175,7 +1189,10 @@ static void configure_static_seg_features(VP9_COMP *cpi) {
 
     // Scan frames from current to arf frame.
     // This function re-enables segmentation if appropriate.
+    vp9_component_timer_start(&cpi->component_timing, &timer);
     vp9_update_mbgraph_stats(cpi);
+    vp9_component_timer_stop(&cpi->component_timing, &timer,
+                             VP9E_TIMING_MBGRAPH);
 
     // If segmentation was enabled set those features needed for the
     // arf itself.
@@ -1291,7 +1308,8 @@ static void alloc_raw_frame_buffers(VP9_COMP *cpi) {
 #if CONFIG_VP9_HIGHBITDEPTH
                                         cm->use_highbitdepth,
 #endif
-                                        oxcf->lag_in_frames);
+                                        oxcf->lag_in_frames,
+                                        oxcf->low_memory_lookahead);
   if (!cpi->lookahead)
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate lag buffers");
@@ -2279,7 +2297,8 @@ void vp9_update_compressor_with_img_fmt(VP9_COMP *cpi, vpx_img_fmt_t img_fmt) {
 #if CONFIG_VP9_HIGHBITDEPTH
                                       use_highbitdepth,
 #endif
-                                      oxcf->lag_in_frames);
+                                      oxcf->lag_in_frames,
+                                      oxcf->low_memory_lookahead);
   alloc_raw_frame_buffers(cpi);
 }
 
@@ -2317,6 +2336,7 @@ VP9_COMP *vp9_create_compressor(const VP9EncoderConfig *oxcf,
   cpi->resize_buffer_underflow = 0;
   cpi->use_skin_detection = 0;
   cpi->common.buffer_pool = pool;
+  for (i = 0; i < REFS_PER_FRAME; ++i) cpi->hash_table_buf_idx[i] = INVALID_IDX;
   init_ref_frame_bufs(cm);
 
   cpi->force_update_segmentation = 0;
@@ -2425,6 +2445,7 @@ VP9_COMP *vp9_create_compressor(const VP9EncoderConfig *oxcf,
    * 'cal_nmvsadcosts' before modifying how these tables are computed. *
    *********************************************************************/
   cal_nmvjointsadcost(cpi->td.mb.nmvjointsadcost);
+  cpi->td.mb.subpel_cache = &cpi->subpel_cache;
   cpi->td.mb.nmvcost[0] = &cpi->nmvcosts[0][MV_MAX];
   cpi->td.mb.nmvcost[1] = &cpi->nmvcosts[1][MV_MAX];
   cpi->td.mb.nmvsadcost[0] = &cpi->nmvsadcosts[0][MV_MAX];
@@ -2895,7 +2916,13 @@ int vp9_set_reference_enc(VP9_COMP *cpi, VP9_REFFRAME ref_frame_flag,
                           YV12_BUFFER_CONFIG *sd) {
   YV12_BUFFER_CONFIG *cfg = get_vp9_ref_frame_buffer(cpi, ref_frame_flag);
   if (cfg) {
+    int i;
     vpx_yv12_copy_frame(sd, cfg);
+    // The hash table of the buffer, if any, no longer matches it.
+    for (i = 0; i < REFS_PER_FRAME; ++i) {
+      if (cpi->hash_tables[i].y_buffer == cfg->y_buffer)
+        cpi->hash_table_buf_idx[i] = INVALID_IDX;
+    }
     return 0;
   } else {
     return -1;
@@ -3269,6 +3296,7 @@ void vp9_update_reference_frames(VP9_COMP *cpi) {
 static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
+  COMPONENT_TIMER component_timer;
   int is_reference_frame =
       (cm->frame_type == KEY_FRAME || cpi->refresh_last_frame ||
        cpi->refresh_golden_frame || cpi->refresh_alt_ref_frame);
@@ -3298,6 +3326,7 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
     vpx_clear_system_state();
 
     vpx_usec_timer_start(&timer);
+    vp9_component_timer_start(&cpi->component_timing, &component_timer);
 
     if (!cpi->rc.is_src_frame_alt_ref) {
       if ((cpi->common.frame_type == KEY_FRAME) &&
@@ -3312,9 +3341,12 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
 
     vpx_usec_timer_mark(&timer);
     cpi->time_pick_lpf += vpx_usec_timer_elapsed(&timer);
+    vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                             VP9E_TIMING_LPF_SEARCH);
   }
 
   if (lf->filter_level > 0 && is_reference_frame) {
+    vp9_component_timer_start(&cpi->component_timing, &component_timer);
     vp9_build_mask_frame(cm, lf->filter_level, 0);
 
     if (cpi->num_workers > 1)
@@ -3323,6 +3355,8 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
                                cpi->num_workers, &cpi->lf_row_sync);
     else
       vp9_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
+    vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                             VP9E_TIMING_LOOP_FILTER);
   }
 
   vpx_extend_frame_inner_borders(cm->frame_to_show);
@@ -3434,6 +3468,96 @@ void vp9_scale_references(VP9_COMP *cpi) {
   }
 }
 
+void vp9_setup_pyramids(VP9_COMP *cpi, int ref_flags) {
+  const ImagePyramid *src_pyramid = NULL;
+  MV_REFERENCE_FRAME ref_frame;
+
+  if (cpi->sf.mv.use_pyramid_search && !frame_is_intra_only(&cpi->common))
+    src_pyramid = vp9_pyramid_cache_get(&cpi->pyramid_cache, cpi->Source);
+
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    PyramidMotionField *const field = &cpi->pyramid_field[ref_frame];
+    const YV12_BUFFER_CONFIG *buf = NULL;
+    const ImagePyramid *ref_pyramid = NULL;
+    if (src_pyramid != NULL && (ref_flags & ref_frame_to_flag(ref_frame))) {
+      buf = vp9_get_scaled_ref_frame(cpi, ref_frame);
+      if (buf == NULL) buf = get_ref_frame_buffer(cpi, ref_frame);
+    }
+    if (buf != NULL)
+      ref_pyramid = vp9_pyramid_cache_get(&cpi->pyramid_cache, buf);
+    if (ref_pyramid == NULL ||
+        !vp9_pyramid_motion_field(src_pyramid, ref_pyramid, field)) {
+      field->rows = 0;
+      field->cols = 0;
+    }
+  }
+}
+
+static int find_hash_table(const VP9_COMP *cpi, int buf_idx) {
+  const YV12_BUFFER_CONFIG *const buf =
+      &cpi->common.buffer_pool->frame_bufs[buf_idx].buf;
+  int i;
+  for (i = 0; i < REFS_PER_FRAME; ++i) {
+    if (cpi->hash_table_buf_idx[i] == buf_idx &&
+        cpi->hash_tables[i].y_buffer == buf->y_buffer)
+      return i;
+  }
+  return -1;
+}
+
+void vp9_setup_hash_tables(VP9_COMP *cpi) {
+  const VP9_COMMON *const cm = &cpi->common;
+  int buf_idx[MAX_REF_FRAMES];
+  int used[REFS_PER_FRAME] = { 0 };
+  MV_REFERENCE_FRAME ref_frame;
+  int i;
+
+  // The buffer being coded is rewritten, so its table, if any, is stale.
+  for (i = 0; i < REFS_PER_FRAME; ++i) {
+    if (cpi->hash_table_buf_idx[i] == cm->new_fb_idx)
+      cpi->hash_table_buf_idx[i] = INVALID_IDX;
+  }
+
+  // Keep the tables of the references hashed for earlier frames.
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    int slot;
+    cpi->hash_table[ref_frame] = NULL;
+    buf_idx[ref_frame] = INVALID_IDX;
+    if (!cpi->sf.mv.use_hash_search || frame_is_intra_only(cm) ||
+        !(cpi->ref_frame_flags & ref_frame_to_flag(ref_frame)) ||
+        vp9_get_scaled_ref_frame(cpi, ref_frame) != NULL)
+      continue;
+    buf_idx[ref_frame] = get_ref_frame_buf_idx(cpi, ref_frame);
+    if (buf_idx[ref_frame] == INVALID_IDX) continue;
+    slot = find_hash_table(cpi, buf_idx[ref_frame]);
+    if (slot >= 0) {
+      used[slot] = 1;
+      cpi->hash_table[ref_frame] = &cpi->hash_tables[slot];
+    }
+  }
+
+  // Hash the others in the tables left.
+  for (ref_frame = LAST_FRAME; ref_frame <= ALTREF_FRAME; ++ref_frame) {
+    const int idx = buf_idx[ref_frame];
+    int slot;
+    if (idx == INVALID_IDX || cpi->hash_table[ref_frame] != NULL) continue;
+    // References may share a buffer hashed by this loop.
+    slot = find_hash_table(cpi, idx);
+    if (slot < 0) {
+      slot = 0;
+      while (used[slot]) ++slot;
+      used[slot] = 1;
+      if (!vp9_block_hash_build(&cpi->hash_tables[slot],
+                                &cm->buffer_pool->frame_bufs[idx].buf)) {
+        cpi->hash_table_buf_idx[slot] = INVALID_IDX;
+        continue;
+      }
+      cpi->hash_table_buf_idx[slot] = idx;
+    }
+    cpi->hash_table[ref_frame] = &cpi->hash_tables[slot];
+  }
+}
+
 static void release_scaled_references(VP9_COMP *cpi) {
   VP9_COMMON *cm = &cpi->common;
   int i;
@@ -4349,6 +4473,32 @@ static void rq_model_update(const RATE_QINDEX_HISTORY *rq_history,
 }
 #endif  // CONFIG_RATE_CTRL
 
+// The first encoding of the frame at its current size stores its motion
+// search results and the recodes reuse them, as they depend little on q.
+static void setup_recode_mvs(VP9_COMP *cpi, int loop_at_this_size) {
+  VP9_COMMON *const cm = &cpi->common;
+  const int size =
+      cm->mi_rows * cm->mi_cols * RECODE_MV_BLOCK_SIZES * REFS_PER_FRAME;
+  int i;
+
+  cpi->recode_mv_mode = RECODE_MV_OFF;
+  if (!cpi->sf.mv.reuse_recode_search || frame_is_intra_only(cm)) return;
+  if (loop_at_this_size > 0) {
+    cpi->recode_mv_mode = RECODE_MV_REUSE;
+    return;
+  }
+
+  if (size > cpi->recode_mvs_size) {
+    vpx_free(cpi->recode_mvs);
+    cpi->recode_mvs_size = 0;
+    CHECK_MEM_ERROR(cm, cpi->recode_mvs,
+                    vpx_malloc(size * sizeof(*cpi->recode_mvs)));
+    cpi->recode_mvs_size = size;
+  }
+  for (i = 0; i < size; ++i) cpi->recode_mvs[i].mv.as_int = INVALID_MV;
+  cpi->recode_mv_mode = RECODE_MV_STORE;
+}
+
 static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
 #if CONFIG_RATE_CTRL
                                     ,
@@ -4536,6 +4686,7 @@ static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
       vp9_psnr_aq_mode_setup(&cm->seg);
     }
 
+    setup_recode_mvs(cpi, loop_at_this_size);
     vp9_encode_frame(cpi);
 
     // Update the skip mb flag probabilities based on the distribution
@@ -4812,6 +4963,8 @@ static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
       if (loop) restore_coding_context(cpi);
   } while (loop);
 
+  cpi->recode_mv_mode = RECODE_MV_OFF;
+
   rc->max_frame_bandwidth = orig_rc_max_frame_bandwidth;
 
 #ifdef AGGRESSIVE_VBR
@@ -5818,6 +5971,7 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
                           int64_t end_time) {
   VP9_COMMON *const cm = &cpi->common;
   struct vpx_usec_timer timer;
+  COMPONENT_TIMER component_timer;
   int res = 0;
   const int subsampling_x = sd->subsampling_x;
   const int subsampling_y = sd->subsampling_y;
@@ -5835,12 +5989,15 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, vpx_enc_frame_flags_t frame_flags,
   alloc_raw_frame_buffers(cpi);
 
   vpx_usec_timer_start(&timer);
+  vp9_component_timer_start(&cpi->component_timing, &component_timer);
 
   if (vp9_lookahead_push(cpi->lookahead, sd, time_stamp, end_time,
                          use_highbitdepth, frame_flags))
     res = -1;
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
+  vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                           VP9E_TIMING_LOOKAHEAD_PUSH);
 
   if ((cm->profile == PROFILE_0 || cm->profile == PROFILE_2) &&
       (subsampling_x != 1 || subsampling_y != 1)) {
@@ -6189,8 +6346,11 @@ static void update_level_info(VP9_COMP *cpi, size_t *size, int arf_src_index) {
 
 typedef struct GF_PICTURE {
   YV12_BUFFER_CONFIG *frame;
+  struct lookahead_entry *lookahead;  // Source entry, if frame is from it.
+  const ImagePyramid *pyramid;        // NULL if the pyramid search is off.
   int ref_frame[3];
   FRAME_UPDATE_TYPE update_type;
+  int frame_offset;  // Display order offset from the golden frame.
 } GF_PICTURE;
 
 static void init_gop_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
@@ -6247,6 +6407,7 @@ static void init_gop_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   gf_picture[0].frame = get_ref_frame_buffer(cpi, GOLDEN_FRAME);
   for (i = 0; i < 3; ++i) gf_picture[0].ref_frame[i] = -1;
   gf_picture[0].update_type = gf_group->update_type[0];
+  gf_picture[0].frame_offset = 0;
   gld_index = 0;
   ++*tpl_group_frames;
 
@@ -6256,6 +6417,7 @@ static void init_gop_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
   gf_picture[1].ref_frame[1] = lst_index;
   gf_picture[1].ref_frame[2] = alt_index;
   gf_picture[1].update_type = gf_group->update_type[1];
+  gf_picture[1].frame_offset = gf_group->frame_gop_index[1];
   alt_index = 1;
   ++*tpl_group_frames;
 
@@ -6268,10 +6430,12 @@ static void init_gop_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
     if (buf == NULL) break;
 
     gf_picture[frame_idx].frame = &buf->img;
+    gf_picture[frame_idx].lookahead = buf;
     gf_picture[frame_idx].ref_frame[0] = gld_index;
     gf_picture[frame_idx].ref_frame[1] = lst_index;
     gf_picture[frame_idx].ref_frame[2] = alt_index;
     gf_picture[frame_idx].update_type = gf_group->update_type[frame_idx];
+    gf_picture[frame_idx].frame_offset = frame_gop_offset;
 
     switch (gf_group->update_type[frame_idx]) {
       case ARF_UPDATE:
@@ -6315,10 +6479,12 @@ static void init_gop_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
     cpi->tpl_stats[frame_idx].base_qindex = pframe_qindex;
 
     gf_picture[frame_idx].frame = &buf->img;
+    gf_picture[frame_idx].lookahead = buf;
     gf_picture[frame_idx].ref_frame[0] = gld_index;
     gf_picture[frame_idx].ref_frame[1] = lst_index;
     gf_picture[frame_idx].ref_frame[2] = alt_index;
     gf_picture[frame_idx].update_type = LF_UPDATE;
+    gf_picture[frame_idx].frame_offset = frame_gop_offset;
     lst_index = frame_idx;
     ++*tpl_group_frames;
     ++extend_frame_count;
@@ -6416,11 +6582,11 @@ static uint32_t sub_pixel_motion_search(VP9_COMP *cpi, ThreadData *td,
 }
 
 #else  // CONFIG_NON_GREEDY_MV
-static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
-                                              uint8_t *cur_frame_buf,
-                                              uint8_t *ref_frame_buf,
-                                              int stride, BLOCK_SIZE bsize,
-                                              MV *mv) {
+static uint32_t motion_compensated_prediction(
+    VP9_COMP *cpi, ThreadData *td, uint8_t *cur_frame_buf,
+    uint8_t *ref_frame_buf, int stride, const ImagePyramid *cur_pyramid,
+    const ImagePyramid *ref_pyramid, int mi_row, int mi_col, BLOCK_SIZE bsize,
+    const MV *seed, MV *mv) {
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
@@ -6435,6 +6601,7 @@ static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
 
   MV best_ref_mv1 = { 0, 0 };
   MV best_ref_mv1_full; /* full-pixel value of best_ref_mv1 */
+  MV pyramid_mv;
 
   best_ref_mv1_full.col = best_ref_mv1.col >> 3;
   best_ref_mv1_full.row = best_ref_mv1.row >> 3;
@@ -6450,9 +6617,29 @@ static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
 
   vp9_set_mv_search_range(&x->mv_limits, &best_ref_mv1);
 
-  vp9_full_pixel_search(cpi, x, bsize, &best_ref_mv1_full, step_param,
-                        search_method, sadpb, cond_cost_list(cpi, cost_list),
-                        &best_ref_mv1, mv, 0, 0);
+  if (seed != NULL) {
+    bestsme = vp9_seeded_full_pixel_search(cpi, x, bsize, seed, sadpb,
+                                           cond_cost_list(cpi, cost_list),
+                                           &best_ref_mv1, mv);
+  } else {
+    // With rd set the pattern searches return the error of
+    // vp9_get_mvpred_var(), as the candidate search below does. NSTEP and
+    // MESH ignore it and return their own error.
+    bestsme = vp9_full_pixel_search(
+        cpi, x, bsize, &best_ref_mv1_full, step_param, search_method, sadpb,
+        cond_cost_list(cpi, cost_list), &best_ref_mv1, mv, INT_MAX, 1);
+  }
+
+  if (cur_pyramid != NULL && ref_pyramid != NULL &&
+      vp9_pyramid_motion_search(cur_pyramid, ref_pyramid, mi_col * MI_SIZE,
+                                mi_row * MI_SIZE,
+                                num_4x4_blocks_wide_lookup[bsize] << 2,
+                                num_4x4_blocks_high_lookup[bsize] << 2,
+                                &pyramid_mv)) {
+    vp9_candidate_full_pixel_search(cpi, x, bsize, &pyramid_mv, sadpb,
+                                    cond_cost_list(cpi, cost_list),
+                                    &best_ref_mv1, mv, (int)bestsme);
+  }
 
   /* restore UMV window */
   x->mv_limits = tmp_mv_limits;
@@ -6467,6 +6654,55 @@ static uint32_t motion_compensated_prediction(VP9_COMP *cpi, ThreadData *td,
 
   return bestsme;
 }
+
+// Returns the processed frame of the group closest to |frame_idx| in display
+// order, whose motion predicts the one of |frame_idx|, or -1 if there is none
+// or the motion is not predicted.
+static int get_tpl_seed_frame(const VP9_COMP *cpi, const GF_PICTURE *gf_picture,
+                              int frame_idx) {
+  int seed_idx = -1;
+  int best_dist = INT_MAX;
+  int idx;
+  if (!cpi->sf.mv.use_temporal_mv_seeds) return -1;
+  // The frames are processed from the last one in coding order.
+  for (idx = frame_idx + 1; idx < MAX_ARF_GOP_SIZE; ++idx) {
+    int dist;
+    if (gf_picture[idx].frame == NULL) break;
+    if (!cpi->tpl_stats[idx].is_valid) continue;
+    dist =
+        abs(gf_picture[idx].frame_offset - gf_picture[frame_idx].frame_offset);
+    if (dist < best_dist) {
+      best_dist = dist;
+      seed_idx = idx;
+    }
+  }
+  return seed_idx;
+}
+
+// Predicts the full pel motion of the block at |mi_row|, |mi_col| of
+// |frame_idx| against its reference |rf_idx| from the best motion found for
+// the block in |seed_idx|, assuming constant motion. Returns NULL if there is
+// no prediction.
+static const MV *get_tpl_mv_seed(const VP9_COMP *cpi,
+                                 const GF_PICTURE *gf_picture, int frame_idx,
+                                 int rf_idx, int seed_idx, int mi_row,
+                                 int mi_col, MV *seed) {
+  const TplDepFrame *seed_frame;
+  const TplDepStats *stats;
+  int dist, seed_dist;
+  if (seed_idx < 0) return NULL;
+  seed_frame = &cpi->tpl_stats[seed_idx];
+  stats = &seed_frame->tpl_stats_ptr[mi_row * seed_frame->stride + mi_col];
+  if (stats->ref_frame_index < 0) return NULL;
+  seed_dist = gf_picture[seed_idx].frame_offset -
+              gf_picture[stats->ref_frame_index].frame_offset;
+  dist = gf_picture[frame_idx].frame_offset -
+         gf_picture[gf_picture[frame_idx].ref_frame[rf_idx]].frame_offset;
+  if (seed_dist == 0) return NULL;
+  seed->row = (stats->mv.as_mv.row * dist / seed_dist + 4) >> 3;
+  seed->col = (stats->mv.as_mv.col * dist / seed_dist + 4) >> 3;
+  return seed;
+}
 #endif
 
 static int get_overlap_area(int grid_pos_row, int grid_pos_col, int ref_pos_row,
@@ -6678,7 +6914,7 @@ static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
                             tran_low_t *qcoeff, tran_low_t *dqcoeff, int mi_row,
                             int mi_col, BLOCK_SIZE bsize, TX_SIZE tx_size,
                             YV12_BUFFER_CONFIG *ref_frame[], uint8_t *predictor,
-                            int64_t *recon_error, int64_t *sse) {
+                            int seed_idx, int64_t *recon_error, int64_t *sse) {
   VP9_COMMON *cm = &cpi->common;
   ThreadData *td = &cpi->td;
 
@@ -6756,18 +6992,27 @@ static void mode_estimation(VP9_COMP *cpi, MACROBLOCK *x, MACROBLOCKD *xd,
     int_mv mv;
 #if CONFIG_NON_GREEDY_MV
     MotionField *motion_field;
+#else
+    MV seed_mv;
 #endif
     if (ref_frame[rf_idx] == NULL) continue;
 
 #if CONFIG_NON_GREEDY_MV
     (void)td;
+    (void)seed_idx;
     motion_field = vp9_motion_field_info_get_motion_field(
         &cpi->motion_field_info, frame_idx, rf_idx, bsize);
     mv = vp9_motion_field_mi_get_mv(motion_field, mi_row, mi_col);
 #else
-    motion_compensated_prediction(cpi, td, xd->cur_buf->y_buffer + mb_y_offset,
-                                  ref_frame[rf_idx]->y_buffer + mb_y_offset,
-                                  xd->cur_buf->y_stride, bsize, &mv.as_mv);
+    motion_compensated_prediction(
+        cpi, td, xd->cur_buf->y_buffer + mb_y_offset,
+        ref_frame[rf_idx]->y_buffer + mb_y_offset, xd->cur_buf->y_stride,
+        gf_picture[frame_idx].pyramid,
+        gf_picture[gf_picture[frame_idx].ref_frame[rf_idx]].pyramid, mi_row,
+        mi_col, bsize,
+        get_tpl_mv_seed(cpi, gf_picture, frame_idx, rf_idx, seed_idx, mi_row,
+                        mi_col, &seed_mv),
+        &mv.as_mv);
 #endif
 
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -7265,6 +7510,9 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
 #if CONFIG_NON_GREEDY_MV
   int square_block_idx;
   int rf_idx;
+  const int seed_idx = -1;
+#else
+  const int seed_idx = get_tpl_seed_frame(cpi, gf_picture, frame_idx);
 #endif
 
   // Setup scaling factor
@@ -7326,7 +7574,8 @@ static void mc_flow_dispenser(VP9_COMP *cpi, GF_PICTURE *gf_picture,
     for (mi_col = 0; mi_col < cm->mi_cols; mi_col += mi_width) {
       mode_estimation(cpi, x, xd, &sf, gf_picture, frame_idx, tpl_frame,
                       src_diff, coeff, qcoeff, dqcoeff, mi_row, mi_col, bsize,
-                      tx_size, ref_frame, predictor, &recon_error, &sse);
+                      tx_size, ref_frame, predictor, seed_idx, &recon_error,
+                      &sse);
       // Motion flow dependency dispenser.
       tpl_model_store(tpl_frame->tpl_stats_ptr, mi_row, mi_col, bsize,
                       tpl_frame->stride);
@@ -7542,6 +7791,35 @@ static void accumulate_frame_tpl_stats(VP9_COMP *cpi) {
 }
 #endif  // CONFIG_RATE_CTRL
 
+// In low-memory lookahead mode the queued frames have no border. The frames
+// searched by one mc_flow_dispenser() step, the frame and its references, get
+// a bordered copy for the step only, so at most 4 copies exist at a time.
+static void materialize_tpl_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
+                                   int frame_idx) {
+  int i;
+  for (i = -1; i < MAX_INTER_REF_FRAMES; ++i) {
+    const int idx = i < 0 ? frame_idx : gf_picture[frame_idx].ref_frame[i];
+    GF_PICTURE *const pic = idx < 0 ? NULL : &gf_picture[idx];
+    if (pic == NULL || pic->lookahead == NULL) continue;
+    pic->frame = vp9_lookahead_materialize(cpi->lookahead, pic->lookahead);
+    if (pic->frame == NULL)
+      vpx_internal_error(&cpi->common.error, VPX_CODEC_MEM_ERROR,
+                         "Failed to materialize lookahead frame");
+  }
+}
+
+static void release_tpl_frames(VP9_COMP *cpi, GF_PICTURE *gf_picture,
+                               int frame_idx) {
+  int i;
+  for (i = -1; i < MAX_INTER_REF_FRAMES; ++i) {
+    const int idx = i < 0 ? frame_idx : gf_picture[frame_idx].ref_frame[i];
+    GF_PICTURE *const pic = idx < 0 ? NULL : &gf_picture[idx];
+    if (pic == NULL || pic->lookahead == NULL) continue;
+    vp9_lookahead_release(cpi->lookahead, pic->lookahead);
+    pic->frame = &pic->lookahead->img;
+  }
+}
+
 static void setup_tpl_stats(VP9_COMP *cpi) {
   GF_PICTURE gf_picture[MAX_ARF_GOP_SIZE];
   const GF_GROUP *gf_group = &cpi->twopass.gf_group;
@@ -7549,14 +7827,28 @@ static void setup_tpl_stats(VP9_COMP *cpi) {
   int frame_idx;
   cpi->tpl_bsize = BLOCK_32X32;
 
+  memset(gf_picture, 0, sizeof(gf_picture));
   init_gop_frames(cpi, gf_picture, gf_group, &tpl_group_frames);
 
+  if (cpi->sf.mv.use_pyramid_search) {
+    for (frame_idx = 0; frame_idx < tpl_group_frames; ++frame_idx) {
+      // Pyramids are built from the queued images, as the bordered copies
+      // only exist during a step.
+      const YV12_BUFFER_CONFIG *const frame = gf_picture[frame_idx].frame;
+      if (frame != NULL)
+        gf_picture[frame_idx].pyramid =
+            vp9_pyramid_cache_get(&cpi->pyramid_cache, frame);
+    }
+  }
+
   init_tpl_stats(cpi);
 
   // Backward propagation from tpl_group_frames to 1.
   for (frame_idx = tpl_group_frames - 1; frame_idx > 0; --frame_idx) {
     if (gf_picture[frame_idx].update_type == USE_BUF_FRAME) continue;
+    materialize_tpl_frames(cpi, gf_picture, frame_idx);
     mc_flow_dispenser(cpi, gf_picture, frame_idx, cpi->tpl_bsize);
+    release_tpl_frames(cpi, gf_picture, frame_idx);
   }
 #if CONFIG_NON_GREEDY_MV
   cpi->tpl_ready = 1;
@@ -7606,6 +7898,82 @@ void vp9_init_encode_frame_result(ENCODE_FRAME_RESULT *encode_frame_result) {
 #endif  // CONFIG_RATE_CTRL
 }
 
+// Lowest cpu-used the automatic real-time speed control works with, and the
+// fastest level it moves to. Like the per layer speeds of SVC, it stays within
+// the speeds that use the non-RD mode search.
+#define AUTO_SPEED_MIN 5
+#define AUTO_SPEED_MAX 9
+// Number of consecutive fast frames before the speed level is lowered.
+#define AUTO_SPEED_DOWN_FRAMES 30
+
+static int use_auto_speed(const VP9_COMP *cpi) {
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+  return oxcf->rtc_target_frame_time > 0 && oxcf->mode == REALTIME &&
+         oxcf->pass == 0 && !cpi->use_svc && oxcf->speed >= AUTO_SPEED_MIN;
+}
+
+// Returns the speed level to encode the next frame with. cpu-used is the
+// slowest level allowed.
+static int get_auto_speed(VP9_COMP *cpi) {
+  AUTO_SPEED *const auto_speed = &cpi->auto_speed;
+  auto_speed->speed =
+      clamp(auto_speed->speed, cpi->oxcf.speed, AUTO_SPEED_MAX);
+  return auto_speed->speed;
+}
+
+// Moves the speed level to keep the encode time of a frame below 7/8 of the
+// target, leaving headroom for load spikes on the host. A frame taking more
+// than twice the target skips a level. The average restarts after every
+// change so that the next decision is based on the new level only.
+static void update_auto_speed(VP9_COMP *cpi, int64_t frame_time) {
+  AUTO_SPEED *const auto_speed = &cpi->auto_speed;
+  const int64_t target = cpi->oxcf.rtc_target_frame_time;
+  int step = 0;
+
+  auto_speed->avg_time = auto_speed->avg_time == 0
+                             ? frame_time
+                             : (3 * auto_speed->avg_time + frame_time) / 4;
+  if (frame_time > 2 * target) {
+    step = 2;
+  } else if (auto_speed->avg_time > target * 7 / 8) {
+    step = 1;
+  } else if (auto_speed->avg_time < target / 2) {
+    if (++auto_speed->frames_fast >= AUTO_SPEED_DOWN_FRAMES) step = -1;
+  } else {
+    auto_speed->frames_fast = 0;
+  }
+
+  if (step != 0) {
+    const int speed = clamp(auto_speed->speed + step, cpi->oxcf.speed,
+                            AUTO_SPEED_MAX);
+    auto_speed->frames_fast = 0;
+    if (speed != auto_speed->speed) {
+      auto_speed->speed = speed;
+      auto_speed->avg_time = 0;
+    }
+  }
+}
+
+// Keeps the references vp9_get_compressed_data() took on |source| and
+// |last_source| until the next frame, and drops the ones of the previous
+// frame.
+static void hold_sources(VP9_COMP *cpi, struct lookahead_entry *source,
+                         struct lookahead_entry *last_source) {
+  int i;
+  for (i = 0; i < 2; ++i) {
+    struct lookahead_entry *const entry = cpi->held_sources[i];
+    // A buffer reused by vp9_lookahead_push() has already dropped its copy.
+    if (entry != NULL && entry->show_idx == cpi->held_show_idx[i])
+      vp9_lookahead_release(cpi->lookahead, entry);
+  }
+  cpi->held_sources[0] = source;
+  cpi->held_sources[1] = last_source;
+  for (i = 0; i < 2; ++i) {
+    if (cpi->held_sources[i] != NULL)
+      cpi->held_show_idx[i] = cpi->held_sources[i]->show_idx;
+  }
+}
+
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest, int64_t *time_stamp,
                             int64_t *time_end, int flush,
@@ -7615,11 +7983,13 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   BufferPool *const pool = cm->buffer_pool;
   RATE_CONTROL *const rc = &cpi->rc;
   struct vpx_usec_timer cmptimer;
+  COMPONENT_TIMER component_timer;
   YV12_BUFFER_CONFIG *force_src_buffer = NULL;
   struct lookahead_entry *last_source = NULL;
   struct lookahead_entry *source = NULL;
   int arf_src_index;
   const int gf_group_index = cpi->twopass.gf_group.index;
+  int configured_speed;
   int i;
 
   if (is_one_pass_cbr_svc(cpi)) {
@@ -7628,6 +7998,9 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 
   vpx_usec_timer_start(&cmptimer);
 
+  // Frame buffers may have been rewritten since the last call.
+  vp9_pyramid_cache_clear(&cpi->pyramid_cache);
+
   vp9_set_high_precision_mv(cpi, ALTREF_HIGH_PRECISION_MV);
 
   // Is multi-arf enabled.
@@ -7687,7 +8060,10 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
         not_last_frame |= ALT_REF_AQ_APPLY_TO_LAST_FRAME;
 
         // Produce the filtered ARF frame.
+        vp9_component_timer_start(&cpi->component_timing, &component_timer);
         vp9_temporal_filter(cpi, arf_src_index);
+        vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                                 VP9E_TIMING_TEMPORAL_FILTER);
         vpx_extend_frame_borders(&cpi->alt_ref_buffer);
 
         // for small bitrates segmentation overhead usually
@@ -7740,8 +8116,16 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   }
 
   if (source) {
-    cpi->un_scaled_source = cpi->Source =
-        force_src_buffer ? force_src_buffer : &source->img;
+    YV12_BUFFER_CONFIG *source_img = force_src_buffer;
+    if (source_img == NULL) {
+      // This stays materialized until the next frame, so looking it up again
+      // as last_source then is free.
+      source_img = vp9_lookahead_materialize(cpi->lookahead, source);
+      if (source_img == NULL)
+        vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                           "Failed to materialize lookahead frame");
+    }
+    cpi->un_scaled_source = cpi->Source = source_img;
 
 #ifdef ENABLE_KF_DENOISE
     // Copy of raw source for metrics calculation.
@@ -7749,7 +8133,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
       vp9_copy_and_extend_frame(cpi->Source, &cpi->raw_unscaled_source);
 #endif
 
-    cpi->unscaled_last_source = last_source != NULL ? &last_source->img : NULL;
+    cpi->unscaled_last_source =
+        last_source != NULL
+            ? vp9_lookahead_materialize(cpi->lookahead, last_source)
+            : NULL;
+    hold_sources(cpi, force_src_buffer == NULL ? source : NULL, last_source);
 
     *time_stamp = source->ts_start;
     *time_end = source->ts_end;
@@ -7845,9 +8233,12 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   if (gf_group_index == 1 &&
       cpi->twopass.gf_group.update_type[gf_group_index] == ARF_UPDATE &&
       cpi->sf.enable_tpl_model) {
+    vp9_component_timer_start(&cpi->component_timing, &component_timer);
     init_tpl_buffer(cpi);
     vp9_estimate_qp_gop(cpi);
     setup_tpl_stats(cpi);
+    vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                             VP9E_TIMING_TPL);
   }
 
 #if CONFIG_BITSTREAM_DEBUG
@@ -7859,6 +8250,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   bitstream_queue_set_frame_write(cm->current_video_frame * 2 + cm->show_frame);
 #endif
 
+  // The speed level only overrides cpu-used for the duration of this frame.
+  configured_speed = cpi->oxcf.speed;
+  if (use_auto_speed(cpi)) cpi->oxcf.speed = get_auto_speed(cpi);
+  cpi->auto_speed.last_speed = cpi->oxcf.speed;
+
   cpi->td.mb.fp_src_pred = 0;
 #if CONFIG_REALTIME_ONLY
   (void)encode_frame_result;
@@ -7883,7 +8279,10 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     cpi->td.mb.fwd_txfm4x4 = lossless ? vp9_fwht4x4 : vpx_fdct4x4;
 #endif  // CONFIG_VP9_HIGHBITDEPTH
     cpi->td.mb.inv_txfm_add = lossless ? vp9_iwht4x4_add : vp9_idct4x4_add;
+    vp9_component_timer_start(&cpi->component_timing, &component_timer);
     vp9_first_pass(cpi, source);
+    vp9_component_timer_stop(&cpi->component_timing, &component_timer,
+                             VP9E_TIMING_FIRST_PASS);
   } else if (oxcf->pass == 2 && !cpi->use_svc) {
     Pass2Encode(cpi, size, dest, frame_flags, encode_frame_result);
     vp9_twopass_postencode_update(cpi);
@@ -7895,6 +8294,8 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   }
 #endif  // CONFIG_REALTIME_ONLY
 
+  cpi->oxcf.speed = configured_speed;
+
   if (cm->show_frame) cm->cur_show_frame_fb_idx = cm->new_fb_idx;
 
   if (cm->refresh_frame_context)
@@ -7919,6 +8320,11 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   vpx_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += vpx_usec_timer_elapsed(&cmptimer);
 
+  // Key frames are not representative of the time taken by the next frames,
+  // and dropped frames cost next to nothing.
+  if (use_auto_speed(cpi) && *size > 0 && !frame_is_intra_only(cm))
+    update_auto_speed(cpi, vpx_usec_timer_elapsed(&cmptimer));
+
   if (cpi->keep_level_stats && oxcf->pass != 1)
     update_level_info(cpi, size, arf_src_index);
 
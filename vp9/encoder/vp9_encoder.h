@@ -36,6 +36,9 @@
 #include "vp9/encoder/vp9_alt_ref_aq.h"
 #endif
 #include "vp9/encoder/vp9_aq_cyclicrefresh.h"
+#include "vp9/encoder/vp9_block_hash.h"
+#include "vp9/encoder/vp9_component_timing.h"
+#include "vp9/encoder/vp9_content_analysis.h"
 #include "vp9/encoder/vp9_context_tree.h"
 #include "vp9/encoder/vp9_encodemb.h"
 #include "vp9/encoder/vp9_ethread.h"
@@ -50,6 +53,8 @@
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
 #include "vp9/encoder/vp9_speed_features.h"
+#include "vp9/encoder/vp9_pyramid.h"
+#include "vp9/encoder/vp9_subpel_cache.h"
 #include "vp9/encoder/vp9_svc_layercontext.h"
 #include "vp9/encoder/vp9_tokenize.h"
 
@@ -288,12 +293,35 @@ typedef struct VP9EncoderConfig {
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
   int use_simple_encode_api;  // Use SimpleEncode APIs or not
+  // Store lookahead frames without borders, see vp9_lookahead_materialize().
+  int low_memory_lookahead;
+  // Target encode time per frame in microseconds for the automatic real-time
+  // speed control, 0 to always encode at |speed|.
+  unsigned int rtc_target_frame_time;
+  // SUBPEL_CACHE_LEVEL for the sub-pixel motion search, -1 for the default
+  // of the speed level.
+  int subpel_cache;
+  // TRELLIS_OPT_TYPE of the quantized coefficients, -1 for the default of the
+  // speed level.
+  int trellis_opt;
+  // Seeds the temporal filter and tpl model motion searches with the motion
+  // of the neighboring frames. Sets sf.mv.use_temporal_mv_seeds.
+  int temporal_mv_seeds;
 } VP9EncoderConfig;
 
 static INLINE int is_lossless_requested(const VP9EncoderConfig *cfg) {
   return cfg->best_allowed_q == 0 && cfg->worst_allowed_q == 0;
 }
 
+// State of the automatic real-time speed control, see
+// VP9EncoderConfig::rtc_target_frame_time.
+typedef struct AUTO_SPEED {
+  int speed;         // Speed level of the next frame.
+  int last_speed;    // Speed level the last frame was encoded with.
+  int64_t avg_time;  // Average encode time at |speed| in us, 0 if unknown.
+  int frames_fast;   // Consecutive frames encoded in under half the target.
+} AUTO_SPEED;
+
 typedef struct TplDepStats {
   int64_t intra_cost;
   int64_t inter_cost;
@@ -391,6 +419,18 @@ typedef struct ThreadData {
   PICK_MODE_CONTEXT *leaf_tree;
   PC_TREE *pc_tree;
   PC_TREE *pc_root;
+
+  // Wall and thread CPU time spent in vp9_tokenize_sb(), only updated when
+  // component timing is enabled.
+  int64_t tokenize_wall_time;
+  int64_t tokenize_cpu_time;
+
+  // CPU time of the worker thread running this ThreadData since the last
+  // join, only updated when component timing is enabled.
+  int64_t worker_cpu_time;
+
+  // Search statistics of the frame being encoded, see VP9E_GET_SEARCH_STATS.
+  vpx_search_stats_t search_counts;
 } ThreadData;
 
 struct EncWorkerData;
@@ -498,8 +538,28 @@ typedef struct {
   double max_cpb_size;  // in bits
 } LevelConstraint;
 
+typedef enum {
+  RECODE_MV_OFF,
+  // The encoding stores its motion search results.
+  RECODE_MV_STORE,
+  // The encoding reuses the stored results.
+  RECODE_MV_REUSE,
+} RECODE_MV_MODE;
+
+// Single reference motion search result of a block.
+typedef struct RECODE_MV {
+  int_mv mv;
+  unsigned int pred_sse;
+} RECODE_MV;
+
+// Search results are stored for the square and rectangular blocks from
+// BLOCK_8X8 up.
+#define RECODE_MV_BLOCK_SIZES (BLOCK_SIZES - BLOCK_8X8)
+
 typedef struct ARNRFilterData {
   YV12_BUFFER_CONFIG *frames[MAX_LAG_BUFFERS];
+  // Pyramids of |frames|, NULL when the pyramid search is off.
+  const ImagePyramid *pyramids[MAX_LAG_BUFFERS];
   int strength;
   int frame_count;
   int alt_ref_index;
@@ -670,6 +730,10 @@ typedef struct VP9_COMP {
   VP9EncoderConfig oxcf;
   struct lookahead_ctx *lookahead;
   struct lookahead_entry *alt_ref_source;
+  // Entries materialized for Source and Last_Source, released once the next
+  // frame has materialized its own, with their show_idx at that time.
+  struct lookahead_entry *held_sources[2];
+  int held_show_idx[2];
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -799,6 +863,32 @@ typedef struct VP9_COMP {
   uint64_t time_pick_lpf;
   uint64_t time_encode_sb_row;
 
+  COMPONENT_TIMING component_timing;
+  vpx_search_stats_t search_stats;
+  AUTO_SPEED auto_speed;
+  SubpelCache subpel_cache;
+  ContentAnalysis content_analysis;
+  // Pyramids of the frames of the current call to
+  // vp9_get_compressed_data().
+  PyramidCache pyramid_cache;
+  // Motion of the frame being coded relative to each reference, set up by
+  // vp9_setup_pyramids(). Empty when the pyramid search is off.
+  PyramidMotionField pyramid_field[MAX_REF_FRAMES];
+  // Block hash tables of the frame buffers in hash_table_buf_idx,
+  // INVALID_IDX for unused tables, kept while the buffers hold the same
+  // frame.
+  BlockHashTable hash_tables[REFS_PER_FRAME];
+  int hash_table_buf_idx[REFS_PER_FRAME];
+  // Table of each reference of the frame being coded, set up by
+  // vp9_setup_hash_tables(). NULL when the hash search is off.
+  const BlockHashTable *hash_table[MAX_REF_FRAMES];
+  // Motion search results of the first encoding of the frame at its current
+  // size, indexed by get_recode_mv_index(), and what the current encoding
+  // does with them.
+  RECODE_MV_MODE recode_mv_mode;
+  RECODE_MV *recode_mvs;
+  int recode_mvs_size;
+
   TWO_PASS twopass;
 
   // Force recalculation of segment_ids for each mode info
@@ -1285,6 +1375,24 @@ int64_t vp9_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
 
 void vp9_scale_references(VP9_COMP *cpi);
 
+// Estimates pyramid_field for the references in |ref_flags|, or empties it
+// when the pyramid search is off.
+void vp9_setup_pyramids(VP9_COMP *cpi, int ref_flags);
+
+static INLINE int get_recode_mv_index(const VP9_COMMON *cm, int mi_row,
+                                      int mi_col, BLOCK_SIZE bsize,
+                                      MV_REFERENCE_FRAME ref_frame) {
+  assert(bsize >= BLOCK_8X8 && ref_frame >= LAST_FRAME);
+  return ((mi_row * cm->mi_cols + mi_col) * RECODE_MV_BLOCK_SIZES + bsize -
+          BLOCK_8X8) *
+             REFS_PER_FRAME +
+         ref_frame - LAST_FRAME;
+}
+
+// Sets up hash_table for the references of the frame being coded, building
+// the tables of the buffers not hashed yet.
+void vp9_setup_hash_tables(VP9_COMP *cpi);
+
 void vp9_update_reference_frames(VP9_COMP *cpi);
 
 void vp9_get_ref_frame_info(FRAME_UPDATE_TYPE update_type, int ref_frame_flags,
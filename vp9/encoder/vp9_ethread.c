@@ -17,6 +17,7 @@
 #include "vp9/encoder/vp9_multi_thread.h"
 #include "vp9/encoder/vp9_temporal_filter.h"
 #include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_util/vpx_trace.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
   int i, j, k, l, m, n;
@@ -47,13 +48,17 @@ static int enc_worker_hook(void *arg1, void *unused) {
 
   (void)unused;
 
+  VPX_TRACE_BEGIN("enc_worker_hook");
   for (t = thread_data->start; t < tile_rows * tile_cols;
        t += cpi->num_workers) {
     int tile_row = t / tile_cols;
     int tile_col = t % tile_cols;
 
+    VPX_TRACE_BEGIN_JOB("encode_tile", t, -1);
     vp9_encode_tile(cpi, thread_data->td, tile_row, tile_col);
+    VPX_TRACE_END("encode_tile");
   }
+  VPX_TRACE_END("enc_worker_hook");
 
   return 0;
 }
@@ -137,15 +142,30 @@ static void create_enc_workers(VP9_COMP *cpi, int num_workers) {
   }
 }
 
+// Runs the stage hook of a worker thread and charges its CPU time to the
+// worker's ThreadData for the component timing.
+static int timed_enc_worker_hook(void *arg1, void *arg2) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  const int64_t cpu_start = vpx_thread_cpu_usec();
+  const int ret = thread_data->hook(arg1, arg2);
+  thread_data->td->worker_cpu_time += vpx_thread_cpu_usec() - cpu_start;
+  return ret;
+}
+
 static void launch_enc_workers(VP9_COMP *cpi, VPxWorkerHook hook, void *data2,
                                int num_workers) {
   const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  const int timed = VP9_TIME_WORKER_THREADS && cpi->component_timing.enabled;
   int i;
 
   for (i = 0; i < num_workers; i++) {
     VPxWorker *const worker = &cpi->workers[i];
-    worker->hook = hook;
-    worker->data1 = &cpi->tile_thr_data[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+    thread_data->hook = hook;
+    // The last worker runs on the calling thread, whose clock already counts.
+    worker->hook =
+        timed && i != cpi->num_workers - 1 ? timed_enc_worker_hook : hook;
+    worker->data1 = thread_data;
     worker->data2 = data2;
   }
 
@@ -168,6 +188,16 @@ static void launch_enc_workers(VP9_COMP *cpi, VPxWorkerHook hook, void *data2,
     VPxWorker *const worker = &cpi->workers[i];
     winterface->sync(worker);
   }
+
+  // Accumulate the CPU time of the worker threads.
+  if (timed) {
+    for (i = 0; i < num_workers; i++) {
+      ThreadData *const td = cpi->tile_thr_data[i].td;
+      if (i == cpi->num_workers - 1) continue;
+      cpi->component_timing.worker_cpu_us += td->worker_cpu_time;
+      td->worker_cpu_time = 0;
+    }
+  }
 }
 
 void vp9_encode_free_mt_data(struct VP9_COMP *cpi) {
@@ -208,7 +238,12 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
+      if (cpi->td.mb.search_counts != NULL)
+        thread_data->td->mb.search_counts = &thread_data->td->search_counts;
       thread_data->td->rd_counts = cpi->td.rd_counts;
+      vp9_zero(thread_data->td->search_counts);
+      if (cpi->sf.reuse_rd_inter_pred && !cpi->sf.use_nonrd_pick_mode)
+        vp9_alloc_pc_tree_inter_pred(cm, thread_data->td);
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -243,6 +278,8 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     if (i < cpi->num_workers - 1) {
       vp9_accumulate_frame_counts(&cm->counts, thread_data->td->counts, 0);
       accumulate_rd_opt(&cpi->td, thread_data->td);
+      vp9_accumulate_search_stats(&cpi->td.search_counts,
+                                  &thread_data->td->search_counts);
     }
   }
 }
@@ -352,8 +389,12 @@ void vp9_row_mt_sync_read(VP9RowMTSync *const row_mt_sync, int r, int c) {
     pthread_mutex_t *const mutex = &row_mt_sync->mutex[r - 1];
     pthread_mutex_lock(mutex);
 
-    while (c > row_mt_sync->cur_col[r - 1] - nsync + 1) {
-      pthread_cond_wait(&row_mt_sync->cond[r - 1], mutex);
+    if (c > row_mt_sync->cur_col[r - 1] - nsync + 1) {
+      VPX_TRACE_BEGIN_JOB("row_mt_sync_read", -1, r);
+      while (c > row_mt_sync->cur_col[r - 1] - nsync + 1) {
+        pthread_cond_wait(&row_mt_sync->cond[r - 1], mutex);
+      }
+      VPX_TRACE_END("row_mt_sync_read");
     }
     pthread_mutex_unlock(mutex);
   }
@@ -429,6 +470,7 @@ static int first_pass_worker_hook(void *arg1, void *arg2) {
   MV best_ref_mv;
   int mb_row;
 
+  VPX_TRACE_BEGIN("first_pass_worker_hook");
   end_of_frame = 0;
   while (0 == end_of_frame) {
     // Get the next job in the queue
@@ -446,13 +488,16 @@ static int first_pass_worker_hook(void *arg1, void *arg2) {
       this_tile = &cpi->tile_data[tile_row * tile_cols + tile_col];
       mb_row = proc_job->vert_unit_row_num;
 
+      VPX_TRACE_BEGIN_JOB("first_pass_mb_row", tile_col, mb_row);
       best_ref_mv = zero_mv;
       vp9_zero(fp_acc_data);
       fp_acc_data.image_data_start_row = INVALID_ROW;
       vp9_first_pass_encode_tile_mb_row(cpi, thread_data->td, &fp_acc_data,
                                         this_tile, &best_ref_mv, mb_row);
+      VPX_TRACE_END("first_pass_mb_row");
     }
   }
+  VPX_TRACE_END("first_pass_worker_hook");
   return 0;
 }
 
@@ -490,6 +535,8 @@ void vp9_encode_fp_row_mt(VP9_COMP *cpi) {
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
+      if (cpi->td.mb.search_counts != NULL)
+        thread_data->td->mb.search_counts = &thread_data->td->search_counts;
     }
   }
 
@@ -518,6 +565,7 @@ static int temporal_filter_worker_hook(void *arg1, void *arg2) {
   JobNode *proc_job = NULL;
   int mb_row;
 
+  VPX_TRACE_BEGIN("temporal_filter_worker_hook");
   end_of_frame = 0;
   while (0 == end_of_frame) {
     // Get the next job in the queue
@@ -536,10 +584,13 @@ static int temporal_filter_worker_hook(void *arg1, void *arg2) {
       mb_col_end = (this_tile->tile_info.mi_col_end + TF_ROUND) >> TF_SHIFT;
       mb_row = proc_job->vert_unit_row_num;
 
+      VPX_TRACE_BEGIN_JOB("temporal_filter_row", tile_col, mb_row);
       vp9_temporal_filter_iterate_row_c(cpi, thread_data->td, mb_row,
                                         mb_col_start, mb_col_end);
+      VPX_TRACE_END("temporal_filter_row");
     }
   }
+  VPX_TRACE_END("temporal_filter_worker_hook");
   return 0;
 }
 
@@ -574,6 +625,8 @@ void vp9_temporal_filter_row_mt(VP9_COMP *cpi) {
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
+      if (cpi->td.mb.search_counts != NULL)
+        thread_data->td->mb.search_counts = &thread_data->td->search_counts;
     }
   }
 
@@ -582,6 +635,50 @@ void vp9_temporal_filter_row_mt(VP9_COMP *cpi) {
 }
 #endif  // !CONFIG_REALTIME_ONLY
 
+static int subpel_cache_worker_hook(void *arg1, void *arg2) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  VP9_COMP *const cpi = thread_data->cpi;
+  const int pass = *(const int *)arg2;
+
+  VPX_TRACE_BEGIN("subpel_cache_worker_hook");
+  vp9_subpel_cache_build_jobs(&cpi->subpel_cache, pass, thread_data->start,
+                              cpi->num_workers);
+  VPX_TRACE_END("subpel_cache_worker_hook");
+  return 0;
+}
+
+void vp9_subpel_cache_build_mt(VP9_COMP *cpi, int num_workers) {
+  int pass;
+
+  create_enc_workers(cpi, num_workers);
+
+  // The vertical pass reads the output of the horizontal pass in the rows
+  // around its own, so every pass waits for the workers to finish.
+  for (pass = 0; pass < 2; ++pass) {
+    launch_enc_workers(cpi, subpel_cache_worker_hook, &pass,
+                       cpi->num_workers);
+  }
+  vp9_subpel_cache_enable(&cpi->subpel_cache);
+}
+
+static int content_analysis_worker_hook(void *arg1, void *arg2) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  VP9_COMP *const cpi = thread_data->cpi;
+  const int num_workers = *(const int *)arg2;
+
+  VPX_TRACE_BEGIN("content_analysis_worker_hook");
+  vp9_content_analysis_jobs(cpi, thread_data->start, num_workers);
+  VPX_TRACE_END("content_analysis_worker_hook");
+  return 0;
+}
+
+void vp9_content_analysis_mt(VP9_COMP *cpi, int num_jobs, int num_workers) {
+  create_enc_workers(cpi, num_workers);
+  num_workers = VPXMIN(cpi->num_workers, num_jobs);
+  launch_enc_workers(cpi, content_analysis_worker_hook, &num_workers,
+                     num_workers);
+}
+
 static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
   EncWorkerData *const thread_data = (EncWorkerData *)arg1;
   MultiThreadHandle *multi_thread_ctxt = (MultiThreadHandle *)arg2;
@@ -595,6 +692,7 @@ static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
   JobNode *proc_job = NULL;
   int mi_row;
 
+  VPX_TRACE_BEGIN("enc_row_mt_worker_hook");
   end_of_frame = 0;
   while (0 == end_of_frame) {
     // Get the next job in the queue
@@ -610,9 +708,13 @@ static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
       tile_row = proc_job->tile_row_id;
       mi_row = proc_job->vert_unit_row_num * MI_BLOCK_SIZE;
 
+      VPX_TRACE_BEGIN_JOB("encode_sb_row", tile_col,
+                          proc_job->vert_unit_row_num);
       vp9_encode_sb_row(cpi, thread_data->td, tile_row, tile_col, mi_row);
+      VPX_TRACE_END("encode_sb_row");
     }
   }
+  VPX_TRACE_END("enc_row_mt_worker_hook");
   return 0;
 }
 
@@ -648,7 +750,12 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
+      if (cpi->td.mb.search_counts != NULL)
+        thread_data->td->mb.search_counts = &thread_data->td->search_counts;
       thread_data->td->rd_counts = cpi->td.rd_counts;
+      vp9_zero(thread_data->td->search_counts);
+      if (cpi->sf.reuse_rd_inter_pred && !cpi->sf.use_nonrd_pick_mode)
+        vp9_alloc_pc_tree_inter_pred(cm, thread_data->td);
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -684,6 +791,8 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
     if (i < cpi->num_workers - 1) {
       vp9_accumulate_frame_counts(&cm->counts, thread_data->td->counts, 0);
       accumulate_rd_opt(&cpi->td, thread_data->td);
+      vp9_accumulate_search_stats(&cpi->td.search_counts,
+                                  &thread_data->td->search_counts);
     }
   }
 }
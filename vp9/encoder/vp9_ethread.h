@@ -11,6 +11,8 @@
 #ifndef VPX_VP9_ENCODER_VP9_ETHREAD_H_
 #define VPX_VP9_ENCODER_VP9_ETHREAD_H_
 
+#include "vpx_util/vpx_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -28,6 +30,8 @@ typedef struct EncWorkerData {
   int start;
   int thread_id;
   int tile_completion_status[MAX_NUM_TILE_COLS];
+  // Stage hook run by the timing wrapper when component timing is enabled.
+  VPxWorkerHook hook;
 } EncWorkerData;
 
 // Encoder row synchronization
@@ -70,6 +74,13 @@ void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync);
 
 void vp9_temporal_filter_row_mt(struct VP9_COMP *cpi);
 
+// Builds the planes of cpi->subpel_cache on |num_workers| threads.
+void vp9_subpel_cache_build_mt(struct VP9_COMP *cpi, int num_workers);
+
+// Runs the |num_jobs| jobs of cpi->content_analysis on |num_workers| threads.
+void vp9_content_analysis_mt(struct VP9_COMP *cpi, int num_jobs,
+                             int num_workers);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -163,6 +163,46 @@ void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                         et_uv, el_uv, eb_uv, er_uv, chroma_step);
 }
 
+void vp9_copy_frame_without_border(const YV12_BUFFER_CONFIG *src,
+                                   YV12_BUFFER_CONFIG *dst) {
+  // Only pad out to the aligned frame size of dst; there is no border.
+  const int eb_y = dst->y_height - src->y_crop_height;
+  const int er_y = dst->y_width - src->y_crop_width;
+  const int eb_uv = dst->uv_height - src->uv_crop_height;
+  const int er_uv = dst->uv_width - src->uv_crop_width;
+  // detect nv12 colorspace
+  const int chroma_step = src->v_buffer - src->u_buffer == 1 ? 2 : 1;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+    highbd_copy_and_extend_plane(src->y_buffer, src->y_stride, dst->y_buffer,
+                                 dst->y_stride, src->y_crop_width,
+                                 src->y_crop_height, 0, 0, eb_y, er_y);
+
+    highbd_copy_and_extend_plane(src->u_buffer, src->uv_stride, dst->u_buffer,
+                                 dst->uv_stride, src->uv_crop_width,
+                                 src->uv_crop_height, 0, 0, eb_uv, er_uv);
+
+    highbd_copy_and_extend_plane(src->v_buffer, src->uv_stride, dst->v_buffer,
+                                 dst->uv_stride, src->uv_crop_width,
+                                 src->uv_crop_height, 0, 0, eb_uv, er_uv);
+    return;
+  }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+  copy_and_extend_plane(src->y_buffer, src->y_stride, dst->y_buffer,
+                        dst->y_stride, src->y_crop_width, src->y_crop_height,
+                        0, 0, eb_y, er_y, 1);
+
+  copy_and_extend_plane(src->u_buffer, src->uv_stride, dst->u_buffer,
+                        dst->uv_stride, src->uv_crop_width, src->uv_crop_height,
+                        0, 0, eb_uv, er_uv, chroma_step);
+
+  copy_and_extend_plane(src->v_buffer, src->uv_stride, dst->v_buffer,
+                        dst->uv_stride, src->uv_crop_width, src->uv_crop_height,
+                        0, 0, eb_uv, er_uv, chroma_step);
+}
+
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
                                          YV12_BUFFER_CONFIG *dst, int srcy,
                                          int srcx, int srch, int srcw) {
@@ -21,6 +21,10 @@ extern "C" {
 void vp9_copy_and_extend_frame(const YV12_BUFFER_CONFIG *src,
                                YV12_BUFFER_CONFIG *dst);
 
+// Copies src into a borderless dst, padding only up to dst's aligned size.
+void vp9_copy_frame_without_border(const YV12_BUFFER_CONFIG *src,
+                                   YV12_BUFFER_CONFIG *dst);
+
 void vp9_copy_and_extend_frame_with_rect(const YV12_BUFFER_CONFIG *src,
                                          YV12_BUFFER_CONFIG *dst, int srcy,
                                          int srcx, int srch, int srcw);
@@ -1088,6 +1088,7 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
       int tmp_err, motion_error, this_motion_error, raw_motion_error;
       // Assume 0,0 motion with no mv overhead.
       MV mv = { 0, 0 }, tmp_mv = { 0, 0 };
+      const MV *field_mv;
       struct buf_2d unscaled_last_source_buf_2d;
       vp9_variance_fn_ptr_t v_fn_ptr = cpi->fn_ptr[bsize];
 
@@ -1162,6 +1163,27 @@ void vp9_first_pass_encode_tile_mb_row(VP9_COMP *cpi, ThreadData *td,
                 vp9_get_mvpred_var(x, &tmp_mv, &zero_mv, &v_fn_ptr, 0);
           }
         }
+
+        // Also search around the motion estimated on the pyramids, which
+        // catches motion beyond the reach of the searches above.
+        field_mv = vp9_pyramid_field_mv(&cpi->pyramid_field[LAST_FRAME],
+                                        mb_col * 16, mb_row * 16, 16, 16);
+        if (field_mv != NULL) {
+          const MV pyramid_mv = { field_mv->row * 8, field_mv->col * 8 };
+          if (!is_zero_mv(&pyramid_mv) &&
+              (pyramid_mv.row != best_ref_mv->row ||
+               pyramid_mv.col != best_ref_mv->col)) {
+            tmp_err = INT_MAX;
+            first_pass_motion_search(cpi, x, &pyramid_mv, &tmp_mv, &tmp_err);
+
+            if (tmp_err < motion_error) {
+              motion_error = tmp_err;
+              mv = tmp_mv;
+              this_motion_error =
+                  vp9_get_mvpred_var(x, &tmp_mv, &pyramid_mv, &v_fn_ptr, 0);
+            }
+          }
+        }
 #if CONFIG_RATE_CTRL
         if (cpi->oxcf.use_simple_encode_api) {
           store_fp_motion_vector(cpi, &mv, mb_row, mb_col, LAST_FRAME, 0);
@@ -1396,6 +1418,7 @@ void vp9_first_pass(VP9_COMP *cpi, const struct lookahead_entry *source) {
   if (!frame_is_intra_only(cm)) {
     vp9_setup_pre_planes(xd, 0, first_ref_buf, 0, 0, NULL);
   }
+  vp9_setup_pyramids(cpi, VP9_LAST_FLAG);
 
   xd->mi = cm->mi_grid_visible;
   xd->mi[0] = cm->mi;
@@ -29,14 +29,32 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx, int *idx) {
   return buf;
 }
 
+/* Hand the bordered copy of an entry back, keeping a few around for reuse */
+static void free_bordered(struct lookahead_ctx *ctx,
+                          struct lookahead_entry *entry) {
+  entry->bordered_refs = 0;
+  if (!entry->bordered.buffer_alloc) return;
+  if (ctx->num_spare < LOOKAHEAD_SPARE_BUFFERS) {
+    ctx->spare[ctx->num_spare++] = entry->bordered;
+  } else {
+    vpx_free_frame_buffer(&entry->bordered);
+  }
+  memset(&entry->bordered, 0, sizeof(entry->bordered));
+}
+
 void vp9_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
     if (ctx->buf) {
       int i;
 
-      for (i = 0; i < ctx->max_sz; i++) vpx_free_frame_buffer(&ctx->buf[i].img);
+      for (i = 0; i < ctx->max_sz; i++) {
+        vpx_free_frame_buffer(&ctx->buf[i].img);
+        vpx_free_frame_buffer(&ctx->buf[i].bordered);
+      }
       free(ctx->buf);
     }
+    while (ctx->num_spare > 0)
+      vpx_free_frame_buffer(&ctx->spare[--ctx->num_spare]);
     free(ctx);
   }
 }
@@ -48,8 +66,9 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 #if CONFIG_VP9_HIGHBITDEPTH
                                          int use_highbitdepth,
 #endif
-                                         unsigned int depth) {
+                                         unsigned int depth, int low_memory) {
   struct lookahead_ctx *ctx = NULL;
+  const int border = low_memory ? 0 : VP9_ENC_BORDER_IN_PIXELS;
 
   // Clamp the lookahead queue depth
   depth = clamp(depth, 1, MAX_LAG_BUFFERS);
@@ -63,6 +82,7 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
     const int legacy_byte_alignment = 0;
     unsigned int i;
     ctx->max_sz = depth;
+    ctx->low_memory = low_memory;
     ctx->buf = calloc(depth, sizeof(*ctx->buf));
     ctx->next_show_idx = 0;
     if (!ctx->buf) goto bail;
@@ -72,7 +92,7 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 #if CONFIG_VP9_HIGHBITDEPTH
               use_highbitdepth,
 #endif
-              VP9_ENC_BORDER_IN_PIXELS, legacy_byte_alignment))
+              border, legacy_byte_alignment))
         goto bail;
   }
   return ctx;
@@ -114,6 +134,7 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
   if (vp9_lookahead_full(ctx)) return 1;
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  free_bordered(ctx, buf);
 
   new_dimensions = width != buf->img.y_crop_width ||
                    height != buf->img.y_crop_height ||
@@ -172,7 +193,8 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
 #if CONFIG_VP9_HIGHBITDEPTH
                                  use_highbitdepth,
 #endif
-                                 VP9_ENC_BORDER_IN_PIXELS, 0))
+                                 ctx->low_memory ? 0 : VP9_ENC_BORDER_IN_PIXELS,
+                                 0))
         return 1;
       vpx_free_frame_buffer(&buf->img);
       buf->img = new_img;
@@ -185,7 +207,10 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
       buf->img.subsampling_y = src->subsampling_y;
     }
     // Partial copy not implemented yet
-    vp9_copy_and_extend_frame(src, &buf->img);
+    if (ctx->low_memory)
+      vp9_copy_frame_without_border(src, &buf->img);
+    else
+      vp9_copy_and_extend_frame(src, &buf->img);
 #if USE_PARTIAL_COPY
   }
 #endif
@@ -233,3 +258,34 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
 }
 
 unsigned int vp9_lookahead_depth(struct lookahead_ctx *ctx) { return ctx->sz; }
+
+YV12_BUFFER_CONFIG *vp9_lookahead_materialize(struct lookahead_ctx *ctx,
+                                              struct lookahead_entry *entry) {
+  YV12_BUFFER_CONFIG *const img = &entry->img;
+
+  if (!ctx->low_memory) return img;
+
+  if (!entry->bordered_refs) {
+    if (!entry->bordered.buffer_alloc && ctx->num_spare > 0) {
+      entry->bordered = ctx->spare[--ctx->num_spare];
+      memset(&ctx->spare[ctx->num_spare], 0, sizeof(ctx->spare[0]));
+    }
+    if (vpx_realloc_frame_buffer(
+            &entry->bordered, img->y_crop_width, img->y_crop_height,
+            img->subsampling_x, img->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+            (img->flags & YV12_FLAG_HIGHBITDEPTH) != 0,
+#endif
+            VP9_ENC_BORDER_IN_PIXELS, 0, NULL, NULL, NULL))
+      return NULL;
+    vp9_copy_and_extend_frame(img, &entry->bordered);
+  }
+  ++entry->bordered_refs;
+  return &entry->bordered;
+}
+
+void vp9_lookahead_release(struct lookahead_ctx *ctx,
+                           struct lookahead_entry *entry) {
+  if (!ctx->low_memory || !entry->bordered_refs) return;
+  if (--entry->bordered_refs == 0) free_bordered(ctx, entry);
+}
@@ -27,11 +27,19 @@ struct lookahead_entry {
   int64_t ts_end;
   int show_idx; /*The show_idx of this frame*/
   vpx_enc_frame_flags_t flags;
+  /* In low-memory mode, img is stored without borders and this holds the
+   * bordered copy handed out by vp9_lookahead_materialize(). */
+  YV12_BUFFER_CONFIG bordered;
+  int bordered_refs; /* Outstanding vp9_lookahead_materialize() calls */
 };
 
 // The max of past frames we want to keep in the queue.
 #define MAX_PRE_FRAMES 1
 
+// Released bordered buffers kept for reuse in low-memory mode: one per frame
+// searched by a tpl step, the frame and its 3 references.
+#define LOOKAHEAD_SPARE_BUFFERS 4
+
 struct lookahead_ctx {
   int max_sz;        /* Absolute size of the queue */
   int sz;            /* Number of buffers currently in the queue */
@@ -39,13 +47,20 @@ struct lookahead_ctx {
   int write_idx;     /* Write index */
   int next_show_idx; /* The show_idx that will be assigned to the next frame
                         being pushed in the queue*/
+  int low_memory;    /* Store frames without borders, see lookahead_entry */
   struct lookahead_entry *buf; /* Buffer list */
+  /* Released bordered buffers kept for reuse */
+  YV12_BUFFER_CONFIG spare[LOOKAHEAD_SPARE_BUFFERS];
+  int num_spare;
 };
 
 /**\brief Initializes the lookahead stage
  *
  * The lookahead stage is a queue of frame buffers on which some analysis
  * may be done when buffers are enqueued.
+ *
+ * When low_memory is set the queued frames are stored without borders and a
+ * bordered copy is only built on demand by vp9_lookahead_materialize().
  */
 struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
                                          unsigned int height,
@@ -54,7 +69,7 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 #if CONFIG_VP9_HIGHBITDEPTH
                                          int use_highbitdepth,
 #endif
-                                         unsigned int depth);
+                                         unsigned int depth, int low_memory);
 
 /**\brief Destroys the lookahead stage
  */
@@ -120,6 +135,30 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
  */
 unsigned int vp9_lookahead_depth(struct lookahead_ctx *ctx);
 
+/**\brief Get the bordered frame of a queued buffer
+ *
+ * Returns a frame with the border extension expected by motion search and
+ * the block-based source readers. Outside of low-memory mode this is simply
+ * the queued image. In low-memory mode a bordered copy is built on the first
+ * call and kept until the matching number of vp9_lookahead_release() calls,
+ * or until the buffer is reused by vp9_lookahead_push().
+ *
+ * \param[in] ctx       Pointer to the lookahead context
+ * \param[in] entry     Buffer returned by vp9_lookahead_pop/peek
+ *
+ * \retval NULL, if the bordered copy could not be allocated
+ */
+YV12_BUFFER_CONFIG *vp9_lookahead_materialize(struct lookahead_ctx *ctx,
+                                              struct lookahead_entry *entry);
+
+/**\brief Drop a reference taken by vp9_lookahead_materialize()
+ *
+ * \param[in] ctx       Pointer to the lookahead context
+ * \param[in] entry     Buffer passed to vp9_lookahead_materialize()
+ */
+void vp9_lookahead_release(struct lookahead_ctx *ctx,
+                           struct lookahead_entry *entry);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -383,11 +383,16 @@ void vp9_update_mbgraph_stats(VP9_COMP *cpi) {
   for (i = 0; i < n_frames; i++) {
     MBGRAPH_FRAME_STATS *frame_stats = &cpi->mbgraph_stats[i];
     struct lookahead_entry *q_cur = vp9_lookahead_peek(cpi->lookahead, i);
+    YV12_BUFFER_CONFIG *cur;
 
     assert(q_cur != NULL);
 
-    update_mbgraph_frame_stats(cpi, frame_stats, &q_cur->img, golden_ref,
-                               cpi->Source);
+    cur = vp9_lookahead_materialize(cpi->lookahead, q_cur);
+    if (cur == NULL)
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "Failed to materialize lookahead frame");
+    update_mbgraph_frame_stats(cpi, frame_stats, cur, golden_ref, cpi->Source);
+    vp9_lookahead_release(cpi->lookahead, q_cur);
   }
 
   vpx_clear_system_state();
@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
@@ -150,6 +151,24 @@ void vp9_init3smotion_compensation(search_site_config *cfg, int stride) {
   cfg->total_steps = ss_count / cfg->searches_per_step;
 }
 
+// Adds the work of one search to the search statistics, if they are enabled.
+// The searches count their evaluations locally so the pointer is only
+// checked once per search.
+static INLINE void count_sub_pel_search(const MACROBLOCK *x, int evals) {
+  if (x->search_counts != NULL) {
+    ++x->search_counts->sub_pel_searches;
+    x->search_counts->sub_pel_evals += evals;
+  }
+}
+
+static INLINE void count_full_pel_work(const MACROBLOCK *x, int steps,
+                                       int sads) {
+  if (x->search_counts != NULL) {
+    x->search_counts->full_pel_steps += steps;
+    x->search_counts->full_pel_sads += sads;
+  }
+}
+
 // convert motion vector component to offset for sv[a]f calc
 static INLINE int sp(int x) { return x & 7; }
 
@@ -157,6 +176,35 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
   return &buf[(r >> 3) * stride + (c >> 3)];
 }
 
+// vfp->svf() of the |w|x|h| block, served from the interpolated planes of
+// x->subpel_cache when it holds the block.
+static unsigned int cached_subpel_variance(
+    const MACROBLOCK *x, const vp9_variance_fn_ptr_t *vfp,
+    const uint8_t *pre_buf, int pre_stride, int xoffset, int yoffset,
+    const uint8_t *src, int src_stride, int w, int h, unsigned int *sse) {
+  const uint8_t *const cached = vp9_subpel_cache_get(
+      x->subpel_cache, pre_buf, xoffset, yoffset, w, h);
+  if (cached != NULL) return vfp->vf(cached, pre_stride, src, src_stride, sse);
+  return vfp->svf(pre_buf, pre_stride, xoffset, yoffset, src, src_stride, sse);
+}
+
+// Whether the sub-pel searches of |x| look up x->subpel_cache, decided once
+// per search so the default path calls vfp->svf() directly.
+static INLINE int use_subpel_cache(const MACROBLOCK *x) {
+  return x->subpel_cache != NULL && x->subpel_cache->level != SUBPEL_CACHE_OFF;
+}
+
+static INLINE unsigned int subpel_variance(
+    const MACROBLOCK *x, int use_cache, const vp9_variance_fn_ptr_t *vfp,
+    const uint8_t *pre_buf, int pre_stride, int xoffset, int yoffset,
+    const uint8_t *src, int src_stride, int w, int h, unsigned int *sse) {
+  if (use_cache) {
+    return cached_subpel_variance(x, vfp, pre_buf, pre_stride, xoffset,
+                                  yoffset, src, src_stride, w, h, sse);
+  }
+  return vfp->svf(pre_buf, pre_stride, xoffset, yoffset, src, src_stride, sse);
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 /* checks if (r, c) has better score than previous best */
 #define CHECK_BETTER(v, r, c)                                                  \
@@ -165,9 +213,11 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
       int64_t tmpmse;                                                          \
       const MV mv = { r, c };                                                  \
       const MV ref_mv = { rr, rc };                                            \
+      ++evals;                                                                 \
       if (second_pred == NULL) {                                               \
-        thismse = vfp->svf(pre(y, y_stride, r, c), y_stride, sp(c), sp(r), z,  \
-                           src_stride, &sse);                                  \
+        thismse = subpel_variance(x, use_cache, vfp, pre(y, y_stride, r, c),   \
+                                  y_stride, sp(c), sp(r), z, src_stride, w, h, \
+                                  &sse);                                       \
       } else {                                                                 \
         thismse = vfp->svaf(pre(y, y_stride, r, c), y_stride, sp(c), sp(r), z, \
                             src_stride, &sse, second_pred);                    \
@@ -194,9 +244,11 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
     if (c >= minc && c <= maxc && r >= minr && r <= maxr) {                    \
       const MV mv = { r, c };                                                  \
       const MV ref_mv = { rr, rc };                                            \
+      ++evals;                                                                 \
       if (second_pred == NULL)                                                 \
-        thismse = vfp->svf(pre(y, y_stride, r, c), y_stride, sp(c), sp(r), z,  \
-                           src_stride, &sse);                                  \
+        thismse = subpel_variance(x, use_cache, vfp, pre(y, y_stride, r, c),   \
+                                  y_stride, sp(c), sp(r), z, src_stride, w, h, \
+                                  &sse);                                       \
       else                                                                     \
         thismse = vfp->svaf(pre(y, y_stride, r, c), y_stride, sp(c), sp(r), z, \
                             src_stride, &sse, second_pred);                    \
@@ -276,6 +328,7 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
   const int y_stride = xd->plane[0].pre[0].stride;                          \
   const int offset = bestmv->row * y_stride + bestmv->col;                  \
   const uint8_t *const y = xd->plane[0].pre[0].buf;                         \
+  const int use_cache = use_subpel_cache(x);                                \
                                                                             \
   int rr = ref_mv->row;                                                     \
   int rc = ref_mv->col;                                                     \
@@ -285,6 +338,8 @@ static INLINE const uint8_t *pre(const uint8_t *buf, int stride, int r, int c) {
   int minc, maxc, minr, maxr;                                               \
   int tr = br;                                                              \
   int tc = bc;                                                              \
+  /* Evaluations, counting the center. */                                   \
+  int evals = 1;                                                            \
   MvLimits subpel_mv_limits;                                                \
                                                                             \
   vp9_set_subpel_mv_search_range(&subpel_mv_limits, &x->mv_limits, ref_mv); \
@@ -395,6 +450,8 @@ uint32_t vp9_skip_sub_pixel_tree(
   (void)thismse;
   (void)cost_list;
   (void)use_accurate_subpel_search;
+  (void)evals;
+  (void)use_cache;
 
   return besterr;
 }
@@ -461,6 +518,7 @@ uint32_t vp9_find_best_sub_pixel_tree_pruned_evenmore(
 
   bestmv->row = br;
   bestmv->col = bc;
+  count_sub_pel_search(x, evals);
 
   return besterr;
 }
@@ -523,6 +581,7 @@ uint32_t vp9_find_best_sub_pixel_tree_pruned_more(
 
   bestmv->row = br;
   bestmv->col = bc;
+  count_sub_pel_search(x, evals);
 
   return besterr;
 }
@@ -607,6 +666,7 @@ uint32_t vp9_find_best_sub_pixel_tree_pruned(
 
   bestmv->row = br;
   bestmv->col = bc;
+  count_sub_pel_search(x, evals);
 
   return besterr;
 }
@@ -688,6 +748,7 @@ static int accurate_sub_pel_search(
       int64_t tmpmse;                                                         \
       const MV mv = { r, c };                                                 \
       const MV ref_mv = { rr, rc };                                           \
+      ++evals;                                                                \
       thismse = accurate_sub_pel_search(xd, &mv, x->me_sf, kernel, vfp, z,    \
                                         src_stride, y, y_stride, second_pred, \
                                         w, h, &sse);                          \
@@ -713,6 +774,7 @@ static int accurate_sub_pel_search(
     if (c >= minc && c <= maxc && r >= minr && r <= maxr) {                   \
       const MV mv = { r, c };                                                 \
       const MV ref_mv = { rr, rc };                                           \
+      ++evals;                                                                \
       thismse = accurate_sub_pel_search(xd, &mv, x->me_sf, kernel, vfp, z,    \
                                         src_stride, y, y_stride, second_pred, \
                                         w, h, &sse);                          \
@@ -747,6 +809,7 @@ uint32_t vp9_find_best_sub_pixel_tree(
   const int y_stride = xd->plane[0].pre[0].stride;
   const int offset = bestmv->row * y_stride + bestmv->col;
   const uint8_t *const y = xd->plane[0].pre[0].buf;
+  const int use_cache = use_subpel_cache(x);
 
   int rr = ref_mv->row;
   int rc = ref_mv->col;
@@ -762,6 +825,7 @@ uint32_t vp9_find_best_sub_pixel_tree(
   int idx, best_idx = -1;
   unsigned int cost_array[5];
   int kr, kc;
+  int evals = 1;
   MvLimits subpel_mv_limits;
 
   // TODO(yunqing): need to add 4-tap filter optimization to speed up the
@@ -802,6 +866,7 @@ uint32_t vp9_find_best_sub_pixel_tree(
         MV this_mv;
         this_mv.row = tr;
         this_mv.col = tc;
+        ++evals;
 
         if (use_accurate_subpel_search) {
           thismse = accurate_sub_pel_search(xd, &this_mv, x->me_sf, kernel, vfp,
@@ -811,8 +876,10 @@ uint32_t vp9_find_best_sub_pixel_tree(
           const uint8_t *const pre_address =
               y + (tr >> 3) * y_stride + (tc >> 3);
           if (second_pred == NULL)
-            thismse = vfp->svf(pre_address, y_stride, sp(tc), sp(tr),
-                               src_address, src_stride, &sse);
+            thismse =
+                subpel_variance(x, use_cache, vfp, pre_address, y_stride,
+                                sp(tc), sp(tr), src_address, src_stride, w, h,
+                                &sse);
           else
             thismse = vfp->svaf(pre_address, y_stride, sp(tc), sp(tr),
                                 src_address, src_stride, &sse, second_pred);
@@ -840,6 +907,7 @@ uint32_t vp9_find_best_sub_pixel_tree(
     tr = br + kr;
     if (tc >= minc && tc <= maxc && tr >= minr && tr <= maxr) {
       MV this_mv = { tr, tc };
+      ++evals;
       if (use_accurate_subpel_search) {
         thismse = accurate_sub_pel_search(xd, &this_mv, x->me_sf, kernel, vfp,
                                           src_address, src_stride, y, y_stride,
@@ -847,8 +915,9 @@ uint32_t vp9_find_best_sub_pixel_tree(
       } else {
         const uint8_t *const pre_address = y + (tr >> 3) * y_stride + (tc >> 3);
         if (second_pred == NULL)
-          thismse = vfp->svf(pre_address, y_stride, sp(tc), sp(tr), src_address,
-                             src_stride, &sse);
+          thismse = subpel_variance(x, use_cache, vfp, pre_address, y_stride,
+                                    sp(tc), sp(tr), src_address, src_stride,
+                                    w, h, &sse);
         else
           thismse = vfp->svaf(pre_address, y_stride, sp(tc), sp(tr),
                               src_address, src_stride, &sse, second_pred);
@@ -933,6 +1002,7 @@ uint32_t vp9_find_best_sub_pixel_tree(
 
   bestmv->row = br;
   bestmv->col = bc;
+  count_sub_pel_search(x, evals);
 
   return besterr;
 }
@@ -955,6 +1025,7 @@ static INLINE int is_mv_in(const MvLimits *mv_limits, const MV *mv) {
 
 #define CHECK_BETTER                                                      \
   {                                                                       \
+    ++num_sads;                                                           \
     if (thissad < bestsad) {                                              \
       if (use_mvcost)                                                     \
         thissad += mvsad_err_cost(x, &this_mv, &fcenter_mv, sad_per_bit); \
@@ -1036,6 +1107,7 @@ static int vp9_pattern_search(
   int bestsad = INT_MAX;
   int thissad;
   int k = -1;
+  int num_steps = 0, num_sads = 0;
   const MV fcenter_mv = { center_mv->row >> 3, center_mv->col >> 3 };
   int best_init_s = search_param_to_steps[search_param];
   // adjust ref_mv to make sure it is within MV range
@@ -1048,6 +1120,7 @@ static int vp9_pattern_search(
   bestsad = vfp->sdf(what->buf, what->stride, get_buf_from_mv(in_what, ref_mv),
                      in_what->stride) +
             mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  ++num_sads;
 
   // Search all possible scales upto the search param around the center point
   // pick the scale of the point that is best as the starting scale of
@@ -1057,6 +1130,7 @@ static int vp9_pattern_search(
     best_init_s = -1;
     for (t = 0; t <= s; ++t) {
       int best_site = -1;
+      ++num_steps;
       if (check_bounds(&x->mv_limits, br, bc, 1 << t)) {
         for (i = 0; i < num_candidates[t]; i++) {
           const MV this_mv = { br + candidates[t][i].row,
@@ -1099,6 +1173,7 @@ static int vp9_pattern_search(
     do {
       // No need to search all 6 points the 1st time if initial search was used
       if (!do_init_search || s != best_init_s) {
+        ++num_steps;
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = { br + candidates[s][i].row,
@@ -1132,6 +1207,7 @@ static int vp9_pattern_search(
       do {
         int next_chkpts_indices[PATTERN_CANDIDATES_REF];
         best_site = -1;
+        ++num_steps;
         next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
         next_chkpts_indices[1] = k;
         next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
@@ -1182,6 +1258,7 @@ static int vp9_pattern_search(
   }
   best_mv->row = br;
   best_mv->col = bc;
+  count_full_pel_work(x, num_steps, num_sads);
   return bestsad;
 }
 
@@ -1206,6 +1283,7 @@ static int vp9_pattern_search_sad(
   int bestsad = INT_MAX;
   int thissad;
   int k = -1;
+  int num_steps = 0, num_sads = 0;
   const MV fcenter_mv = { center_mv->row >> 3, center_mv->col >> 3 };
   int best_init_s = search_param_to_steps[search_param];
   // adjust ref_mv to make sure it is within MV range
@@ -1222,6 +1300,7 @@ static int vp9_pattern_search_sad(
   bestsad = vfp->sdf(what->buf, what->stride, get_buf_from_mv(in_what, ref_mv),
                      in_what->stride) +
             mvsad_err_cost(x, ref_mv, &fcenter_mv, sad_per_bit);
+  ++num_sads;
 
   // Search all possible scales upto the search param around the center point
   // pick the scale of the point that is best as the starting scale of
@@ -1231,6 +1310,7 @@ static int vp9_pattern_search_sad(
     best_init_s = -1;
     for (t = 0; t <= s; ++t) {
       int best_site = -1;
+      ++num_steps;
       if (check_bounds(&x->mv_limits, br, bc, 1 << t)) {
         for (i = 0; i < num_candidates[t]; i++) {
           const MV this_mv = { br + candidates[t][i].row,
@@ -1273,6 +1353,7 @@ static int vp9_pattern_search_sad(
 
     for (; s >= do_sad; s--) {
       if (!do_init_search || s != best_init_s) {
+        ++num_steps;
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = { br + candidates[s][i].row,
@@ -1306,6 +1387,7 @@ static int vp9_pattern_search_sad(
       do {
         int next_chkpts_indices[PATTERN_CANDIDATES_REF];
         best_site = -1;
+        ++num_steps;
         next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
         next_chkpts_indices[1] = k;
         next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
@@ -1347,6 +1429,7 @@ static int vp9_pattern_search_sad(
     if (s == 0) {
       cost_list[0] = bestsad;
       if (!do_init_search || s != best_init_s) {
+        ++num_steps;
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
           for (i = 0; i < num_candidates[s]; i++) {
             const MV this_mv = { br + candidates[s][i].row,
@@ -1377,6 +1460,7 @@ static int vp9_pattern_search_sad(
       while (best_site != -1) {
         int next_chkpts_indices[PATTERN_CANDIDATES_REF];
         best_site = -1;
+        ++num_steps;
         next_chkpts_indices[0] = (k == 0) ? num_candidates[s] - 1 : k - 1;
         next_chkpts_indices[1] = k;
         next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
@@ -1463,6 +1547,7 @@ static int vp9_pattern_search_sad(
   }
   best_mv->row = br;
   best_mv->col = bc;
+  count_full_pel_work(x, num_steps, num_sads);
   return bestsad;
 }
 
@@ -1661,6 +1746,7 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
   int r, c, i;
   int start_col, end_col, start_row, end_row;
   int col_step = (step > 1) ? step : 4;
+  int num_sads = 1;
 
   assert(step >= 1);
 
@@ -1684,6 +1770,7 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
         unsigned int sad =
             fn_ptr->sdf(what->buf, what->stride, get_buf_from_mv(in_what, &mv),
                         in_what->stride);
+        ++num_sads;
         if (sad < best_sad) {
           sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
           if (sad < best_sad) {
@@ -1701,6 +1788,7 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
             addrs[i] = get_buf_from_mv(in_what, &mv);
           }
           fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
+          num_sads += 4;
 
           for (i = 0; i < 4; ++i) {
             if (sads[i] < best_sad) {
@@ -1719,6 +1807,7 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
             unsigned int sad =
                 fn_ptr->sdf(what->buf, what->stride,
                             get_buf_from_mv(in_what, &mv), in_what->stride);
+            ++num_sads;
             if (sad < best_sad) {
               sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
               if (sad < best_sad) {
@@ -1732,6 +1821,7 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
     }
   }
 
+  count_full_pel_work(x, 1, num_sads);
   return best_sad;
 }
 
@@ -2505,6 +2595,16 @@ int vp9_full_pixel_diamond_new(const VP9_COMP *cpi, MACROBLOCK *x,
 /* do_refine: If last step (1-away) of n-step search doesn't pick the center
               point as the best match, we will do a final 1-away diamond
               refining search  */
+// Adds the work of one cpi->diamond_search_sad() call to the search
+// statistics. This is done here rather than in the search so that its SIMD
+// versions need no changes; candidates outside the MV limits are included.
+static void count_diamond_search(const MACROBLOCK *x,
+                                 const search_site_config *cfg,
+                                 int search_param) {
+  const int steps = VPXMAX(cfg->total_steps - search_param, 0);
+  count_full_pel_work(x, steps, 1 + steps * cfg->searches_per_step);
+}
+
 static int full_pixel_diamond(const VP9_COMP *const cpi,
                               const MACROBLOCK *const x, MV *mvp_full,
                               int step_param, int sadpb, int further_steps,
@@ -2515,6 +2615,7 @@ static int full_pixel_diamond(const VP9_COMP *const cpi,
   int thissme, n, num00 = 0;
   int bestsme = cpi->diamond_search_sad(x, &cpi->ss_cfg, mvp_full, &temp_mv,
                                         step_param, sadpb, &n, fn_ptr, ref_mv);
+  count_diamond_search(x, &cpi->ss_cfg, step_param);
   if (bestsme < INT_MAX)
     bestsme = vp9_get_mvpred_var(x, &temp_mv, ref_mv, fn_ptr, 1);
   *dst_mv = temp_mv;
@@ -2532,6 +2633,7 @@ static int full_pixel_diamond(const VP9_COMP *const cpi,
       thissme = cpi->diamond_search_sad(x, &cpi->ss_cfg, mvp_full, &temp_mv,
                                         step_param + n, sadpb, &num00, fn_ptr,
                                         ref_mv);
+      count_diamond_search(x, &cpi->ss_cfg, step_param + n);
       if (thissme < INT_MAX)
         thissme = vp9_get_mvpred_var(x, &temp_mv, ref_mv, fn_ptr, 1);
 
@@ -2722,6 +2824,7 @@ int vp9_refining_search_sad(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
       fn_ptr->sdf(what->buf, what->stride, best_address, in_what->stride) +
       mvsad_err_cost(x, ref_mv, &fcenter_mv, error_per_bit);
   int i, j;
+  int num_steps = 0, num_sads = 1;
 
   for (i = 0; i < search_range; i++) {
     int best_site = -1;
@@ -2730,6 +2833,7 @@ int vp9_refining_search_sad(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
                        ((ref_mv->col - 1) > x->mv_limits.col_min) &
                        ((ref_mv->col + 1) < x->mv_limits.col_max);
 
+    ++num_steps;
     if (all_in) {
       unsigned int sads[4];
       const uint8_t *const positions[4] = { best_address - in_what->stride,
@@ -2737,6 +2841,7 @@ int vp9_refining_search_sad(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
                                             best_address + in_what->stride };
 
       fn_ptr->sdx4df(what->buf, what->stride, positions, in_what->stride, sads);
+      num_sads += 4;
 
       for (j = 0; j < 4; ++j) {
         if (sads[j] < best_sad) {
@@ -2758,6 +2863,7 @@ int vp9_refining_search_sad(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
           unsigned int sad =
               fn_ptr->sdf(what->buf, what->stride,
                           get_buf_from_mv(in_what, &mv), in_what->stride);
+          ++num_sads;
           if (sad < best_sad) {
             sad += mvsad_err_cost(x, &mv, &fcenter_mv, error_per_bit);
             if (sad < best_sad) {
@@ -2778,6 +2884,7 @@ int vp9_refining_search_sad(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
     }
   }
 
+  count_full_pel_work(x, num_steps, num_sads);
   return best_sad;
 }
 
@@ -2795,6 +2902,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
   const MV fcenter_mv = { center_mv->row >> 3, center_mv->col >> 3 };
   unsigned int best_sad = INT_MAX;
   int i, j;
+  int num_steps = 0, num_sads = 1;
   clamp_mv(ref_mv, x->mv_limits.col_min, x->mv_limits.col_max,
            x->mv_limits.row_min, x->mv_limits.row_max);
   best_sad =
@@ -2805,6 +2913,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
   for (i = 0; i < search_range; ++i) {
     int best_site = -1;
 
+    ++num_steps;
     for (j = 0; j < 8; ++j) {
       const MV mv = { ref_mv->row + neighbors[j].row,
                       ref_mv->col + neighbors[j].col };
@@ -2813,6 +2922,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
         unsigned int sad =
             fn_ptr->sdaf(what->buf, what->stride, get_buf_from_mv(in_what, &mv),
                          in_what->stride, second_pred);
+        ++num_sads;
         if (sad < best_sad) {
           sad += mvsad_err_cost(x, &mv, &fcenter_mv, error_per_bit);
           if (sad < best_sad) {
@@ -2830,6 +2940,7 @@ int vp9_refining_search_8p_c(const MACROBLOCK *x, MV *ref_mv, int error_per_bit,
       ref_mv->col += neighbors[best_site].col;
     }
   }
+  count_full_pel_work(x, num_steps, num_sads);
   return best_sad;
 }
 
@@ -2843,6 +2954,7 @@ int vp9_full_pixel_search(const VP9_COMP *const cpi, const MACROBLOCK *const x,
   int var = 0;
   int run_exhaustive_search = 0;
 
+  if (x->search_counts != NULL) ++x->search_counts->full_pel_searches;
   if (cost_list) {
     cost_list[0] = INT_MAX;
     cost_list[1] = INT_MAX;
@@ -2911,6 +3023,73 @@ int vp9_full_pixel_search(const VP9_COMP *const cpi, const MACROBLOCK *const x,
   return var;
 }
 
+int vp9_candidate_full_pixel_search(const VP9_COMP *cpi, const MACROBLOCK *x,
+                                    BLOCK_SIZE bsize, const MV *candidate,
+                                    int error_per_bit, int *cost_list,
+                                    const MV *ref_mv, MV *best_mv,
+                                    int best_err) {
+  const int step_param = CANDIDATE_SEARCH_STEP_PARAM;
+  MV start, this_mv;
+  int this_cost_list[5];
+  int this_err;
+
+  if (candidate == NULL) return best_err;
+  start = *candidate;
+  clamp_mv(&start, x->mv_limits.col_min, x->mv_limits.col_max,
+           x->mv_limits.row_min, x->mv_limits.row_max);
+  if (start.row == best_mv->row && start.col == best_mv->col) return best_err;
+
+  // The n-step search without the exhaustive search of NSTEP, whose error is
+  // the variance and motion cost of vp9_get_mvpred_var(). The costs around
+  // the candidate only replace the ones of |best_mv| if it wins.
+  if (x->search_counts != NULL) ++x->search_counts->full_pel_searches;
+  this_err = full_pixel_diamond(
+      cpi, x, &start, step_param, error_per_bit,
+      MAX_MVSEARCH_STEPS - 1 - step_param, 1,
+      cost_list ? this_cost_list : NULL, &cpi->fn_ptr[bsize], ref_mv, &this_mv);
+  if (this_err >= best_err) return best_err;
+  *best_mv = this_mv;
+  if (cost_list) memcpy(cost_list, this_cost_list, sizeof(this_cost_list));
+  return this_err;
+}
+
+int vp9_seeded_full_pixel_search(const VP9_COMP *cpi, const MACROBLOCK *x,
+                                 BLOCK_SIZE bsize, const MV *seed,
+                                 int error_per_bit, int *cost_list,
+                                 const MV *ref_mv, MV *best_mv) {
+  const MV zero_mv = { 0, 0 };
+  MV start = *seed;
+  int err, zero_err;
+
+  clamp_mv(&start, x->mv_limits.col_min, x->mv_limits.col_max,
+           x->mv_limits.row_min, x->mv_limits.row_max);
+  err = vp9_full_pixel_search(cpi, x, bsize, &start, SEEDED_SEARCH_STEP_PARAM,
+                              NSTEP, error_per_bit, cost_list, ref_mv, best_mv,
+                              0, 0);
+  if (best_mv->row == 0 && best_mv->col == 0) return err;
+
+  zero_err = vp9_get_mvpred_var(x, &zero_mv, ref_mv, &cpi->fn_ptr[bsize], 1);
+  if (zero_err >= err) return err;
+  *best_mv = zero_mv;
+  // The costs around the searched motion do not apply to the zero motion.
+  if (cost_list) {
+    cost_list[0] = cost_list[1] = cost_list[2] = cost_list[3] = cost_list[4] =
+        INT_MAX;
+  }
+  return zero_err;
+}
+
+int vp9_hash_motion_search(const BlockHashTable *table, const MACROBLOCK *x,
+                           BLOCK_SIZE bsize, int mi_row, int mi_col,
+                           const MV *ref_mv, MV *mv) {
+  const MV ref_full = { ref_mv->row >> 3, ref_mv->col >> 3 };
+  if (table == NULL) return 0;
+  return vp9_block_hash_search(
+      table, x->plane[0].src.buf, x->plane[0].src.stride, mi_col * MI_SIZE,
+      mi_row * MI_SIZE, num_4x4_blocks_wide_lookup[bsize] << 2,
+      num_4x4_blocks_high_lookup[bsize] << 2, &x->mv_limits, &ref_full, mv);
+}
+
 // Note(yunqingwang): The following 2 functions are only used in the motion
 // vector unit test, which return extreme motion vectors allowed by the MV
 // limits.
@@ -2947,6 +3126,8 @@ int vp9_full_pixel_search(const VP9_COMP *const cpi, const MACROBLOCK *const x,
   (void)sse;           \
   (void)thismse;       \
   (void)cost_list;     \
+  (void)evals;         \
+  (void)use_cache;     \
   (void)use_accurate_subpel_search
 
 // Return the maximum MV.
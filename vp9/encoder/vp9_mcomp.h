@@ -114,6 +114,44 @@ int vp9_full_pixel_search(const struct VP9_COMP *const cpi,
                           int error_per_bit, int *cost_list, const MV *ref_mv,
                           MV *tmp_mv, int var_max, int rd);
 
+// Step param of vp9_candidate_full_pixel_search(). The first step is 4
+// pixels, so the search stays within a few pixels of the candidate.
+#define CANDIDATE_SEARCH_STEP_PARAM (MAX_MVSEARCH_STEPS - 3)
+
+// Full pel search around the full pel |candidate|, e.g. the motion estimated
+// on the pyramids, for a |bsize| block whose search already found |best_mv|
+// with error |best_err|, the variance and motion cost of vp9_get_mvpred_var()
+// as returned by vp9_full_pixel_search() with rd set. Replaces |best_mv| and
+// |cost_list| and returns the new error if the search finds a lower one,
+// otherwise returns |best_err|.
+int vp9_candidate_full_pixel_search(const struct VP9_COMP *cpi,
+                                    const MACROBLOCK *x, BLOCK_SIZE bsize,
+                                    const MV *candidate, int error_per_bit,
+                                    int *cost_list, const MV *ref_mv,
+                                    MV *best_mv, int best_err);
+
+// Step param of vp9_seeded_full_pixel_search(). The first step is 8 pixels.
+#define SEEDED_SEARCH_STEP_PARAM (MAX_MVSEARCH_STEPS - 4)
+
+// Full pel search of a |bsize| block around the full pel |seed|, a motion
+// predicted from the one of the block in a neighboring frame, in place of a
+// wide search from the zero motion. The zero motion is also tried. Stores the
+// best motion in |best_mv| and returns its error.
+int vp9_seeded_full_pixel_search(const struct VP9_COMP *cpi,
+                                 const MACROBLOCK *x, BLOCK_SIZE bsize,
+                                 const MV *seed, int error_per_bit,
+                                 int *cost_list, const MV *ref_mv,
+                                 MV *best_mv);
+
+struct BlockHashTable;
+
+// Looks for an exact copy of the |bsize| block at (|mi_row|, |mi_col|) in
+// |table|, which may be NULL. On success stores the full pel motion of the
+// copy closest to |ref_mv| within x->mv_limits in |mv| and returns 1.
+int vp9_hash_motion_search(const struct BlockHashTable *table,
+                           const MACROBLOCK *x, BLOCK_SIZE bsize, int mi_row,
+                           int mi_col, const MV *ref_mv, MV *mv);
+
 void vp9_set_subpel_mv_search_range(MvLimits *subpel_mv_limits,
                                     const MvLimits *umv_window_limits,
                                     const MV *ref_mv);
@@ -158,7 +158,7 @@ static int combined_motion_search(VP9_COMP *cpi, MACROBLOCK *x,
   MACROBLOCKD *xd = &x->e_mbd;
   MODE_INFO *mi = xd->mi[0];
   struct buf_2d backup_yv12[MAX_MB_PLANE] = { { 0, 0 } };
-  const int step_param = cpi->sf.mv.fullpel_search_step_param;
+  int step_param = cpi->sf.mv.fullpel_search_step_param;
   const int sadpb = x->sadperbit16;
   MV mvp_full;
   const int ref = mi->ref_frame[0];
@@ -208,6 +208,10 @@ static int combined_motion_search(VP9_COMP *cpi, MACROBLOCK *x,
     tmp_mv->as_mv.row = x->sb_mvrow_part >> 3;
     tmp_mv->as_mv.col = x->sb_mvcol_part >> 3;
   } else {
+    // An exact copy of the block only needs a short search around it.
+    if (vp9_hash_motion_search(cpi->hash_table[ref], x, bsize, mi_row, mi_col,
+                               &center_mv, &mvp_full))
+      step_param = CANDIDATE_SEARCH_STEP_PARAM;
     vp9_full_pixel_search(
         cpi, x, bsize, &mvp_full, step_param, cpi->sf.mv.search_method, sadpb,
         cond_cost_list(cpi, cost_list), &center_mv, &tmp_mv->as_mv, INT_MAX, 0);
@@ -1180,6 +1184,7 @@ void vp9_pick_intra_mode(VP9_COMP *cpi, MACROBLOCK *x, RD_COST *rd_cost,
   // Change the limit of this loop to add other intra prediction
   // mode tests.
   for (this_mode = DC_PRED; this_mode <= H_PRED; ++this_mode) {
+    if (x->search_counts != NULL) ++x->search_counts->intra_modes_tested;
     this_rdc.dist = this_rdc.rate = 0;
     args.mode = this_mode;
     args.skippable = 1;
@@ -1694,6 +1699,7 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
   uint8_t mode_checked[MB_MODE_COUNT][MAX_REF_FRAMES];
   struct buf_2d yv12_mb[4][MAX_MB_PLANE];
   RD_COST this_rdc, best_rdc;
+  int modes_visited = 0, modes_tested = 0;
   // var_y and sse_y are saved to be used in skipping checking
   unsigned int var_y = UINT_MAX;
   unsigned int sse_y = UINT_MAX;
@@ -2046,6 +2052,7 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
     int force_mv_inter_layer = 0;
     PREDICTION_MODE this_mode;
     second_ref_frame = NONE;
+    ++modes_visited;
 
     if (idx < num_inter_modes) {
       this_mode = ref_mode_set[idx].pred_mode;
@@ -2281,6 +2288,8 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
             frame_mv[NEARESTMV][ref_frame].as_int)
       continue;
 
+    ++modes_tested;
+    if (x->search_counts != NULL) ++x->search_counts->inter_modes_tested;
     mi->mode = this_mode;
     mi->mv[0].as_int = frame_mv[this_mode][ref_frame].as_int;
     mi->mv[1].as_int = 0;
@@ -2459,13 +2468,16 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
     }
 
     if (x->skip &&
-        (!force_test_gf_zeromv || mode_checked[ZEROMV][GOLDEN_FRAME]))
+        (!force_test_gf_zeromv || mode_checked[ZEROMV][GOLDEN_FRAME])) {
+      if (x->search_counts != NULL) ++x->search_counts->mode_early_exits;
       break;
+    }
 
     // If early termination flag is 1 and at least 2 modes are checked,
     // the mode search is terminated.
     if (best_early_term && idx > 0 && !scene_change_detected &&
         (!force_test_gf_zeromv || mode_checked[ZEROMV][GOLDEN_FRAME])) {
+      if (x->search_counts != NULL) ++x->search_counts->mode_early_exits;
       x->skip = 1;
       break;
     }
@@ -2550,6 +2562,7 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
       const PREDICTION_MODE this_mode = intra_mode_list[i];
       THR_MODES mode_index = mode_idx[INTRA_FRAME][mode_offset(this_mode)];
       int mode_rd_thresh = rd_threshes[mode_index];
+      ++modes_visited;
       // For spatially flat blocks, under short_circuit_flat_blocks flag:
       // only check DC mode for stationary blocks, otherwise also check
       // H and V mode.
@@ -2579,6 +2592,8 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
           continue;
       }
 
+      ++modes_tested;
+      if (x->search_counts != NULL) ++x->search_counts->intra_modes_tested;
       mi->mode = this_mode;
       mi->ref_frame[0] = INTRA_FRAME;
       this_rdc.dist = this_rdc.rate = 0;
@@ -2638,6 +2653,9 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x, TileDataEnc *tile_data,
     }
   }
 
+  if (x->search_counts != NULL)
+    x->search_counts->modes_skipped += modes_visited - modes_tested;
+
   pd->dst = orig_dst;
   mi->mode = best_pickmode.best_mode;
   mi->ref_frame[0] = best_pickmode.best_ref_frame;
@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/encoder/vp9_pyramid.h"
+
+typedef unsigned int (*PyramidSadFn)(const uint8_t *src, int src_stride,
+                                     const uint8_t *ref, int ref_stride);
+
+int vp9_pyramid_num_levels(int width, int height) {
+  const int min_size = VPXMIN(width, height);
+  int levels = 0;
+  while (levels < PYRAMID_MAX_LEVELS &&
+         (min_size >> (levels + 1)) >= PYRAMID_MIN_LEVEL_SIZE)
+    ++levels;
+  return levels;
+}
+
+static void extend_level(uint8_t *level, int width, int height, int stride) {
+  uint8_t *row = level;
+  int i;
+  for (i = 0; i < height; ++i) {
+    memset(row - PYRAMID_BORDER, row[0], PYRAMID_BORDER);
+    memset(row + width, row[width - 1], PYRAMID_BORDER);
+    row += stride;
+  }
+  row = level - PYRAMID_BORDER;
+  for (i = 1; i <= PYRAMID_BORDER; ++i) {
+    memcpy(row - i * stride, row, stride);
+    memcpy(row + (height - 1 + i) * stride, row + (height - 1) * stride,
+           stride);
+  }
+}
+
+// Averages each 2x2 block of |src|. The last column and row of odd sized
+// planes are repeated.
+static void downsample(const uint8_t *src, int src_stride, int src_width,
+                       int src_height, uint8_t *dst, int dst_stride,
+                       int dst_width, int dst_height) {
+  int r, c;
+  for (r = 0; r < dst_height; ++r) {
+    const uint8_t *const row0 = src + 2 * r * src_stride;
+    const uint8_t *const row1 =
+        2 * r + 1 < src_height ? row0 + src_stride : row0;
+    for (c = 0; c < dst_width; ++c) {
+      const int c0 = 2 * c;
+      const int c1 = VPXMIN(c0 + 1, src_width - 1);
+      dst[c] = (row0[c0] + row0[c1] + row1[c0] + row1[c1] + 2) >> 2;
+    }
+    dst += dst_stride;
+  }
+}
+
+int vp9_pyramid_build(ImagePyramid *pyr, const YV12_BUFFER_CONFIG *src) {
+  const int num_levels =
+      vp9_pyramid_num_levels(src->y_crop_width, src->y_crop_height);
+  int offsets[PYRAMID_MAX_LEVELS];
+  size_t size = 0;
+  int width = src->y_crop_width;
+  int height = src->y_crop_height;
+  int i;
+
+  pyr->num_levels = 0;
+  if (num_levels == 0) return 0;
+
+  for (i = 0; i < num_levels; ++i) {
+    width = (width + 1) >> 1;
+    height = (height + 1) >> 1;
+    pyr->width[i] = width;
+    pyr->height[i] = height;
+    pyr->stride[i] = (width + 2 * PYRAMID_BORDER + 31) & ~31;
+    offsets[i] = (int)size + PYRAMID_BORDER * pyr->stride[i] + PYRAMID_BORDER;
+    size += (size_t)pyr->stride[i] * (height + 2 * PYRAMID_BORDER);
+  }
+  if (size > pyr->buf_size) {
+    vpx_free(pyr->buf);
+    pyr->buf_size = 0;
+    pyr->buf = (uint8_t *)vpx_memalign(32, size);
+    if (pyr->buf == NULL) return 0;
+    pyr->buf_size = size;
+  }
+
+  for (i = 0; i < num_levels; ++i) {
+    pyr->level[i] = pyr->buf + offsets[i];
+    if (i == 0) {
+      downsample(src->y_buffer, src->y_stride, src->y_crop_width,
+                 src->y_crop_height, pyr->level[0], pyr->stride[0],
+                 pyr->width[0], pyr->height[0]);
+    } else {
+      downsample(pyr->level[i - 1], pyr->stride[i - 1], pyr->width[i - 1],
+                 pyr->height[i - 1], pyr->level[i], pyr->stride[i],
+                 pyr->width[i], pyr->height[i]);
+    }
+    extend_level(pyr->level[i], pyr->width[i], pyr->height[i],
+                 pyr->stride[i]);
+  }
+  pyr->num_levels = num_levels;
+  return 1;
+}
+
+void vp9_pyramid_free(ImagePyramid *pyr) {
+  vpx_free(pyr->buf);
+  memset(pyr, 0, sizeof(*pyr));
+}
+
+static unsigned int sad_generic(const uint8_t *src, int src_stride,
+                                const uint8_t *ref, int ref_stride, int w,
+                                int h) {
+  unsigned int sad = 0;
+  int r, c;
+  for (r = 0; r < h; ++r) {
+    for (c = 0; c < w; ++c) sad += abs(src[c] - ref[c]);
+    src += src_stride;
+    ref += ref_stride;
+  }
+  return sad;
+}
+
+static PyramidSadFn get_sad_fn(int w, int h) {
+  if (w == 8 && h == 8) return vpx_sad8x8;
+  if (w == 8 && h == 16) return vpx_sad8x16;
+  if (w == 16 && h == 8) return vpx_sad16x8;
+  if (w == 16 && h == 16) return vpx_sad16x16;
+  if (w == 16 && h == 32) return vpx_sad16x32;
+  if (w == 32 && h == 16) return vpx_sad32x16;
+  if (w == 32 && h == 32) return vpx_sad32x32;
+  return NULL;
+}
+
+static int clamp_window(int pos, int size, int level_size) {
+  return clamp(pos, 0, VPXMAX(level_size - size, 0));
+}
+
+int vp9_pyramid_motion_search(const ImagePyramid *src, const ImagePyramid *ref,
+                              int x, int y, int w, int h, MV *mv) {
+  const int num_levels = VPXMIN(src->num_levels, ref->num_levels);
+  MV best = { 0, 0 };
+  int level;
+
+  if (num_levels == 0) return 0;
+  for (level = 0; level < num_levels; ++level) {
+    if (src->width[level] != ref->width[level] ||
+        src->height[level] != ref->height[level])
+      return 0;
+  }
+
+  for (level = num_levels - 1; level >= 0; --level) {
+    const int shift = level + 1;
+    const int width = src->width[level];
+    const int height = src->height[level];
+    const int bw = VPXMIN(VPXMAX(w >> shift, PYRAMID_MIN_WINDOW), width);
+    const int bh = VPXMIN(VPXMAX(h >> shift, PYRAMID_MIN_WINDOW), height);
+    const int bx = clamp_window(((x + w / 2) >> shift) - bw / 2, bw, width);
+    const int by = clamp_window(((y + h / 2) >> shift) - bh / 2, bh, height);
+    const int src_stride = src->stride[level];
+    const int ref_stride = ref->stride[level];
+    const uint8_t *const src_buf = src->level[level] + by * src_stride + bx;
+    const PyramidSadFn sad_fn = get_sad_fn(bw, bh);
+    // Candidates must keep the window inside the bordered level.
+    const int row_min = -PYRAMID_BORDER - by;
+    const int row_max = height + PYRAMID_BORDER - bh - by;
+    const int col_min = -PYRAMID_BORDER - bx;
+    const int col_max = width + PYRAMID_BORDER - bw - bx;
+    const int range = level == num_levels - 1 ? PYRAMID_SEARCH_RANGE : 1;
+    unsigned int best_sad = UINT_MAX;
+    MV center;
+    int dr, dc;
+
+    if (level != num_levels - 1) {
+      best.row *= 2;
+      best.col *= 2;
+    }
+    center.row = clamp(best.row, row_min, row_max);
+    center.col = clamp(best.col, col_min, col_max);
+    best = center;
+
+    // The center is checked first so that ties on flat areas keep it.
+    for (dr = 0; dr <= 2 * range; ++dr) {
+      const int row = center.row + (dr & 1 ? -((dr + 1) >> 1) : dr >> 1);
+      if (row < row_min || row > row_max) continue;
+      for (dc = 0; dc <= 2 * range; ++dc) {
+        const int col = center.col + (dc & 1 ? -((dc + 1) >> 1) : dc >> 1);
+        const uint8_t *ref_buf;
+        unsigned int sad;
+        if (col < col_min || col > col_max) continue;
+        ref_buf = ref->level[level] + (by + row) * ref_stride + bx + col;
+        sad = sad_fn ? sad_fn(src_buf, src_stride, ref_buf, ref_stride)
+                     : sad_generic(src_buf, src_stride, ref_buf, ref_stride,
+                                   bw, bh);
+        if (sad < best_sad) {
+          best_sad = sad;
+          best.row = row;
+          best.col = col;
+        }
+      }
+    }
+  }
+
+  mv->row = best.row * 2;
+  mv->col = best.col * 2;
+  return 1;
+}
+
+int vp9_pyramid_motion_field(const ImagePyramid *src, const ImagePyramid *ref,
+                             PyramidMotionField *field) {
+  const int num_levels = VPXMIN(src->num_levels, ref->num_levels);
+  const int block_size = PYRAMID_MIN_WINDOW << num_levels;
+  // Full resolution size, rounded up to even.
+  const int width = src->width[0] * 2;
+  const int height = src->height[0] * 2;
+  const int rows = (height + block_size - 1) / block_size;
+  const int cols = (width + block_size - 1) / block_size;
+  int r, c;
+
+  field->rows = 0;
+  field->cols = 0;
+  if (num_levels == 0 || ref->width[0] != src->width[0] ||
+      ref->height[0] != src->height[0])
+    return 0;
+  if (rows * cols > field->mvs_size) {
+    vpx_free(field->mvs);
+    field->mvs_size = 0;
+    field->mvs = (MV *)vpx_malloc(rows * cols * sizeof(*field->mvs));
+    if (field->mvs == NULL) return 0;
+    field->mvs_size = rows * cols;
+  }
+
+  for (r = 0; r < rows; ++r) {
+    for (c = 0; c < cols; ++c) {
+      vp9_pyramid_motion_search(src, ref, c * block_size, r * block_size,
+                                block_size, block_size,
+                                &field->mvs[r * cols + c]);
+    }
+  }
+  field->block_size = block_size;
+  field->rows = rows;
+  field->cols = cols;
+  return 1;
+}
+
+void vp9_pyramid_motion_field_free(PyramidMotionField *field) {
+  vpx_free(field->mvs);
+  memset(field, 0, sizeof(*field));
+}
+
+const ImagePyramid *vp9_pyramid_cache_get(PyramidCache *cache,
+                                          const YV12_BUFFER_CONFIG *src) {
+  PyramidCacheEntry *entry;
+  int i;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) return NULL;
+#endif
+  if (vp9_pyramid_num_levels(src->y_crop_width, src->y_crop_height) == 0)
+    return NULL;
+
+  for (i = 0; i < cache->num_entries; ++i) {
+    entry = &cache->entries[i];
+    if (entry->key == src->y_buffer && entry->width == src->y_crop_width &&
+        entry->height == src->y_crop_height)
+      return entry->pyramid.num_levels ? &entry->pyramid : NULL;
+  }
+  if (cache->num_entries == PYRAMID_CACHE_SIZE) return NULL;
+
+  entry = &cache->entries[cache->num_entries++];
+  entry->key = src->y_buffer;
+  entry->width = src->y_crop_width;
+  entry->height = src->y_crop_height;
+  // A failed build leaves an empty pyramid, which is not retried.
+  return vp9_pyramid_build(&entry->pyramid, src) ? &entry->pyramid : NULL;
+}
+
+void vp9_pyramid_cache_clear(PyramidCache *cache) { cache->num_entries = 0; }
+
+void vp9_pyramid_cache_free(PyramidCache *cache) {
+  int i;
+  for (i = 0; i < PYRAMID_CACHE_SIZE; ++i)
+    vp9_pyramid_free(&cache->entries[i].pyramid);
+  cache->num_entries = 0;
+}
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_PYRAMID_H_
+#define VPX_VP9_ENCODER_VP9_PYRAMID_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vp9/common/vp9_mv.h"
+#include "vp9/encoder/vp9_lookahead.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+#include "vpx_scale/yv12config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// At high resolutions the motion of a block often exceeds what the full pel
+// search finds from its start point. An image pyramid holds the luma plane
+// downsampled by 2, 4, 8 and 16. A coarse to fine search on the pyramids of
+// the source and the reference estimates the motion at a fraction of the cost
+// of a wide search, and the full resolution search also looks around the
+// estimate.
+#define PYRAMID_MAX_LEVELS 4
+
+// Levels are only added while both of their dimensions are at least this
+// large, so the top level keeps enough detail to match against.
+#define PYRAMID_MIN_LEVEL_SIZE 128
+
+// Pixels of edge extension around each level.
+#define PYRAMID_BORDER 16
+
+// Smallest window matched on a level. Blocks that shrink below it are matched
+// with the window of this size centered on them.
+#define PYRAMID_MIN_WINDOW 8
+
+// Range of the exhaustive search on the top level, in pixels of that level.
+#define PYRAMID_SEARCH_RANGE 8
+
+typedef struct ImagePyramid {
+  int num_levels;
+  // Level 0 is the luma plane downsampled by 2, level i by 2 << i.
+  int width[PYRAMID_MAX_LEVELS];
+  int height[PYRAMID_MAX_LEVELS];
+  int stride[PYRAMID_MAX_LEVELS];
+  // Top left pixel of each level, excluding the border.
+  uint8_t *level[PYRAMID_MAX_LEVELS];
+  uint8_t *buf;
+  size_t buf_size;
+} ImagePyramid;
+
+// Number of levels of the pyramid of a |width|x|height| frame, 0 if the frame
+// is too small to benefit from one.
+int vp9_pyramid_num_levels(int width, int height);
+
+// Builds the pyramid of the luma plane of |src|. Returns 0 on allocation
+// failure or if |src| is too small, in which case the pyramid is empty.
+int vp9_pyramid_build(ImagePyramid *pyr, const YV12_BUFFER_CONFIG *src);
+
+void vp9_pyramid_free(ImagePyramid *pyr);
+
+// Estimates the motion of the |w|x|h| block at (|x|, |y|) of the frame of
+// |src| in the frame of |ref|. Returns 0 if the pyramids can not be matched,
+// otherwise stores the full pel motion vector in |mv|, in full resolution
+// pixels.
+int vp9_pyramid_motion_search(const ImagePyramid *src, const ImagePyramid *ref,
+                              int x, int y, int w, int h, MV *mv);
+
+// Motion of the blocks of a grid over the frame, estimated on the pyramids
+// once per frame for the searches that run many times per block.
+typedef struct PyramidMotionField {
+  // Size of the blocks of the grid, in full resolution pixels. Their windows
+  // on the top level are PYRAMID_MIN_WINDOW wide.
+  int block_size;
+  int rows;
+  int cols;
+  MV *mvs;
+  int mvs_size;
+} PyramidMotionField;
+
+// Estimates the motion field of the frame of |src| in the frame of |ref|.
+// Returns 0 if the pyramids can not be matched or on allocation failure, in
+// which case the field is empty.
+int vp9_pyramid_motion_field(const ImagePyramid *src, const ImagePyramid *ref,
+                             PyramidMotionField *field);
+
+// Returns the motion of the grid block holding the center of the |w|x|h|
+// block at (|x|, |y|), or NULL if the field is empty.
+static INLINE const MV *vp9_pyramid_field_mv(const PyramidMotionField *field,
+                                             int x, int y, int w, int h) {
+  int row, col;
+  if (field->rows == 0) return NULL;
+  row = VPXMIN((y + h / 2) / field->block_size, field->rows - 1);
+  col = VPXMIN((x + w / 2) / field->block_size, field->cols - 1);
+  return &field->mvs[row * field->cols + col];
+}
+
+void vp9_pyramid_motion_field_free(PyramidMotionField *field);
+
+// Room for the lookahead frames, the references and their scaled versions,
+// and the source.
+#define PYRAMID_CACHE_SIZE (MAX_LAG_BUFFERS + 8)
+
+typedef struct PyramidCacheEntry {
+  // Luma address and size of the frame the pyramid was built from.
+  const uint8_t *key;
+  int width;
+  int height;
+  ImagePyramid pyramid;
+} PyramidCacheEntry;
+
+// Pyramids of the frames used by the current call to the encoder. Frames are
+// identified by the address of their luma plane, so the cache must be
+// cleared whenever a frame buffer may have been rewritten, and callers pass
+// the queued lookahead image rather than its bordered copy, which is
+// recycled between frames.
+typedef struct PyramidCache {
+  int num_entries;
+  PyramidCacheEntry entries[PYRAMID_CACHE_SIZE];
+} PyramidCache;
+
+// Returns the pyramid of |src|, building it if needed, or NULL if |src| has
+// no pyramid, is high bitdepth, or the cache is full.
+const ImagePyramid *vp9_pyramid_cache_get(PyramidCache *cache,
+                                          const YV12_BUFFER_CONFIG *src);
+
+// Empties the cache, keeping the allocations.
+void vp9_pyramid_cache_clear(PyramidCache *cache);
+
+void vp9_pyramid_cache_free(PyramidCache *cache);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_PYRAMID_H_
@@ -51,6 +51,48 @@ void vp9_quantize_fp_c(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
   *eob_ptr = eob + 1;
 }
 
+void vp9_fdct_quantize_fp_4x4_c(const uint8_t *src, int src_stride,
+                                const uint8_t *pred, int pred_stride,
+                                tran_low_t *coeff_ptr, const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan, const int16_t *iscan) {
+  int16_t src_diff[4 * 4];
+  vpx_subtract_block_c(4, 4, src_diff, 4, src, src_stride, pred, pred_stride);
+  vpx_fdct4x4_c(src_diff, coeff_ptr, 4);
+  vp9_quantize_fp_c(coeff_ptr, 4 * 4, round_ptr, quant_ptr, qcoeff_ptr,
+                    dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
+
+void vp9_fdct_quantize_fp_8x8_c(const uint8_t *src, int src_stride,
+                                const uint8_t *pred, int pred_stride,
+                                tran_low_t *coeff_ptr, const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan, const int16_t *iscan) {
+  int16_t src_diff[8 * 8];
+  vpx_subtract_block_c(8, 8, src_diff, 8, src, src_stride, pred, pred_stride);
+  vpx_fdct8x8_c(src_diff, coeff_ptr, 8);
+  vp9_quantize_fp_c(coeff_ptr, 8 * 8, round_ptr, quant_ptr, qcoeff_ptr,
+                    dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
+
+void vp9_fdct_quantize_fp_16x16_c(
+    const uint8_t *src, int src_stride, const uint8_t *pred, int pred_stride,
+    tran_low_t *coeff_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const int16_t *iscan) {
+  int16_t src_diff[16 * 16];
+  vpx_subtract_block_c(16, 16, src_diff, 16, src, src_stride, pred,
+                       pred_stride);
+  vpx_fdct16x16_c(src_diff, coeff_ptr, 16);
+  vp9_quantize_fp_c(coeff_ptr, 16 * 16, round_ptr, quant_ptr, qcoeff_ptr,
+                    dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 void vp9_highbd_quantize_fp_c(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
                               const int16_t *round_ptr,
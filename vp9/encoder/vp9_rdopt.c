@@ -1393,11 +1393,18 @@ static int64_t rd_pick_intra_sby_mode(VP9_COMP *cpi, MACROBLOCK *x, int *rate,
     if (cpi->sf.use_nonrd_pick_mode) {
       // These speed features are turned on in hybrid non-RD and RD mode
       // for key frame coding in the context of real-time setting.
-      if (conditional_skipintra(mode, mode_selected)) continue;
-      if (*skippable) break;
+      if (conditional_skipintra(mode, mode_selected)) {
+        if (x->search_counts != NULL) ++x->search_counts->modes_skipped;
+        continue;
+      }
+      if (*skippable) {
+        if (x->search_counts != NULL) ++x->search_counts->mode_early_exits;
+        break;
+      }
     }
 
     mic->mode = mode;
+    if (x->search_counts != NULL) ++x->search_counts->intra_modes_tested;
 
     super_block_yrd(cpi, x, &this_rate_tokenonly, &this_distortion, &s, NULL,
                     bsize, best_rd, /*recon = */ 0);
@@ -2471,6 +2478,20 @@ static int ref_frame_to_gf_rf_idx(int ref_frame) {
 }
 #endif
 
+// The motion vector of a block stored by the first encoding of the frame can
+// only be reused if it can be coded against the current |ref_mv|, which may
+// change between recodes like the motion vector precision.
+static int is_recode_mv_valid(const VP9_COMMON *cm, const MACROBLOCK *x,
+                              const MV *mv, const MV *ref_mv) {
+  MvLimits limits;
+  if (!(cm->allow_high_precision_mv && use_mv_hp(ref_mv)) &&
+      ((mv->row | mv->col) & 1))
+    return 0;
+  vp9_set_subpel_mv_search_range(&limits, &x->mv_limits, ref_mv);
+  return mv->col >= limits.col_min && mv->col <= limits.col_max &&
+         mv->row >= limits.row_min && mv->row <= limits.row_max;
+}
+
 static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
                                  int mi_row, int mi_col, int_mv *tmp_mv,
                                  int *rate_mv) {
@@ -2568,6 +2589,25 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
     }
   }
 
+  if (cpi->recode_mv_mode == RECODE_MV_REUSE) {
+    const RECODE_MV *const saved = &cpi->recode_mvs[get_recode_mv_index(
+        cm, mi_row, mi_col, bsize, ref)];
+    if (saved->mv.as_int != INVALID_MV &&
+        is_recode_mv_valid(cm, x, &saved->mv.as_mv, &ref_mv)) {
+      *tmp_mv = saved->mv;
+      x->pred_sse[ref] = saved->pred_sse;
+      *rate_mv = vp9_mv_bit_cost(&tmp_mv->as_mv, &ref_mv, x->nmvjointcost,
+                                 x->mvcost, MV_COST_WEIGHT);
+      x->pred_mv[ref] = tmp_mv->as_mv;
+
+      if (scaled_ref_frame) {
+        int i;
+        for (i = 0; i < MAX_MB_PLANE; ++i) xd->plane[i].pre[0] = backup_yv12[i];
+      }
+      return;
+    }
+  }
+
   // Note: MV limits are modified here. Always restore the original values
   // after full-pixel motion search.
   vp9_set_mv_search_range(&x->mv_limits, &ref_mv);
@@ -2576,6 +2616,11 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
   mvp_full.col >>= 3;
   mvp_full.row >>= 3;
 
+  // An exact copy of the block only needs a short search around it.
+  if (vp9_hash_motion_search(cpi->hash_table[ref], x, bsize, mi_row, mi_col,
+                             &ref_mv, &mvp_full))
+    step_param = CANDIDATE_SEARCH_STEP_PARAM;
+
 #if CONFIG_NON_GREEDY_MV
   bestsme = vp9_full_pixel_diamond_new(cpi, x, bsize, &mvp_full, step_param,
                                        lambda, 1, nb_full_mvs, nb_full_mv_num,
@@ -2584,6 +2629,14 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
   bestsme = vp9_full_pixel_search(
       cpi, x, bsize, &mvp_full, step_param, cpi->sf.mv.search_method, sadpb,
       cond_cost_list(cpi, cost_list), &ref_mv, &tmp_mv->as_mv, INT_MAX, 1);
+
+  // Large motion can be out of reach of the search above, so also search
+  // around the motion estimated on the pyramids.
+  bestsme = vp9_candidate_full_pixel_search(
+      cpi, x, bsize,
+      vp9_pyramid_field_mv(&cpi->pyramid_field[ref], mi_col * MI_SIZE,
+                           mi_row * MI_SIZE, pw, ph),
+      sadpb, cond_cost_list(cpi, cost_list), &ref_mv, &tmp_mv->as_mv, bestsme);
 #endif  // CONFIG_NON_GREEDY_MV
 
   if (cpi->sf.enhanced_full_pixel_motion_search) {
@@ -2642,6 +2695,13 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
         cpi->sf.mv.subpel_search_level, cond_cost_list(cpi, cost_list),
         x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], NULL, pw, ph,
         cpi->sf.use_accurate_subpel_search);
+
+    if (cpi->recode_mv_mode == RECODE_MV_STORE) {
+      RECODE_MV *const saved = &cpi->recode_mvs[get_recode_mv_index(
+          cm, mi_row, mi_col, bsize, ref)];
+      saved->mv = *tmp_mv;
+      saved->pred_sse = x->pred_sse[ref];
+    }
   }
   *rate_mv = vp9_mv_bit_cost(&tmp_mv->as_mv, &ref_mv, x->nmvjointcost,
                              x->mvcost, MV_COST_WEIGHT);
@@ -2726,7 +2786,8 @@ static int64_t handle_inter_mode(
     int mi_row, int mi_col, int_mv single_newmv[MAX_REF_FRAMES],
     INTERP_FILTER (*single_filter)[MAX_REF_FRAMES],
     int (*single_skippable)[MAX_REF_FRAMES], int64_t *psse,
-    const int64_t ref_best_rd, int64_t *mask_filter, int64_t filter_cache[]) {
+    const int64_t ref_best_rd, int64_t *mask_filter, int64_t filter_cache[],
+    int keep_pred) {
   VP9_COMMON *cm = &cpi->common;
   MACROBLOCKD *xd = &x->e_mbd;
   MODE_INFO *mi = xd->mi[0];
@@ -2985,10 +3046,22 @@ static int64_t handle_inter_mode(
 
   if (pred_exists) {
     if (best_needs_copy) {
-      // again temporarily set the buffers to local memory to prevent a memcpy
+      struct buf_2d tmp_pred[MAX_MB_PLANE];
       for (i = 0; i < MAX_MB_PLANE; i++) {
-        xd->plane[i].dst.buf = tmp_buf + i * 64 * 64;
-        xd->plane[i].dst.stride = 64;
+        tmp_pred[i].buf = tmp_buf + i * 64 * 64;
+        tmp_pred[i].stride = 64;
+      }
+      if (keep_pred) {
+        // The caller keeps the prediction left in the destination buffer.
+        struct buf_2d dst[MAX_MB_PLANE];
+        for (i = 0; i < MAX_MB_PLANE; i++) {
+          dst[i].buf = orig_dst[i];
+          dst[i].stride = orig_dst_stride[i];
+        }
+        vp9_copy_pred_planes(xd, bsize, tmp_pred, dst);
+      } else {
+        // again temporarily set the buffers to local memory to prevent a memcpy
+        for (i = 0; i < MAX_MB_PLANE; i++) xd->plane[i].dst = tmp_pred[i];
       }
     }
     rd = tmp_rd + RDCOST(x->rdmult, x->rddiv, rs, 0);
@@ -3306,6 +3379,10 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
   MODE_INFO *const mi = xd->mi[0];
   MB_MODE_INFO_EXT *const mbmi_ext = x->mbmi_ext;
   const struct segmentation *const seg = &cm->seg;
+  // The buffers are allocated per frame, on the main thread, when the speed
+  // features ask for the reuse.
+  const int reuse_inter_pred =
+      sf->reuse_rd_inter_pred && ctx->inter_pred_pbuf[0] != NULL;
   PREDICTION_MODE this_mode;
   MV_REFERENCE_FRAME ref_frame, second_ref_frame;
   unsigned char segment_id = mi->segment_id;
@@ -3323,6 +3400,7 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
   MODE_INFO best_mbmode;
   int best_mode_skippable = 0;
   int midx, best_mode_index = -1;
+  int modes_visited = 0, modes_tested = 0;
   unsigned int ref_costs_single[MAX_REF_FRAMES], ref_costs_comp[MAX_REF_FRAMES];
   vpx_prob comp_mode_p;
   int64_t best_intra_rd = INT64_MAX;
@@ -3351,6 +3429,9 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
   int64_t mask_filter = 0;
   int64_t filter_cache[SWITCHABLE_FILTER_CONTEXTS];
 
+  struct buf_2d orig_dst[MAX_MB_PLANE];
+  struct buf_2d inter_pred[MAX_MB_PLANE];
+
   struct buf_2d *recon;
   struct buf_2d recon_buf;
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -3366,6 +3447,8 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
   recon = cpi->oxcf.content == VP9E_CONTENT_FILM ? &recon_buf : 0;
 
   vp9_zero(best_mbmode);
+  ctx->inter_pred_ready = 0;
+  for (i = 0; i < MAX_MB_PLANE; ++i) orig_dst[i] = xd->plane[i].dst;
 
   x->skip_encode = sf->skip_encode_frame && x->q_index < QIDX_SKIP_THRESH;
 
@@ -3511,6 +3594,7 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
     this_mode = vp9_mode_order[mode_index].mode;
     ref_frame = vp9_mode_order[mode_index].ref_frame[0];
     second_ref_frame = vp9_mode_order[mode_index].ref_frame[1];
+    ++modes_visited;
 
     vp9_zero(x->sum_y_eobs);
 
@@ -3675,9 +3759,11 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
       if (comp_pred) xd->plane[i].pre[1] = yv12_mb[second_ref_frame][i];
     }
 
+    ++modes_tested;
     if (ref_frame == INTRA_FRAME) {
       TX_SIZE uv_tx;
       struct macroblockd_plane *const pd = &xd->plane[1];
+      if (x->search_counts != NULL) ++x->search_counts->intra_modes_tested;
       memset(x->skip_txfm, 0, sizeof(x->skip_txfm));
       super_block_yrd(cpi, x, &rate_y, &distortion_y, &skippable, NULL, bsize,
                       best_rd, recon);
@@ -3701,11 +3787,21 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
         rate2 += intra_cost_penalty;
       distortion2 = distortion_y + distortion_uv;
     } else {
+      if (x->search_counts != NULL) ++x->search_counts->inter_modes_tested;
+      if (reuse_inter_pred) {
+        // Predict into the context buffer, so the prediction of the best
+        // mode does not need to be rebuilt when the block is encoded.
+        vp9_get_inter_pred_planes(ctx, 0, xd, bsize, inter_pred);
+        for (i = 0; i < MAX_MB_PLANE; ++i) xd->plane[i].dst = inter_pred[i];
+      }
       this_rd = handle_inter_mode(
           cpi, x, bsize, &rate2, &distortion2, &skippable, &rate_y, &rate_uv,
           recon, &disable_skip, frame_mv, mi_row, mi_col, single_newmv,
           single_inter_filter, single_skippable, &total_sse, best_rd,
-          &mask_filter, filter_cache);
+          &mask_filter, filter_cache, reuse_inter_pred);
+      if (reuse_inter_pred) {
+        for (i = 0; i < MAX_MB_PLANE; ++i) xd->plane[i].dst = orig_dst[i];
+      }
       if (this_rd == INT64_MAX) continue;
 
       compmode_cost = vp9_cost_bit(comp_mode_p, comp_pred);
@@ -3820,8 +3916,10 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
           // Initialize interp_filter here so we do not have to check for
           // inter block modes in get_pred_context_switchable_interp()
           mi->interp_filter = SWITCHABLE_FILTERS;
+          ctx->inter_pred_ready = 0;
         } else {
           best_pred_sse = x->pred_sse[ref_frame];
+          if (reuse_inter_pred) vp9_store_inter_pred(ctx, mi);
         }
 
         rd_cost->rate = rate2;
@@ -3910,10 +4008,13 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi, TileDataEnc *tile_data,
       }
     }
 
-    if (early_term) break;
-
-    if (x->skip && !comp_pred) break;
+    if (early_term || (x->skip && !comp_pred)) {
+      if (x->search_counts != NULL) ++x->search_counts->mode_early_exits;
+      break;
+    }
   }
+  if (x->search_counts != NULL)
+    x->search_counts->modes_skipped += modes_visited - modes_tested;
 
   // The inter modes' rate costs are not calculated precisely in some cases.
   // Therefore, sometimes, NEWMV is chosen instead of NEARESTMV, NEARMV, and
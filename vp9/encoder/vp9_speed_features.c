@@ -74,6 +74,10 @@ static void set_good_speed_feature_framesize_dependent(VP9_COMP *cpi,
   sf->use_square_only_thresh_high = BLOCK_SIZES;
   sf->use_square_only_thresh_low = BLOCK_4X4;
 
+  // Motion at these sizes often exceeds what the full pel search finds from
+  // its start point.
+  if (is_720p_or_larger && speed <= 2) sf->mv.use_pyramid_search = 1;
+
   if (is_480p_or_larger) {
     // Currently, the machine-learning based partition search early termination
     // is only used while VPXMIN(cm->width, cm->height) >= 480 and speed = 0.
@@ -239,6 +243,7 @@ static void set_good_speed_feature_framesize_independent(VP9_COMP *cpi,
 
   if (speed >= 1) {
     sf->temporal_filter_search_method = NSTEP;
+    sf->mv.reuse_recode_search = 1;
     sf->rd_ml_partition.var_pruning = !boosted;
     sf->rd_ml_partition.prune_rect_thresh[1] = 225;
     sf->rd_ml_partition.prune_rect_thresh[2] = 225;
@@ -258,7 +263,7 @@ static void set_good_speed_feature_framesize_independent(VP9_COMP *cpi,
 
     sf->allow_txfm_domain_distortion = 1;
     sf->tx_domain_thresh = tx_dom_thresholds[(speed < 6) ? speed : 5];
-    sf->allow_quant_coeff_opt = sf->optimize_coefficients;
+    sf->allow_quant_coeff_opt = sf->optimize_coefficients != NO_TRELLIS_OPT;
     sf->quant_opt_thresh = qopt_thresholds[(speed < 6) ? speed : 5];
     sf->less_rectangular_check = 1;
     sf->use_rd_breakout = 1;
@@ -374,7 +379,7 @@ static void set_good_speed_feature_framesize_independent(VP9_COMP *cpi,
 
   if (speed >= 5) {
     int i;
-    sf->optimize_coefficients = 0;
+    sf->optimize_coefficients = NO_TRELLIS_OPT;
     sf->mv.search_method = HEX;
     sf->disable_filter_search_var_thresh = 500;
     for (i = 0; i < TX_SIZES; ++i) {
@@ -526,7 +531,7 @@ static void set_rt_speed_feature_framesize_independent(
     sf->adaptive_rd_thresh = 4;
     sf->mode_skip_start = 6;
     sf->allow_skip_recode = 0;
-    sf->optimize_coefficients = 0;
+    sf->optimize_coefficients = NO_TRELLIS_OPT;
     sf->disable_split_mask = DISABLE_ALL_SPLIT;
     sf->lpf_pick = LPF_PICK_FROM_Q;
   }
@@ -849,6 +854,7 @@ void vp9_set_speed_features_framesize_dependent(VP9_COMP *cpi, int speed) {
   sf->partition_search_breakout_thr.rate = 80;
   sf->rd_ml_partition.search_early_termination = 0;
   sf->rd_ml_partition.search_breakout = 0;
+  sf->mv.use_pyramid_search = 0;
 
   if (oxcf->mode == REALTIME)
     set_rt_speed_feature_framesize_dependent(cpi, sf, speed);
@@ -899,11 +905,15 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
   sf->mv.subpel_search_method = SUBPEL_TREE;
   sf->mv.subpel_search_level = 2;
   sf->mv.subpel_force_stop = EIGHTH_PEL;
-  sf->optimize_coefficients = !is_lossless_requested(&cpi->oxcf);
+  sf->optimize_coefficients =
+      is_lossless_requested(&cpi->oxcf) ? NO_TRELLIS_OPT : FULL_TRELLIS_OPT;
   sf->mv.reduce_first_step_size = 0;
   sf->coeff_prob_appx_step = 1;
   sf->mv.auto_mv_step_size = 0;
   sf->mv.fullpel_search_step_param = 6;
+  sf->mv.use_hash_search = oxcf->content == VP9E_CONTENT_SCREEN;
+  sf->mv.reuse_recode_search = 0;
+  sf->mv.use_temporal_mv_seeds = 0;
   sf->comp_inter_joint_search_thresh = BLOCK_4X4;
   sf->tx_size_search_method = USE_FULL_RD;
   sf->use_lp32x32fdct = 0;
@@ -936,7 +946,7 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
   sf->adaptive_interp_filter_search = 0;
   sf->allow_txfm_domain_distortion = 0;
   sf->tx_domain_thresh = 99.0;
-  sf->allow_quant_coeff_opt = sf->optimize_coefficients;
+  sf->allow_quant_coeff_opt = sf->optimize_coefficients != NO_TRELLIS_OPT;
   sf->quant_opt_thresh = 99.0;
   sf->allow_acl = 1;
   sf->enable_tpl_model = oxcf->enable_tpl_model;
@@ -961,6 +971,7 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
   for (i = 0; i < BLOCK_SIZES; ++i) sf->inter_mode_mask[i] = INTER_ALL;
   sf->max_intra_bsize = BLOCK_64X64;
   sf->reuse_inter_pred_sby = 0;
+  sf->reuse_rd_inter_pred = 1;
   // This setting only takes effect when partition_search_type is set
   // to FIXED_PARTITION.
   sf->always_this_block_size = BLOCK_16X16;
@@ -982,6 +993,7 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
   sf->rd_ml_partition.prune_rect_thresh[3] = -1;
   sf->rd_ml_partition.var_pruning = 0;
   sf->use_accurate_subpel_search = USE_8_TAPS;
+  sf->subpel_cache_level = SUBPEL_CACHE_OFF;
 
   // Some speed-up features even for best quality as minimal impact on quality.
   sf->adaptive_rd_thresh = 1;
@@ -1005,16 +1017,27 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
     set_good_speed_feature_framesize_independent(cpi, cm, sf, speed);
 #endif
 
+  if (oxcf->subpel_cache >= 0)
+    sf->subpel_cache_level = (SUBPEL_CACHE_LEVEL)oxcf->subpel_cache;
+  sf->mv.use_temporal_mv_seeds = oxcf->temporal_mv_seeds;
+  if (oxcf->trellis_opt >= 0 && !is_lossless_requested(oxcf)) {
+    sf->optimize_coefficients = (TRELLIS_OPT_TYPE)oxcf->trellis_opt;
+    if (sf->allow_quant_coeff_opt)
+      sf->allow_quant_coeff_opt = sf->optimize_coefficients != NO_TRELLIS_OPT;
+  }
+  // Also applies to the trellis of the rd search, which stays on in 1 pass.
+  x->fast_coeff_opt = sf->optimize_coefficients == FAST_TRELLIS_OPT;
+
   cpi->diamond_search_sad = vp9_diamond_search_sad;
 
   // Slow quant, dct and trellis not worthwhile for first pass
   // so make sure they are always turned off.
-  if (oxcf->pass == 1) sf->optimize_coefficients = 0;
+  if (oxcf->pass == 1) sf->optimize_coefficients = NO_TRELLIS_OPT;
 
   // No recode for 1 pass.
   if (oxcf->pass == 0) {
     sf->recode_loop = DISALLOW_RECODE;
-    sf->optimize_coefficients = 0;
+    sf->optimize_coefficients = NO_TRELLIS_OPT;
   }
 
   if (sf->mv.subpel_force_stop == FULL_PEL) {
@@ -1036,7 +1059,8 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
   else if (cpi->oxcf.motion_vector_unit_test == 2)
     cpi->find_fractional_mv_step = vp9_return_min_sub_pixel_mv;
 
-  x->optimize = sf->optimize_coefficients == 1 && oxcf->pass != 1;
+  x->optimize =
+      sf->optimize_coefficients != NO_TRELLIS_OPT && oxcf->pass != 1;
 
   x->min_partition_size = sf->default_min_partition_size;
   x->max_partition_size = sf->default_max_partition_size;
@@ -12,6 +12,7 @@
 #define VPX_VP9_ENCODER_VP9_SPEED_FEATURES_H_
 
 #include "vp9/common/vp9_enums.h"
+#include "vp9/encoder/vp9_subpel_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -210,6 +211,27 @@ typedef struct MV_SPEED_FEATURES {
 
   // This variable sets the step_param used in full pel motion search.
   int fullpel_search_step_param;
+
+  // If set, the rd motion search, the first pass, the temporal filter and the
+  // tpl model also search around the motion estimated on image pyramids. See
+  // vp9_pyramid.h.
+  int use_pyramid_search;
+
+  // If set, the rd and non-rd motion searches start from an exact match of
+  // the block found in the block hash table of the reference. See
+  // vp9_block_hash.h.
+  int use_hash_search;
+
+  // If set, the recodes of a frame reuse the single reference motion search
+  // results of its first encoding instead of searching again.
+  int reuse_recode_search;
+
+  // If set, the temporal filter and the tpl model search the motion of a
+  // block in a frame around the one extrapolated from the motion found for it
+  // in the neighboring frames, with a reduced range, instead of searching the
+  // full range around the zero motion. Set from oxcf.temporal_mv_seeds; it
+  // costs some compression at every speed.
+  int use_temporal_mv_seeds;
 } MV_SPEED_FEATURES;
 
 typedef struct PARTITION_SEARCH_BREAKOUT_THR {
@@ -246,6 +268,15 @@ typedef enum {
   USE_8_TAPS_SHARP,
 } SUBPEL_SEARCH_TYPE;
 
+typedef enum {
+  NO_TRELLIS_OPT = 0,
+  // Greedy search over all the quantized values, looking ahead at the effect
+  // of each choice on the context of the next value.
+  FULL_TRELLIS_OPT,
+  // Single pass over the small quantized values, each one costed on its own.
+  FAST_TRELLIS_OPT,
+} TRELLIS_OPT_TYPE;
+
 typedef struct SPEED_FEATURES {
   MV_SPEED_FEATURES mv;
 
@@ -255,7 +286,7 @@ typedef struct SPEED_FEATURES {
   RECODE_LOOP_TYPE recode_loop;
 
   // Trellis (dynamic programming) optimization of quantized values (+1, 0).
-  int optimize_coefficients;
+  TRELLIS_OPT_TYPE optimize_coefficients;
 
   // Always set to 0. If on it enables 0 cost background transmission
   // (except for the initial transmission of the segmentation). The feature is
@@ -483,6 +514,10 @@ typedef struct SPEED_FEATURES {
   // time mode speed 6.
   int reuse_inter_pred_sby;
 
+  // Keep the inter prediction of the best mode of the rd mode search and
+  // reuse it in the final block encoding process.
+  int reuse_rd_inter_pred;
+
   // This variable sets the encode_breakout threshold. Currently, it is only
   // enabled in real time mode.
   int encode_breakout_thresh;
@@ -594,6 +629,11 @@ typedef struct SPEED_FEATURES {
   // order to achieve accurate motion search result.
   SUBPEL_SEARCH_TYPE use_accurate_subpel_search;
 
+  // Interpolated reference planes kept for the bilinear sub-pixel search.
+  // Costs 3 (half pel) or 15 (quarter pel) luma planes per reference, so it
+  // is off unless VP9E_SET_SUBPEL_CACHE asks for it.
+  SUBPEL_CACHE_LEVEL subpel_cache_level;
+
   // Search method used by temporal filtering in full_pixel_motion_search.
   SEARCH_METHODS temporal_filter_search_method;
 
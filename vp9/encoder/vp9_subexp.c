@@ -122,14 +122,28 @@ int64_t vp9_prob_diff_update_savings_search(const unsigned int *ct,
   vpx_prob newp, bestnewp = oldp;
   const int step = *bestp > oldp ? -1 : 1;
   const int upd_cost = vp9_cost_one(upd) - vp9_cost_zero(upd);
+  const int64_t min_update_b =
+      upd_cost + (MIN_DELP_BITS << VP9_PROB_COST_SHIFT);
 
-  if (old_b > upd_cost + (MIN_DELP_BITS << VP9_PROB_COST_SHIFT)) {
+  if (old_b > min_update_b) {
+    const vpx_prob last_newp = oldp - step;
     for (newp = *bestp; newp != oldp; newp += step) {
-      const int64_t new_b = cost_branch256(ct, newp);
+      // vp9_prob_cost is decreasing, so the cost of the candidates from newp
+      // to last_newp is at least the one of the zeros at the highest of them
+      // plus the one of the ones at the lowest.
+      const vpx_prob lo = step > 0 ? newp : last_newp;
+      const vpx_prob hi = step > 0 ? last_newp : newp;
+      const int64_t min_new_b = (int64_t)ct[0] * vp9_cost_zero(hi) +
+                                (int64_t)ct[1] * vp9_cost_one(lo);
+      // A candidate only wins if its cost is below |limit|.
       const int64_t update_b = prob_diff_update_cost(newp, oldp) + upd_cost;
-      const int64_t savings = old_b - new_b - update_b;
-      if (savings > bestsavings) {
-        bestsavings = savings;
+      const int64_t limit = old_b - update_b - bestsavings;
+      int64_t new_b;
+      if (old_b - min_new_b - min_update_b <= bestsavings) break;
+      if (limit <= 0) continue;
+      new_b = cost_branch256(ct, newp);
+      if (new_b < limit) {
+        bestsavings = limit + bestsavings - new_b;
         bestnewp = newp;
       }
     }
@@ -142,17 +156,24 @@ int64_t vp9_prob_diff_update_savings_search_model(const unsigned int *ct,
                                                   const vpx_prob oldp,
                                                   vpx_prob *bestp, vpx_prob upd,
                                                   int stepsize) {
-  int64_t i, old_b, new_b, update_b, savings, bestsavings;
+  int64_t i, old_b, new_b, update_b, limit, bestsavings;
   int64_t newp;
   const int64_t step_sign = *bestp > oldp ? -1 : 1;
   const int64_t step = stepsize * step_sign;
   const int64_t upd_cost = vp9_cost_one(upd) - vp9_cost_zero(upd);
   const vpx_prob *newplist, *oldplist;
   vpx_prob bestnewp;
+  // Model nodes with counts, the others cost nothing whatever their
+  // probability.
+  int model_nodes[MODEL_NODES];
+  int num_model_nodes = 0;
   oldplist = vp9_pareto8_full[oldp - 1];
   old_b = cost_branch256(ct + 2 * PIVOT_NODE, oldp);
-  for (i = UNCONSTRAINED_NODES; i < ENTROPY_NODES; ++i)
+  for (i = UNCONSTRAINED_NODES; i < ENTROPY_NODES; ++i) {
+    if (ct[2 * i] == 0 && ct[2 * i + 1] == 0) continue;
+    model_nodes[num_model_nodes++] = (int)i;
     old_b += cost_branch256(ct + 2 * i, oldplist[i - UNCONSTRAINED_NODES]);
+  }
 
   bestsavings = 0;
   bestnewp = oldp;
@@ -161,15 +182,21 @@ int64_t vp9_prob_diff_update_savings_search_model(const unsigned int *ct,
 
   if (old_b > upd_cost + (MIN_DELP_BITS << VP9_PROB_COST_SHIFT)) {
     for (newp = *bestp; (newp - oldp) * step_sign < 0; newp += step) {
+      int n;
       if (newp < 1 || newp > 255) continue;
+      // A candidate only wins if its cost is below |limit|, so its cost is
+      // accumulated until it reaches it.
+      update_b = prob_diff_update_cost((vpx_prob)newp, oldp) + upd_cost;
+      limit = old_b - update_b - bestsavings;
+      if (limit <= 0) continue;
       newplist = vp9_pareto8_full[newp - 1];
       new_b = cost_branch256(ct + 2 * PIVOT_NODE, (vpx_prob)newp);
-      for (i = UNCONSTRAINED_NODES; i < ENTROPY_NODES; ++i)
+      for (n = 0; n < num_model_nodes && new_b < limit; ++n) {
+        i = model_nodes[n];
         new_b += cost_branch256(ct + 2 * i, newplist[i - UNCONSTRAINED_NODES]);
-      update_b = prob_diff_update_cost((vpx_prob)newp, oldp) + upd_cost;
-      savings = old_b - new_b - update_b;
-      if (savings > bestsavings) {
-        bestsavings = savings;
+      }
+      if (new_b < limit) {
+        bestsavings = limit + bestsavings - new_b;
         bestnewp = (vpx_prob)newp;
       }
     }
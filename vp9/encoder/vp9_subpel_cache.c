@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/vpx_filter.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/encoder/vp9_subpel_cache.h"
+
+// Rows per job of vp9_subpel_cache_build_jobs().
+#define SUBPEL_CACHE_JOB_ROWS 32
+
+// The vertical pass reads one row below the area, so the planes hold one row
+// more than the area.
+static int plane_rows(const SubpelCacheRef *ref) {
+  return ref->row_end - ref->row_begin + 1;
+}
+
+static int num_row_jobs(const SubpelCacheRef *ref) {
+  return (plane_rows(ref) + SUBPEL_CACHE_JOB_ROWS - 1) / SUBPEL_CACHE_JOB_ROWS;
+}
+
+static void setup_area(SubpelCacheRef *ref, const YV12_BUFFER_CONFIG *src) {
+  const int border = src->border;
+  const int margin = VPXMIN(border, SUBPEL_CACHE_BORDER);
+  ref->src = src;
+  ref->stride = src->y_stride;
+  ref->origin = (uintptr_t)(src->y_buffer - border * src->y_stride - border);
+  ref->row_begin = border - margin;
+  ref->row_end = border + src->y_height + margin;
+  ref->col_begin = border - margin;
+  ref->col_end = border + src->y_width + margin;
+  // The filters read one row and one column past the area, which must stay
+  // inside the frame buffer.
+  if (ref->row_end == src->y_height + 2 * border) --ref->row_end;
+  if (ref->col_end == src->y_width + 2 * border) --ref->col_end;
+}
+
+int vp9_subpel_cache_setup(SubpelCache *cache, SUBPEL_CACHE_LEVEL level,
+                           const YV12_BUFFER_CONFIG *const *refs,
+                           int num_refs) {
+  const int step = level == SUBPEL_CACHE_QUARTER_PEL ? 2 : 4;
+  const int positions = 8 / step;
+  size_t size = 0;
+  uint8_t *buf;
+  int i, j;
+
+  vp9_subpel_cache_clear(cache);
+  if (level == SUBPEL_CACHE_OFF || num_refs == 0) return 1;
+  assert(num_refs <= SUBPEL_CACHE_MAX_REFS);
+
+  for (i = 0; i < num_refs; ++i) {
+    setup_area(&cache->refs[i], refs[i]);
+    size += (size_t)cache->refs[i].stride * plane_rows(&cache->refs[i]) *
+            (positions * positions - 1);
+  }
+  if (size > cache->buf_size) {
+    vpx_free(cache->buf);
+    cache->buf_size = 0;
+    cache->buf = (uint8_t *)vpx_memalign(32, size);
+    if (cache->buf == NULL) return 0;
+    cache->buf_size = size;
+  }
+
+  buf = cache->buf;
+  for (i = 0; i < num_refs; ++i) {
+    SubpelCacheRef *const ref = &cache->refs[i];
+    const size_t plane_size = (size_t)ref->stride * plane_rows(ref);
+    ref->planes[0] = NULL;
+    for (j = 1; j < positions * positions; ++j) {
+      ref->planes[j] = buf;
+      buf += plane_size;
+    }
+  }
+  cache->step = step;
+  cache->positions = positions;
+  cache->num_refs = num_refs;
+  cache->setup_level = level;
+  return 1;
+}
+
+int vp9_subpel_cache_num_jobs(const SubpelCache *cache) {
+  int i, jobs = 0;
+  for (i = 0; i < cache->num_refs; ++i) jobs += num_row_jobs(&cache->refs[i]);
+  return jobs;
+}
+
+// Same taps and rounding as the two passes of the bilinear filter of
+// vpx_sub_pixel_variance*().
+static void filter_rows(const uint8_t *src, int src_stride, uint8_t *dst,
+                        int dst_stride, int rows, int cols, int offset,
+                        int pixel_step) {
+  const int f1 = offset * 16;
+  const int f0 = (1 << FILTER_BITS) - f1;
+  int r, c;
+  for (r = 0; r < rows; ++r) {
+    for (c = 0; c < cols; ++c) {
+      dst[c] = ROUND_POWER_OF_TWO(src[c] * f0 + src[c + pixel_step] * f1,
+                                  FILTER_BITS);
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+static void build_job(SubpelCache *cache, int pass, int job) {
+  const int positions = cache->positions;
+  const int step = cache->step;
+  const SubpelCacheRef *ref = cache->refs;
+  int stride, row, rows, cols, offset, x, y;
+  const uint8_t *src;
+
+  while (job >= num_row_jobs(ref)) job -= num_row_jobs(ref++);
+  stride = ref->stride;
+  // Rows of the planes, which start at ref->row_begin.
+  row = job * SUBPEL_CACHE_JOB_ROWS;
+  rows = VPXMIN(SUBPEL_CACHE_JOB_ROWS, plane_rows(ref) - row);
+  cols = ref->col_end - ref->col_begin;
+  offset = row * stride + ref->col_begin;
+  src = (const uint8_t *)ref->origin + ref->row_begin * stride + offset;
+
+  if (pass == 0) {
+    // Horizontal pass, on all the rows of the planes.
+    for (x = 1; x < positions; ++x) {
+      filter_rows(src, stride, ref->planes[x] + offset, stride, rows, cols,
+                  x * step, 1);
+    }
+  } else {
+    // Vertical pass, on the rows of the area, from the source or from the
+    // output of the horizontal pass.
+    if (row + rows == plane_rows(ref)) --rows;
+    for (y = 1; y < positions; ++y) {
+      for (x = 0; x < positions; ++x) {
+        filter_rows(x == 0 ? src : ref->planes[x] + offset, stride,
+                    ref->planes[y * positions + x] + offset, stride, rows,
+                    cols, y * step, stride);
+      }
+    }
+  }
+}
+
+void vp9_subpel_cache_build_jobs(SubpelCache *cache, int pass, int first_job,
+                                 int job_step) {
+  const int num_jobs = vp9_subpel_cache_num_jobs(cache);
+  int job;
+  for (job = first_job; job < num_jobs; job += job_step)
+    build_job(cache, pass, job);
+}
+
+void vp9_subpel_cache_enable(SubpelCache *cache) {
+  cache->level = cache->setup_level;
+}
+
+void vp9_subpel_cache_build(SubpelCache *cache) {
+  vp9_subpel_cache_build_jobs(cache, 0, 0, 1);
+  vp9_subpel_cache_build_jobs(cache, 1, 0, 1);
+  vp9_subpel_cache_enable(cache);
+}
+
+void vp9_subpel_cache_clear(SubpelCache *cache) {
+  cache->level = SUBPEL_CACHE_OFF;
+  cache->setup_level = SUBPEL_CACHE_OFF;
+  cache->num_refs = 0;
+}
+
+void vp9_subpel_cache_free(SubpelCache *cache) {
+  vp9_subpel_cache_clear(cache);
+  vpx_free(cache->buf);
+  cache->buf = NULL;
+  cache->buf_size = 0;
+}
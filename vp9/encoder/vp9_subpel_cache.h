@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_SUBPEL_CACHE_H_
+#define VPX_VP9_ENCODER_VP9_SUBPEL_CACHE_H_
+
+#include <stdint.h>
+
+#include "vpx_ports/mem.h"
+#include "vpx_scale/yv12config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The sub-pixel motion search evaluates the bilinear interpolation of the
+// reference at many positions, and overlapping blocks, partitions and
+// reference MVs interpolate the same area again and again. The cache holds
+// the interpolated luma planes of the references of the frame being coded,
+// so the search only computes the variance against them. The planes are
+// bit-exact with vpx_sub_pixel_variance*(), so the cache does not change the
+// encoding.
+typedef enum {
+  SUBPEL_CACHE_OFF = 0,
+  // Half pel positions: 3 planes per reference.
+  SUBPEL_CACHE_HALF_PEL = 1,
+  // Half and quarter pel positions: 15 planes per reference.
+  SUBPEL_CACHE_QUARTER_PEL = 2,
+} SUBPEL_CACHE_LEVEL;
+
+#define SUBPEL_CACHE_MAX_REFS 3
+#define SUBPEL_CACHE_MAX_PLANES 16
+
+// Pixels of the reference border covered by the planes. Blocks further out
+// fall back to vpx_sub_pixel_variance*().
+#define SUBPEL_CACHE_BORDER 32
+
+typedef struct SubpelCacheRef {
+  // Luma plane of the reference, NULL if the entry is unused.
+  const YV12_BUFFER_CONFIG *src;
+  // Address of the top left pixel of the luma plane of |src|, borders
+  // included.
+  uintptr_t origin;
+  int stride;
+  // Area of the luma plane of |src| held by the planes, relative to |origin|.
+  int row_begin;
+  int row_end;
+  int col_begin;
+  int col_end;
+  // Interpolated planes, starting at row |row_begin| and laid out like the
+  // luma plane of |src|. Indexed by (yoffset / step) * positions +
+  // xoffset / step, entry 0 is unused.
+  uint8_t *planes[SUBPEL_CACHE_MAX_PLANES];
+} SubpelCacheRef;
+
+typedef struct SubpelCache {
+  // Level of the planes served, SUBPEL_CACHE_OFF until they are built.
+  SUBPEL_CACHE_LEVEL level;
+  // Level of the planes set up by vp9_subpel_cache_setup().
+  SUBPEL_CACHE_LEVEL setup_level;
+  // Distance between the cached positions, in 1/8 pel.
+  int step;
+  // Number of cached positions per dimension.
+  int positions;
+  int num_refs;
+  SubpelCacheRef refs[SUBPEL_CACHE_MAX_REFS];
+  uint8_t *buf;
+  size_t buf_size;
+} SubpelCache;
+
+// Points the cache at |refs| and allocates their planes. Returns 0 on
+// allocation failure, in which case the cache stays empty.
+int vp9_subpel_cache_setup(SubpelCache *cache, SUBPEL_CACHE_LEVEL level,
+                           const YV12_BUFFER_CONFIG *const *refs,
+                           int num_refs);
+
+// Number of row jobs vp9_subpel_cache_build_jobs() splits each pass into.
+int vp9_subpel_cache_num_jobs(const SubpelCache *cache);
+
+// Builds the planes in two passes: |pass| 0 filters horizontally, |pass| 1
+// vertically from the result of pass 0. All the jobs of a pass must be done
+// before the next pass starts. Runs jobs |first_job|, |first_job| +
+// |job_step|... Once both passes are done, vp9_subpel_cache_enable() starts
+// serving the planes.
+void vp9_subpel_cache_build_jobs(SubpelCache *cache, int pass, int first_job,
+                                 int job_step);
+
+void vp9_subpel_cache_enable(SubpelCache *cache);
+
+// Builds all the planes on the calling thread and enables them.
+void vp9_subpel_cache_build(SubpelCache *cache);
+
+// Empties the cache, keeping the allocation.
+void vp9_subpel_cache_clear(SubpelCache *cache);
+
+void vp9_subpel_cache_free(SubpelCache *cache);
+
+// Returns the |w|x|h| block at |pre| interpolated at 1/8 pel offsets
+// (|xoffset|, |yoffset|) with the same stride as |pre|, or NULL if the cache
+// does not hold it.
+static INLINE const uint8_t *vp9_subpel_cache_get(const SubpelCache *cache,
+                                                  const uint8_t *pre,
+                                                  int xoffset, int yoffset,
+                                                  int w, int h) {
+  const uintptr_t addr = (uintptr_t)pre;
+  int i;
+  if (cache->level == SUBPEL_CACHE_OFF ||
+      ((xoffset | yoffset) & (cache->step - 1)))
+    return NULL;
+  for (i = 0; i < cache->num_refs; ++i) {
+    const SubpelCacheRef *const ref = &cache->refs[i];
+    const uintptr_t offset = addr - ref->origin;
+    if (addr >= ref->origin &&
+        offset < (uintptr_t)ref->row_end * ref->stride) {
+      const int row = (int)(offset / ref->stride);
+      const int col = (int)(offset % ref->stride);
+      if (row >= ref->row_begin && row + h <= ref->row_end &&
+          col >= ref->col_begin && col + w <= ref->col_end) {
+        const int idx = (yoffset / cache->step) * cache->positions +
+                        xoffset / cache->step;
+        if (idx == 0) return pre;
+        return ref->planes[idx] + (offset - ref->row_begin * ref->stride);
+      }
+    }
+  }
+  return NULL;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_SUBPEL_CACHE_H_
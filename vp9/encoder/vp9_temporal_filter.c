@@ -551,14 +551,16 @@ void vp9_highbd_apply_temporal_filter_c(
 
 static uint32_t temporal_filter_find_matching_mb_c(
     VP9_COMP *cpi, ThreadData *td, uint8_t *arf_frame_buf,
-    uint8_t *frame_ptr_buf, int stride, MV *ref_mv, MV *blk_mvs,
-    int *blk_bestsme) {
+    uint8_t *frame_ptr_buf, int stride, const ImagePyramid *arf_pyramid,
+    const ImagePyramid *frame_pyramid, int mb_row, int mb_col, const MV *seed,
+    MV *ref_mv, MV *blk_mvs, int *blk_bestsme) {
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   MV_SPEED_FEATURES *const mv_sf = &cpi->sf.mv;
   const SEARCH_METHODS search_method = MESH;
   const SEARCH_METHODS search_method_16 = cpi->sf.temporal_filter_search_method;
   int step_param;
+  int sub_step_param;
   int sadpb = x->sadperbit16;
   uint32_t bestsme = UINT_MAX;
   uint32_t distortion;
@@ -568,6 +570,7 @@ static uint32_t temporal_filter_find_matching_mb_c(
 
   MV best_ref_mv1 = { 0, 0 };
   MV best_ref_mv1_full; /* full-pixel value of best_ref_mv1 */
+  MV pyramid_mv;
 
   // Save input state
   struct buf_2d src = x->plane[0].src;
@@ -585,12 +588,33 @@ static uint32_t temporal_filter_find_matching_mb_c(
 
   step_param = mv_sf->reduce_first_step_size;
   step_param = VPXMIN(step_param, MAX_MVSEARCH_STEPS - 2);
+  // The sub-blocks are searched around the motion of the block.
+  sub_step_param = mv_sf->use_temporal_mv_seeds
+                       ? VPXMAX(step_param, SEEDED_SEARCH_STEP_PARAM)
+                       : step_param;
 
   vp9_set_mv_search_range(&x->mv_limits, &best_ref_mv1);
 
-  vp9_full_pixel_search(cpi, x, TF_BLOCK, &best_ref_mv1_full, step_param,
-                        search_method, sadpb, cond_cost_list(cpi, cost_list),
-                        &best_ref_mv1, ref_mv, 0, 0);
+  if (seed != NULL) {
+    bestsme = vp9_seeded_full_pixel_search(
+        cpi, x, TF_BLOCK, seed, sadpb, cond_cost_list(cpi, cost_list),
+        &best_ref_mv1, ref_mv);
+  } else {
+    // With rd set the pattern searches return the error of
+    // vp9_get_mvpred_var(), as the candidate search below does. NSTEP and
+    // MESH ignore it and return their own error.
+    bestsme = vp9_full_pixel_search(
+        cpi, x, TF_BLOCK, &best_ref_mv1_full, step_param, search_method, sadpb,
+        cond_cost_list(cpi, cost_list), &best_ref_mv1, ref_mv, INT_MAX, 1);
+  }
+
+  if (arf_pyramid != NULL && frame_pyramid != NULL &&
+      vp9_pyramid_motion_search(arf_pyramid, frame_pyramid, mb_col * BW,
+                                mb_row * BH, BW, BH, &pyramid_mv)) {
+    vp9_candidate_full_pixel_search(cpi, x, TF_BLOCK, &pyramid_mv, sadpb,
+                                    cond_cost_list(cpi, cost_list),
+                                    &best_ref_mv1, ref_mv, (int)bestsme);
+  }
 
   /* restore UMV window */
   x->mv_limits = tmp_mv_limits;
@@ -620,7 +644,7 @@ static uint32_t temporal_filter_find_matching_mb_c(
 
       vp9_set_mv_search_range(&x->mv_limits, &best_ref_mv1);
       vp9_full_pixel_search(cpi, x, TF_SUB_BLOCK, &best_ref_mv1_full,
-                            step_param, search_method_16, sadpb,
+                            sub_step_param, search_method_16, sadpb,
                             cond_cost_list(cpi, cost_list), &best_ref_mv1,
                             &blk_mvs[k], 0, 0);
       /* restore UMV window */
@@ -653,7 +677,12 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
   struct scale_factors *scale = &arnr_filter_data->sf;
   int byte;
   int frame;
+  int n;
   int mb_col;
+  // Frames by increasing distance to the ARF, so that the motion found in a
+  // frame predicts the one in the next frame away from the ARF.
+  int frame_order[MAX_LAG_BUFFERS];
+  const int use_seeds = cpi->sf.mv.use_temporal_mv_seeds;
   int mb_cols = (frames[alt_ref_index]->y_crop_width + BW - 1) >> BW_LOG2;
   int mb_rows = (frames[alt_ref_index]->y_crop_height + BH - 1) >> BH_LOG2;
   DECLARE_ALIGNED(16, uint32_t, accumulator[BLK_PELS * 3]);
@@ -698,10 +727,20 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
   td->mb.mv_limits.row_max =
       ((mb_rows - 1 - mb_row) * BH) + (17 - 2 * VP9_INTERP_EXTEND);
 
+  frame_order[0] = alt_ref_index;
+  for (frame = 1, n = 1; n < frame_count; frame++) {
+    if (alt_ref_index - frame >= 0) frame_order[n++] = alt_ref_index - frame;
+    if (alt_ref_index + frame < frame_count)
+      frame_order[n++] = alt_ref_index + frame;
+  }
+
   for (mb_col = mb_col_start; mb_col < mb_col_end; mb_col++) {
     int i, j, k;
     int stride;
     MV ref_mv;
+    // Motion of the block in each frame, if it was searched.
+    MV frame_mvs[MAX_LAG_BUFFERS];
+    int frame_mv_found[MAX_LAG_BUFFERS];
 
     vp9_zero_array(accumulator, BLK_PELS * 3);
     vp9_zero_array(count, BLK_PELS * 3);
@@ -733,13 +772,20 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
       }
     }
 
-    for (frame = 0; frame < frame_count; frame++) {
+    vp9_zero_array(frame_mv_found, frame_count);
+    frame_mvs[alt_ref_index] = kZeroMv;
+    frame_mv_found[alt_ref_index] = 1;
+
+    // The filtered frame is the sum of the contributions of the frames, so
+    // their order does not matter.
+    for (n = 0; n < frame_count; n++) {
       // MVs for 4 16x16 sub blocks.
       MV blk_mvs[4];
       // Filter weights for 4 16x16 sub blocks.
       int blk_fw[4] = { 0, 0, 0, 0 };
       int use_32x32 = 0;
 
+      frame = frame_order[n];
       if (frames[frame] == NULL) continue;
 
       ref_mv.row = 0;
@@ -755,17 +801,37 @@ void vp9_temporal_filter_iterate_row_c(VP9_COMP *cpi, ThreadData *td,
       } else {
         const int thresh_low = 10000;
         const int thresh_high = 20000;
+        const int dir = frame < alt_ref_index ? -1 : 1;
+        const int prev = frame - dir;
         int blk_bestsme[4] = { INT_MAX, INT_MAX, INT_MAX, INT_MAX };
+        int err, err16;
+        int max_err = INT_MIN, min_err = INT_MAX;
+        MV seed_mv;
+        const MV *seed = NULL;
+
+        // Extrapolate the motion of the block in the two previous frames on
+        // the same side of the ARF.
+        if (use_seeds && prev != alt_ref_index && frame_mv_found[prev] &&
+            frame_mv_found[prev - dir]) {
+          const MV *mv1 = &frame_mvs[prev];
+          const MV *mv2 = &frame_mvs[prev - dir];
+          seed_mv.row = (2 * mv1->row - mv2->row + 4) >> 3;
+          seed_mv.col = (2 * mv1->col - mv2->col + 4) >> 3;
+          seed = &seed_mv;
+        }
 
         // Find best match in this frame by MC
-        int err = temporal_filter_find_matching_mb_c(
+        err = temporal_filter_find_matching_mb_c(
             cpi, td, frames[alt_ref_index]->y_buffer + mb_y_offset,
             frames[frame]->y_buffer + mb_y_offset, frames[frame]->y_stride,
-            &ref_mv, blk_mvs, blk_bestsme);
+            arnr_filter_data->pyramids[alt_ref_index],
+            arnr_filter_data->pyramids[frame], mb_row, mb_col, seed, &ref_mv,
+            blk_mvs, blk_bestsme);
+        frame_mvs[frame] = ref_mv;
+        frame_mv_found[frame] = 1;
 
-        int err16 =
+        err16 =
             blk_bestsme[0] + blk_bestsme[1] + blk_bestsme[2] + blk_bestsme[3];
-        int max_err = INT_MIN, min_err = INT_MAX;
         for (k = 0; k < 4; k++) {
           if (min_err > blk_bestsme[k]) min_err = blk_bestsme[k];
           if (max_err < blk_bestsme[k]) max_err = blk_bestsme[k];
@@ -1114,6 +1180,7 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
   int frames_to_blur_forward;
   struct scale_factors *sf = &arnr_filter_data->sf;
   YV12_BUFFER_CONFIG **frames = arnr_filter_data->frames;
+  struct lookahead_entry *entries[MAX_LAG_BUFFERS];
   int rdmult;
 
   // Apply context specific adjustments to the arnr filter parameters.
@@ -1131,7 +1198,12 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
     const int which_buffer = start_frame - frame;
     struct lookahead_entry *buf =
         vp9_lookahead_peek(cpi->lookahead, which_buffer);
-    frames[frames_to_blur - 1 - frame] = &buf->img;
+    entries[frame] = buf;
+    frames[frames_to_blur - 1 - frame] =
+        vp9_lookahead_materialize(cpi->lookahead, buf);
+    if (frames[frames_to_blur - 1 - frame] == NULL)
+      vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                         "Failed to materialize lookahead frame");
   }
 
   if (frames_to_blur > 0) {
@@ -1193,6 +1265,15 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
     }
   }
 
+  // The pyramids are built from the queued images, as the bordered copies
+  // are recycled between frames.
+  for (frame = 0; frame < frames_to_blur; ++frame) {
+    arnr_filter_data->pyramids[frames_to_blur - 1 - frame] =
+        cpi->sf.mv.use_pyramid_search && !cpi->use_svc
+            ? vp9_pyramid_cache_get(&cpi->pyramid_cache, &entries[frame]->img)
+            : NULL;
+  }
+
   // Initialize errorperbit and sabperbit.
   rdmult = vp9_compute_rd_mult_based_on_qindex(cpi, ARNR_FILT_QINDEX);
   set_error_per_bit(&cpi->td.mb, rdmult);
@@ -1202,4 +1283,7 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
     temporal_filter_iterate_c(cpi);
   else
     vp9_temporal_filter_row_mt(cpi);
+
+  for (frame = 0; frame < frames_to_blur; ++frame)
+    vp9_lookahead_release(cpi->lookahead, entries[frame]);
 }
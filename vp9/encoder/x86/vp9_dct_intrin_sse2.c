@@ -16,21 +16,17 @@
 #include "vpx_dsp/txfm_common.h"
 #include "vpx_dsp/x86/bitdepth_conversion_sse2.h"
 #include "vpx_dsp/x86/fwd_txfm_sse2.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+#include "vpx_dsp/x86/quantize_sse2.h"
 #include "vpx_dsp/x86/transpose_sse2.h"
 #include "vpx_dsp/x86/txfm_common_sse2.h"
 #include "vpx_ports/mem.h"
 
-static INLINE void load_buffer_4x4(const int16_t *input, __m128i *in,
-                                   int stride) {
+static INLINE void scale_buffer_4x4(__m128i *in) {
   const __m128i k__nonzero_bias_a = _mm_setr_epi16(0, 1, 1, 1, 1, 1, 1, 1);
   const __m128i k__nonzero_bias_b = _mm_setr_epi16(1, 0, 0, 0, 0, 0, 0, 0);
   __m128i mask;
 
-  in[0] = _mm_loadl_epi64((const __m128i *)(input + 0 * stride));
-  in[1] = _mm_loadl_epi64((const __m128i *)(input + 1 * stride));
-  in[2] = _mm_loadl_epi64((const __m128i *)(input + 2 * stride));
-  in[3] = _mm_loadl_epi64((const __m128i *)(input + 3 * stride));
-
   in[0] = _mm_slli_epi16(in[0], 4);
   in[1] = _mm_slli_epi16(in[1], 4);
   in[2] = _mm_slli_epi16(in[2], 4);
@@ -41,16 +37,31 @@ static INLINE void load_buffer_4x4(const int16_t *input, __m128i *in,
   in[0] = _mm_add_epi16(in[0], k__nonzero_bias_b);
 }
 
-static INLINE void write_buffer_4x4(tran_low_t *output, __m128i *res) {
+static INLINE void load_buffer_4x4(const int16_t *input, __m128i *in,
+                                   int stride) {
+  in[0] = _mm_loadl_epi64((const __m128i *)(input + 0 * stride));
+  in[1] = _mm_loadl_epi64((const __m128i *)(input + 1 * stride));
+  in[2] = _mm_loadl_epi64((const __m128i *)(input + 2 * stride));
+  in[3] = _mm_loadl_epi64((const __m128i *)(input + 3 * stride));
+  scale_buffer_4x4(in);
+}
+
+// Packs the 4 rows into out[0] (rows 0-1) and out[1] (rows 2-3) and rounds.
+static INLINE void round_buffer_4x4(const __m128i *res, __m128i *out) {
   const __m128i kOne = _mm_set1_epi16(1);
   __m128i in01 = _mm_unpacklo_epi64(res[0], res[1]);
   __m128i in23 = _mm_unpacklo_epi64(res[2], res[3]);
-  __m128i out01 = _mm_add_epi16(in01, kOne);
-  __m128i out23 = _mm_add_epi16(in23, kOne);
-  out01 = _mm_srai_epi16(out01, 2);
-  out23 = _mm_srai_epi16(out23, 2);
-  store_output(&out01, (output + 0 * 8));
-  store_output(&out23, (output + 1 * 8));
+  out[0] = _mm_add_epi16(in01, kOne);
+  out[1] = _mm_add_epi16(in23, kOne);
+  out[0] = _mm_srai_epi16(out[0], 2);
+  out[1] = _mm_srai_epi16(out[1], 2);
+}
+
+static INLINE void write_buffer_4x4(tran_low_t *output, __m128i *res) {
+  __m128i out[2];
+  round_buffer_4x4(res, out);
+  store_output(&out[0], (output + 0 * 8));
+  store_output(&out[1], (output + 1 * 8));
 }
 
 static INLINE void transpose_4x4(__m128i *res) {
@@ -1535,3 +1546,149 @@ void vp9_fht16x16_sse2(const int16_t *input, tran_low_t *output, int stride,
       break;
   }
 }
+
+// Returns |src| - |pred| for the 8 pixels in the low half of the registers.
+static INLINE __m128i subtract_8(const __m128i src, const __m128i pred) {
+  const __m128i zero = _mm_setzero_si128();
+  return _mm_sub_epi16(_mm_unpacklo_epi8(src, zero),
+                       _mm_unpacklo_epi8(pred, zero));
+}
+
+// Loads the residual of an 8x8 block, scaled as load_buffer_8x8() does.
+static INLINE void load_residual_8x8(const uint8_t *src, int src_stride,
+                                     const uint8_t *pred, int pred_stride,
+                                     __m128i *in) {
+  int i;
+  for (i = 0; i < 8; ++i) {
+    const __m128i s = _mm_loadl_epi64((const __m128i *)(src + i * src_stride));
+    const __m128i p =
+        _mm_loadl_epi64((const __m128i *)(pred + i * pred_stride));
+    in[i] = _mm_slli_epi16(subtract_8(s, p), 2);
+  }
+}
+
+// Quantizes 8 coefficients as vp9_quantize_fp_c() does and stores the results.
+// Returns the scan position plus one of the nonzero coefficients, 0 elsewhere.
+static INLINE __m128i quantize_fp_8(const __m128i coeff, const __m128i round,
+                                    const __m128i quant, const __m128i dequant,
+                                    const int16_t *iscan,
+                                    tran_low_t *qcoeff_ptr,
+                                    tran_low_t *dqcoeff_ptr) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i sign = _mm_srai_epi16(coeff, 15);
+  __m128i qcoeff, nzero, eob;
+
+  qcoeff = invert_sign_sse2(coeff, sign);
+  qcoeff = _mm_adds_epi16(qcoeff, round);
+  qcoeff = _mm_mulhi_epi16(qcoeff, quant);
+  qcoeff = invert_sign_sse2(qcoeff, sign);
+  store_tran_low(qcoeff, qcoeff_ptr);
+  calculate_dqcoeff_and_store(qcoeff, dequant, dqcoeff_ptr);
+
+  nzero = _mm_cmpeq_epi16(_mm_cmpeq_epi16(qcoeff, zero), zero);
+  eob = _mm_load_si128((const __m128i *)iscan);
+  eob = _mm_sub_epi16(eob, nzero);
+  return _mm_and_si128(eob, nzero);
+}
+
+// Quantizes the |num| registers of coefficients in raster order, the first
+// holding the DC, and returns the eob.
+static INLINE uint16_t quantize_fp_rows(const __m128i *coeff, int num,
+                                        const int16_t *round_ptr,
+                                        const int16_t *quant_ptr,
+                                        const int16_t *dequant_ptr,
+                                        const int16_t *iscan,
+                                        tran_low_t *qcoeff_ptr,
+                                        tran_low_t *dqcoeff_ptr) {
+  __m128i round = _mm_load_si128((const __m128i *)round_ptr);
+  __m128i quant = _mm_load_si128((const __m128i *)quant_ptr);
+  __m128i dequant = _mm_load_si128((const __m128i *)dequant_ptr);
+  __m128i eob = quantize_fp_8(coeff[0], round, quant, dequant, iscan,
+                              qcoeff_ptr, dqcoeff_ptr);
+  int i;
+
+  round = _mm_unpackhi_epi64(round, round);
+  quant = _mm_unpackhi_epi64(quant, quant);
+  dequant = _mm_unpackhi_epi64(dequant, dequant);
+  for (i = 1; i < num; ++i) {
+    const __m128i eob_i =
+        quantize_fp_8(coeff[i], round, quant, dequant, iscan + 8 * i,
+                      qcoeff_ptr + 8 * i, dqcoeff_ptr + 8 * i);
+    eob = _mm_max_epi16(eob, eob_i);
+  }
+  return (uint16_t)accumulate_eob(eob);
+}
+
+void vp9_fdct_quantize_fp_4x4_sse2(
+    const uint8_t *src, int src_stride, const uint8_t *pred, int pred_stride,
+    tran_low_t *coeff_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const int16_t *iscan) {
+  __m128i in[4], out[2];
+  int i;
+  (void)scan;
+
+  for (i = 0; i < 4; ++i) {
+    in[i] = subtract_8(load_unaligned_u32(src + i * src_stride),
+                       load_unaligned_u32(pred + i * pred_stride));
+  }
+  scale_buffer_4x4(in);
+  fdct4_sse2(in);
+  fdct4_sse2(in);
+  round_buffer_4x4(in, out);
+  store_output(&out[0], coeff_ptr);
+  store_output(&out[1], coeff_ptr + 8);
+
+  *eob_ptr = quantize_fp_rows(out, 2, round_ptr, quant_ptr, dequant_ptr, iscan,
+                              qcoeff_ptr, dqcoeff_ptr);
+}
+
+void vp9_fdct_quantize_fp_8x8_sse2(
+    const uint8_t *src, int src_stride, const uint8_t *pred, int pred_stride,
+    tran_low_t *coeff_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const int16_t *iscan) {
+  __m128i in[8];
+  (void)scan;
+
+  load_residual_8x8(src, src_stride, pred, pred_stride, in);
+  fdct8_sse2(in);
+  fdct8_sse2(in);
+  right_shift_8x8(in, 1);
+  write_buffer_8x8(coeff_ptr, in, 8);
+
+  *eob_ptr = quantize_fp_rows(in, 8, round_ptr, quant_ptr, dequant_ptr, iscan,
+                              qcoeff_ptr, dqcoeff_ptr);
+}
+
+void vp9_fdct_quantize_fp_16x16_sse2(
+    const uint8_t *src, int src_stride, const uint8_t *pred, int pred_stride,
+    tran_low_t *coeff_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan,
+    const int16_t *iscan) {
+  const __m128i zero = _mm_setzero_si128();
+  DECLARE_ALIGNED(16, int16_t, src_diff[16 * 16]);
+  __m128i coeff[32];
+  int i;
+  (void)scan;
+
+  // fdct16_sse2() rounds differently from vpx_fdct16x16_c(), so the residual
+  // goes through a small buffer into vpx_fdct16x16_sse2() instead.
+  for (i = 0; i < 16; ++i) {
+    const __m128i s = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+    const __m128i p =
+        _mm_loadu_si128((const __m128i *)(pred + i * pred_stride));
+    _mm_store_si128((__m128i *)(src_diff + 16 * i), subtract_8(s, p));
+    _mm_store_si128(
+        (__m128i *)(src_diff + 16 * i + 8),
+        _mm_sub_epi16(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(p, zero)));
+  }
+  vpx_fdct16x16_sse2(src_diff, coeff_ptr, 16);
+
+  for (i = 0; i < 32; ++i) coeff[i] = load_tran_low(coeff_ptr + 8 * i);
+  *eob_ptr = quantize_fp_rows(coeff, 32, round_ptr, quant_ptr, dequant_ptr,
+                              iscan, qcoeff_ptr, dqcoeff_ptr);
+}
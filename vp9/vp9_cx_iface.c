@@ -62,6 +62,11 @@ typedef struct vp9_extracfg {
   unsigned int row_mt;
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
+  unsigned int low_memory_lookahead;
+  unsigned int rtc_target_frame_time;
+  int subpel_cache;
+  int trellis_opt;
+  int temporal_mv_seeds;
 } vp9_extracfg;
 
 static struct vp9_extracfg default_extra_cfg = {
@@ -97,6 +102,11 @@ static struct vp9_extracfg default_extra_cfg = {
   0,                     // row_mt
   0,                     // motion_vector_unit_test
   0,                     // delta_q_uv
+  0,                     // low_memory_lookahead
+  0,                     // rtc_target_frame_time
+  -1,                    // subpel_cache
+  -1,                    // trellis_opt
+  0,                     // temporal_mv_seeds
 };
 
 struct vpx_codec_alg_priv {
@@ -261,6 +271,10 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
 
   RANGE_CHECK(extra_cfg, row_mt, 0, 1);
   RANGE_CHECK(extra_cfg, motion_vector_unit_test, 0, 2);
+  RANGE_CHECK(extra_cfg, low_memory_lookahead, 0, 1);
+  RANGE_CHECK(extra_cfg, subpel_cache, -1, SUBPEL_CACHE_QUARTER_PEL);
+  RANGE_CHECK(extra_cfg, trellis_opt, -1, FAST_TRELLIS_OPT);
+  RANGE_CHECK(extra_cfg, temporal_mv_seeds, 0, 1);
   RANGE_CHECK(extra_cfg, enable_auto_alt_ref, 0, MAX_ARF_LAYERS);
   RANGE_CHECK(extra_cfg, cpu_used, -9, 9);
   RANGE_CHECK_HI(extra_cfg, noise_sensitivity, 6);
@@ -629,6 +643,12 @@ static vpx_codec_err_t set_encoder_config(
 
   oxcf->delta_q_uv = extra_cfg->delta_q_uv;
 
+  oxcf->low_memory_lookahead = extra_cfg->low_memory_lookahead;
+  oxcf->rtc_target_frame_time = extra_cfg->rtc_target_frame_time;
+  oxcf->subpel_cache = extra_cfg->subpel_cache;
+  oxcf->trellis_opt = extra_cfg->trellis_opt;
+  oxcf->temporal_mv_seeds = extra_cfg->temporal_mv_seeds;
+
   for (sl = 0; sl < oxcf->ss_number_layers; ++sl) {
     for (tl = 0; tl < oxcf->ts_number_layers; ++tl) {
       oxcf->layer_target_bitrate[sl * oxcf->ts_number_layers + tl] =
@@ -858,6 +878,30 @@ static vpx_codec_err_t ctrl_get_loopfilter_level(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_get_component_timing(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  vpx_component_timing_t *const arg = va_arg(args, vpx_component_timing_t *);
+  if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
+  *arg = ctx->cpi->component_timing.stats;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_get_search_stats(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  vpx_search_stats_t *const arg = va_arg(args, vpx_search_stats_t *);
+  if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
+  *arg = ctx->cpi->search_stats;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_get_last_speed(vpx_codec_alg_priv_t *ctx,
+                                           va_list args) {
+  int *const arg = va_arg(args, int *);
+  if (arg == NULL) return VPX_CODEC_INVALID_PARAM;
+  *arg = ctx->cpi->auto_speed.last_speed;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t update_extra_cfg(vpx_codec_alg_priv_t *ctx,
                                         const struct vp9_extracfg *extra_cfg) {
   const vpx_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
@@ -1055,6 +1099,59 @@ static vpx_codec_err_t ctrl_set_row_mt(vpx_codec_alg_priv_t *ctx,
   return update_extra_cfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t ctrl_set_low_memory_lookahead(vpx_codec_alg_priv_t *ctx,
+                                                     va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.low_memory_lookahead = CAST(VP9E_SET_LOW_MEMORY_LOOKAHEAD, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_rtc_target_frame_time(
+    vpx_codec_alg_priv_t *ctx, va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.rtc_target_frame_time =
+      CAST(VP9E_SET_RTC_TARGET_FRAME_TIME, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_subpel_cache(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.subpel_cache = CAST(VP9E_SET_SUBPEL_CACHE, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_trellis_opt(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.trellis_opt = CAST(VP9E_SET_TRELLIS_OPT, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_temporal_mv_seeds(vpx_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.temporal_mv_seeds = CAST(VP9E_SET_TEMPORAL_MV_SEEDS, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_component_timing(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  COMPONENT_TIMING *const timing = &ctx->cpi->component_timing;
+  const int enable = CAST(VP9E_SET_COMPONENT_TIMING, args) != 0;
+  if (enable && !timing->enabled) vp9_zero(timing->stats);
+  timing->enabled = enable;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_search_stats(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  ThreadData *const td = &ctx->cpi->td;
+  td->mb.search_counts =
+      CAST(VP9E_SET_SEARCH_STATS, args) ? &td->search_counts : NULL;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_set_rtc_external_ratectrl(vpx_codec_alg_priv_t *ctx,
                                                       va_list args) {
   VP9_COMP *const cpi = ctx->cpi;
@@ -1295,6 +1392,9 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
 
   if (cpi == NULL) return VPX_CODEC_INVALID_PARAM;
 
+  vp9_component_timing_new_frame(&cpi->component_timing);
+  vp9_zero(cpi->search_stats);
+
   if (img != NULL) {
     res = validate_img(ctx, img);
     if (res == VPX_CODEC_OK) {
@@ -2000,12 +2100,22 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_SET_DISABLE_LOOPFILTER, ctrl_set_disable_loopfilter },
   { VP9E_SET_RTC_EXTERNAL_RATECTRL, ctrl_set_rtc_external_ratectrl },
   { VP9E_SET_EXTERNAL_RATE_CONTROL, ctrl_set_external_rate_control },
+  { VP9E_SET_LOW_MEMORY_LOOKAHEAD, ctrl_set_low_memory_lookahead },
+  { VP9E_SET_COMPONENT_TIMING, ctrl_set_component_timing },
+  { VP9E_SET_SEARCH_STATS, ctrl_set_search_stats },
+  { VP9E_SET_RTC_TARGET_FRAME_TIME, ctrl_set_rtc_target_frame_time },
+  { VP9E_SET_SUBPEL_CACHE, ctrl_set_subpel_cache },
+  { VP9E_SET_TRELLIS_OPT, ctrl_set_trellis_opt },
+  { VP9E_SET_TEMPORAL_MV_SEEDS, ctrl_set_temporal_mv_seeds },
 
   // Getters
   { VP8E_GET_LAST_QUANTIZER, ctrl_get_quantizer },
   { VP8E_GET_LAST_QUANTIZER_64, ctrl_get_quantizer64 },
   { VP9E_GET_LAST_QUANTIZER_SVC_LAYERS, ctrl_get_quantizer_svc_layers },
   { VP9E_GET_LOOPFILTER_LEVEL, ctrl_get_loopfilter_level },
+  { VP9E_GET_COMPONENT_TIMING, ctrl_get_component_timing },
+  { VP9E_GET_SEARCH_STATS, ctrl_get_search_stats },
+  { VP9E_GET_LAST_SPEED, ctrl_get_last_speed },
   { VP9_GET_REFERENCE, ctrl_get_reference },
   { VP9E_GET_SVC_LAYER_ID, ctrl_get_svc_layer_id },
   { VP9E_GET_ACTIVEMAP, ctrl_get_active_map },
@@ -2328,6 +2438,11 @@ void vp9_dump_encoder_config(const VP9EncoderConfig *oxcf, FILE *fp) {
   DUMP_STRUCT_VALUE(fp, oxcf, row_mt);
   DUMP_STRUCT_VALUE(fp, oxcf, motion_vector_unit_test);
   DUMP_STRUCT_VALUE(fp, oxcf, delta_q_uv);
+  DUMP_STRUCT_VALUE(fp, oxcf, low_memory_lookahead);
+  DUMP_STRUCT_VALUE(fp, oxcf, rtc_target_frame_time);
+  DUMP_STRUCT_VALUE(fp, oxcf, subpel_cache);
+  DUMP_STRUCT_VALUE(fp, oxcf, trellis_opt);
+  DUMP_STRUCT_VALUE(fp, oxcf, temporal_mv_seeds);
   DUMP_STRUCT_VALUE(fp, oxcf, use_simple_encode_api);
 }
 
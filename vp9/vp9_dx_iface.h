@@ -47,6 +47,7 @@ struct vpx_codec_alg_priv {
   int svc_spatial_layer;
   int row_mt;
   int lpf_opt;
+  int decode_stats;
 };
 
 #endif  // VPX_VP9_VP9_DX_IFACE_H_
@@ -14,8 +14,10 @@
  */
 #include <stdarg.h>
 #include <stdlib.h>
+#include "./vpx_config.h"
 #include "vpx/vpx_integer.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_ports/vpx_rtcd_profile.h"
 #include "vpx_version.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
@@ -71,6 +73,9 @@ vpx_codec_err_t vpx_codec_destroy(vpx_codec_ctx_t *ctx) {
     res = VPX_CODEC_ERROR;
   else {
     ctx->iface->destroy((vpx_codec_alg_priv_t *)ctx->priv);
+#if CONFIG_RTCD_PROFILE
+    vpx_rtcd_profile_dump();
+#endif
 
     ctx->iface = NULL;
     ctx->name = NULL;
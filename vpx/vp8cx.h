@@ -757,6 +757,138 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP8
    */
   VP8E_SET_RTC_EXTERNAL_RATECTRL,
+
+  /*!\brief Codec control function to reduce the memory used by lookahead.
+   *
+   * When enabled, frames queued for lag_in_frames are stored without the
+   * encoder border. A bordered copy is only built for frames that are about
+   * to be encoded or used for motion search (ARNR, TPL, mbgraph), and is
+   * released again afterwards. This trades extra frame copies for memory.
+   * Must be set before the first frame is encoded.
+   *
+   * 0 : off (default), 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_LOW_MEMORY_LOOKAHEAD,
+
+  /*!\brief Codec control function to enable per-stage encoder timing.
+   *
+   * When enabled, the encoder measures the wall clock and CPU time spent in
+   * each of the stages listed in #vp9e_timing_component. Enabling the timing
+   * clears previously accumulated values. When disabled, the instrumentation
+   * costs one branch per stage.
+   *
+   * 0 : off (default), 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_COMPONENT_TIMING,
+
+  /*!\brief Codec control function to get per-stage encoder timing.
+   *
+   * Fills in a #vpx_component_timing_t with the time accumulated since the
+   * timing was enabled, and the time spent during the last call to
+   * vpx_codec_encode(). All values are zero unless #VP9E_SET_COMPONENT_TIMING
+   * is on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_COMPONENT_TIMING,
+
+  /*!\brief Codec control function to enable encoder search statistics.
+   *
+   * When enabled, the encoder counts the partition, mode and motion search
+   * work reported by #VP9E_GET_SEARCH_STATS. When disabled, the motion
+   * searches check once per search whether to count.
+   *
+   * 0 : off (default), 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_SEARCH_STATS,
+
+  /*!\brief Codec control function to get encoder search statistics.
+   *
+   * Fills in a #vpx_search_stats_t with the amount of partition, mode and
+   * motion search work done during the last call to vpx_codec_encode(). All
+   * values are zero unless #VP9E_SET_SEARCH_STATS is on. The counters are
+   * meant for tuning speed features.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_SEARCH_STATS,
+
+  /*!\brief Codec control function to set the target encode time per frame.
+   *
+   * When non-zero, a one pass non-SVC real-time encode with cpu-used 5 or
+   * higher measures the time spent encoding each frame and raises the speed
+   * level above cpu-used, up to 9, when the frames take longer than about
+   * 7/8 of the target. The speed is lowered back toward cpu-used once the
+   * frames take less than half of the target. The value is in microseconds,
+   * e.g. 33333 to keep up with 30 fps on a single core.
+   *
+   * 0 : off (default)
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_RTC_TARGET_FRAME_TIME,
+
+  /*!\brief Codec control function to get the speed level of the last frame.
+   *
+   * This is cpu-used unless #VP9E_SET_RTC_TARGET_FRAME_TIME changed it.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_LAST_SPEED,
+
+  /*!\brief Codec control function to set the sub-pixel search plane cache.
+   *
+   * The encoder can interpolate the references once per frame so the
+   * bilinear sub-pixel motion search only computes variances. The encoding
+   * is the same with and without the cache. Each reference costs 3 extra
+   * luma planes for half pel positions, or 15 with quarter pel positions.
+   *
+   * -1 : default of the speed level, currently off (default)
+   *  0 : off
+   *  1 : half pel positions
+   *  2 : half and quarter pel positions
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_SUBPEL_CACHE,
+
+  /*!\brief Codec control function to set the trellis optimization of the
+   * quantized coefficients, int parameter.
+   *
+   * The fast mode only considers lowering the small quantized values, each
+   * one judged on its own rate and distortion. It has no effect in lossless
+   * mode, and the trellis optimization always stays off in the first pass.
+   *
+   * -1 : default of the speed level (default)
+   *  0 : off
+   *  1 : full trellis optimization
+   *  2 : fast approximate trellis optimization
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_TRELLIS_OPT,
+
+  /*!\brief Codec control function to seed the temporal filter and tpl model
+   * motion searches, int parameter.
+   *
+   * When enabled, the motion of a block is searched with a reduced range
+   * around the motion extrapolated from the neighboring frames of the group,
+   * instead of over the full range around the zero motion. This cuts the
+   * temporal filter and tpl model search time by about a third in 2-pass good
+   * quality encodes, at a small compression cost.
+   *
+   * 0 : off (default)
+   * 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_TEMPORAL_MV_SEEDS,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -948,6 +1080,73 @@ typedef struct vpx_svc_spatial_layer_sync {
   int base_layer_intra_only; /**< Flag for setting Intra-only frame on base */
 } vpx_svc_spatial_layer_sync_t;
 
+/*!\brief vp9 encoder stages reported by #VP9E_GET_COMPONENT_TIMING.
+ *
+ * The stages do not overlap. Tokenization runs inside the superblock encode
+ * loop and is timed per tile worker; its value is the time summed over all
+ * workers, and only the share of a single worker is removed from the wall
+ * time of #VP9E_TIMING_MODE_SEARCH.
+ */
+typedef enum vp9e_timing_component {
+  VP9E_TIMING_LOOKAHEAD_PUSH,   /**< Copying source frames into lookahead */
+  VP9E_TIMING_FIRST_PASS,       /**< First pass statistics collection */
+  VP9E_TIMING_TEMPORAL_FILTER,  /**< ARNR temporal filtering */
+  VP9E_TIMING_TPL,              /**< TPL model construction */
+  VP9E_TIMING_MBGRAPH,          /**< Macroblock graph analysis */
+  VP9E_TIMING_MODE_SEARCH,      /**< Partition and mode search, encoding */
+  VP9E_TIMING_TOKENIZE,         /**< Coefficient tokenization */
+  VP9E_TIMING_LPF_SEARCH,       /**< Loop filter level search */
+  VP9E_TIMING_LOOP_FILTER,      /**< Loop filtering */
+  VP9E_TIMING_PACK_BITSTREAM,   /**< Bitstream packing */
+  VP9E_TIMING_COMPONENTS        /**< Number of stages */
+} vp9e_timing_component;
+
+/*!\brief vp9 per-stage encoder timing, in microseconds.
+ *
+ * Arrays are indexed by #vp9e_timing_component. CPU time is the CPU time of
+ * the thread calling vpx_codec_encode() plus that of the encoder worker
+ * threads, other threads of the application are not counted. The loop filter
+ * worker threads are shared with the decoder and only show in the wall time.
+ */
+typedef struct vpx_component_timing {
+  int64_t total_wall_us[VP9E_TIMING_COMPONENTS]; /**< Since enabled */
+  int64_t total_cpu_us[VP9E_TIMING_COMPONENTS];  /**< Since enabled */
+  int64_t frame_wall_us[VP9E_TIMING_COMPONENTS]; /**< Last encode call */
+  int64_t frame_cpu_us[VP9E_TIMING_COMPONENTS];  /**< Last encode call */
+} vpx_component_timing_t;
+
+/*!\brief Number of block sizes in #vpx_search_stats_t::blocks_searched. */
+#define VPX_SEARCH_STATS_BLOCK_SIZES 13
+
+/*!\brief vp9 encoder search statistics.
+ *
+ * Counters of the work done by the partition, mode and motion searches of
+ * the frames coded during the last vpx_codec_encode() call, summed over all
+ * encoder threads. Motion searches done outside the mode search, such as for
+ * the temporal filter or the first pass, are not included.
+ */
+typedef struct vpx_search_stats {
+  /*!\brief Blocks whose modes were searched, indexed by block size from 4x4
+   * to 64x64 in the order 4x4, 4x8, 8x4, 8x8, 8x16, 16x8, 16x16, 16x32,
+   * 32x16, 32x32, 32x64, 64x32, 64x64.
+   */
+  int64_t blocks_searched[VPX_SEARCH_STATS_BLOCK_SIZES];
+  int64_t ml_prune_checks;    /**< Calls to the ML partition pruning model */
+  int64_t ml_prunes;          /**< Searches where it pruned partitions */
+  int64_t ml_breakout_checks; /**< Calls to the ML partition breakout model */
+  int64_t ml_breakouts;       /**< Partition searches it stopped */
+  int64_t rd_breakouts;       /**< Partition searches stopped by rd cost */
+  int64_t intra_modes_tested; /**< Intra mode candidates evaluated */
+  int64_t inter_modes_tested; /**< Inter mode candidates evaluated */
+  int64_t modes_skipped;      /**< Mode candidates pruned before evaluation */
+  int64_t mode_early_exits;   /**< Mode searches ended on a good candidate */
+  int64_t full_pel_searches;  /**< Full pixel motion searches */
+  int64_t full_pel_steps;     /**< Full pixel search iterations */
+  int64_t full_pel_sads;      /**< Full pixel SAD evaluations */
+  int64_t sub_pel_searches;   /**< Sub pixel motion searches */
+  int64_t sub_pel_evals;      /**< Sub pixel variance evaluations */
+} vpx_search_stats_t;
+
 /*!\cond */
 /*!\brief VP8 encoder control function parameter type
  *
@@ -1085,6 +1284,26 @@ VPX_CTRL_USE_TYPE(VP9E_GET_LAST_QUANTIZER_SVC_LAYERS, int *)
 #define VPX_CTRL_VP9E_GET_LAST_QUANTIZER_SVC_LAYERS
 VPX_CTRL_USE_TYPE(VP8E_SET_RTC_EXTERNAL_RATECTRL, int)
 #define VPX_CTRL_VP8E_SET_RTC_EXTERNAL_RATECTRL
+VPX_CTRL_USE_TYPE(VP9E_SET_LOW_MEMORY_LOOKAHEAD, unsigned int)
+#define VPX_CTRL_VP9E_SET_LOW_MEMORY_LOOKAHEAD
+VPX_CTRL_USE_TYPE(VP9E_SET_COMPONENT_TIMING, unsigned int)
+#define VPX_CTRL_VP9E_SET_COMPONENT_TIMING
+VPX_CTRL_USE_TYPE(VP9E_GET_COMPONENT_TIMING, vpx_component_timing_t *)
+#define VPX_CTRL_VP9E_GET_COMPONENT_TIMING
+VPX_CTRL_USE_TYPE(VP9E_SET_SEARCH_STATS, unsigned int)
+#define VPX_CTRL_VP9E_SET_SEARCH_STATS
+VPX_CTRL_USE_TYPE(VP9E_GET_SEARCH_STATS, vpx_search_stats_t *)
+#define VPX_CTRL_VP9E_GET_SEARCH_STATS
+VPX_CTRL_USE_TYPE(VP9E_SET_RTC_TARGET_FRAME_TIME, unsigned int)
+#define VPX_CTRL_VP9E_SET_RTC_TARGET_FRAME_TIME
+VPX_CTRL_USE_TYPE(VP9E_GET_LAST_SPEED, int *)
+#define VPX_CTRL_VP9E_GET_LAST_SPEED
+VPX_CTRL_USE_TYPE(VP9E_SET_SUBPEL_CACHE, int)
+#define VPX_CTRL_VP9E_SET_SUBPEL_CACHE
+VPX_CTRL_USE_TYPE(VP9E_SET_TRELLIS_OPT, int)
+#define VPX_CTRL_VP9E_SET_TRELLIS_OPT
+VPX_CTRL_USE_TYPE(VP9E_SET_TEMPORAL_MV_SEEDS, int)
+#define VPX_CTRL_VP9E_SET_TEMPORAL_MV_SEEDS
 
 /*!\endcond */
 /*! @} - end defgroup vp8_encoder */
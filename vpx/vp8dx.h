@@ -158,6 +158,29 @@ enum vp8_dec_control_id {
    */
   VP9D_SET_LOOP_FILTER_OPT,
 
+  /*!\brief Codec control function to enable decoder stage statistics.
+   *
+   * When enabled, the decoder times each stage of the frame decode and the
+   * time its worker threads spend waiting on each other. The statistics are
+   * read with #VP9D_GET_DECODE_STATS.
+   *
+   * 0 : off (default), 1 : on
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_DECODE_STATS,
+
+  /*!\brief Codec control function to get the statistics of the last frame.
+   *
+   * Fills in a #vpx_decode_stats_t for the last decoded frame. The
+   * post-processing time is added when the frame is retrieved with
+   * vpx_codec_get_frame(). All values are zero unless #VP9D_SET_DECODE_STATS
+   * is on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_GET_DECODE_STATS,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -179,6 +202,40 @@ typedef struct vpx_decrypt_init {
   void *decrypt_state;
 } vpx_decrypt_init;
 
+/*!\brief Maximum number of workers reported in #vpx_decode_stats_t. */
+#define VPX_DECODE_STATS_MAX_WORKERS 64
+
+/*!\brief vp9 decoder stages reported by #VP9D_GET_DECODE_STATS.
+ *
+ * Without row based multi-threading, coefficient tokens are read while the
+ * block is reconstructed and are counted in #VP9D_STAGE_RECON; only the mode
+ * info is counted in #VP9D_STAGE_PARSE.
+ */
+typedef enum vp9d_decode_stage {
+  VP9D_STAGE_HEADER,      /**< Frame header parsing and setup */
+  VP9D_STAGE_PARSE,       /**< Tile parsing */
+  VP9D_STAGE_RECON,       /**< Prediction and reconstruction */
+  VP9D_STAGE_LOOP_FILTER, /**< Loop filtering */
+  VP9D_STAGE_POSTPROC,    /**< Post-processing */
+  VP9D_STAGE_COUNT        /**< Number of stages */
+} vp9d_decode_stage;
+
+/*!\brief vp9 decoder statistics for one frame, in microseconds.
+ *
+ * Stage times are summed over the threads that ran the stage. The frame
+ * level loop filter that runs after multi-threaded tile decoding when
+ * #VP9D_SET_LOOP_FILTER_OPT is off is the exception and is reported as wall
+ * time. A worker's busy time is the sum of the stage times it ran. Its wait
+ * time covers blocking on row dependencies, on the row job queue, and, for
+ * the calling thread, on the other workers.
+ */
+typedef struct vpx_decode_stats {
+  int64_t stage_us[VP9D_STAGE_COUNT]; /**< Indexed by #vp9d_decode_stage */
+  int num_workers;                    /**< Number of valid worker entries */
+  int64_t worker_busy_us[VPX_DECODE_STATS_MAX_WORKERS]; /**< Busy time */
+  int64_t worker_wait_us[VPX_DECODE_STATS_MAX_WORKERS]; /**< Wait time */
+} vpx_decode_stats_t;
+
 /*!\cond */
 /*!\brief VP8 decoder control function parameter type
  *
@@ -217,6 +274,10 @@ VPX_CTRL_USE_TYPE(VP9D_SET_ROW_MT, int)
 #define VPX_CTRL_VP9_DECODE_SET_ROW_MT
 VPX_CTRL_USE_TYPE(VP9D_SET_LOOP_FILTER_OPT, int)
 #define VPX_CTRL_VP9_SET_LOOP_FILTER_OPT
+VPX_CTRL_USE_TYPE(VP9D_SET_DECODE_STATS, int)
+#define VPX_CTRL_VP9D_SET_DECODE_STATS
+VPX_CTRL_USE_TYPE(VP9D_GET_DECODE_STATS, vpx_decode_stats_t *)
+#define VPX_CTRL_VP9D_GET_DECODE_STATS
 
 /*!\endcond */
 /*! @} - end defgroup vp8_decoder */
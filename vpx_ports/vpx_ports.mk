@@ -18,6 +18,8 @@ PORTS_SRCS-yes += msvc.h
 PORTS_SRCS-yes += static_assert.h
 PORTS_SRCS-yes += system_state.h
 PORTS_SRCS-yes += vpx_timer.h
+PORTS_SRCS-yes += vpx_rtcd_profile.h
+PORTS_SRCS-$(CONFIG_RTCD_PROFILE) += vpx_rtcd_profile.c
 
 ifeq ($(VPX_ARCH_X86),yes)
 PORTS_SRCS-$(HAVE_MMX) += emms_mmx.c
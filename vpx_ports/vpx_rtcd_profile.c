@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vpx_ports/vpx_rtcd_profile.h"
+
+#if CONFIG_RTCD_PROFILE
+
+#define MAX_MODULES 8
+
+typedef struct RtcdProfileModule {
+  vpx_rtcd_profile_entry *entries;
+  int count;
+} RtcdProfileModule;
+
+static RtcdProfileModule modules[MAX_MODULES];
+static volatile long num_modules = 0;
+
+void vpx_rtcd_profile_register(vpx_rtcd_profile_entry *entries, int count) {
+#if defined(_MSC_VER)
+  const long slot = InterlockedIncrement(&num_modules) - 1;
+#else
+  const long slot = __sync_fetch_and_add(&num_modules, 1);
+#endif
+  if (slot >= MAX_MODULES) return;
+  modules[slot].entries = entries;
+  modules[slot].count = count;
+}
+
+static int compare_ticks(const void *a, const void *b) {
+  const vpx_rtcd_profile_entry *const ea =
+      *(vpx_rtcd_profile_entry *const *)a;
+  const vpx_rtcd_profile_entry *const eb =
+      *(vpx_rtcd_profile_entry *const *)b;
+  if (ea->ticks == eb->ticks) return 0;
+  return ea->ticks < eb->ticks ? 1 : -1;
+}
+
+void vpx_rtcd_profile_dump(void) {
+  const int count = num_modules < MAX_MODULES ? (int)num_modules : MAX_MODULES;
+  const char *const path = getenv("VPX_RTCD_PROFILE_FILE");
+  vpx_rtcd_profile_entry **sorted;
+  uint64_t total_ticks = 0;
+  int num_entries = 0;
+  int m, i;
+  FILE *f;
+
+  for (m = 0; m < count; ++m) num_entries += modules[m].count;
+  sorted = (vpx_rtcd_profile_entry **)malloc(num_entries * sizeof(*sorted));
+  if (sorted == NULL) return;
+  num_entries = 0;
+  for (m = 0; m < count; ++m) {
+    for (i = 0; i < modules[m].count; ++i) {
+      vpx_rtcd_profile_entry *const entry = &modules[m].entries[i];
+      if (entry->calls == 0) continue;
+      total_ticks += entry->ticks;
+      sorted[num_entries++] = entry;
+    }
+  }
+  if (num_entries == 0) {
+    free(sorted);
+    return;
+  }
+  qsort(sorted, num_entries, sizeof(*sorted), compare_ticks);
+
+  f = path != NULL ? fopen(path, "a") : stderr;
+  if (f == NULL) f = stderr;
+  fprintf(f, "%-40s %12s %16s %12s %7s\n", "function", "calls", "ticks",
+          "ticks/call", "%");
+  for (i = 0; i < num_entries; ++i) {
+    const vpx_rtcd_profile_entry *const entry = sorted[i];
+    fprintf(f, "%-40s %12" PRIu64 " %16" PRIu64 " %12.1f %6.2f%%\n",
+            entry->name, entry->calls, entry->ticks,
+            (double)entry->ticks / entry->calls,
+            100.0 * entry->ticks / (total_ticks ? total_ticks : 1));
+    sorted[i]->calls = 0;
+    sorted[i]->ticks = 0;
+  }
+  fprintf(f, "\n");
+  if (f != stderr) fclose(f);
+  free(sorted);
+}
+
+#endif  // CONFIG_RTCD_PROFILE
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_PORTS_VPX_RTCD_PROFILE_H_
+#define VPX_VPX_PORTS_VPX_RTCD_PROFILE_H_
+
+#include "./vpx_config.h"
+
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+#if CONFIG_RTCD_PROFILE
+
+#if defined(_WIN32)
+#undef NOMINMAX
+#define NOMINMAX
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+#include "vpx_ports/x86.h"
+#elif !defined(_WIN32)
+#include <time.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// With --enable-rtcd-profile every rtcd function is called through a wrapper
+// that counts the calls and the ticks spent in the selected implementation.
+// Ticks are TSC cycles on x86 and nanoseconds or performance counter ticks
+// elsewhere, and include any rtcd functions called by the function, such as
+// the SAD functions of a motion search. Block sizes are part of the function
+// names of most kernels, so the table is also a per block size breakdown.
+typedef struct vpx_rtcd_profile_entry {
+  const char *name;
+  uint64_t calls;
+  uint64_t ticks;
+} vpx_rtcd_profile_entry;
+
+static INLINE uint64_t vpx_rtcd_profile_now(void) {
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+  return x86_readtsc64();
+#elif defined(_WIN32)
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  return (uint64_t)now.QuadPart;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+static INLINE void vpx_rtcd_profile_add(vpx_rtcd_profile_entry *entry,
+                                        uint64_t start) {
+  const uint64_t ticks = vpx_rtcd_profile_now() - start;
+#if defined(_MSC_VER)
+  InterlockedIncrement64((volatile LONG64 *)&entry->calls);
+  InterlockedExchangeAdd64((volatile LONG64 *)&entry->ticks, (LONG64)ticks);
+#else
+  __atomic_fetch_add(&entry->calls, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&entry->ticks, ticks, __ATOMIC_RELAXED);
+#endif
+}
+
+// Called by the generated setup_rtcd_internal() of each rtcd module.
+void vpx_rtcd_profile_register(vpx_rtcd_profile_entry *entries, int count);
+
+// Writes the functions called since the previous dump, most expensive first,
+// and resets the counters. The table is appended to the file named by the
+// VPX_RTCD_PROFILE_FILE environment variable, or written to stderr.
+// vpx_codec_destroy() calls this for every codec instance.
+void vpx_rtcd_profile_dump(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // CONFIG_RTCD_PROFILE
+
+#endif  // VPX_VPX_PORTS_VPX_RTCD_PROFILE_H_
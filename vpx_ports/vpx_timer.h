@@ -32,6 +32,7 @@
  * POSIX specific includes
  */
 #include <sys/time.h>
+#include <time.h>
 
 /* timersub is not provided by msys at this time. */
 #ifndef timersub
@@ -87,6 +88,60 @@ static INLINE int64_t vpx_usec_timer_elapsed(struct vpx_usec_timer *t) {
 #endif
 }
 
+/* Returns the CPU time used by all threads of the process, in microseconds. */
+static INLINE int64_t vpx_process_cpu_usec(void) {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  ULARGE_INTEGER k, u;
+
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    return 0;
+  k.LowPart = kernel.dwLowDateTime;
+  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;
+  u.HighPart = user.dwHighDateTime;
+  return (int64_t)((k.QuadPart + u.QuadPart) / 10);
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+  struct timespec ts;
+
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts)) return 0;
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  return (int64_t)clock() * 1000000 / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Nonzero when vpx_thread_cpu_usec() reads a clock of the calling thread. */
+#if defined(_WIN32) || defined(CLOCK_THREAD_CPUTIME_ID)
+#define VPX_HAVE_THREAD_CPU_CLOCK 1
+#else
+#define VPX_HAVE_THREAD_CPU_CLOCK 0
+#endif
+
+/* Returns the CPU time used by the calling thread, in microseconds. Falls back
+ * to the process CPU time where there is no per-thread clock. */
+static INLINE int64_t vpx_thread_cpu_usec(void) {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  ULARGE_INTEGER k, u;
+
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+    return 0;
+  k.LowPart = kernel.dwLowDateTime;
+  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;
+  u.HighPart = user.dwHighDateTime;
+  return (int64_t)((k.QuadPart + u.QuadPart) / 10);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) return 0;
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  return vpx_process_cpu_usec();
+#endif
+}
+
 #else /* CONFIG_OS_SUPPORT = 0*/
 
 /* Empty timer functions if CONFIG_OS_SUPPORT = 0 */
@@ -104,6 +159,12 @@ static INLINE void vpx_usec_timer_mark(struct vpx_usec_timer *t) {}
 
 static INLINE int vpx_usec_timer_elapsed(struct vpx_usec_timer *t) { return 0; }
 
+static INLINE int64_t vpx_process_cpu_usec(void) { return 0; }
+
+#define VPX_HAVE_THREAD_CPU_CLOCK 0
+
+static INLINE int64_t vpx_thread_cpu_usec(void) { return 0; }
+
 #endif /* CONFIG_OS_SUPPORT */
 
 #endif  // VPX_VPX_PORTS_VPX_TIMER_H_
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vpx_ports/vpx_once.h"
+#include "vpx_ports/vpx_timer.h"
+#include "vpx_util/vpx_trace.h"
+
+#if CONFIG_TRACE
+#if defined(_MSC_VER)
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL __thread
+#endif
+
+#define TRACE_MAX_THREADS 256
+#define TRACE_MAX_EVENTS (1 << 16)
+
+typedef struct TraceEvent {
+  const char *name;
+  int64_t ts;
+  int tile;
+  int row;
+  char phase;
+} TraceEvent;
+
+typedef struct TraceBuffer {
+  TraceEvent events[TRACE_MAX_EVENTS];
+  int count;
+  int dropped;
+} TraceBuffer;
+
+static const char *trace_path = NULL;
+static struct vpx_usec_timer trace_start;
+// Each thread claims a slot the first time it records an event and is the
+// only writer of the buffer in that slot.
+static TraceBuffer *trace_buffers[TRACE_MAX_THREADS];
+static volatile long trace_num_buffers = 0;
+static TRACE_THREAD_LOCAL TraceBuffer *thread_buffer = NULL;
+static TRACE_THREAD_LOCAL int thread_has_slot = 0;
+
+static int claim_slot(void) {
+#if defined(_MSC_VER)
+  return (int)InterlockedIncrement(&trace_num_buffers) - 1;
+#else
+  return (int)__sync_fetch_and_add(&trace_num_buffers, 1);
+#endif
+}
+
+static void write_trace(void) {
+  FILE *const f = fopen(trace_path, "w");
+  const int num_buffers = trace_num_buffers < TRACE_MAX_THREADS
+                              ? (int)trace_num_buffers
+                              : TRACE_MAX_THREADS;
+  int dropped = 0;
+  int first = 1;
+  int tid, i;
+
+  if (f == NULL) {
+    fprintf(stderr, "Failed to open trace file %s\n", trace_path);
+    return;
+  }
+  fprintf(f, "{\"traceEvents\":[");
+  for (tid = 0; tid < num_buffers; ++tid) {
+    const TraceBuffer *const buf = trace_buffers[tid];
+    if (buf == NULL) continue;
+    for (i = 0; i < buf->count; ++i) {
+      const TraceEvent *const e = &buf->events[i];
+      fprintf(f, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRId64
+                 ",\"pid\":1,\"tid\":%d",
+              first ? "" : ",", e->name, e->phase, e->ts, tid);
+      if (e->tile >= 0 || e->row >= 0) {
+        fprintf(f, ",\"args\":{\"tile\":%d,\"row\":%d}", e->tile, e->row);
+      }
+      fprintf(f, "}");
+      first = 0;
+    }
+    dropped += buf->dropped;
+  }
+  fprintf(f, "\n],\"otherData\":{\"dropped_events\":\"%d\"}}\n", dropped);
+  fclose(f);
+}
+
+static void trace_init(void) {
+  trace_path = getenv("VPX_TRACE_FILE");
+  if (trace_path == NULL || trace_path[0] == '\0') {
+    trace_path = NULL;
+    return;
+  }
+  vpx_usec_timer_start(&trace_start);
+  atexit(write_trace);
+}
+
+static TraceBuffer *get_thread_buffer(void) {
+  int slot;
+
+  if (thread_has_slot) return thread_buffer;
+  thread_has_slot = 1;
+  once(trace_init);
+  if (trace_path == NULL) return NULL;
+  slot = claim_slot();
+  if (slot >= TRACE_MAX_THREADS) return NULL;
+  thread_buffer = (TraceBuffer *)calloc(1, sizeof(*thread_buffer));
+  trace_buffers[slot] = thread_buffer;
+  return thread_buffer;
+}
+
+void vpx_trace_event(const char *name, char phase, int tile, int row) {
+  TraceBuffer *const buf = get_thread_buffer();
+  struct vpx_usec_timer now = trace_start;
+  TraceEvent *e;
+
+  if (buf == NULL) return;
+  if (buf->count == TRACE_MAX_EVENTS) {
+    ++buf->dropped;
+    return;
+  }
+  vpx_usec_timer_mark(&now);
+  e = &buf->events[buf->count];
+  e->name = name;
+  e->ts = vpx_usec_timer_elapsed(&now);
+  e->tile = tile;
+  e->row = row;
+  e->phase = phase;
+  ++buf->count;
+}
+#endif  // CONFIG_TRACE
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_UTIL_VPX_TRACE_H_
+#define VPX_VPX_UTIL_VPX_TRACE_H_
+
+#include "./vpx_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_TRACE
+/* This is a debug tool used to look at the scheduling of the worker threads.
+ * When the VPX_TRACE_FILE environment variable names a file, begin and end
+ * events are recorded into a buffer owned by the calling thread, so no locks
+ * are taken while recording. At exit the buffers are written to that file in
+ * the Chrome trace event JSON format, which can be loaded in chrome://tracing
+ * or https://ui.perfetto.dev.
+ *
+ * |name| must be a string literal. |tile| and |row| are attached to the event
+ * when they are not negative. */
+void vpx_trace_event(const char *name, char phase, int tile, int row);
+
+#define VPX_TRACE_BEGIN(name) vpx_trace_event(name, 'B', -1, -1)
+#define VPX_TRACE_BEGIN_JOB(name, tile, row) \
+  vpx_trace_event(name, 'B', tile, row)
+#define VPX_TRACE_END(name) vpx_trace_event(name, 'E', -1, -1)
+#else
+#define VPX_TRACE_BEGIN(name) (void)0
+#define VPX_TRACE_BEGIN_JOB(name, tile, row) (void)0
+#define VPX_TRACE_END(name) (void)0
+#endif  // CONFIG_TRACE
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VPX_UTIL_VPX_TRACE_H_
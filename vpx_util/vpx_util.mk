@@ -18,3 +18,5 @@ UTIL_SRCS-yes += vpx_write_yuv_frame.c
 UTIL_SRCS-yes += vpx_timestamp.h
 UTIL_SRCS-$(or $(CONFIG_BITSTREAM_DEBUG),$(CONFIG_MISMATCH_DEBUG)) += vpx_debug_util.h
 UTIL_SRCS-$(or $(CONFIG_BITSTREAM_DEBUG),$(CONFIG_MISMATCH_DEBUG)) += vpx_debug_util.c
+UTIL_SRCS-yes += vpx_trace.h
+UTIL_SRCS-$(CONFIG_TRACE) += vpx_trace.c
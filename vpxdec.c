@@ -25,6 +25,7 @@
 #include "./ivfdec.h"
 
 #include "vpx/vpx_decoder.h"
+#include "vpx/vpx_frame_buffer.h"
 #include "vpx_ports/mem_ops.h"
 #include "vpx_ports/vpx_timer.h"
 
@@ -33,8 +34,12 @@
 #endif
 
 #include "./md5_utils.h"
+#include "./xxhash64.h"
 
 #include "./tools_common.h"
+#if CONFIG_MULTITHREAD
+#include "./thread_queue.h"
+#endif
 #if CONFIG_WEBM_IO
 #include "./webmdec.h"
 #endif
@@ -45,6 +50,7 @@ static const char *exec_name;
 struct VpxDecInputContext {
   struct VpxInputContext *vpx_input_ctx;
   struct WebmInputContext *webm_ctx;
+  struct MmapInputContext *mmap;
 };
 
 static const arg_def_t help =
@@ -90,6 +96,9 @@ static const arg_def_t fb_arg =
     ARG_DEF(NULL, "frame-buffers", 1, "Number of frame buffers to use");
 static const arg_def_t md5arg =
     ARG_DEF(NULL, "md5", 0, "Compute the MD5 sum of the decoded frame");
+static const arg_def_t hasharg =
+    ARG_DEF(NULL, "hash", 1,
+            "Hash the decoded frames instead of writing them (md5, xxh64)");
 #if CONFIG_VP9_HIGHBITDEPTH
 static const arg_def_t outbitdeptharg =
     ARG_DEF(NULL, "output-bit-depth", 1, "Output bit-depth for decoded frames");
@@ -103,6 +112,16 @@ static const arg_def_t rowmtarg =
 static const arg_def_t lpfoptarg =
     ARG_DEF(NULL, "lpf-opt", 1,
             "Do loopfilter without waiting for all threads to sync.");
+static const arg_def_t bencharg =
+    ARG_DEF(NULL, "bench", 1,
+            "Time N in-memory decodes, sweeping --threads, --row-mt and "
+            "--lpf-opt lists");
+static const arg_def_t mmaparg =
+    ARG_DEF(NULL, "mmap", 0, "Memory-map the input file (IVF, WebM and raw)");
+#if CONFIG_MULTITHREAD
+static const arg_def_t outputthreadarg = ARG_DEF(
+    NULL, "output-thread", 0, "Write or hash frames on a separate thread");
+#endif
 
 static const arg_def_t *all_args[] = { &help,
                                        &codecarg,
@@ -123,6 +142,7 @@ static const arg_def_t *all_args[] = { &help,
                                        &scalearg,
                                        &fb_arg,
                                        &md5arg,
+                                       &hasharg,
                                        &error_concealment,
                                        &continuearg,
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -132,6 +152,11 @@ static const arg_def_t *all_args[] = { &help,
                                        &framestatsarg,
                                        &rowmtarg,
                                        &lpfoptarg,
+                                       &bencharg,
+                                       &mmaparg,
+#if CONFIG_MULTITHREAD
+                                       &outputthreadarg,
+#endif
                                        NULL };
 
 #if CONFIG_VP8_DECODER
@@ -265,25 +290,104 @@ static int raw_read_frame(FILE *infile, uint8_t **buffer, size_t *bytes_read,
   return 1;
 }
 
+static int raw_read_frame_mmap(struct MmapInputContext *input,
+                               const uint8_t **frame, size_t *bytes_read) {
+  const uint8_t *const raw_hdr = mmap_input_read(input, RAW_FRAME_HDR_SZ);
+  const size_t kCorruptFrameThreshold = 256 * 1024 * 1024;
+  const size_t kFrameTooSmallThreshold = 256 * 1024;
+  size_t frame_size;
+
+  if (raw_hdr == NULL) {
+    if (!mmap_input_eof(input)) warn("Failed to read RAW frame size\n");
+    return 1;
+  }
+
+  frame_size = mem_get_le32(raw_hdr);
+  if (frame_size > kCorruptFrameThreshold) {
+    warn("Read invalid frame size (%u)\n", (unsigned int)frame_size);
+    frame_size = 0;
+  }
+
+  if (frame_size < kFrameTooSmallThreshold) {
+    warn("Warning: Read invalid frame size (%u) - not a raw file?\n",
+         (unsigned int)frame_size);
+  }
+
+  *frame = mmap_input_read(input, frame_size);
+  if (*frame == NULL) {
+    warn("Failed to read full frame\n");
+    return 1;
+  }
+  *bytes_read = frame_size;
+  return 0;
+}
+
+// Reads the next frame into |data|. With a mapped input |data| points into the
+// mapping, otherwise it points to |*buf|.
 static int dec_read_frame(struct VpxDecInputContext *input, uint8_t **buf,
-                          size_t *bytes_in_buffer, size_t *buffer_size) {
+                          size_t *bytes_in_buffer, size_t *buffer_size,
+                          const uint8_t **data) {
+  if (input->mmap != NULL) {
+    switch (input->vpx_input_ctx->file_type) {
+#if CONFIG_WEBM_IO
+      case FILE_TYPE_WEBM:
+        return webm_read_frame_mmap(input->webm_ctx, data, bytes_in_buffer);
+#endif
+      case FILE_TYPE_RAW:
+        return raw_read_frame_mmap(input->mmap, data, bytes_in_buffer);
+      case FILE_TYPE_IVF:
+        return ivf_read_frame_mmap(input->mmap, data, bytes_in_buffer);
+      default: return 1;
+    }
+  }
+
   switch (input->vpx_input_ctx->file_type) {
 #if CONFIG_WEBM_IO
     case FILE_TYPE_WEBM:
-      return webm_read_frame(input->webm_ctx, buf, bytes_in_buffer);
+      if (webm_read_frame(input->webm_ctx, buf, bytes_in_buffer)) return 1;
+      break;
 #endif
     case FILE_TYPE_RAW:
-      return raw_read_frame(input->vpx_input_ctx->file, buf, bytes_in_buffer,
-                            buffer_size);
+      if (raw_read_frame(input->vpx_input_ctx->file, buf, bytes_in_buffer,
+                         buffer_size))
+        return 1;
+      break;
     case FILE_TYPE_IVF:
-      return ivf_read_frame(input->vpx_input_ctx->file, buf, bytes_in_buffer,
-                            buffer_size);
+      if (ivf_read_frame(input->vpx_input_ctx->file, buf, bytes_in_buffer,
+                         buffer_size))
+        return 1;
+      break;
     default: return 1;
   }
+  *data = *buf;
+  return 0;
+}
+
+enum HashType { HASH_MD5, HASH_XXH64 };
+
+struct FrameHash {
+  enum HashType type;
+  MD5Context md5;
+  Xxh64Context xxh64;
+};
+
+static void frame_hash_init(struct FrameHash *hash) {
+  if (hash->type == HASH_XXH64)
+    xxh64_init(&hash->xxh64, 0);
+  else
+    MD5Init(&hash->md5);
 }
 
-static void update_image_md5(const vpx_image_t *img, const int planes[3],
-                             MD5Context *md5) {
+static void frame_hash_update(struct FrameHash *hash, const unsigned char *data,
+                              unsigned int size) {
+  if (hash->type == HASH_XXH64)
+    xxh64_update(&hash->xxh64, data, size);
+  else
+    MD5Update(&hash->md5, data, size);
+}
+
+static void update_image_hash(const vpx_image_t *img, const int planes[3],
+                              struct FrameHash *hash) {
   int i, y;
 
   for (i = 0; i < 3; ++i) {
@@ -295,7 +399,7 @@ static void update_image_md5(const vpx_image_t *img, const int planes[3],
     const int h = vpx_img_plane_height(img, plane);
 
     for (y = 0; y < h; ++y) {
-      MD5Update(md5, buf, w);
+      frame_hash_update(hash, buf, w);
       buf += stride;
     }
   }
@@ -365,14 +469,40 @@ static void show_progress(int frame_in, int frame_out, uint64_t dx_time) {
 struct ExternalFrameBuffer {
   uint8_t *data;
   size_t size;
+  // Number of references: one from the decoder while it uses the buffer,
+  // plus one for each frame waiting on the output thread.
   int in_use;
 };
 
 struct ExternalFrameBufferList {
   int num_external_frame_buffers;
   struct ExternalFrameBuffer *ext_fb;
+#if CONFIG_MULTITHREAD
+  // Set while the output thread may hold buffers. The counts are then
+  // protected by |mutex| and |released| is signalled when one drops.
+  int threaded;
+  int held;
+  pthread_mutex_t mutex;
+  pthread_cond_t released;
+#endif
 };
 
+static void lock_frame_buffers(struct ExternalFrameBufferList *ext_fb_list) {
+#if CONFIG_MULTITHREAD
+  if (ext_fb_list->threaded) pthread_mutex_lock(&ext_fb_list->mutex);
+#else
+  (void)ext_fb_list;
+#endif
+}
+
+static void unlock_frame_buffers(struct ExternalFrameBufferList *ext_fb_list) {
+#if CONFIG_MULTITHREAD
+  if (ext_fb_list->threaded) pthread_mutex_unlock(&ext_fb_list->mutex);
+#else
+  (void)ext_fb_list;
+#endif
+}
+
 // Callback used by libvpx to request an external frame buffer. |cb_priv|
 // Application private data passed into the set function. |min_size| is the
 // minimum size in bytes needed to decode the next frame. |fb| pointer to the
@@ -384,24 +514,42 @@ static int get_vp9_frame_buffer(void *cb_priv, size_t min_size,
       (struct ExternalFrameBufferList *)cb_priv;
   if (ext_fb_list == NULL) return -1;
 
-  // Find a free frame buffer.
-  for (i = 0; i < ext_fb_list->num_external_frame_buffers; ++i) {
-    if (!ext_fb_list->ext_fb[i].in_use) break;
+  lock_frame_buffers(ext_fb_list);
+  for (;;) {
+    // Find a free frame buffer.
+    for (i = 0; i < ext_fb_list->num_external_frame_buffers; ++i) {
+      if (!ext_fb_list->ext_fb[i].in_use) break;
+    }
+    if (i < ext_fb_list->num_external_frame_buffers) break;
+#if CONFIG_MULTITHREAD
+    // Wait for the output thread to finish with a frame if it holds any.
+    if (ext_fb_list->threaded && ext_fb_list->held > 0) {
+      pthread_cond_wait(&ext_fb_list->released, &ext_fb_list->mutex);
+      continue;
+    }
+#endif
+    unlock_frame_buffers(ext_fb_list);
+    return -1;
   }
-
-  if (i == ext_fb_list->num_external_frame_buffers) return -1;
+  ext_fb_list->ext_fb[i].in_use = 1;
+  unlock_frame_buffers(ext_fb_list);
 
   if (ext_fb_list->ext_fb[i].size < min_size) {
     free(ext_fb_list->ext_fb[i].data);
     ext_fb_list->ext_fb[i].data = (uint8_t *)calloc(min_size, sizeof(uint8_t));
-    if (!ext_fb_list->ext_fb[i].data) return -1;
+    if (!ext_fb_list->ext_fb[i].data) {
+      ext_fb_list->ext_fb[i].size = 0;
+      lock_frame_buffers(ext_fb_list);
+      ext_fb_list->ext_fb[i].in_use = 0;
+      unlock_frame_buffers(ext_fb_list);
+      return -1;
+    }
 
     ext_fb_list->ext_fb[i].size = min_size;
   }
 
   fb->data = ext_fb_list->ext_fb[i].data;
   fb->size = ext_fb_list->ext_fb[i].size;
-  ext_fb_list->ext_fb[i].in_use = 1;
 
   // Set the frame buffer's private data to point at the external frame buffer.
   fb->priv = &ext_fb_list->ext_fb[i];
@@ -413,10 +561,13 @@ static int get_vp9_frame_buffer(void *cb_priv, size_t min_size,
 // to the frame buffer.
 static int release_vp9_frame_buffer(void *cb_priv,
                                     vpx_codec_frame_buffer_t *fb) {
+  struct ExternalFrameBufferList *const ext_fb_list =
+      (struct ExternalFrameBufferList *)cb_priv;
   struct ExternalFrameBuffer *const ext_fb =
       (struct ExternalFrameBuffer *)fb->priv;
-  (void)cb_priv;
-  ext_fb->in_use = 0;
+  lock_frame_buffers(ext_fb_list);
+  --ext_fb->in_use;
+  unlock_frame_buffers(ext_fb_list);
   return 0;
 }
 
@@ -494,6 +645,16 @@ static void print_md5(unsigned char digest[16], const char *filename) {
   printf("  %s\n", filename);
 }
 
+static void frame_hash_print(struct FrameHash *hash, const char *filename) {
+  if (hash->type == HASH_XXH64) {
+    printf("%016" PRIx64 "  %s\n", xxh64_final(&hash->xxh64), filename);
+  } else {
+    unsigned char md5_digest[16];
+    MD5Final(md5_digest, &hash->md5);
+    print_md5(md5_digest, filename);
+  }
+}
+
 static FILE *open_outfile(const char *name) {
   if (strcmp("-", name) == 0) {
     set_binary_mode(stdout);
@@ -514,22 +675,473 @@ static int img_shifted_realloc_required(const vpx_image_t *img,
 }
 #endif
 
+// Where and how decoded frames are written.
+struct FrameOutput {
+  int single_file;
+  int use_y4m;
+  int do_hash;
+  int flipuv;
+  int opt_i420;
+  int opt_yv12;
+  const char *outfile_pattern;
+  char outfile_name[PATH_MAX];
+  FILE *outfile;
+  struct FrameHash hash;
+  const struct VpxInputContext *input;
+};
+
+// Writes or hashes the |frame_out|th shown frame. Returns 0 if the frame
+// cannot be represented in the requested output format.
+static int write_frame(struct FrameOutput *out, const vpx_image_t *img,
+                       int frame_in, int frame_out, int corrupted) {
+  const int PLANES_YUV[] = { VPX_PLANE_Y, VPX_PLANE_U, VPX_PLANE_V };
+  const int PLANES_YVU[] = { VPX_PLANE_Y, VPX_PLANE_V, VPX_PLANE_U };
+  const int *planes = out->flipuv ? PLANES_YVU : PLANES_YUV;
+
+  if (out->single_file) {
+    if (out->use_y4m) {
+      char buf[Y4M_BUFFER_SIZE] = { 0 };
+      size_t len = 0;
+      if (img->fmt == VPX_IMG_FMT_I440 || img->fmt == VPX_IMG_FMT_I44016) {
+        fprintf(stderr, "Cannot produce y4m output for 440 sampling.\n");
+        return 0;
+      }
+      if (frame_out == 1) {
+        // Y4M file header
+        len = y4m_write_file_header(
+            buf, sizeof(buf), out->input->width, out->input->height,
+            &out->input->framerate, img->fmt, img->bit_depth);
+        if (out->do_hash) {
+          frame_hash_update(&out->hash, (md5byte *)buf, (unsigned int)len);
+        } else {
+          fputs(buf, out->outfile);
+        }
+      }
+
+      // Y4M frame header
+      len = y4m_write_frame_header(buf, sizeof(buf));
+      if (out->do_hash) {
+        frame_hash_update(&out->hash, (md5byte *)buf, (unsigned int)len);
+      } else {
+        fputs(buf, out->outfile);
+      }
+    } else {
+      if (frame_out == 1) {
+        // Check if --yv12 or --i420 options are consistent with the
+        // bit-stream decoded
+        if (out->opt_i420) {
+          if (img->fmt != VPX_IMG_FMT_I420 && img->fmt != VPX_IMG_FMT_I42016) {
+            fprintf(stderr, "Cannot produce i420 output for bit-stream.\n");
+            return 0;
+          }
+        }
+        if (out->opt_yv12) {
+          if ((img->fmt != VPX_IMG_FMT_I420 && img->fmt != VPX_IMG_FMT_YV12) ||
+              img->bit_depth != 8) {
+            fprintf(stderr, "Cannot produce yv12 output for bit-stream.\n");
+            return 0;
+          }
+        }
+      }
+    }
+
+    if (out->do_hash) {
+      update_image_hash(img, planes, &out->hash);
+    } else {
+      if (!corrupted) write_image_file(img, planes, out->outfile);
+    }
+  } else {
+    generate_filename(out->outfile_pattern, out->outfile_name, PATH_MAX,
+                      img->d_w, img->d_h, frame_in);
+    if (out->do_hash) {
+      frame_hash_init(&out->hash);
+      update_image_hash(img, planes, &out->hash);
+      frame_hash_print(&out->hash, out->outfile_name);
+    } else {
+      FILE *const outfile = open_outfile(out->outfile_name);
+      write_image_file(img, planes, outfile);
+      fclose(outfile);
+    }
+  }
+  return 1;
+}
+
+#if CONFIG_MULTITHREAD
+#define OUTPUT_THREAD_FRAMES 8
+
+// A shown frame waiting to be written. It either holds a reference on the
+// decoder's external frame buffer |fb| or refers to a private |copy|.
+struct OutputFrame {
+  vpx_image_t img;
+  struct ExternalFrameBuffer *fb;
+  vpx_image_t *copy;
+  int frame_in;
+  int frame_out;
+  int corrupted;
+};
+
+struct OutputThread {
+  struct FrameOutput *output;
+  struct ExternalFrameBufferList *ext_fb_list;
+  struct OutputFrame frames[OUTPUT_THREAD_FRAMES];
+  struct ThreadQueue free_frames;
+  struct ThreadQueue ready_frames;
+  pthread_t thread;
+  int failed;
+};
+
+static void copy_image(vpx_image_t *dst, const vpx_image_t *src) {
+  const int bytes_per_sample = (src->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  int plane;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int w = vpx_img_plane_width(src, plane) * bytes_per_sample;
+    const int h = vpx_img_plane_height(src, plane);
+    const unsigned char *src_row = src->planes[plane];
+    unsigned char *dst_row = dst->planes[plane];
+    int y;
+
+    for (y = 0; y < h; ++y) {
+      memcpy(dst_row, src_row, w);
+      src_row += src->stride[plane];
+      dst_row += dst->stride[plane];
+    }
+  }
+}
+
+static void release_output_frame(struct OutputThread *ot,
+                                 struct OutputFrame *frame) {
+  if (frame->fb) {
+    lock_frame_buffers(ot->ext_fb_list);
+    --frame->fb->in_use;
+    --ot->ext_fb_list->held;
+    pthread_cond_signal(&ot->ext_fb_list->released);
+    unlock_frame_buffers(ot->ext_fb_list);
+    frame->fb = NULL;
+  }
+}
+
+static THREADFN output_thread_loop(void *arg) {
+  struct OutputThread *const ot = (struct OutputThread *)arg;
+  void *item;
+
+  while (thread_queue_pop(&ot->ready_frames, &item)) {
+    struct OutputFrame *const frame = (struct OutputFrame *)item;
+    if (!ot->failed &&
+        !write_frame(ot->output, &frame->img, frame->frame_in,
+                     frame->frame_out, frame->corrupted)) {
+      // Stop the decode loop at its next frame.
+      ot->failed = 1;
+      thread_queue_close(&ot->free_frames);
+    }
+    release_output_frame(ot, frame);
+    thread_queue_push(&ot->free_frames, frame);
+  }
+  return THREAD_RETURN(NULL);
+}
+
+static int output_thread_start(struct OutputThread *ot,
+                               struct FrameOutput *output,
+                               struct ExternalFrameBufferList *ext_fb_list) {
+  int i;
+
+  memset(ot, 0, sizeof(*ot));
+  ot->output = output;
+  ot->ext_fb_list = ext_fb_list;
+  if (thread_queue_init(&ot->free_frames, OUTPUT_THREAD_FRAMES)) return 0;
+  if (thread_queue_init(&ot->ready_frames, OUTPUT_THREAD_FRAMES)) {
+    thread_queue_destroy(&ot->free_frames);
+    return 0;
+  }
+  for (i = 0; i < OUTPUT_THREAD_FRAMES; ++i)
+    thread_queue_push(&ot->free_frames, &ot->frames[i]);
+  if (pthread_create(&ot->thread, NULL, output_thread_loop, ot)) {
+    thread_queue_destroy(&ot->ready_frames);
+    thread_queue_destroy(&ot->free_frames);
+    return 0;
+  }
+  return 1;
+}
+
+// Hands |img| to the output thread. Frames decoded into external frame
+// buffers are passed by reference; anything else is copied first. Returns 0
+// if the output thread has failed or the copy cannot be allocated.
+static int output_thread_submit(struct OutputThread *ot, const vpx_image_t *img,
+                                int from_decoder, int frame_in, int frame_out,
+                                int corrupted) {
+  struct OutputFrame *frame;
+  void *item;
+
+  if (!thread_queue_pop(&ot->free_frames, &item)) return 0;
+  frame = (struct OutputFrame *)item;
+  frame->frame_in = frame_in;
+  frame->frame_out = frame_out;
+  frame->corrupted = corrupted;
+
+  if (from_decoder && ot->ext_fb_list->threaded && img->fb_priv) {
+    frame->img = *img;
+    frame->fb = (struct ExternalFrameBuffer *)img->fb_priv;
+    lock_frame_buffers(ot->ext_fb_list);
+    ++frame->fb->in_use;
+    ++ot->ext_fb_list->held;
+    unlock_frame_buffers(ot->ext_fb_list);
+  } else {
+    if (frame->copy && (frame->copy->fmt != img->fmt ||
+                        frame->copy->d_w != img->d_w ||
+                        frame->copy->d_h != img->d_h)) {
+      vpx_img_free(frame->copy);
+      frame->copy = NULL;
+    }
+    if (!frame->copy) {
+      frame->copy = vpx_img_alloc(NULL, img->fmt, img->d_w, img->d_h, 16);
+      if (!frame->copy) {
+        fprintf(stderr, "Failed to allocate image\n");
+        thread_queue_push(&ot->free_frames, frame);
+        return 0;
+      }
+    }
+    frame->copy->bit_depth = img->bit_depth;
+    copy_image(frame->copy, img);
+    frame->img = *frame->copy;
+  }
+  return thread_queue_push(&ot->ready_frames, frame);
+}
+
+// Waits for all submitted frames to be written. Returns 0 if any failed.
+static int output_thread_stop(struct OutputThread *ot) {
+  int i;
+
+  thread_queue_close(&ot->ready_frames);
+  pthread_join(ot->thread, NULL);
+  for (i = 0; i < OUTPUT_THREAD_FRAMES; ++i) {
+    if (ot->frames[i].copy) vpx_img_free(ot->frames[i].copy);
+  }
+  thread_queue_destroy(&ot->ready_frames);
+  thread_queue_destroy(&ot->free_frames);
+  return !ot->failed;
+}
+#endif  // CONFIG_MULTITHREAD
+
+#define MAX_BENCH_VALUES 16
+
+// Values of an option swept by --bench. Without --bench only one value is
+// accepted.
+struct BenchValues {
+  unsigned int values[MAX_BENCH_VALUES];
+  int count;
+};
+
+struct BenchFrame {
+  uint8_t *data;
+  size_t size;
+};
+
+// Parses the comma separated list of unsigned values of |arg|.
+static void parse_bench_values(const struct arg *arg,
+                               struct BenchValues *list) {
+  char buf[256];
+  char *value, *next;
+
+  if (strlen(arg->val) >= sizeof(buf))
+    die("Error: Too long argument to --%s\n", arg->def->long_name);
+  strcpy(buf, arg->val);
+  list->count = 0;
+  for (value = buf; value != NULL; value = next) {
+    struct arg value_arg = *arg;
+    next = strchr(value, ',');
+    if (next != NULL) *next++ = '\0';
+    if (list->count == MAX_BENCH_VALUES)
+      die("Error: Too many values for --%s\n", arg->def->long_name);
+    value_arg.val = value;
+    list->values[list->count++] = arg_parse_uint(&value_arg);
+  }
+}
+
+// Reads the frames to benchmark into memory, skipping the first |skip| ones
+// and stopping after |limit| frames if it is not 0.
+static int bench_load_frames(struct VpxDecInputContext *input, uint8_t **buf,
+                             size_t *bytes_in_buffer, size_t *buffer_size,
+                             int skip, int limit, struct BenchFrame **frames,
+                             int *num_frames) {
+  const uint8_t *frame_data;
+  int capacity = 0;
+
+  *frames = NULL;
+  *num_frames = 0;
+  while (!limit || *num_frames < limit) {
+    struct BenchFrame *frame;
+    if (dec_read_frame(input, buf, bytes_in_buffer, buffer_size, &frame_data))
+      break;
+    if (skip > 0) {
+      --skip;
+      continue;
+    }
+    if (*num_frames == capacity) {
+      struct BenchFrame *const grown = (struct BenchFrame *)realloc(
+          *frames, (capacity * 2 + 64) * sizeof(**frames));
+      if (!grown) return 0;
+      *frames = grown;
+      capacity = capacity * 2 + 64;
+    }
+    frame = &(*frames)[*num_frames];
+    frame->size = *bytes_in_buffer;
+    frame->data = (uint8_t *)malloc(frame->size ? frame->size : 1);
+    if (!frame->data) return 0;
+    if (frame->size) memcpy(frame->data, frame_data, frame->size);
+    ++*num_frames;
+  }
+  return 1;
+}
+
+static void bench_free_frames(struct BenchFrame *frames, int num_frames) {
+  int i;
+  for (i = 0; i < num_frames; ++i) free(frames[i].data);
+  free(frames);
+}
+
+static int compare_latency(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t *)a;
+  const uint64_t y = *(const uint64_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+// Returns the |percent| percentile of the sorted |latency| array.
+static uint64_t bench_percentile(const uint64_t *latency, int count,
+                                 int percent) {
+  const int rank = (int)(((int64_t)count * percent + 99) / 100);
+  return latency[rank > 0 ? rank - 1 : 0];
+}
+
+// Decodes |data| and releases all the frames it produces. A NULL |data|
+// flushes the decoder.
+static int bench_decode(vpx_codec_ctx_t *decoder, const uint8_t *data,
+                        size_t size) {
+  vpx_codec_iter_t iter = NULL;
+  if (vpx_codec_decode(decoder, data, (unsigned int)size, NULL, 0)) {
+    const char *detail = vpx_codec_error_detail(decoder);
+    warn("Failed to decode frame: %s", vpx_codec_error(decoder));
+    if (detail) warn("Additional information: %s", detail);
+    return 0;
+  }
+  while (vpx_codec_get_frame(decoder, &iter) != NULL) {
+  }
+  return 1;
+}
+
+// Decodes |frames| |loops| times for every combination of the swept options
+// and prints the throughput, the per-frame latency percentiles and the CPU
+// utilization of each one. Output is disabled, so only the decoder is timed.
+static int run_benchmark(const VpxInterface *interface, int dec_flags,
+                         const struct BenchFrame *frames, int num_frames,
+                         int loops, const struct BenchValues *threads,
+                         const struct BenchValues *row_mt,
+                         const struct BenchValues *lpf_opt) {
+  const int is_vp9 = interface->fourcc == VP9_FOURCC;
+  const int num_row_mt = is_vp9 ? row_mt->count : 1;
+  const int num_lpf_opt = is_vp9 ? lpf_opt->count : 1;
+  const int count = num_frames * loops;
+  uint64_t *const latency = (uint64_t *)malloc(sizeof(*latency) * count);
+  int t, r, l;
+
+  if (!latency || count == 0) {
+    fprintf(stderr, count ? "Failed to allocate latency buffer\n"
+                          : "No frames to benchmark\n");
+    free(latency);
+    return EXIT_FAILURE;
+  }
+
+  printf("%-7s %-6s %-7s %10s %9s %9s %9s %9s %7s\n", "threads", "row-mt",
+         "lpf-opt", "fps", "p50(us)", "p90(us)", "p99(us)", "max(us)", "cpu");
+  for (t = 0; t < threads->count; ++t) {
+    for (r = 0; r < num_row_mt; ++r) {
+      for (l = 0; l < num_lpf_opt; ++l) {
+        vpx_codec_ctx_t decoder;
+        vpx_codec_dec_cfg_t cfg = { 0, 0, 0 };
+        struct vpx_usec_timer total_timer;
+        int64_t cpu_start, cpu_time, total_time;
+        int loop, i, n = 0, ok = 1;
+
+        cfg.threads = threads->values[t];
+        if (vpx_codec_dec_init(&decoder, interface->codec_interface(), &cfg,
+                               dec_flags)) {
+          fprintf(stderr, "Failed to initialize decoder: %s\n",
+                  vpx_codec_error(&decoder));
+          free(latency);
+          return EXIT_FAILURE;
+        }
+        if (is_vp9 &&
+            (vpx_codec_control(&decoder, VP9D_SET_ROW_MT, row_mt->values[r]) ||
+             vpx_codec_control(&decoder, VP9D_SET_LOOP_FILTER_OPT,
+                               lpf_opt->values[l]))) {
+          fprintf(stderr, "Failed to configure decoder: %s\n",
+                  vpx_codec_error(&decoder));
+          ok = 0;
+        }
+
+        vpx_usec_timer_start(&total_timer);
+        cpu_start = vpx_process_cpu_usec();
+        for (loop = 0; ok && loop < loops; ++loop) {
+          for (i = 0; ok && i < num_frames; ++i) {
+            struct vpx_usec_timer timer;
+            vpx_usec_timer_start(&timer);
+            ok = bench_decode(&decoder, frames[i].data, frames[i].size);
+            vpx_usec_timer_mark(&timer);
+            latency[n++] = (uint64_t)vpx_usec_timer_elapsed(&timer);
+          }
+          if (ok) ok = bench_decode(&decoder, NULL, 0);
+        }
+        vpx_usec_timer_mark(&total_timer);
+        cpu_time = vpx_process_cpu_usec() - cpu_start;
+        total_time = vpx_usec_timer_elapsed(&total_timer);
+
+        if (vpx_codec_destroy(&decoder)) {
+          fprintf(stderr, "Failed to destroy decoder: %s\n",
+                  vpx_codec_error(&decoder));
+          ok = 0;
+        }
+        if (!ok) {
+          free(latency);
+          return EXIT_FAILURE;
+        }
+
+        qsort(latency, n, sizeof(*latency), compare_latency);
+        printf("%7u %6u %7u %10.2f %9" PRIu64 " %9" PRIu64 " %9" PRIu64
+               " %9" PRIu64 " %6.1f%%\n",
+               threads->values[t], row_mt->values[r], lpf_opt->values[l],
+               total_time > 0 ? n * 1000000.0 / total_time : 0.0,
+               bench_percentile(latency, n, 50),
+               bench_percentile(latency, n, 90),
+               bench_percentile(latency, n, 99), latency[n - 1],
+               total_time > 0 ? cpu_time * 100.0 / total_time : 0.0);
+        fflush(stdout);
+      }
+    }
+  }
+  free(latency);
+  return EXIT_SUCCESS;
+}
+
 static int main_loop(int argc, const char **argv_) {
   vpx_codec_ctx_t decoder;
   char *fn = NULL;
   int i;
   int ret = EXIT_FAILURE;
   uint8_t *buf = NULL;
+  const uint8_t *frame_data = NULL;
   size_t bytes_in_buffer = 0, buffer_size = 0;
   FILE *infile;
   int frame_in = 0, frame_out = 0, flipuv = 0, noblit = 0;
-  int do_md5 = 0, progress = 0;
+  int do_hash = 0, progress = 0;
   int stop_after = 0, postproc = 0, summary = 0, quiet = 1;
   int arg_skip = 0;
   int ec_enabled = 0;
   int keep_going = 0;
   int enable_row_mt = 0;
   int enable_lpf_opt = 0;
+  int bench_loops = 0;
+  struct BenchValues bench_threads = { { 0 }, 1 };
+  struct BenchValues bench_row_mt = { { 0 }, 1 };
+  struct BenchValues bench_lpf_opt = { { 0 }, 1 };
   const VpxInterface *interface = NULL;
   const VpxInterface *fourcc_interface = NULL;
   uint64_t dx_time = 0;
@@ -538,6 +1150,8 @@ static int main_loop(int argc, const char **argv_) {
 
   int single_file;
   int use_y4m = 1;
+  int use_mmap = 0;
+  struct MmapInputContext mmap_ctx;
   int opt_yv12 = 0;
   int opt_i420 = 0;
   vpx_codec_dec_cfg_t cfg = { 0, 0, 0 };
@@ -558,24 +1172,27 @@ static int main_loop(int argc, const char **argv_) {
 #endif
   int frame_avail, got_data, flush_decoder = 0;
   int num_external_frame_buffers = 0;
-  struct ExternalFrameBufferList ext_fb_list = { 0, NULL };
+  struct ExternalFrameBufferList ext_fb_list;
 
   const char *outfile_pattern = NULL;
-  char outfile_name[PATH_MAX] = { 0 };
-  FILE *outfile = NULL;
+  struct FrameOutput output;
+#if CONFIG_MULTITHREAD
+  int use_output_thread = 0;
+  int output_thread_running = 0;
+  struct OutputThread output_thread;
+#endif
 
   FILE *framestats_file = NULL;
 
-  MD5Context md5_ctx;
-  unsigned char md5_digest[16];
-
-  struct VpxDecInputContext input = { NULL, NULL };
+  struct VpxDecInputContext input = { NULL, NULL, NULL };
   struct VpxInputContext vpx_input_ctx;
 #if CONFIG_WEBM_IO
   struct WebmInputContext webm_ctx;
   memset(&(webm_ctx), 0, sizeof(webm_ctx));
   input.webm_ctx = &webm_ctx;
 #endif
+  memset(&output, 0, sizeof(output));
+  memset(&ext_fb_list, 0, sizeof(ext_fb_list));
   input.vpx_input_ctx = &vpx_input_ctx;
 
   /* Parse command line */
@@ -622,12 +1239,24 @@ static int main_loop(int argc, const char **argv_) {
       arg_skip = arg_parse_uint(&arg);
     else if (arg_match(&arg, &postprocarg, argi))
       postproc = 1;
-    else if (arg_match(&arg, &md5arg, argi))
-      do_md5 = 1;
+    else if (arg_match(&arg, &md5arg, argi)) {
+      do_hash = 1;
+      output.hash.type = HASH_MD5;
+    } else if (arg_match(&arg, &hasharg, argi)) {
+      do_hash = 1;
+      if (!strcmp(arg.val, "md5"))
+        output.hash.type = HASH_MD5;
+      else if (!strcmp(arg.val, "xxh64"))
+        output.hash.type = HASH_XXH64;
+      else
+        die("Error: Unrecognized argument (%s) to --hash\n", arg.val);
+    }
     else if (arg_match(&arg, &summaryarg, argi))
       summary = 1;
-    else if (arg_match(&arg, &threadsarg, argi))
-      cfg.threads = arg_parse_uint(&arg);
+    else if (arg_match(&arg, &threadsarg, argi)) {
+      parse_bench_values(&arg, &bench_threads);
+      cfg.threads = bench_threads.values[0];
+    }
 #if CONFIG_VP9_DECODER
     else if (arg_match(&arg, &frameparallelarg, argi)) {
       /* ignored for compatibility */
@@ -656,10 +1285,21 @@ static int main_loop(int argc, const char **argv_) {
             arg.val);
       }
     } else if (arg_match(&arg, &rowmtarg, argi)) {
-      enable_row_mt = arg_parse_uint(&arg);
+      parse_bench_values(&arg, &bench_row_mt);
+      enable_row_mt = bench_row_mt.values[0];
     } else if (arg_match(&arg, &lpfoptarg, argi)) {
-      enable_lpf_opt = arg_parse_uint(&arg);
+      parse_bench_values(&arg, &bench_lpf_opt);
+      enable_lpf_opt = bench_lpf_opt.values[0];
+    } else if (arg_match(&arg, &bencharg, argi)) {
+      bench_loops = arg_parse_uint(&arg);
+    } else if (arg_match(&arg, &mmaparg, argi)) {
+      use_mmap = 1;
+    }
+#if CONFIG_MULTITHREAD
+    else if (arg_match(&arg, &outputthreadarg, argi)) {
+      use_output_thread = 1;
     }
+#endif
 #if CONFIG_VP8_DECODER
     else if (arg_match(&arg, &addnoise_level, argi)) {
       postproc = 1;
@@ -696,6 +1336,14 @@ static int main_loop(int argc, const char **argv_) {
     fprintf(stderr, "No input file specified!\n");
     usage_exit();
   }
+
+  if (!bench_loops && (bench_threads.count > 1 || bench_row_mt.count > 1 ||
+                       bench_lpf_opt.count > 1)) {
+    die("Error: Lists of values to --threads, --row-mt and --lpf-opt "
+        "require --bench\n");
+  }
+  // The benchmark only times the decoder, so nothing is written.
+  if (bench_loops) noblit = 1;
   /* Open file */
   infile = strcmp(fn, "-") ? fopen(fn, "rb") : set_binary_mode(stdin);
 
@@ -704,7 +1352,7 @@ static int main_loop(int argc, const char **argv_) {
   }
 #if CONFIG_OS_SUPPORT
   /* Make sure we don't dump to the terminal, unless forced to with -o - */
-  if (!outfile_pattern && isatty(fileno(stdout)) && !do_md5 && !noblit) {
+  if (!outfile_pattern && isatty(fileno(stdout)) && !do_hash && !noblit) {
     fprintf(stderr,
             "Not dumping raw video to your terminal. Use '-o -' to "
             "override.\n");
@@ -712,6 +1360,13 @@ static int main_loop(int argc, const char **argv_) {
   }
 #endif
   input.vpx_input_ctx->file = infile;
+  // Pipes and platforms without mmap fall back to reading through |infile|.
+  if (use_mmap && !mmap_input_open(&mmap_ctx, infile)) {
+    input.mmap = &mmap_ctx;
+#if CONFIG_WEBM_IO
+    input.webm_ctx->mmap = &mmap_ctx;
+#endif
+  }
   if (file_is_ivf(input.vpx_input_ctx))
     input.vpx_input_ctx->file_type = FILE_TYPE_IVF;
 #if CONFIG_WEBM_IO
@@ -728,17 +1383,19 @@ static int main_loop(int argc, const char **argv_) {
     free(argv);
     return EXIT_FAILURE;
   }
+  // The IVF and raw readers continue from wherever type detection stopped.
+  if (input.mmap) input.mmap->position = (size_t)ftello(infile);
 
   outfile_pattern = outfile_pattern ? outfile_pattern : "-";
   single_file = is_single_file(outfile_pattern);
 
   if (!noblit && single_file) {
-    generate_filename(outfile_pattern, outfile_name, PATH_MAX,
+    generate_filename(outfile_pattern, output.outfile_name, PATH_MAX,
                       vpx_input_ctx.width, vpx_input_ctx.height, 0);
-    if (do_md5)
-      MD5Init(&md5_ctx);
+    if (do_hash)
+      frame_hash_init(&output.hash);
     else
-      outfile = open_outfile(outfile_name);
+      output.outfile = open_outfile(output.outfile_name);
   }
 
   if (use_y4m && !noblit) {
@@ -771,6 +1428,23 @@ static int main_loop(int argc, const char **argv_) {
 
   dec_flags = (postproc ? VPX_CODEC_USE_POSTPROC : 0) |
               (ec_enabled ? VPX_CODEC_USE_ERROR_CONCEALMENT : 0);
+
+  if (bench_loops) {
+    struct BenchFrame *frames;
+    int num_frames;
+    if (!bench_load_frames(&input, &buf, &bytes_in_buffer, &buffer_size,
+                           arg_skip, stop_after, &frames, &num_frames)) {
+      fprintf(stderr, "Failed to allocate frame buffers\n");
+    } else {
+      fprintf(stderr, "Benchmarking %d frames x %d loops.\n", num_frames,
+              bench_loops);
+      ret = run_benchmark(interface, dec_flags, frames, num_frames,
+                          bench_loops, &bench_threads, &bench_row_mt,
+                          &bench_lpf_opt);
+    }
+    bench_free_frames(frames, num_frames);
+    goto fail2;
+  }
   if (vpx_codec_dec_init(&decoder, interface->codec_interface(), &cfg,
                          dec_flags)) {
     fprintf(stderr, "Failed to initialize decoder: %s\n",
@@ -810,10 +1484,25 @@ static int main_loop(int argc, const char **argv_) {
 
   if (arg_skip) fprintf(stderr, "Skipping first %d frames.\n", arg_skip);
   while (arg_skip) {
-    if (dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) break;
+    if (dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size,
+                       &frame_data))
+      break;
     arg_skip--;
   }
 
+#if CONFIG_MULTITHREAD
+  use_output_thread = use_output_thread && !noblit;
+  // Let the output thread reference VP9 frames instead of copying them. The
+  // pool covers the decoder's references and work buffers plus every frame
+  // that may be waiting to be written.
+  if (use_output_thread && interface->fourcc == VP9_FOURCC &&
+      num_external_frame_buffers == 0) {
+    num_external_frame_buffers = VP9_MAXIMUM_REF_BUFFERS +
+                                 VPX_MAXIMUM_WORK_BUFFERS +
+                                 OUTPUT_THREAD_FRAMES;
+  }
+#endif
+
   if (num_external_frame_buffers > 0) {
     ext_fb_list.num_external_frame_buffers = num_external_frame_buffers;
     ext_fb_list.ext_fb = (struct ExternalFrameBuffer *)calloc(
@@ -831,6 +1520,30 @@ static int main_loop(int argc, const char **argv_) {
     }
   }
 
+  output.single_file = single_file;
+  output.use_y4m = use_y4m;
+  output.do_hash = do_hash;
+  output.flipuv = flipuv;
+  output.opt_i420 = opt_i420;
+  output.opt_yv12 = opt_yv12;
+  output.outfile_pattern = outfile_pattern;
+  output.input = &vpx_input_ctx;
+
+#if CONFIG_MULTITHREAD
+  if (use_output_thread) {
+    if (ext_fb_list.ext_fb && !(dec_flags & VPX_CODEC_USE_POSTPROC)) {
+      pthread_mutex_init(&ext_fb_list.mutex, NULL);
+      pthread_cond_init(&ext_fb_list.released, NULL);
+      ext_fb_list.threaded = 1;
+    }
+    if (!output_thread_start(&output_thread, &output, &ext_fb_list)) {
+      fprintf(stderr, "Failed to start output thread\n");
+      goto fail;
+    }
+    output_thread_running = 1;
+  }
+#endif
+
   frame_avail = 1;
   got_data = 0;
 
@@ -845,14 +1558,15 @@ static int main_loop(int argc, const char **argv_) {
 
     frame_avail = 0;
     if (!stop_after || frame_in < stop_after) {
-      if (!dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) {
+      if (!dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size,
+                          &frame_data)) {
         frame_avail = 1;
         frame_in++;
 
         vpx_usec_timer_start(&timer);
 
-        if (vpx_codec_decode(&decoder, buf, (unsigned int)bytes_in_buffer, NULL,
-                             0)) {
+        if (vpx_codec_decode(&decoder, frame_data,
+                             (unsigned int)bytes_in_buffer, NULL, 0)) {
           const char *detail = vpx_codec_error_detail(&decoder);
           warn("Failed to decode frame %d: %s", frame_in,
                vpx_codec_error(&decoder));
@@ -910,9 +1624,7 @@ static int main_loop(int argc, const char **argv_) {
     if (progress) show_progress(frame_in, frame_out, dx_time);
 
     if (!noblit && img) {
-      const int PLANES_YUV[] = { VPX_PLANE_Y, VPX_PLANE_U, VPX_PLANE_V };
-      const int PLANES_YVU[] = { VPX_PLANE_Y, VPX_PLANE_V, VPX_PLANE_U };
-      const int *planes = flipuv ? PLANES_YVU : PLANES_YUV;
+      const vpx_image_t *const decoded = img;
 
       if (do_scale) {
         if (frame_out == 1) {
@@ -961,7 +1673,7 @@ static int main_loop(int argc, const char **argv_) {
       }
 #if CONFIG_VP9_HIGHBITDEPTH
       // Default to codec bit depth if output bit depth not set
-      if (!output_bit_depth && single_file && !do_md5) {
+      if (!output_bit_depth && single_file && !do_hash) {
         output_bit_depth = img->bit_depth;
       }
       // Shift up or down if necessary
@@ -994,77 +1706,25 @@ static int main_loop(int argc, const char **argv_) {
       }
 #endif
 
-      if (single_file) {
-        if (use_y4m) {
-          char buf[Y4M_BUFFER_SIZE] = { 0 };
-          size_t len = 0;
-          if (img->fmt == VPX_IMG_FMT_I440 || img->fmt == VPX_IMG_FMT_I44016) {
-            fprintf(stderr, "Cannot produce y4m output for 440 sampling.\n");
-            goto fail;
-          }
-          if (frame_out == 1) {
-            // Y4M file header
-            len = y4m_write_file_header(
-                buf, sizeof(buf), vpx_input_ctx.width, vpx_input_ctx.height,
-                &vpx_input_ctx.framerate, img->fmt, img->bit_depth);
-            if (do_md5) {
-              MD5Update(&md5_ctx, (md5byte *)buf, (unsigned int)len);
-            } else {
-              fputs(buf, outfile);
-            }
-          }
-
-          // Y4M frame header
-          len = y4m_write_frame_header(buf, sizeof(buf));
-          if (do_md5) {
-            MD5Update(&md5_ctx, (md5byte *)buf, (unsigned int)len);
-          } else {
-            fputs(buf, outfile);
-          }
-        } else {
-          if (frame_out == 1) {
-            // Check if --yv12 or --i420 options are consistent with the
-            // bit-stream decoded
-            if (opt_i420) {
-              if (img->fmt != VPX_IMG_FMT_I420 &&
-                  img->fmt != VPX_IMG_FMT_I42016) {
-                fprintf(stderr, "Cannot produce i420 output for bit-stream.\n");
-                goto fail;
-              }
-            }
-            if (opt_yv12) {
-              if ((img->fmt != VPX_IMG_FMT_I420 &&
-                   img->fmt != VPX_IMG_FMT_YV12) ||
-                  img->bit_depth != 8) {
-                fprintf(stderr, "Cannot produce yv12 output for bit-stream.\n");
-                goto fail;
-              }
-            }
-          }
-        }
-
-        if (do_md5) {
-          update_image_md5(img, planes, &md5_ctx);
-        } else {
-          if (!corrupted) write_image_file(img, planes, outfile);
-        }
-      } else {
-        generate_filename(outfile_pattern, outfile_name, PATH_MAX, img->d_w,
-                          img->d_h, frame_in);
-        if (do_md5) {
-          MD5Init(&md5_ctx);
-          update_image_md5(img, planes, &md5_ctx);
-          MD5Final(md5_digest, &md5_ctx);
-          print_md5(md5_digest, outfile_name);
-        } else {
-          outfile = open_outfile(outfile_name);
-          write_image_file(img, planes, outfile);
-          fclose(outfile);
-        }
-      }
+#if CONFIG_MULTITHREAD
+      if (output_thread_running) {
+        if (!output_thread_submit(&output_thread, img, img == decoded,
+                                  frame_in, frame_out, corrupted))
+          goto fail;
+      } else
+#endif
+      if (!write_frame(&output, img, frame_in, frame_out, corrupted))
+        goto fail;
     }
   }
 
+#if CONFIG_MULTITHREAD
+  if (output_thread_running) {
+    output_thread_running = 0;
+    if (!output_thread_stop(&output_thread)) goto fail;
+  }
+#endif
+
   if (summary || progress) {
     show_progress(frame_in, frame_out, dx_time);
     fprintf(stderr, "\n");
@@ -1078,6 +1738,10 @@ static int main_loop(int argc, const char **argv_) {
 
 fail:
 
+#if CONFIG_MULTITHREAD
+  if (output_thread_running) output_thread_stop(&output_thread);
+#endif
+
   if (vpx_codec_destroy(&decoder)) {
     fprintf(stderr, "Failed to destroy decoder: %s\n",
             vpx_codec_error(&decoder));
@@ -1086,11 +1750,10 @@ fail:
 fail2:
 
   if (!noblit && single_file) {
-    if (do_md5) {
-      MD5Final(md5_digest, &md5_ctx);
-      print_md5(md5_digest, outfile_name);
+    if (do_hash) {
+      frame_hash_print(&output.hash, output.outfile_name);
     } else {
-      fclose(outfile);
+      fclose(output.outfile);
     }
   }
 
@@ -1100,6 +1763,7 @@ fail2:
 #endif
 
   if (input.vpx_input_ctx->file_type != FILE_TYPE_WEBM) free(buf);
+  if (input.mmap) mmap_input_close(input.mmap);
 
   if (scaled_img) vpx_img_free(scaled_img);
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -1110,6 +1774,12 @@ fail2:
     free(ext_fb_list.ext_fb[i].data);
   }
   free(ext_fb_list.ext_fb);
+#if CONFIG_MULTITHREAD
+  if (ext_fb_list.threaded) {
+    pthread_cond_destroy(&ext_fb_list.released);
+    pthread_mutex_destroy(&ext_fb_list.mutex);
+  }
+#endif
 
   fclose(infile);
   if (framestats_file) fclose(framestats_file);
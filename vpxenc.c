@@ -8,6 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for sched_getaffinity() */
+#endif
+
 #include "./vpxenc.h"
 #include "./vpx_config.h"
 
@@ -22,6 +26,12 @@
 #if CONFIG_LIBYUV
 #include "third_party/libyuv/include/libyuv/scale.h"
 #endif
+#if CONFIG_MULTITHREAD && defined(_WIN32)
+#include <windows.h> /* NOLINT */
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include "vpx/vpx_encoder.h"
 #if CONFIG_DECODERS
@@ -42,7 +52,9 @@
 #include "vpx/vpx_integer.h"
 #include "vpx_ports/mem_ops.h"
 #include "vpx_ports/vpx_timer.h"
+#include "./mmapinput.h"
 #include "./rate_hist.h"
+#include "./thread_queue.h"
 #include "./vpxstats.h"
 #include "./warnings.h"
 #if CONFIG_WEBM_IO
@@ -161,6 +173,14 @@ static const arg_def_t disable_warnings =
 static const arg_def_t disable_warning_prompt =
     ARG_DEF("y", "disable-warning-prompt", 0,
             "Display warnings, but do not prompt user to continue.");
+static const arg_def_t mmaparg =
+    ARG_DEF(NULL, "mmap", 0, "Memory-map the input file (Y4M only)");
+static const arg_def_t pipelinearg =
+    ARG_DEF(NULL, "pipeline", 0,
+            "Read input and write output on separate threads");
+static const arg_def_t parallelstreamsarg =
+    ARG_DEF(NULL, "parallel-streams", 0,
+            "Run each stream's encoder on its own thread (implies --pipeline)");
 
 #if CONFIG_VP9_HIGHBITDEPTH
 static const arg_def_t test16bitinternalarg = ARG_DEF(
@@ -190,13 +210,18 @@ static const arg_def_t *main_args[] = { &help,
                                         &rate_hist_n,
                                         &disable_warnings,
                                         &disable_warning_prompt,
+                                        &mmaparg,
+                                        &pipelinearg,
+                                        &parallelstreamsarg,
                                         &recontest,
                                         NULL };
 
 static const arg_def_t usage =
     ARG_DEF("u", "usage", 1, "Usage profile number to use");
 static const arg_def_t threads =
-    ARG_DEF("t", "threads", 1, "Max number of threads to use");
+    ARG_DEF("t", "threads", 1,
+            "Max number of threads to use, or auto to size threads, tiles "
+            "and row-mt to the available cores");
 static const arg_def_t profile =
     ARG_DEF(NULL, "profile", 1, "Bitstream profile number to use");
 static const arg_def_t width = ARG_DEF("w", "width", 1, "Frame width");
@@ -528,6 +553,31 @@ static const arg_def_t disable_loopfilter =
             "0: Loopfilter on for all frames (default)\n"
             "1: Loopfilter off for non reference frames\n"
             "2: Loopfilter off for all frames");
+
+static const arg_def_t low_memory_lookahead =
+    ARG_DEF(NULL, "low-memory-lookahead", 1,
+            "Store lookahead frames without borders (0: off (default), 1: on)");
+
+static const arg_def_t rtc_target_frame_time =
+    ARG_DEF(NULL, "rtc-target-frame-time", 1,
+            "Raise the real-time speed above cpu-used to keep the encode time "
+            "per frame below this many microseconds (0: off (default))");
+
+static const arg_def_t subpel_cache =
+    ARG_DEF(NULL, "subpel-cache", 1,
+            "Interpolated reference planes for the sub-pixel search "
+            "(-1: speed default (default), 0: off, 1: half pel, "
+            "2: quarter pel)");
+
+static const arg_def_t trellis_opt =
+    ARG_DEF(NULL, "trellis", 1,
+            "Trellis optimization of the quantized coefficients "
+            "(-1: speed default (default), 0: off, 1: full, 2: fast)");
+
+static const arg_def_t temporal_mv_seeds =
+    ARG_DEF(NULL, "temporal-mv-seeds", 1,
+            "Seed the temporal filter and tpl motion searches with the motion "
+            "of the neighboring frames (0: off (default), 1: on)");
 #endif
 
 #if CONFIG_VP9_ENCODER
@@ -559,6 +609,11 @@ static const arg_def_t *vp9_args[] = { &cpu_used_vp9,
                                        &target_level,
                                        &row_mt,
                                        &disable_loopfilter,
+                                       &low_memory_lookahead,
+                                       &rtc_target_frame_time,
+                                       &subpel_cache,
+                                       &trellis_opt,
+                                       &temporal_mv_seeds,
 // NOTE: The entries above have a corresponding entry in vp9_arg_ctrl_map. The
 // entries below do not have a corresponding entry in vp9_arg_ctrl_map. They
 // must be listed at the end of vp9_args.
@@ -595,6 +650,11 @@ static const int vp9_arg_ctrl_map[] = { VP8E_SET_CPUUSED,
                                         VP9E_SET_TARGET_LEVEL,
                                         VP9E_SET_ROW_MT,
                                         VP9E_SET_DISABLE_LOOPFILTER,
+                                        VP9E_SET_LOW_MEMORY_LOOKAHEAD,
+                                        VP9E_SET_RTC_TARGET_FRAME_TIME,
+                                        VP9E_SET_SUBPEL_CACHE,
+                                        VP9E_SET_TRELLIS_OPT,
+                                        VP9E_SET_TEMPORAL_MV_SEEDS,
                                         0 };
 #endif
 
@@ -676,6 +736,8 @@ struct stream_config {
   int arg_ctrls[ARG_CTRL_CNT_MAX][2];
   int arg_ctrl_cnt;
   int write_webm;
+  int have_threads;
+  int auto_threads;
 #if CONFIG_VP9_HIGHBITDEPTH
   // whether to use 16bit internal buffers
   int use_16bit_internal;
@@ -702,6 +764,21 @@ struct stream_state {
   struct vpx_image *img;
   vpx_codec_ctx_t decoder;
   int mismatch_seen;
+  size_t ivf_frame_size;
+  FileOffset ivf_header_pos;
+#if CONFIG_MULTITHREAD
+  /* When set, frame packets are copied here for the writer thread. */
+  struct ThreadQueue *write_queue;
+  /* Frames for this stream's encoder thread with --parallel-streams. */
+  struct ThreadQueue encode_queue;
+  pthread_t encode_thread;
+  struct parallel_encoder *parallel;
+  /* frames_out and nbytes as published by encode_thread for the progress
+   * display, under parallel->mutex.
+   */
+  unsigned int published_frames_out;
+  size_t published_nbytes;
+#endif
 };
 
 static void validate_positive_rational(const char *msg,
@@ -801,6 +878,12 @@ static void parse_global_config(struct VpxEncoderConfig *global, char **argv) {
       global->disable_warnings = 1;
     else if (arg_match(&arg, &disable_warning_prompt, argi))
       global->disable_warning_prompt = 1;
+    else if (arg_match(&arg, &mmaparg, argi))
+      global->use_mmap = 1;
+    else if (arg_match(&arg, &pipelinearg, argi))
+      global->pipeline = 1;
+    else if (arg_match(&arg, &parallelstreamsarg, argi))
+      global->pipeline = global->parallel_streams = 1;
     else
       argj++;
   }
@@ -832,6 +915,14 @@ static void parse_global_config(struct VpxEncoderConfig *global, char **argv) {
     warn("Enforcing one-pass encoding in realtime mode\n");
     global->passes = 1;
   }
+
+#if !CONFIG_MULTITHREAD
+  if (global->pipeline) {
+    warn("--pipeline and --parallel-streams require multithreading support; "
+         "ignoring\n");
+    global->pipeline = global->parallel_streams = 0;
+  }
+#endif
 }
 
 static struct stream_state *new_stream(struct VpxEncoderConfig *global,
@@ -891,6 +982,155 @@ static struct stream_state *new_stream(struct VpxEncoderConfig *global,
   return stream;
 }
 
+#if defined(__linux__)
+static int read_cgroup_file(const char *path, char *buf, int size) {
+  FILE *const file = fopen(path, "r");
+  int ok;
+  if (!file) return 0;
+  ok = fgets(buf, size, file) != NULL;
+  fclose(file);
+  return ok;
+}
+
+/* Sets |path| to the cgroup of the process in the cgroup v1 hierarchy with
+ * |controller|, or in the cgroup v2 hierarchy when |controller| is NULL, as
+ * listed in /proc/self/cgroup. Returns 0 if there is no such hierarchy.
+ */
+static int get_cgroup_path(const char *controller, char *path, int size) {
+  FILE *const file = fopen("/proc/self/cgroup", "r");
+  char line[512];
+  int found = 0;
+  if (!file) return 0;
+  while (!found && fgets(line, sizeof(line), file) != NULL) {
+    /* "<hierarchy id>:<controller>,<controller>...:<path>" */
+    char *const controllers = strchr(line, ':');
+    char *cgroup, *name;
+    if (controllers == NULL) continue;
+    cgroup = strchr(controllers + 1, ':');
+    if (cgroup == NULL) continue;
+    *cgroup++ = '\0';
+    if (controller == NULL) {
+      found = controllers[1] == '\0';
+    } else {
+      for (name = strtok(controllers + 1, ","); name != NULL && !found;
+           name = strtok(NULL, ",")) {
+        found = strcmp(name, controller) == 0;
+      }
+    }
+    if (found) {
+      cgroup[strcspn(cgroup, "\n")] = '\0';
+      snprintf(path, size, "%s", cgroup);
+    }
+  }
+  fclose(file);
+  return found;
+}
+
+/* Returns the CPU bandwidth quota of the cgroup directory |dir| in CPUs,
+ * rounded up, or 0 without a quota.
+ */
+static int read_cgroup_quota(const char *dir, int v2) {
+  char path[600];
+  char buf[256];
+  long long quota = -1, period = 0;
+
+  if (v2) {
+    /* "<quota> <period>", the quota being "max" if unlimited, which sscanf()
+     * does not parse.
+     */
+    snprintf(path, sizeof(path), "%s/cpu.max", dir);
+    if (!read_cgroup_file(path, buf, sizeof(buf)) ||
+        sscanf(buf, "%lld %lld", &quota, &period) != 2) {
+      return 0;
+    }
+  } else {
+    /* The quota is -1 if unlimited. */
+    snprintf(path, sizeof(path), "%s/cpu.cfs_quota_us", dir);
+    if (!read_cgroup_file(path, buf, sizeof(buf))) return 0;
+    quota = strtoll(buf, NULL, 10);
+    snprintf(path, sizeof(path), "%s/cpu.cfs_period_us", dir);
+    if (!read_cgroup_file(path, buf, sizeof(buf))) return 0;
+    period = strtoll(buf, NULL, 10);
+  }
+  if (quota <= 0 || period <= 0) return 0;
+  return (int)((quota + period - 1) / period);
+}
+
+/* Returns the smallest CPU quota set on the cgroup |path| of the hierarchy
+ * mounted at |mount| or on its ancestors, or 0 without a quota. A container
+ * without its own cgroup namespace sees the host's |path|, which does not
+ * exist under |mount|; the walk then ends at the container's cgroup, mounted
+ * at |mount| itself.
+ */
+static int get_cgroup_quota(const char *mount, char *path, int v2) {
+  char dir[512];
+  int limit = 0;
+  for (;;) {
+    char *const slash = strrchr(path, '/');
+    int quota;
+    snprintf(dir, sizeof(dir), "%s%s", mount, path);
+    quota = read_cgroup_quota(dir, v2);
+    if (quota > 0 && (limit == 0 || quota < limit)) limit = quota;
+    if (slash == NULL || (slash == path && path[1] == '\0')) break;
+    /* Go up to the parent, keeping the "/" of the root. */
+    if (slash == path) {
+      path[1] = '\0';
+    } else {
+      *slash = '\0';
+    }
+  }
+  return limit;
+}
+
+/* Returns the number of CPUs the CPU bandwidth quota of the cgroup of the
+ * process allows, from /proc/self/cgroup, or 0 without a quota.
+ */
+static int get_cgroup_cpu_limit(void) {
+  char path[512];
+  int limit = 0;
+  if (get_cgroup_path(NULL, path, sizeof(path))) {
+    limit = get_cgroup_quota("/sys/fs/cgroup", path, 1);
+  }
+  /* A hybrid setup lists a v2 hierarchy without the cpu controller. */
+  if (limit == 0 && get_cgroup_path("cpu", path, sizeof(path))) {
+    limit = get_cgroup_quota("/sys/fs/cgroup/cpu", path, 0);
+  }
+  return limit;
+}
+#endif  // __linux__
+
+/* Most threads --threads=auto asks for, the encoders' limit. */
+#define AUTO_MAX_THREADS 64
+
+/* Returns the number of CPUs vpxenc may use. */
+static int get_cpu_count(void) {
+#if !CONFIG_MULTITHREAD
+  return 1;
+#elif HAVE_UNISTD_H && defined(_SC_NPROCESSORS_ONLN)
+  const long count = sysconf(_SC_NPROCESSORS_ONLN);
+  int cpus = count > 0 ? (int)count : 1;
+#if defined(__linux__)
+  int limit;
+#if defined(CPU_COUNT)
+  /* The affinity mask also reflects the cpuset of the cgroup. */
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) {
+    cpus = CPU_COUNT(&set);
+  }
+#endif
+  limit = get_cgroup_cpu_limit();
+  if (limit > 0 && limit < cpus) cpus = limit;
+#endif
+  return cpus;
+#elif defined(_WIN32)
+  SYSTEM_INFO sysinfo;
+  GetSystemInfo(&sysinfo);
+  return (int)sysinfo.dwNumberOfProcessors;
+#else
+  return 1;
+#endif
+}
+
 static int parse_stream_params(struct VpxEncoderConfig *global,
                                struct stream_state *stream, char **argv) {
   char **argi, **argj;
@@ -944,7 +1184,18 @@ static int parse_stream_params(struct VpxEncoderConfig *global,
     } else if (arg_match(&arg, &use_ivf, argi)) {
       config->write_webm = 0;
     } else if (arg_match(&arg, &threads, argi)) {
-      config->cfg.g_threads = arg_parse_uint(&arg);
+      if (!strcmp(arg.val, "auto")) {
+        /* Refined by plan_stream_threads() once the frame size is known. */
+        const int cpus = get_cpu_count();
+        config->cfg.g_threads =
+            cpus < AUTO_MAX_THREADS ? cpus : AUTO_MAX_THREADS;
+        config->have_threads = 0;
+        config->auto_threads = 1;
+      } else {
+        config->cfg.g_threads = arg_parse_uint(&arg);
+        config->have_threads = 1;
+        config->auto_threads = 0;
+      }
     } else if (arg_match(&arg, &profile, argi)) {
       config->cfg.g_profile = arg_parse_uint(&arg);
     } else if (arg_match(&arg, &width, argi)) {
@@ -1173,6 +1424,72 @@ static void set_stream_dimensions(struct stream_state *stream, unsigned int w,
   }
 }
 
+#if CONFIG_VP9_ENCODER
+/* Narrowest tile columns --threads=auto uses. Blocks do not predict from or
+ * use the contexts of blocks across a tile column boundary, so narrow tiles
+ * cost compression. Real-time encodes trade that for speed down to the VP9
+ * minimum of 256.
+ */
+#define AUTO_MIN_TILE_WIDTH 512
+#define AUTO_MIN_TILE_WIDTH_RT 256
+#define AUTO_MAX_LOG2_TILE_COLS 6
+
+/* Returns the value of |ctrl| for the stream, setting it to |value| if it was
+ * not given on the command line.
+ */
+static int default_stream_ctrl(struct stream_config *config, int ctrl,
+                               int value) {
+  int i;
+  for (i = 0; i < config->arg_ctrl_cnt; i++)
+    if (config->arg_ctrls[i][0] == ctrl) return config->arg_ctrls[i][1];
+  assert(config->arg_ctrl_cnt < (int)ARG_CTRL_CNT_MAX);
+  config->arg_ctrls[config->arg_ctrl_cnt][0] = ctrl;
+  config->arg_ctrls[config->arg_ctrl_cnt][1] = value;
+  config->arg_ctrl_cnt++;
+  return value;
+}
+#endif
+
+/* Completes --threads=auto once the frame size is known. g_threads holds the
+ * cores given to the stream. For VP9, tile columns, which are only worth
+ * their compression cost while there are idle cores, are added until either
+ * every core has one or they would get narrower than the minimum width.
+ * Row based multi-threading keeps the remaining cores busy, and also spreads
+ * the first pass and the ARNR filtering, which do not use tiles, over all the
+ * threads. Explicit --tile-columns and --row-mt settings are kept.
+ */
+static void plan_stream_threads(struct stream_state *stream,
+                                const struct VpxEncoderConfig *global) {
+  struct stream_config *const config = &stream->config;
+  const int threads = (int)config->cfg.g_threads;
+
+  if (!config->auto_threads) return;
+#if CONFIG_VP9_ENCODER
+  if (global->codec->fourcc == VP9_FOURCC) {
+    const unsigned int min_tile_width = global->deadline == VPX_DL_REALTIME
+                                            ? AUTO_MIN_TILE_WIDTH_RT
+                                            : AUTO_MIN_TILE_WIDTH;
+    int log2_tile_cols = 0, row_mt;
+    while (log2_tile_cols < AUTO_MAX_LOG2_TILE_COLS &&
+           (2 << log2_tile_cols) <= threads &&
+           (config->cfg.g_w >> (log2_tile_cols + 1)) >= min_tile_width) {
+      ++log2_tile_cols;
+    }
+    log2_tile_cols =
+        default_stream_ctrl(config, VP9E_SET_TILE_COLUMNS, log2_tile_cols);
+    row_mt = default_stream_ctrl(config, VP9E_SET_ROW_MT, threads > 1);
+    if (global->verbose) {
+      fprintf(stderr,
+              "Stream %d: --threads=auto uses %d threads, %d tile columns "
+              "(log2) and row-mt %d.\n",
+              stream->index, threads, log2_tile_cols, row_mt);
+    }
+  }
+#else
+  (void)global;
+#endif
+}
+
 static const char *file_type_to_string(enum VideoFileType t) {
   switch (t) {
     case FILE_TYPE_RAW: return "RAW";
@@ -1325,6 +1642,10 @@ static void setup_pass(struct stream_state *stream,
   stream->cx_time = 0;
   stream->nbytes = 0;
   stream->frames_out = 0;
+#if CONFIG_MULTITHREAD
+  stream->published_nbytes = 0;
+  stream->published_frames_out = 0;
+#endif
 }
 
 static void initialize_encoder(struct stream_state *stream,
@@ -1463,6 +1784,59 @@ static void update_quantizer_histogram(struct stream_state *stream) {
   }
 }
 
+static void write_frame_packet(struct stream_state *stream,
+                               const vpx_codec_cx_pkt_t *pkt) {
+#if CONFIG_WEBM_IO
+  if (stream->config.write_webm) {
+    write_webm_block(&stream->webm_ctx, &stream->config.cfg, pkt);
+  }
+#endif
+  if (!stream->config.write_webm) {
+    if (pkt->data.frame.partition_id <= 0) {
+      stream->ivf_header_pos = ftello(stream->file);
+      stream->ivf_frame_size = pkt->data.frame.sz;
+
+      ivf_write_frame_header(stream->file, pkt->data.frame.pts,
+                             stream->ivf_frame_size);
+    } else {
+      stream->ivf_frame_size += pkt->data.frame.sz;
+
+      if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
+        const FileOffset currpos = ftello(stream->file);
+        fseeko(stream->file, stream->ivf_header_pos, SEEK_SET);
+        ivf_write_frame_size(stream->file, stream->ivf_frame_size);
+        fseeko(stream->file, currpos, SEEK_SET);
+      }
+    }
+
+    (void)fwrite(pkt->data.frame.buf, 1, pkt->data.frame.sz, stream->file);
+  }
+}
+
+#if CONFIG_MULTITHREAD
+struct queued_packet {
+  struct stream_state *stream;
+  vpx_codec_cx_pkt_t pkt;
+};
+
+/* The encoder owns the packet data only until the next encode call, so the
+ * writer thread gets its own copy.
+ */
+static void queue_frame_packet(struct stream_state *stream,
+                               const vpx_codec_cx_pkt_t *pkt) {
+  struct queued_packet *const queued = malloc(sizeof(*queued));
+  void *const buf = malloc(pkt->data.frame.sz ? pkt->data.frame.sz : 1);
+
+  if (!queued || !buf) fatal("Failed to allocate output packet");
+  memcpy(buf, pkt->data.frame.buf, pkt->data.frame.sz);
+  queued->stream = stream;
+  queued->pkt = *pkt;
+  queued->pkt.data.frame.buf = buf;
+  if (!thread_queue_push(stream->write_queue, queued))
+    fatal("Output queue closed unexpectedly");
+}
+#endif
+
 static void get_cx_data(struct stream_state *stream,
                         struct VpxEncoderConfig *global, int *got_data) {
   const vpx_codec_cx_pkt_t *pkt;
@@ -1471,9 +1845,6 @@ static void get_cx_data(struct stream_state *stream,
 
   *got_data = 0;
   while ((pkt = vpx_codec_get_cx_data(&stream->encoder, &iter))) {
-    static size_t fsize = 0;
-    static FileOffset ivf_header_pos = 0;
-
     switch (pkt->kind) {
       case VPX_CODEC_CX_FRAME_PKT:
         if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
@@ -1483,31 +1854,12 @@ static void get_cx_data(struct stream_state *stream,
           fprintf(stderr, " %6luF", (unsigned long)pkt->data.frame.sz);
 
         update_rate_histogram(stream->rate_hist, cfg, pkt);
-#if CONFIG_WEBM_IO
-        if (stream->config.write_webm) {
-          write_webm_block(&stream->webm_ctx, cfg, pkt);
-        }
+#if CONFIG_MULTITHREAD
+        if (stream->write_queue)
+          queue_frame_packet(stream, pkt);
+        else
 #endif
-        if (!stream->config.write_webm) {
-          if (pkt->data.frame.partition_id <= 0) {
-            ivf_header_pos = ftello(stream->file);
-            fsize = pkt->data.frame.sz;
-
-            ivf_write_frame_header(stream->file, pkt->data.frame.pts, fsize);
-          } else {
-            fsize += pkt->data.frame.sz;
-
-            if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
-              const FileOffset currpos = ftello(stream->file);
-              fseeko(stream->file, ivf_header_pos, SEEK_SET);
-              ivf_write_frame_size(stream->file, fsize);
-              fseeko(stream->file, currpos, SEEK_SET);
-            }
-          }
-
-          (void)fwrite(pkt->data.frame.buf, 1, pkt->data.frame.sz,
-                       stream->file);
-        }
+          write_frame_packet(stream, pkt);
         stream->nbytes += pkt->data.raw.sz;
 
         *got_data = 1;
@@ -1552,6 +1904,191 @@ static void get_cx_data(struct stream_state *stream,
   }
 }
 
+/* Returns the offset of the next byte read from the input. A mapped input
+ * does not move the stream position of input->file.
+ */
+static int64_t get_input_position(const struct VpxInputContext *input) {
+  if (input->file_type == FILE_TYPE_Y4M && input->y4m.mmap != NULL)
+    return (int64_t)input->y4m.mmap->position;
+  return (int64_t)ftello(input->file);
+}
+
+#if CONFIG_MULTITHREAD
+/* Number of frames the reader thread may run ahead of the encoder, and of
+ * packets the encoder may run ahead of the writer thread.
+ */
+#define PIPELINE_FRAMES 4
+#define PIPELINE_PACKETS 32
+
+struct input_pipeline {
+  struct VpxInputContext *input;
+  int limit;
+  int input_shift;
+  int upshift;
+  /* Y4M frames and frames that get upshifted are read here first. */
+  vpx_image_t scratch;
+  int scratch_allocated;
+  vpx_image_t frames[PIPELINE_FRAMES];
+  /* Input file position after each frame, set by the reader thread, which
+   * owns the file, before it queues the frame.
+   */
+  FileOffset positions[PIPELINE_FRAMES];
+  struct ThreadQueue free_frames;
+  struct ThreadQueue ready_frames;
+  pthread_t thread;
+};
+
+struct output_pipeline {
+  struct ThreadQueue packets;
+  pthread_t thread;
+};
+
+static void copy_image(vpx_image_t *dst, const vpx_image_t *src) {
+  const int bytes_per_sample = (src->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  int plane;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int w = vpx_img_plane_width(src, plane) * bytes_per_sample;
+    const int h = vpx_img_plane_height(src, plane);
+    const unsigned char *src_row = src->planes[plane];
+    unsigned char *dst_row = dst->planes[plane];
+    int y;
+
+    for (y = 0; y < h; ++y) {
+      memcpy(dst_row, src_row, w);
+      src_row += src->stride[plane];
+      dst_row += dst->stride[plane];
+    }
+  }
+}
+
+static int input_pipeline_read(struct input_pipeline *pipe, vpx_image_t *img) {
+  vpx_image_t *const src =
+      pipe->input->file_type == FILE_TYPE_Y4M || pipe->upshift ? &pipe->scratch
+                                                               : img;
+
+  if (!read_frame(pipe->input, src)) return 0;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (pipe->upshift) {
+    vpx_img_upshift(img, src, pipe->input_shift);
+    return 1;
+  }
+#endif
+  if (src != img) copy_image(img, src);
+  return 1;
+}
+
+static THREADFN input_pipeline_thread(void *arg) {
+  struct input_pipeline *const pipe = (struct input_pipeline *)arg;
+  int frames = 0;
+  void *img;
+
+  while ((!pipe->limit || frames < pipe->limit) &&
+         thread_queue_pop(&pipe->free_frames, &img)) {
+    if (!input_pipeline_read(pipe, (vpx_image_t *)img)) break;
+    pipe->positions[(vpx_image_t *)img - pipe->frames] =
+        get_input_position(pipe->input);
+    if (!thread_queue_push(&pipe->ready_frames, img)) break;
+    ++frames;
+  }
+  thread_queue_close(&pipe->ready_frames);
+  return THREAD_RETURN(NULL);
+}
+
+/* Starts reading up to |limit| frames (0 for all) from |input| on a separate
+ * thread. With |upshift| set the frames are shifted up by |input_shift| bits
+ * to the high bitdepth format on the way.
+ */
+static void input_pipeline_start(struct input_pipeline *pipe,
+                                 struct VpxInputContext *input, int limit,
+                                 int upshift, int input_shift) {
+  const vpx_img_fmt_t fmt =
+      upshift ? input->fmt | VPX_IMG_FMT_HIGHBITDEPTH : input->fmt;
+  int i;
+
+  memset(pipe, 0, sizeof(*pipe));
+  pipe->input = input;
+  pipe->limit = limit;
+  pipe->upshift = upshift;
+  pipe->input_shift = input_shift;
+  if (thread_queue_init(&pipe->free_frames, PIPELINE_FRAMES) ||
+      thread_queue_init(&pipe->ready_frames, PIPELINE_FRAMES))
+    fatal("Failed to allocate input queue");
+  if (upshift && input->file_type != FILE_TYPE_Y4M) {
+    if (!vpx_img_alloc(&pipe->scratch, input->fmt, input->width,
+                       input->height, 32))
+      fatal("Failed to allocate image");
+    pipe->scratch_allocated = 1;
+  }
+  for (i = 0; i < PIPELINE_FRAMES; ++i) {
+    if (!vpx_img_alloc(&pipe->frames[i], fmt, input->width, input->height, 32))
+      fatal("Failed to allocate image");
+    thread_queue_push(&pipe->free_frames, &pipe->frames[i]);
+  }
+  if (pthread_create(&pipe->thread, NULL, input_pipeline_thread, pipe))
+    fatal("Failed to create reader thread");
+}
+
+/* Returns the next frame, or NULL at the end of the input, and stores the
+ * input position after it in |pos|. The frame stays valid until it is handed
+ * back with input_pipeline_release().
+ */
+static vpx_image_t *input_pipeline_next(struct input_pipeline *pipe,
+                                        int64_t *pos) {
+  void *img;
+  if (!thread_queue_pop(&pipe->ready_frames, &img)) return NULL;
+  *pos = pipe->positions[(vpx_image_t *)img - pipe->frames];
+  return (vpx_image_t *)img;
+}
+
+static void input_pipeline_release(struct input_pipeline *pipe,
+                                   vpx_image_t *img) {
+  thread_queue_push(&pipe->free_frames, img);
+}
+
+static void input_pipeline_stop(struct input_pipeline *pipe) {
+  int i;
+
+  thread_queue_close(&pipe->free_frames);
+  pthread_join(pipe->thread, NULL);
+  for (i = 0; i < PIPELINE_FRAMES; ++i) vpx_img_free(&pipe->frames[i]);
+  if (pipe->scratch_allocated) vpx_img_free(&pipe->scratch);
+  thread_queue_destroy(&pipe->ready_frames);
+  thread_queue_destroy(&pipe->free_frames);
+}
+
+static THREADFN output_pipeline_thread(void *arg) {
+  struct output_pipeline *const pipe = (struct output_pipeline *)arg;
+  void *item;
+
+  while (thread_queue_pop(&pipe->packets, &item)) {
+    struct queued_packet *const queued = (struct queued_packet *)item;
+    write_frame_packet(queued->stream, &queued->pkt);
+    free(queued->pkt.data.frame.buf);
+    free(queued);
+  }
+  return THREAD_RETURN(NULL);
+}
+
+static void output_pipeline_start(struct output_pipeline *pipe,
+                                  struct stream_state *streams) {
+  if (thread_queue_init(&pipe->packets, PIPELINE_PACKETS))
+    fatal("Failed to allocate output queue");
+  FOREACH_STREAM(stream->write_queue = &pipe->packets);
+  if (pthread_create(&pipe->thread, NULL, output_pipeline_thread, pipe))
+    fatal("Failed to create writer thread");
+}
+
+/* Waits for all queued packets to be written. */
+static void output_pipeline_stop(struct output_pipeline *pipe,
+                                 struct stream_state *streams) {
+  thread_queue_close(&pipe->packets);
+  pthread_join(pipe->thread, NULL);
+  thread_queue_destroy(&pipe->packets);
+  FOREACH_STREAM(stream->write_queue = NULL);
+}
+#endif  // CONFIG_MULTITHREAD
+
 static void show_psnr(struct stream_state *stream, double peak) {
   int i;
   double ovpsnr;
@@ -1650,6 +2187,162 @@ static void test_decode(struct stream_state *stream,
   vpx_img_free(&dec_img);
 }
 
+#if CONFIG_MULTITHREAD
+/* With --parallel-streams every stream encodes on its own thread. Each
+ * frame from the reader thread is shared by all streams and goes back to
+ * the reader once the last of them has encoded it, so a fast stream can
+ * run at most PIPELINE_FRAMES frames ahead of the slowest one.
+ */
+struct parallel_encoder {
+  struct VpxEncoderConfig *global;
+  struct input_pipeline *input;
+  pthread_mutex_t mutex;
+};
+
+struct shared_frame {
+  vpx_image_t *img; /* NULL to flush the encoder. */
+  unsigned int frames_in;
+  int refs;
+};
+
+static int encode_stream_frame(struct stream_state *stream,
+                               struct VpxEncoderConfig *global,
+                               vpx_image_t *img, unsigned int frames_in) {
+  int got_data;
+
+  encode_frame(stream, global, img, frames_in);
+  update_quantizer_histogram(stream);
+  get_cx_data(stream, global, &got_data);
+  if (got_data && global->test_decode != TEST_DECODE_OFF)
+    test_decode(stream, global->test_decode, global->codec);
+  return got_data;
+}
+
+static void release_shared_frame(struct parallel_encoder *parallel,
+                                 struct shared_frame *frame) {
+  int refs;
+
+  pthread_mutex_lock(&parallel->mutex);
+  refs = --frame->refs;
+  pthread_mutex_unlock(&parallel->mutex);
+  if (refs == 0) {
+    if (frame->img) input_pipeline_release(parallel->input, frame->img);
+    free(frame);
+  }
+}
+
+static THREADFN stream_encode_thread(void *arg) {
+  struct stream_state *const stream = (struct stream_state *)arg;
+  struct parallel_encoder *const parallel = stream->parallel;
+  void *item;
+
+  while (thread_queue_pop(&stream->encode_queue, &item)) {
+    struct shared_frame *const frame = (struct shared_frame *)item;
+
+    if (frame->img) {
+      encode_stream_frame(stream, parallel->global, frame->img,
+                          frame->frames_in);
+    } else {
+      while (encode_stream_frame(stream, parallel->global, NULL,
+                                 frame->frames_in)) {
+      }
+    }
+    pthread_mutex_lock(&parallel->mutex);
+    stream->published_frames_out = stream->frames_out;
+    stream->published_nbytes = stream->nbytes;
+    pthread_mutex_unlock(&parallel->mutex);
+    release_shared_frame(parallel, frame);
+  }
+  return THREAD_RETURN(NULL);
+}
+
+/* Splits the machine's cores between the streams that did not ask for a
+ * specific number of threads. Streams with --threads=auto are told when this
+ * gives them fewer threads than cores.
+ */
+static void parallel_encoder_budget_threads(struct stream_state *streams,
+                                            int stream_cnt) {
+  const int cpus = get_cpu_count();
+  const int share = cpus > stream_cnt ? cpus / stream_cnt : 1;
+  /* The encoders reject more than AUTO_MAX_THREADS threads. */
+  const int threads = share < AUTO_MAX_THREADS ? share : AUTO_MAX_THREADS;
+  FOREACH_STREAM({
+    struct stream_config *const config = &stream->config;
+    if (!config->have_threads) {
+      if (config->auto_threads && (int)config->cfg.g_threads > threads) {
+        fprintf(stderr,
+                "Stream %d: --threads=auto reduced from %u to %d threads, "
+                "the share of %d CPUs over %d parallel streams\n",
+                stream->index, config->cfg.g_threads, threads, cpus,
+                stream_cnt);
+      }
+      config->cfg.g_threads = threads;
+    }
+  });
+}
+
+static void parallel_encoder_start(struct parallel_encoder *parallel,
+                                   struct VpxEncoderConfig *global,
+                                   struct input_pipeline *input,
+                                   struct stream_state *streams) {
+  parallel->global = global;
+  parallel->input = input;
+  pthread_mutex_init(&parallel->mutex, NULL);
+  FOREACH_STREAM({
+    /* One slot per shared frame plus the final flush. */
+    if (thread_queue_init(&stream->encode_queue, PIPELINE_FRAMES + 1))
+      fatal("Failed to allocate encode queue");
+    stream->parallel = parallel;
+    if (pthread_create(&stream->encode_thread, NULL, stream_encode_thread,
+                       stream))
+      fatal("Failed to create encoder thread");
+  });
+}
+
+/* Hands |img| to every stream, or tells them to flush when |img| is NULL. */
+static void parallel_encoder_submit(struct stream_state *streams,
+                                    int stream_cnt, vpx_image_t *img,
+                                    unsigned int frames_in) {
+  struct shared_frame *const frame = malloc(sizeof(*frame));
+
+  if (!frame) fatal("Failed to allocate frame");
+  frame->img = img;
+  frame->frames_in = frames_in;
+  frame->refs = stream_cnt;
+  FOREACH_STREAM({
+    if (!thread_queue_push(&stream->encode_queue, frame))
+      fatal("Encode queue closed unexpectedly");
+  });
+}
+
+static void parallel_encoder_stop(struct parallel_encoder *parallel,
+                                  struct stream_state *streams) {
+  FOREACH_STREAM({
+    thread_queue_close(&stream->encode_queue);
+    pthread_join(stream->encode_thread, NULL);
+    thread_queue_destroy(&stream->encode_queue);
+    stream->parallel = NULL;
+  });
+  pthread_mutex_destroy(&parallel->mutex);
+}
+#endif  // CONFIG_MULTITHREAD
+
+/* Returns the number of frames and bytes |stream| has output so far. */
+static void get_stream_progress(const struct stream_state *stream,
+                                unsigned int *frames_out, int64_t *nbytes) {
+#if CONFIG_MULTITHREAD
+  if (stream->parallel) {
+    pthread_mutex_lock(&stream->parallel->mutex);
+    *frames_out = stream->published_frames_out;
+    *nbytes = (int64_t)stream->published_nbytes;
+    pthread_mutex_unlock(&stream->parallel->mutex);
+    return;
+  }
+#endif
+  *frames_out = stream->frames_out;
+  *nbytes = (int64_t)stream->nbytes;
+}
+
 static void print_time(const char *label, int64_t etl) {
   int64_t hours;
   int64_t mins;
@@ -1679,8 +2372,15 @@ int main(int argc, const char **argv_) {
   int input_shift = 0;
 #endif
   int frame_avail, got_data;
+#if CONFIG_MULTITHREAD
+  struct input_pipeline input_pipe;
+  struct output_pipeline output_pipe;
+  struct parallel_encoder parallel;
+  struct vpx_usec_timer parallel_timer;
+#endif
 
   struct VpxInputContext input;
+  struct MmapInputContext input_mmap;
   struct VpxEncoderConfig global;
   struct stream_state *streams = NULL;
   char **argv, **argi;
@@ -1739,6 +2439,11 @@ int main(int argc, const char **argv_) {
     if (argi[0][0] == '-' && argi[0][1])
       die("Error: Unrecognized option %s\n", *argi);
 
+#if CONFIG_MULTITHREAD
+  if (global.parallel_streams)
+    parallel_encoder_budget_threads(streams, stream_cnt);
+#endif
+
   FOREACH_STREAM(check_encoder_config(global.disable_warning_prompt, &global,
                                       &stream->config.cfg););
 
@@ -1758,8 +2463,15 @@ int main(int argc, const char **argv_) {
     int64_t estimated_time_left = -1;
     int64_t average_rate = -1;
     int64_t lagged_count = 0;
+    /* Input file position after the last frame read, for the ETA. */
+    int64_t input_pos = 0;
 
     open_input_file(&input);
+    // Pipes and platforms without mmap keep reading through input.file.
+    if (global.use_mmap && input.file_type == FILE_TYPE_Y4M &&
+        !mmap_input_open(&input_mmap, input.file)) {
+      input.y4m.mmap = &input_mmap;
+    }
 
     /* If the input file doesn't specify its w/h (raw files), try to get
      * the data from the first stream's configuration.
@@ -1801,6 +2513,8 @@ int main(int argc, const char **argv_) {
 
     FOREACH_STREAM(set_stream_dimensions(stream, input.width, input.height));
     FOREACH_STREAM(validate_stream_config(stream, &global));
+    if (pass == (global.pass ? global.pass - 1 : 0))
+      FOREACH_STREAM(plan_stream_threads(stream, &global));
 
     /* Ensure that --passes and --pass are consistent. If --pass is set and
      * --passes=2, ensure --fpf was set.
@@ -1871,14 +2585,44 @@ int main(int argc, const char **argv_) {
     }
 #endif
 
+#if CONFIG_MULTITHREAD
+    if (global.pipeline) {
+      int upshift = 0;
+#if CONFIG_VP9_HIGHBITDEPTH
+      upshift = input_shift || (use_16bit_internal && input.bit_depth == 8);
+      input_pipeline_start(&input_pipe, &input, global.limit, upshift,
+                           input_shift);
+#else
+      input_pipeline_start(&input_pipe, &input, global.limit, upshift, 0);
+#endif
+      output_pipeline_start(&output_pipe, streams);
+      if (global.parallel_streams) {
+        parallel_encoder_start(&parallel, &global, &input_pipe, streams);
+        vpx_usec_timer_start(&parallel_timer);
+      }
+    }
+#endif
+
     frame_avail = 1;
     got_data = 0;
 
     while (frame_avail || got_data) {
       struct vpx_usec_timer timer;
+      /* The frame to encode when it comes from the reader thread. */
+      vpx_image_t *pipe_img = NULL;
 
       if (!global.limit || frames_in < global.limit) {
-        frame_avail = read_frame(&input, &raw);
+#if CONFIG_MULTITHREAD
+        if (global.pipeline) {
+          /* The reader thread owns input.file. */
+          pipe_img = input_pipeline_next(&input_pipe, &input_pos);
+          frame_avail = pipe_img != NULL;
+        } else
+#endif
+        {
+          frame_avail = read_frame(&input, &raw);
+          if (input.length) input_pos = get_input_position(&input);
+        }
 
         if (frame_avail) frames_in++;
         seen_frames =
@@ -1888,11 +2632,15 @@ int main(int argc, const char **argv_) {
           float fps = usec_to_fps(cx_time, seen_frames);
           fprintf(stderr, "\rPass %d/%d ", pass + 1, global.passes);
 
-          if (stream_cnt == 1)
+          if (stream_cnt == 1) {
+            unsigned int frames_out;
+            int64_t nbytes;
+            get_stream_progress(streams, &frames_out, &nbytes);
             fprintf(stderr, "frame %4d/%-4d %7" PRId64 "B ", frames_in,
-                    streams->frames_out, (int64_t)streams->nbytes);
-          else
+                    frames_out, nbytes);
+          } else {
             fprintf(stderr, "frame %4d ", frames_in);
+          }
 
           fprintf(stderr, "%7" PRId64 " %s %.2f %s ",
                   cx_time > 9999999 ? cx_time / 1000 : cx_time,
@@ -1904,10 +2652,24 @@ int main(int argc, const char **argv_) {
       } else
         frame_avail = 0;
 
+#if CONFIG_MULTITHREAD
+      if (global.parallel_streams && frames_in > global.skip_frames) {
+        /* The stream threads hand the frame back to the reader. */
+        parallel_encoder_submit(streams, stream_cnt, pipe_img, frames_in);
+        pipe_img = NULL;
+        vpx_usec_timer_mark(&parallel_timer);
+        cx_time = vpx_usec_timer_elapsed(&parallel_timer);
+      } else
+#endif
       if (frames_in > global.skip_frames) {
 #if CONFIG_VP9_HIGHBITDEPTH
         vpx_image_t *frame_to_encode;
-        if (input_shift || (use_16bit_internal && input.bit_depth == 8)) {
+        if (global.pipeline) {
+          // The reader thread has already done any shifting. This is NULL
+          // once the input is exhausted.
+          frame_to_encode = pipe_img;
+        } else if (input_shift ||
+                   (use_16bit_internal && input.bit_depth == 8)) {
           assert(use_16bit_internal);
           // Input bit depth and stream bit depth do not match, so up
           // shift frame to stream bit depth
@@ -1923,7 +2685,8 @@ int main(int argc, const char **argv_) {
         }
         vpx_usec_timer_start(&timer);
         if (use_16bit_internal) {
-          assert(frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH);
+          assert(!frame_to_encode ||
+                 (frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH));
           FOREACH_STREAM({
             if (stream->config.use_16bit_internal)
               encode_frame(stream, &global,
@@ -1932,14 +2695,17 @@ int main(int argc, const char **argv_) {
               assert(0);
           });
         } else {
-          assert((frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH) == 0);
+          assert(!frame_to_encode ||
+                 (frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH) == 0);
           FOREACH_STREAM(encode_frame(stream, &global,
                                       frame_avail ? frame_to_encode : NULL,
                                       frames_in));
         }
 #else
         vpx_usec_timer_start(&timer);
-        FOREACH_STREAM(encode_frame(stream, &global, frame_avail ? &raw : NULL,
+        FOREACH_STREAM(encode_frame(stream, &global,
+                                    frame_avail ? (pipe_img ? pipe_img : &raw)
+                                                : NULL,
                                     frames_in));
 #endif
         vpx_usec_timer_mark(&timer);
@@ -1952,7 +2718,7 @@ int main(int argc, const char **argv_) {
 
         if (!got_data && input.length && streams != NULL &&
             !streams->frames_out) {
-          lagged_count = global.limit ? seen_frames : ftello(input.file);
+          lagged_count = global.limit ? seen_frames : input_pos;
         } else if (input.length) {
           int64_t remaining;
           int64_t rate;
@@ -1964,7 +2730,6 @@ int main(int argc, const char **argv_) {
             remaining = 1000 * (global.limit - global.skip_frames -
                                 seen_frames + lagged_count);
           } else {
-            const int64_t input_pos = ftello(input.file);
             const int64_t input_pos_lagged = input_pos - lagged_count;
             const int64_t limit = input.length;
 
@@ -1981,10 +2746,23 @@ int main(int argc, const char **argv_) {
           FOREACH_STREAM(test_decode(stream, global.test_decode, global.codec));
       }
 
+#if CONFIG_MULTITHREAD
+      /* The encoder has made its own copy of the frame by now. */
+      if (pipe_img) input_pipeline_release(&input_pipe, pipe_img);
+#endif
+
       fflush(stdout);
       if (!global.quiet) fprintf(stderr, "\033[K");
     }
 
+#if CONFIG_MULTITHREAD
+    if (global.pipeline) {
+      if (global.parallel_streams) parallel_encoder_stop(&parallel, streams);
+      input_pipeline_stop(&input_pipe);
+      output_pipeline_stop(&output_pipe, streams);
+    }
+#endif
+
     if (stream_cnt > 1) fprintf(stderr, "\n");
 
     if (!global.quiet) {
@@ -2020,6 +2798,8 @@ int main(int argc, const char **argv_) {
     }
 
     close_input_file(&input);
+    if (input.file_type == FILE_TYPE_Y4M && input.y4m.mmap)
+      mmap_input_close(input.y4m.mmap);
 
     if (global.test_decode == TEST_DECODE_FATAL) {
       FOREACH_STREAM(res |= stream->mismatch_seen);
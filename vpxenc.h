@@ -56,6 +56,9 @@ struct VpxEncoderConfig {
   int disable_warnings;
   int disable_warning_prompt;
   int experimental_bitstream;
+  int use_mmap;
+  int pipeline;
+  int parallel_streams;
 };
 
 #ifdef __cplusplus
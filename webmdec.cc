@@ -18,11 +18,38 @@
 
 namespace {
 
+// Serves mkvparser reads from a memory-mapped file.
+class MmapMkvReader : public mkvparser::IMkvReader {
+ public:
+  explicit MmapMkvReader(const struct MmapInputContext *mmap) : mmap_(mmap) {}
+  virtual ~MmapMkvReader() {}
+
+  virtual int Read(long long position, long length, unsigned char *buffer) {
+    if (position < 0 || length < 0 ||
+        static_cast<unsigned long long>(position) + length > mmap_->size) {
+      return -1;
+    }
+    memcpy(buffer, mmap_->data + position, length);
+    return 0;
+  }
+
+  virtual int Length(long long *total, long long *available) {
+    if (total) *total = static_cast<long long>(mmap_->size);
+    if (available) *available = static_cast<long long>(mmap_->size);
+    return 0;
+  }
+
+ private:
+  const struct MmapInputContext *const mmap_;
+};
+
 void reset(struct WebmInputContext *const webm_ctx) {
   if (webm_ctx->reader != nullptr) {
-    mkvparser::MkvReader *const reader =
-        reinterpret_cast<mkvparser::MkvReader *>(webm_ctx->reader);
-    delete reader;
+    if (webm_ctx->mmap != nullptr) {
+      delete reinterpret_cast<MmapMkvReader *>(webm_ctx->reader);
+    } else {
+      delete reinterpret_cast<mkvparser::MkvReader *>(webm_ctx->reader);
+    }
   }
   if (webm_ctx->segment != nullptr) {
     mkvparser::Segment *const segment =
@@ -61,8 +88,17 @@ void rewind_and_reset(struct WebmInputContext *const webm_ctx,
 
 int file_is_webm(struct WebmInputContext *webm_ctx,
                  struct VpxInputContext *vpx_ctx) {
-  mkvparser::MkvReader *const reader = new mkvparser::MkvReader(vpx_ctx->file);
-  webm_ctx->reader = reader;
+  mkvparser::IMkvReader *reader;
+  if (webm_ctx->mmap != nullptr) {
+    MmapMkvReader *const mmap_reader = new MmapMkvReader(webm_ctx->mmap);
+    webm_ctx->reader = mmap_reader;
+    reader = mmap_reader;
+  } else {
+    mkvparser::MkvReader *const file_reader =
+        new mkvparser::MkvReader(vpx_ctx->file);
+    webm_ctx->reader = file_reader;
+    reader = file_reader;
+  }
   webm_ctx->reached_eos = 0;
 
   mkvparser::EBMLHeader header;
@@ -118,8 +154,12 @@ int file_is_webm(struct WebmInputContext *webm_ctx,
   return 1;
 }
 
-int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
-                    size_t *buffer_size) {
+namespace {
+
+// Advances to the next frame of the video track. Returns 0 and sets |frame|
+// on success, 1 at the end of the stream and -1 on error.
+int next_frame(struct WebmInputContext *webm_ctx,
+               const mkvparser::Block::Frame **frame) {
   // This check is needed for frame parallel decoding, in which case this
   // function could be called even after it has reached end of input stream.
   if (webm_ctx->reached_eos) {
@@ -143,7 +183,6 @@ int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
     } else if (block_entry_eos || block_entry->EOS()) {
       cluster = segment->GetNext(cluster);
       if (cluster == nullptr || cluster->EOS()) {
-        *buffer_size = 0;
         webm_ctx->reached_eos = 1;
         return 1;
       }
@@ -175,9 +214,25 @@ int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
   webm_ctx->block_entry = block_entry;
   webm_ctx->block = block;
 
-  const mkvparser::Block::Frame &frame =
-      block->GetFrame(webm_ctx->block_frame_index);
+  *frame = &block->GetFrame(webm_ctx->block_frame_index);
   ++webm_ctx->block_frame_index;
+  webm_ctx->timestamp_ns = block->GetTime(cluster);
+  webm_ctx->is_key_frame = block->IsKey();
+  return 0;
+}
+
+}  // namespace
+
+int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
+                    size_t *buffer_size) {
+  const mkvparser::Block::Frame *frame_ptr;
+  const int status = next_frame(webm_ctx, &frame_ptr);
+  if (status) {
+    if (status == 1) *buffer_size = 0;
+    return status;
+  }
+
+  const mkvparser::Block::Frame &frame = *frame_ptr;
   if (frame.len > static_cast<long>(*buffer_size)) {
     delete[] * buffer;
     *buffer = new uint8_t[frame.len];
@@ -187,14 +242,32 @@ int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
     webm_ctx->buffer = *buffer;
   }
   *buffer_size = frame.len;
-  webm_ctx->timestamp_ns = block->GetTime(cluster);
-  webm_ctx->is_key_frame = block->IsKey();
 
-  mkvparser::MkvReader *const reader =
-      reinterpret_cast<mkvparser::MkvReader *>(webm_ctx->reader);
+  mkvparser::IMkvReader *const reader =
+      reinterpret_cast<mkvparser::IMkvReader *>(webm_ctx->reader);
   return frame.Read(reader, *buffer) ? -1 : 0;
 }
 
+int webm_read_frame_mmap(struct WebmInputContext *webm_ctx,
+                         const uint8_t **frame, size_t *frame_size) {
+  const mkvparser::Block::Frame *frame_ptr;
+  const int status = next_frame(webm_ctx, &frame_ptr);
+  if (status) {
+    if (status == 1) *frame_size = 0;
+    return status;
+  }
+
+  const struct MmapInputContext *const mmap = webm_ctx->mmap;
+  if (frame_ptr->pos < 0 || frame_ptr->len < 0 ||
+      static_cast<unsigned long long>(frame_ptr->pos) + frame_ptr->len >
+          mmap->size) {
+    return -1;
+  }
+  *frame = mmap->data + frame_ptr->pos;
+  *frame_size = frame_ptr->len;
+  return 0;
+}
+
 int webm_guess_framerate(struct WebmInputContext *webm_ctx,
                          struct VpxInputContext *vpx_ctx) {
   uint32_t i = 0;
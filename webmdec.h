@@ -10,6 +10,7 @@
 #ifndef VPX_WEBMDEC_H_
 #define VPX_WEBMDEC_H_
 
+#include "./mmapinput.h"
 #include "./tools_common.h"
 
 #ifdef __cplusplus
@@ -19,6 +20,9 @@ extern "C" {
 struct VpxInputContext;
 
 struct WebmInputContext {
+  // When set before file_is_webm(), the file is parsed from this mapping
+  // instead of through VpxInputContext::file.
+  struct MmapInputContext *mmap;
   void *reader;
   void *segment;
   uint8_t *buffer;
@@ -55,6 +59,11 @@ int file_is_webm(struct WebmInputContext *webm_ctx,
 int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
                     size_t *buffer_size);
 
+// Like webm_read_frame(), but for a context opened on a mapped file. |frame|
+// points into the mapping, so no copy of the frame data is made.
+int webm_read_frame_mmap(struct WebmInputContext *webm_ctx,
+                         const uint8_t **frame, size_t *frame_size);
+
 // Guesses the frame rate of the input file based on the container timestamps.
 int webm_guess_framerate(struct WebmInputContext *webm_ctx,
                          struct VpxInputContext *vpx_ctx);
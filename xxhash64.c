@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./xxhash64.h"
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+static uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static uint64_t read64(const uint8_t *p) {
+  return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+         ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+         ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+         ((uint64_t)p[7] << 56);
+}
+
+static uint32_t read32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+static uint64_t round64(uint64_t acc, uint64_t input) {
+  acc += input * PRIME64_2;
+  acc = rotl64(acc, 31);
+  return acc * PRIME64_1;
+}
+
+static uint64_t merge_round64(uint64_t acc, uint64_t val) {
+  acc ^= round64(0, val);
+  return acc * PRIME64_1 + PRIME64_4;
+}
+
+// Consumes whole 32-byte stripes from |p| and returns the number of bytes
+// used.
+static size_t consume_stripes(uint64_t v[4], const uint8_t *p, size_t size) {
+  size_t used = 0;
+  while (size - used >= 32) {
+    v[0] = round64(v[0], read64(p + used));
+    v[1] = round64(v[1], read64(p + used + 8));
+    v[2] = round64(v[2], read64(p + used + 16));
+    v[3] = round64(v[3], read64(p + used + 24));
+    used += 32;
+  }
+  return used;
+}
+
+void xxh64_init(Xxh64Context *ctx, uint64_t seed) {
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->seed = seed;
+  ctx->v[0] = seed + PRIME64_1 + PRIME64_2;
+  ctx->v[1] = seed + PRIME64_2;
+  ctx->v[2] = seed;
+  ctx->v[3] = seed - PRIME64_1;
+}
+
+void xxh64_update(Xxh64Context *ctx, const void *data, size_t size) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  ctx->total_len += size;
+  if (ctx->buffer_size + size < 32) {
+    if (size > 0) memcpy(ctx->buffer + ctx->buffer_size, p, size);
+    ctx->buffer_size += size;
+    return;
+  }
+
+  if (ctx->buffer_size > 0) {
+    const size_t fill = 32 - ctx->buffer_size;
+    memcpy(ctx->buffer + ctx->buffer_size, p, fill);
+    consume_stripes(ctx->v, ctx->buffer, 32);
+    p += fill;
+    size -= fill;
+    ctx->buffer_size = 0;
+  }
+
+  {
+    const size_t used = consume_stripes(ctx->v, p, size);
+    p += used;
+    size -= used;
+  }
+  if (size > 0) memcpy(ctx->buffer, p, size);
+  ctx->buffer_size = size;
+}
+
+uint64_t xxh64_final(const Xxh64Context *ctx) {
+  const uint8_t *p = ctx->buffer;
+  const uint8_t *const end = p + ctx->buffer_size;
+  uint64_t h;
+
+  if (ctx->total_len >= 32) {
+    h = rotl64(ctx->v[0], 1) + rotl64(ctx->v[1], 7) + rotl64(ctx->v[2], 12) +
+        rotl64(ctx->v[3], 18);
+    h = merge_round64(h, ctx->v[0]);
+    h = merge_round64(h, ctx->v[1]);
+    h = merge_round64(h, ctx->v[2]);
+    h = merge_round64(h, ctx->v[3]);
+  } else {
+    h = ctx->seed + PRIME64_5;
+  }
+  h += ctx->total_len;
+
+  while (end - p >= 8) {
+    h ^= round64(0, read64(p));
+    h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+    p += 8;
+  }
+  if (end - p >= 4) {
+    h ^= (uint64_t)read32(p) * PRIME64_1;
+    h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+    p += 4;
+  }
+  while (p < end) {
+    h ^= (*p) * PRIME64_5;
+    h = rotl64(h, 11) * PRIME64_1;
+    ++p;
+  }
+
+  h ^= h >> 33;
+  h *= PRIME64_2;
+  h ^= h >> 29;
+  h *= PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
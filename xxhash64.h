@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef VPX_XXHASH64_H_
+#define VPX_XXHASH64_H_
+
+#include <stddef.h>
+
+#include "vpx/vpx_integer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Streaming implementation of the XXH64 non-cryptographic hash. It produces
+// the same values as the reference xxHash library and is several times
+// faster than MD5, which makes it suitable for hashing large numbers of
+// decoded frames.
+typedef struct Xxh64Context {
+  uint64_t v[4];
+  uint64_t seed;
+  uint64_t total_len;
+  uint8_t buffer[32];
+  size_t buffer_size;
+} Xxh64Context;
+
+void xxh64_init(Xxh64Context *ctx, uint64_t seed);
+void xxh64_update(Xxh64Context *ctx, const void *data, size_t size);
+uint64_t xxh64_final(const Xxh64Context *ctx);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_XXHASH64_H_
@@ -16,6 +16,7 @@
 #include <string.h>
 
 #include "vpx/vpx_integer.h"
+#include "./mmapinput.h"
 #include "y4minput.h"
 
 // Reads 'size' bytes from 'file' into 'buf' with some fault tolerance.
@@ -868,6 +869,7 @@ int y4m_input_open(y4m_input *y4m_ctx, FILE *file, char *skip_buffer,
   y4m_ctx->bit_depth = 8;
   y4m_ctx->aux_buf = NULL;
   y4m_ctx->dst_buf = NULL;
+  y4m_ctx->mmap = NULL;
   if (strcmp(y4m_ctx->chroma_type, "420") == 0 ||
       strcmp(y4m_ctx->chroma_type, "420jpeg") == 0 ||
       strcmp(y4m_ctx->chroma_type, "420mpeg2") == 0) {
@@ -1104,13 +1106,89 @@ void y4m_input_close(y4m_input *_y4m) {
   free(_y4m->aux_buf);
 }
 
-int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
-  char frame[6];
+/*Fill in the frame buffer pointers for a frame stored at _buf.
+  We don't use vpx_img_wrap() because it forces padding for odd picture
+   sizes, which would require a separate fread call for every row.*/
+static void y4m_setup_image(const y4m_input *_y4m, vpx_image_t *_img,
+                            unsigned char *_buf) {
   int pic_sz;
   int c_w;
   int c_h;
   int c_sz;
   int bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
+  memset(_img, 0, sizeof(*_img));
+  /*Y4M has the planes in Y'CbCr order, which libvpx calls Y, U, and V.*/
+  _img->fmt = _y4m->vpx_fmt;
+  _img->w = _img->d_w = _y4m->pic_w;
+  _img->h = _img->d_h = _y4m->pic_h;
+  _img->x_chroma_shift = _y4m->dst_c_dec_h >> 1;
+  _img->y_chroma_shift = _y4m->dst_c_dec_v >> 1;
+  _img->bps = _y4m->bps;
+
+  /*Set up the buffer pointers.*/
+  pic_sz = _y4m->pic_w * _y4m->pic_h * bytes_per_sample;
+  c_w = (_y4m->pic_w + _y4m->dst_c_dec_h - 1) / _y4m->dst_c_dec_h;
+  c_w *= bytes_per_sample;
+  c_h = (_y4m->pic_h + _y4m->dst_c_dec_v - 1) / _y4m->dst_c_dec_v;
+  c_sz = c_w * c_h;
+  _img->stride[VPX_PLANE_Y] = _img->stride[VPX_PLANE_ALPHA] =
+      _y4m->pic_w * bytes_per_sample;
+  _img->stride[VPX_PLANE_U] = _img->stride[VPX_PLANE_V] = c_w;
+  _img->planes[VPX_PLANE_Y] = _buf;
+  _img->planes[VPX_PLANE_U] = _buf + pic_sz;
+  _img->planes[VPX_PLANE_V] = _buf + pic_sz + c_sz;
+  _img->planes[VPX_PLANE_ALPHA] = _buf + pic_sz + 2 * c_sz;
+}
+
+static int y4m_input_fetch_frame_mmap(y4m_input *_y4m, vpx_image_t *_img) {
+  struct MmapInputContext *mmap = _y4m->mmap;
+  const uint8_t *frame;
+  uint8_t *data;
+  /*Read and skip the frame header.*/
+  frame = mmap_input_read(mmap, 6);
+  if (frame == NULL) return 0;
+  if (memcmp(frame, "FRAME", 5)) {
+    fprintf(stderr, "Loss of framing in Y4M input data\n");
+    return -1;
+  }
+  if (frame[5] != '\n') {
+    const uint8_t *c;
+    int j;
+    for (j = 0; j < 79 && (c = mmap_input_read(mmap, 1)) != NULL && *c != '\n';
+         j++) {
+    }
+    if (j == 79) {
+      fprintf(stderr, "Error parsing Y4M frame header\n");
+      return -1;
+    }
+  }
+  data = mmap_input_read(mmap, _y4m->dst_buf_read_sz);
+  if (data == NULL) {
+    fprintf(stderr, "Error reading Y4M frame data.\n");
+    return -1;
+  }
+  if (_y4m->convert == y4m_convert_null && _y4m->aux_buf_read_sz == 0) {
+    /*The frame is already in its final layout, so use it in place.*/
+    y4m_setup_image(_y4m, _img, data);
+    return 1;
+  }
+  memcpy(_y4m->dst_buf, data, _y4m->dst_buf_read_sz);
+  data = mmap_input_read(mmap, _y4m->aux_buf_read_sz);
+  if (data == NULL) {
+    fprintf(stderr, "Error reading Y4M frame data.\n");
+    return -1;
+  }
+  if (_y4m->aux_buf_read_sz > 0) {
+    memcpy(_y4m->aux_buf, data, _y4m->aux_buf_read_sz);
+  }
+  (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
+  y4m_setup_image(_y4m, _img, _y4m->dst_buf);
+  return 1;
+}
+
+int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
+  char frame[6];
+  if (_y4m->mmap != NULL) return y4m_input_fetch_frame_mmap(_y4m, _img);
   /*Read and skip the frame header.*/
   if (!file_read(frame, 6, _fin)) return 0;
   if (memcmp(frame, "FRAME", 5)) {
@@ -1139,30 +1217,6 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
   }
   /*Now convert the just read frame.*/
   (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
-  /*Fill in the frame buffer pointers.
-    We don't use vpx_img_wrap() because it forces padding for odd picture
-     sizes, which would require a separate fread call for every row.*/
-  memset(_img, 0, sizeof(*_img));
-  /*Y4M has the planes in Y'CbCr order, which libvpx calls Y, U, and V.*/
-  _img->fmt = _y4m->vpx_fmt;
-  _img->w = _img->d_w = _y4m->pic_w;
-  _img->h = _img->d_h = _y4m->pic_h;
-  _img->x_chroma_shift = _y4m->dst_c_dec_h >> 1;
-  _img->y_chroma_shift = _y4m->dst_c_dec_v >> 1;
-  _img->bps = _y4m->bps;
-
-  /*Set up the buffer pointers.*/
-  pic_sz = _y4m->pic_w * _y4m->pic_h * bytes_per_sample;
-  c_w = (_y4m->pic_w + _y4m->dst_c_dec_h - 1) / _y4m->dst_c_dec_h;
-  c_w *= bytes_per_sample;
-  c_h = (_y4m->pic_h + _y4m->dst_c_dec_v - 1) / _y4m->dst_c_dec_v;
-  c_sz = c_w * c_h;
-  _img->stride[VPX_PLANE_Y] = _img->stride[VPX_PLANE_ALPHA] =
-      _y4m->pic_w * bytes_per_sample;
-  _img->stride[VPX_PLANE_U] = _img->stride[VPX_PLANE_V] = c_w;
-  _img->planes[VPX_PLANE_Y] = _y4m->dst_buf;
-  _img->planes[VPX_PLANE_U] = _y4m->dst_buf + pic_sz;
-  _img->planes[VPX_PLANE_V] = _y4m->dst_buf + pic_sz + c_sz;
-  _img->planes[VPX_PLANE_ALPHA] = _y4m->dst_buf + pic_sz + 2 * c_sz;
+  y4m_setup_image(_y4m, _img, _y4m->dst_buf);
   return 1;
 }
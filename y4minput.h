@@ -23,6 +23,8 @@ extern "C" {
 
 typedef struct y4m_input y4m_input;
 
+struct MmapInputContext;
+
 /*The function used to perform chroma conversion.*/
 typedef void (*y4m_convert_func)(y4m_input *_y4m, unsigned char *_dst,
                                  unsigned char *_src);
@@ -54,6 +56,10 @@ struct y4m_input {
   enum vpx_img_fmt vpx_fmt;
   int bps;
   unsigned int bit_depth;
+  /*When not NULL, frames are fetched from this mapping of the input file
+     rather than read from the FILE, and frames that need no conversion
+     are returned without a copy.*/
+  struct MmapInputContext *mmap;
 };
 
 /**